@@ -282,6 +282,9 @@ iod_release_buffer(struct bio_desc *biod)
 	rsrvd_dma->brd_dma_chks = NULL;
 	rsrvd_dma->brd_chk_max = rsrvd_dma->brd_chk_cnt = 0;
 
+	if (biod->bd_sgl_filled != NULL)
+		D_FREE(biod->bd_sgl_filled);
+
 	biod->bd_buffer_prep = 0;
 }
 
@@ -320,6 +323,7 @@ iterate_biov(struct bio_desc *biod,
 		if (bsgl->bs_nr_out == 0)
 			continue;
 
+		biod->bd_sgl_idx = i;
 		for (j = 0; j < bsgl->bs_nr_out; j++) {
 			struct bio_iov *biov = &bsgl->bs_iovs[j];
 
@@ -467,6 +471,9 @@ iod_add_region(struct bio_desc *biod, struct bio_dma_chunk *chk,
 	rsrvd_dma->brd_regions[cnt].brr_pg_idx = chk_pg_idx;
 	rsrvd_dma->brd_regions[cnt].brr_off = off;
 	rsrvd_dma->brd_regions[cnt].brr_end = end;
+	rsrvd_dma->brd_regions[cnt].brr_sgl_first = biod->bd_sgl_idx;
+	rsrvd_dma->brd_regions[cnt].brr_sgl_last = biod->bd_sgl_idx;
+	rsrvd_dma->brd_regions[cnt].brr_submitted = false;
 	rsrvd_dma->brd_rg_cnt++;
 	return 0;
 }
@@ -566,6 +573,7 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov,
 				D_DEBUG(DB_IO, "Consecutive reserve %p.\n",
 					biov->bi_buf);
 				last_rg->brr_end = end;
+				last_rg->brr_sgl_last = biod->bd_sgl_idx;
 				return 0;
 			}
 		}
@@ -649,70 +657,118 @@ rw_completion(void *cb_arg, int err)
 }
 
 static void
-dma_rw(struct bio_desc *biod, bool prep)
+dma_rw_begin(struct bio_desc *biod)
+{
+	biod->bd_inflights = 0;
+	biod->bd_dma_issued = 0;
+	biod->bd_result = 0;
+}
+
+/* Submit DMA transfer for a reserved region, don't wait for completion */
+static void
+dma_rw_region(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 {
 	struct spdk_io_channel	*channel;
 	struct spdk_blob	*blob;
+	uint64_t		 pg_idx, pg_cnt;
+	void			*payload;
+
+	D_ASSERT(!rg->brr_submitted);
+	rg->brr_submitted = true;
+
+	/* Bypass NVMe I/O, used by daos_perf for performance evaluation */
+	if (daos_io_bypass & IOBP_NVME)
+		return;
+
+	blob = biod->bd_ctxt->bic_blob;
+	channel = biod->bd_ctxt->bic_xs_ctxt->bxc_io_channel;
+	D_ASSERT(blob != NULL && channel != NULL);
+
+	D_ASSERT(rg->brr_chk != NULL);
+	pg_idx = rg->brr_off >> BIO_DMA_PAGE_SHIFT;
+	payload = rg->brr_chk->bdc_ptr + (rg->brr_pg_idx << BIO_DMA_PAGE_SHIFT);
+
+	pg_cnt = (rg->brr_end + BIO_DMA_PAGE_SZ - 1) >> BIO_DMA_PAGE_SHIFT;
+	D_ASSERT(pg_cnt > pg_idx);
+	pg_cnt -= pg_idx;
+
+	ABT_mutex_lock(biod->bd_mutex);
+	biod->bd_inflights++;
+	ABT_mutex_unlock(biod->bd_mutex);
+
+	D_DEBUG(DB_IO, "%s blob:%p payload:%p, pg_idx:"DF_U64", pg_cnt:"DF_U64
+		"\n", biod->bd_update ? "Write" : "Read", blob, payload,
+		pg_idx, pg_cnt);
+
+	if (biod->bd_update)
+		spdk_blob_io_write(blob, channel, payload, pg_idx, pg_cnt,
+				   rw_completion, biod);
+	else
+		spdk_blob_io_read(blob, channel, payload, pg_idx, pg_cnt,
+				  rw_completion, biod);
+}
+
+/* Wait for all the submitted DMA transfers of @biod */
+static void
+dma_rw_wait(struct bio_desc *biod)
+{
+	struct bio_xs_context	*xs_ctxt;
+
+	D_ASSERT(biod->bd_ctxt->bic_xs_ctxt);
+	xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
+
+	if (xs_ctxt->bxc_xs_id == -1) {
+		D_DEBUG(DB_IO, "Self poll completion, biod:%p\n", biod);
+		xs_poll_completion(xs_ctxt, &biod->bd_inflights);
+	} else {
+		ABT_mutex_lock(biod->bd_mutex);
+		biod->bd_dma_issued = 1;
+		if (biod->bd_inflights != 0)
+			ABT_cond_wait(biod->bd_dma_done, biod->bd_mutex);
+		biod->bd_dma_issued = 0;
+		ABT_mutex_unlock(biod->bd_mutex);
+	}
+
+	D_DEBUG(DB_IO, "DMA done, biod:%p, update:%d\n", biod,
+		biod->bd_update);
+}
+
+/*
+ * Submit DMA transfers for all the regions not submitted yet, the caller
+ * waits for completion by dma_rw_wait().
+ */
+static void
+dma_rw_submit(struct bio_desc *biod, bool prep)
+{
 	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
 	struct bio_rsrvd_region	*rg;
-	struct bio_xs_context	*xs_ctxt;
-	uint64_t		 pg_idx, pg_cnt, pg_end;
+	uint64_t		 pg_idx, pg_end;
 	void			*payload, *pg_rmw = NULL;
 	bool			 rmw_read = (prep && biod->bd_update);
 	unsigned int		 pg_off;
 	int			 i;
 
-	D_ASSERT(biod->bd_ctxt->bic_xs_ctxt);
-	xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
-	blob = biod->bd_ctxt->bic_blob;
-	channel = xs_ctxt->bxc_io_channel;
-	D_ASSERT(blob != NULL && channel != NULL);
-
 	/* Bypass NVMe I/O, used by daos_perf for performance evaluation */
 	if (daos_io_bypass & IOBP_NVME)
 		return;
 
-	D_DEBUG(DB_IO, "DMA start, blob:%p, update:%d, rmw:%d\n",
-		blob, biod->bd_update, rmw_read);
-
-	biod->bd_inflights = 0;
-	biod->bd_dma_issued = 0;
-	biod->bd_result = 0;
+	D_DEBUG(DB_IO, "DMA start, biod:%p, update:%d, rmw:%d\n",
+		biod, biod->bd_update, rmw_read);
 
 	for (i = 0; i < rsrvd_dma->brd_rg_cnt; i++) {
 		rg = &rsrvd_dma->brd_regions[i];
 
+		if (!rmw_read) {
+			if (!rg->brr_submitted)
+				dma_rw_region(biod, rg);
+			continue;
+		}
+
 		D_ASSERT(rg->brr_chk != NULL);
 		pg_idx = rg->brr_off >> BIO_DMA_PAGE_SHIFT;
 		payload = rg->brr_chk->bdc_ptr +
 			(rg->brr_pg_idx << BIO_DMA_PAGE_SHIFT);
 
-		if (!rmw_read) {
-			pg_cnt = (rg->brr_end + BIO_DMA_PAGE_SZ - 1) >>
-					BIO_DMA_PAGE_SHIFT;
-			D_ASSERT(pg_cnt > pg_idx);
-			pg_cnt -= pg_idx;
-
-			ABT_mutex_lock(biod->bd_mutex);
-			biod->bd_inflights++;
-			ABT_mutex_unlock(biod->bd_mutex);
-
-			D_DEBUG(DB_IO, "%s blob:%p payload:%p, "
-				"pg_idx:"DF_U64", pg_cnt:"DF_U64"\n",
-				biod->bd_update ? "Write" : "Read",
-				blob, payload, pg_idx, pg_cnt);
-
-			if (biod->bd_update)
-				spdk_blob_io_write(blob, channel, payload,
-						   pg_idx, pg_cnt,
-						   rw_completion, biod);
-			else
-				spdk_blob_io_read(blob, channel, payload,
-						  pg_idx, pg_cnt,
-						  rw_completion, biod);
-			continue;
-		}
-
 		/*
 		 * Since DAOS doesn't support partial overwrite yet, we don't
 		 * do RMW for partial update, only zeroing the page instead.
@@ -720,9 +776,9 @@ dma_rw(struct bio_desc *biod, bool prep)
 		pg_off = rg->brr_off & ((uint64_t)BIO_DMA_PAGE_SZ - 1);
 
 		if (pg_off != 0 && payload != pg_rmw) {
-			D_DEBUG(DB_IO, "Front partial blob:%p payload:%p, "
+			D_DEBUG(DB_IO, "Front partial payload:%p, "
 				"pg_idx:"DF_U64" pg_off:%d\n",
-				blob, payload, pg_idx, pg_off);
+				payload, pg_idx, pg_off);
 
 			memset(payload, 0, BIO_DMA_PAGE_SZ);
 			pg_rmw = payload;
@@ -734,28 +790,14 @@ dma_rw(struct bio_desc *biod, bool prep)
 		pg_off = rg->brr_end & ((uint64_t)BIO_DMA_PAGE_SZ - 1);
 
 		if (pg_off != 0 && payload != pg_rmw) {
-			D_DEBUG(DB_IO, "Rear partial blob:%p payload:%p, "
+			D_DEBUG(DB_IO, "Rear partial payload:%p, "
 				"pg_idx:"DF_U64" pg_off:%d\n",
-				blob, payload, pg_idx, pg_off);
+				payload, pg_idx, pg_off);
 
 			memset(payload, 0, BIO_DMA_PAGE_SZ);
 			pg_rmw = payload;
 		}
 	}
-
-	if (xs_ctxt->bxc_xs_id == -1) {
-		D_DEBUG(DB_IO, "Self poll completion, blob:%p\n", blob);
-		xs_poll_completion(xs_ctxt, &biod->bd_inflights);
-	} else {
-		ABT_mutex_lock(biod->bd_mutex);
-		biod->bd_dma_issued = 1;
-		if (biod->bd_inflights != 0)
-			ABT_cond_wait(biod->bd_dma_done, biod->bd_mutex);
-		ABT_mutex_unlock(biod->bd_mutex);
-	}
-
-	D_DEBUG(DB_IO, "DMA done, blob:%p, update:%d, rmw:%d\n",
-		blob, biod->bd_update, rmw_read);
 }
 
 void
@@ -853,8 +895,8 @@ dma_drop_iod(struct bio_dma_buffer *bdb)
 	ABT_mutex_unlock(bdb->bdb_mutex);
 }
 
-int
-bio_iod_prep(struct bio_desc *biod)
+static int
+iod_prep(struct bio_desc *biod, bool wait)
 {
 	struct bio_dma_buffer *bdb;
 	int rc, retry_cnt = 0;
@@ -903,19 +945,28 @@ retry:
 	bdb = iod_dma_buf(biod);
 	bdb->bdb_active_iods++;
 
-	rc = ABT_mutex_create(&biod->bd_mutex);
-	if (rc != ABT_SUCCESS) {
-		rc = -DER_NOMEM;
-		goto failed;
+	if (biod->bd_mutex == ABT_MUTEX_NULL) {
+		rc = ABT_mutex_create(&biod->bd_mutex);
+		if (rc != ABT_SUCCESS) {
+			rc = -DER_NOMEM;
+			goto failed;
+		}
 	}
 
-	rc = ABT_cond_create(&biod->bd_dma_done);
-	if (rc != ABT_SUCCESS) {
-		rc = -DER_NOMEM;
-		goto failed;
+	if (biod->bd_dma_done == ABT_COND_NULL) {
+		rc = ABT_cond_create(&biod->bd_dma_done);
+		if (rc != ABT_SUCCESS) {
+			rc = -DER_NOMEM;
+			goto failed;
+		}
 	}
 
-	dma_rw(biod, true);
+	dma_rw_begin(biod);
+	dma_rw_submit(biod, true);
+	if (!wait)
+		return 0;
+
+	dma_rw_wait(biod);
 	if (biod->bd_result) {
 		rc = biod->bd_result;
 		goto failed;
@@ -928,6 +979,74 @@ failed:
 	return rc;
 }
 
+int
+bio_iod_prep(struct bio_desc *biod)
+{
+	return iod_prep(biod, true);
+}
+
+int
+bio_iod_prep_nowait(struct bio_desc *biod)
+{
+	return iod_prep(biod, false);
+}
+
+int
+bio_iod_wait(struct bio_desc *biod)
+{
+	if (!biod->bd_buffer_prep)
+		return -DER_INVAL;
+
+	/* All SCM IOVs, no DMA transfer submitted */
+	if (biod->bd_rsrvd.brd_rg_cnt == 0)
+		return 0;
+
+	dma_rw_wait(biod);
+	return biod->bd_result;
+}
+
+int
+bio_iod_flush(struct bio_desc *biod, unsigned int sgl_idx)
+{
+	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
+	struct bio_rsrvd_region	*rg;
+	unsigned int		 i, j;
+
+	if (!biod->bd_buffer_prep || sgl_idx >= biod->bd_sgl_cnt)
+		return -DER_INVAL;
+
+	/* Nothing to write back for fetch or SCM IOVs */
+	if (!biod->bd_update || rsrvd_dma->brd_rg_cnt == 0)
+		return 0;
+
+	if (biod->bd_sgl_filled == NULL) {
+		D_ALLOC_ARRAY(biod->bd_sgl_filled, biod->bd_sgl_cnt);
+		if (biod->bd_sgl_filled == NULL)
+			return -DER_NOMEM;
+	}
+	biod->bd_sgl_filled[sgl_idx] = true;
+
+	/*
+	 * A region could be shared by adjacent SG lists, it can only be
+	 * written back once all of them are filled.
+	 */
+	for (i = 0; i < rsrvd_dma->brd_rg_cnt; i++) {
+		rg = &rsrvd_dma->brd_regions[i];
+		if (rg->brr_submitted || rg->brr_sgl_first > sgl_idx ||
+		    rg->brr_sgl_last < sgl_idx)
+			continue;
+
+		for (j = rg->brr_sgl_first; j <= rg->brr_sgl_last; j++) {
+			if (!biod->bd_sgl_filled[j])
+				break;
+		}
+		if (j > rg->brr_sgl_last)
+			dma_rw_region(biod, rg);
+	}
+
+	return 0;
+}
+
 int
 bio_iod_post(struct bio_desc *biod)
 {
@@ -942,10 +1061,14 @@ bio_iod_post(struct bio_desc *biod)
 		return 0;
 	}
 
+	/*
+	 * Write back the regions not flushed yet, and wait for all the
+	 * inflight DMA transfers (including the ones submitted by
+	 * bio_iod_prep_nowait() or bio_iod_flush()) before releasing buffer.
+	 */
 	if (biod->bd_update)
-		dma_rw(biod, false);
-	else
-		biod->bd_result = 0;
+		dma_rw_submit(biod, false);
+	dma_rw_wait(biod);
 
 	iod_release_buffer(biod);
 	bdb = iod_dma_buf(biod);
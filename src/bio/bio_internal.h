@@ -98,6 +98,11 @@ struct bio_rsrvd_region {
 	uint64_t		 brr_off;
 	/* End (not included) in bytes */
 	uint64_t		 brr_end;
+	/* First and last SG list which have data in the region */
+	unsigned int		 brr_sgl_first;
+	unsigned int		 brr_sgl_last;
+	/* DMA transfer for the region has been submitted */
+	bool			 brr_submitted;
 };
 
 /* Reserved DMA buffer for certain io descriptor */
@@ -133,6 +138,10 @@ struct bio_desc {
 	/* Inflight SPDK DMA transfers */
 	unsigned int		 bd_inflights;
 	int			 bd_result;
+	/* SG list being mapped by bio_iod_prep() */
+	unsigned int		 bd_sgl_idx;
+	/* SG lists filled by caller, see bio_iod_flush() */
+	bool			*bd_sgl_filled;
 	/* Flags */
 	unsigned int		 bd_buffer_prep:1,
 				 bd_update:1,
@@ -0,0 +1,327 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * Client OID allocator
+ *
+ * Hands out unique IDs of a container from ranges reserved with
+ * daos_cont_alloc_oids(). The next range is reserved asynchronously when the
+ * current one runs low, and the range size adapts to the consumption rate.
+ *
+ * Callers take tickets with an atomic increment. The published ranges map
+ * consecutive tickets to their IDs: the first ticket of a range is the last
+ * ticket of the previous range plus one. A small ring of the latest ranges,
+ * each guarded by a sequence counter, lets callers translate their tickets
+ * without a lock. If the range of a ticket has been recycled before the caller
+ * could look it up, the ticket (and its ID) is skipped. Only callers whose
+ * tickets are not covered yet take the lock to wait for a refill.
+ */
+#define D_LOGFAC	DD_FAC(client)
+
+#include <daos/common.h>
+#include <daos_api.h>
+
+/* number of latest ranges in which tickets can be looked up */
+#define OID_ALLOC_RING		4
+/* bounds of the range size */
+#define OID_ALLOC_NR_MIN	256ULL
+#define OID_ALLOC_NR_MAX	(1ULL << 20)
+/* range lifetimes (in us) below and above which the range size is adapted */
+#define OID_ALLOC_FAST_US	1000000ULL
+#define OID_ALLOC_SLOW_US	30000000ULL
+
+struct oid_range {
+	uint64_t	or_seq;		/* odd while being written */
+	uint64_t	or_ticket;	/* first ticket */
+	uint64_t	or_nr;		/* number of tickets */
+	uint64_t	or_oid;		/* ID of or_ticket */
+};
+
+struct daos_oid_alloc {
+	daos_handle_t		oa_coh;
+	/* next ticket */
+	uint64_t		oa_ticket;
+	/* tickets below this are covered by published ranges */
+	uint64_t		oa_avail;
+	/* size of the next range */
+	uint64_t		oa_nr;
+	/* refill in flight */
+	bool			oa_inflight;
+	struct oid_range	oa_ring[OID_ALLOC_RING];
+	/* members below are protected by oa_lock */
+	pthread_mutex_t		oa_lock;
+	uint64_t		oa_nranges;	/* ranges ever published */
+	uint64_t		oa_publish_us;	/* last publish time */
+	daos_event_t		oa_ev;		/* event of the refill */
+	uint64_t		oa_refill_oid;
+	uint64_t		oa_refill_nr;
+};
+
+/* Translate ticket \a t. Return false if its range has been recycled. */
+static bool
+oid_alloc_lookup(struct daos_oid_alloc *oa, uint64_t t, uint64_t *oid)
+{
+	int i;
+
+	for (i = 0; i < OID_ALLOC_RING; i++) {
+		struct oid_range       *r = &oa->oa_ring[i];
+		uint64_t		seq;
+		uint64_t		ticket;
+		uint64_t		nr;
+		uint64_t		base;
+
+		seq = __atomic_load_n(&r->or_seq, __ATOMIC_ACQUIRE);
+		if (seq & 1)
+			continue;
+		ticket = __atomic_load_n(&r->or_ticket, __ATOMIC_RELAXED);
+		nr = __atomic_load_n(&r->or_nr, __ATOMIC_RELAXED);
+		base = __atomic_load_n(&r->or_oid, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&r->or_seq, __ATOMIC_RELAXED) != seq)
+			continue;
+
+		if (t >= ticket && t - ticket < nr) {
+			*oid = base + (t - ticket);
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Publish range [oid, oid + nr) for the next nr tickets. Call with oa_lock. */
+static void
+oid_alloc_publish(struct daos_oid_alloc *oa, uint64_t oid, uint64_t nr)
+{
+	struct oid_range       *r;
+	uint64_t		avail = oa->oa_avail;
+	uint64_t		now = d_timeus_secdiff(0);
+	uint64_t		seq;
+
+	r = &oa->oa_ring[oa->oa_nranges % OID_ALLOC_RING];
+	seq = r->or_seq;
+	__atomic_store_n(&r->or_seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	__atomic_store_n(&r->or_ticket, avail, __ATOMIC_RELAXED);
+	__atomic_store_n(&r->or_nr, nr, __ATOMIC_RELAXED);
+	__atomic_store_n(&r->or_oid, oid, __ATOMIC_RELAXED);
+	__atomic_store_n(&r->or_seq, seq + 2, __ATOMIC_RELEASE);
+	oa->oa_nranges++;
+	__atomic_store_n(&oa->oa_avail, avail + nr, __ATOMIC_RELEASE);
+
+	/* Size the next range by how long the previous one lasted. */
+	if (now - oa->oa_publish_us < OID_ALLOC_FAST_US &&
+	    oa->oa_nr < OID_ALLOC_NR_MAX)
+		__atomic_store_n(&oa->oa_nr, oa->oa_nr * 2, __ATOMIC_RELAXED);
+	else if (now - oa->oa_publish_us > OID_ALLOC_SLOW_US &&
+		 oa->oa_nr > OID_ALLOC_NR_MIN)
+		__atomic_store_n(&oa->oa_nr, oa->oa_nr / 2, __ATOMIC_RELAXED);
+	oa->oa_publish_us = now;
+
+	D_DEBUG(DB_TRACE, "oid range "DF_U64"-"DF_U64" for tickets from "
+		DF_U64", next size "DF_U64"\n", oid, oid + nr - 1, avail,
+		oa->oa_nr);
+}
+
+/* Start a refill. Call with oa_lock and no refill in flight. */
+static int
+oid_alloc_refill(struct daos_oid_alloc *oa)
+{
+	int rc;
+
+	D_ASSERT(!oa->oa_inflight);
+	oa->oa_refill_nr = oa->oa_nr;
+	rc = daos_cont_alloc_oids(oa->oa_coh, oa->oa_refill_nr,
+				  &oa->oa_refill_oid, &oa->oa_ev);
+	if (rc != 0) {
+		D_ERROR("failed to start oid refill: %d\n", rc);
+		return rc;
+	}
+	__atomic_store_n(&oa->oa_inflight, true, __ATOMIC_RELEASE);
+	return 0;
+}
+
+/*
+ * Check, or if \a wait is true, wait for, the refill in flight, and publish
+ * its range if it has completed. Call with oa_lock.
+ */
+static int
+oid_alloc_poll(struct daos_oid_alloc *oa, bool wait)
+{
+	bool	done;
+	int	rc;
+
+	D_ASSERT(oa->oa_inflight);
+	rc = daos_event_test(&oa->oa_ev, wait ? DAOS_EQ_WAIT : DAOS_EQ_NOWAIT,
+			     &done);
+	if (rc != 0)
+		return rc;
+	if (!done)
+		return 0;
+
+	__atomic_store_n(&oa->oa_inflight, false, __ATOMIC_RELEASE);
+	rc = oa->oa_ev.ev_error;
+	if (rc != 0) {
+		D_ERROR("failed to refill oids: %d\n", rc);
+		return rc;
+	}
+	oid_alloc_publish(oa, oa->oa_refill_oid, oa->oa_refill_nr);
+	return 0;
+}
+
+/*
+ * Below the low watermark: start a refill or check the one in flight, unless
+ * another caller is doing either.
+ */
+static void
+oid_alloc_low(struct daos_oid_alloc *oa)
+{
+	uint64_t	left;
+	int		rc;
+
+	if (pthread_mutex_trylock(&oa->oa_lock) != 0)
+		return;
+
+	if (oa->oa_inflight) {
+		oid_alloc_poll(oa, false /* wait */);
+	} else {
+		/* Someone may have refilled already. */
+		left = __atomic_load_n(&oa->oa_avail, __ATOMIC_RELAXED) -
+		       __atomic_load_n(&oa->oa_ticket, __ATOMIC_RELAXED);
+		if ((int64_t)left <= (int64_t)(oa->oa_nr / 2)) {
+			rc = oid_alloc_refill(oa);
+			if (rc != 0)
+				D_DEBUG(DB_TRACE, "refill deferred: %d\n", rc);
+		}
+	}
+
+	D_MUTEX_UNLOCK(&oa->oa_lock);
+}
+
+/* Wait until ticket \a t is covered. */
+static int
+oid_alloc_wait(struct daos_oid_alloc *oa, uint64_t t)
+{
+	int rc = 0;
+
+	D_MUTEX_LOCK(&oa->oa_lock);
+	while (__atomic_load_n(&oa->oa_avail, __ATOMIC_ACQUIRE) <= t) {
+		if (!oa->oa_inflight) {
+			rc = oid_alloc_refill(oa);
+			if (rc != 0)
+				break;
+		}
+		rc = oid_alloc_poll(oa, true /* wait */);
+		if (rc != 0)
+			break;
+	}
+	D_MUTEX_UNLOCK(&oa->oa_lock);
+	return rc;
+}
+
+int
+daos_cont_oid_alloc_init(daos_handle_t coh, struct daos_oid_alloc **oap)
+{
+	struct daos_oid_alloc  *oa;
+	int			rc;
+
+	if (oap == NULL)
+		return -DER_INVAL;
+
+	D_ALLOC_PTR(oa);
+	if (oa == NULL)
+		return -DER_NOMEM;
+
+	oa->oa_coh = coh;
+	oa->oa_nr = OID_ALLOC_NR_MIN;
+	oa->oa_publish_us = d_timeus_secdiff(0);
+	rc = D_MUTEX_INIT(&oa->oa_lock, NULL);
+	if (rc != 0)
+		D_GOTO(err_oa, rc);
+	rc = daos_event_init(&oa->oa_ev, DAOS_HDL_INVAL, NULL /* parent */);
+	if (rc != 0)
+		D_GOTO(err_lock, rc);
+
+	/* Reserve the first range in the background. */
+	D_MUTEX_LOCK(&oa->oa_lock);
+	rc = oid_alloc_refill(oa);
+	D_MUTEX_UNLOCK(&oa->oa_lock);
+	if (rc != 0)
+		D_GOTO(err_ev, rc);
+
+	*oap = oa;
+	return 0;
+
+err_ev:
+	daos_event_fini(&oa->oa_ev);
+err_lock:
+	D_MUTEX_DESTROY(&oa->oa_lock);
+err_oa:
+	D_FREE(oa);
+	return rc;
+}
+
+int
+daos_cont_oid_alloc(struct daos_oid_alloc *oa, uint64_t *oid)
+{
+	uint64_t	t;
+	uint64_t	avail;
+	int		rc;
+
+	if (oa == NULL || oid == NULL)
+		return -DER_INVAL;
+
+	do {
+		t = __atomic_fetch_add(&oa->oa_ticket, 1, __ATOMIC_RELAXED);
+		avail = __atomic_load_n(&oa->oa_avail, __ATOMIC_ACQUIRE);
+		if (t >= avail) {
+			rc = oid_alloc_wait(oa, t);
+			if (rc != 0)
+				return rc;
+		} else if (avail - t <=
+			   __atomic_load_n(&oa->oa_nr, __ATOMIC_RELAXED) / 2 ||
+			   __atomic_load_n(&oa->oa_inflight,
+					   __ATOMIC_RELAXED)) {
+			oid_alloc_low(oa);
+		}
+	} while (!oid_alloc_lookup(oa, t, oid));
+
+	return 0;
+}
+
+int
+daos_cont_oid_alloc_fini(struct daos_oid_alloc *oa)
+{
+	int rc = 0;
+
+	if (oa == NULL)
+		return -DER_INVAL;
+
+	D_MUTEX_LOCK(&oa->oa_lock);
+	if (oa->oa_inflight)
+		rc = oid_alloc_poll(oa, true /* wait */);
+	D_MUTEX_UNLOCK(&oa->oa_lock);
+
+	daos_event_fini(&oa->oa_ev);
+	D_MUTEX_DESTROY(&oa->oa_lock);
+	D_FREE(oa);
+	return rc;
+}
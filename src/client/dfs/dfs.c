@@ -35,6 +35,7 @@
 #include <daos/common.h>
 #include <daos/debug.h>
 #include <daos/container.h>
+#include <daos/object.h>
 
 #include "daos_types.h"
 #include "daos_api.h"
@@ -49,7 +50,7 @@
 #define SB_MAGIC	0xda05df50da05df50
 
 /** Number of A-keys for attributes in any object entry */
-#define INODE_AKEYS	6
+#define INODE_AKEYS	7
 /** A-key name of mode_t value */
 #define MODE_NAME	"mode"
 /** A-key name of object ID value */
@@ -60,11 +61,12 @@
 #define MTIME_NAME	"mtime"
 /** A-key name of last change time */
 #define CTIME_NAME	"ctime"
+/** A-key name of the object class and chunk size policy of a directory */
+#define POLICY_NAME	"policy"
 /** A-key name of symlink value */
 #define SYML_NAME	"syml"
 
-/** Array object stripe size for regular files */
-/** TODO - make this user configurable */
+/** Default array object stripe size for regular files (see dfs_policy_t) */
 #define STRIPE_SIZE	1048576
 
 /** Parameters for dkey enumeration */
@@ -96,14 +98,14 @@ struct dfs_obj {
 	char			name[DFS_MAX_PATH];
 	/** Symlink value if object is a symbolic link */
 	char			*value;
+	/** Policy for new objects if object is a directory */
+	dfs_policy_t		policy;
 };
 
 /** dfs struct that is instantiated for a mounted DFS namespace */
 struct dfs {
 	/** flag to indicate whether the dfs is mounted */
 	bool			mounted;
-	/** lock for threadsafety */
-	pthread_mutex_t		lock;
 	/** uid - inherited from pool. TODO - make this from container. */
 	uid_t			uid;
 	/** gid - inherited from pool. TODO - make this from container. */
@@ -114,8 +116,8 @@ struct dfs {
 	daos_handle_t		poh;
 	/** Open container handle of the DFS */
 	daos_handle_t		coh;
-	/** Object ID reserved for this DFS (see oid_gen below) */
-	daos_obj_id_t		oid;
+	/** OID allocator of a RW mount (see oid_gen below) */
+	struct daos_oid_alloc	*oid_alloc;
 	/** OID of SB */
 	daos_obj_id_t		super_oid;
 	/** Open object handle of SB */
@@ -137,6 +139,8 @@ struct dfs_entry {
 	time_t		mtime;
 	/* Time of last status change */
 	time_t		ctime;
+	/* Policy for new objects if a directory */
+	dfs_policy_t	policy;
 };
 
 #if 0
@@ -211,43 +215,39 @@ oid_cp(daos_obj_id_t *dst, daos_obj_id_t src)
 	dst->lo = src.lo;
 }
 
-#define MAX_OID_HI ((1UL << 32) - 1)
-
 /*
  * OID generation for the dfs objects.
  *
- * The oid.lo uint64_t value will be allocated from the DAOS container using the
- * unique oid allocator. 1 oid at a time will be allocated for the dfs mount.
- * The oid.hi value has the high 32 bits reserved for DAOS (obj class, type,
- * etc.). The lower 32 bits will be used locally by the dfs mount point, and
- * hence discarded when the dfs is unmounted.
+ * The oid.lo uint64_t value is a unique ID handed out by the container OID
+ * allocator of the mount, which reserves ranges of IDs from the container in
+ * the background. ID 0 (RESERVED_LO) is skipped since it is used by the SB and
+ * root objects. The oid.hi value has the high 32 bits reserved for DAOS (obj
+ * class, type, etc.), the lower 32 bits are always 0. IDs left in the reserved
+ * ranges are discarded when the dfs is unmounted.
  */
 int
 oid_gen(dfs_t *dfs, uint16_t oclass, bool file, daos_obj_id_t *oid)
 {
 	daos_ofeat_t	feat = 0;
-	int		rc = 0;
+	uint64_t	lo;
+	int		rc;
+
+	if (dfs->oid_alloc == NULL)
+		return -DER_NO_PERM;
 
 	if (oclass == 0)
 		oclass = DAOS_OC_REPL_MAX_RW;
 
-	D_MUTEX_LOCK(&dfs->lock);
-	/** If we ran out of local OIDs, alloc one from the container */
-	if (dfs->oid.hi >= MAX_OID_HI) {
-		/** Allocate an OID for the namespace */
-		rc = daos_cont_alloc_oids(dfs->coh, 1, &dfs->oid.lo, NULL);
+	do {
+		rc = daos_cont_oid_alloc(dfs->oid_alloc, &lo);
 		if (rc) {
-			D_ERROR("daos_cont_alloc_oids() Failed (%d)\n", rc);
-			D_MUTEX_UNLOCK(&dfs->lock);
+			D_ERROR("daos_cont_oid_alloc() Failed (%d)\n", rc);
 			return rc;
 		}
-		dfs->oid.hi = 0;
-	}
+	} while (lo == RESERVED_LO);
 
-	/** set oid and lo, bump the current hi value */
-	oid->lo = dfs->oid.lo;
-	oid->hi = dfs->oid.hi++;
-	D_MUTEX_UNLOCK(&dfs->lock);
+	oid->lo = lo;
+	oid->hi = 0;
 
 	/** if a regular file, use UINT64 typed dkeys for the array object */
 	if (file)
@@ -308,6 +308,11 @@ fetch_entry(daos_handle_t oh, daos_handle_t th, const char *name,
 	daos_iov_set(&iods[i].iod_name, CTIME_NAME, strlen(CTIME_NAME));
 	i++;
 
+	/** Set Akey for the policy, will be empty if not a dir */
+	daos_iov_set(&sg_iovs[i], &entry->policy, sizeof(dfs_policy_t));
+	daos_iov_set(&iods[i].iod_name, POLICY_NAME, strlen(POLICY_NAME));
+	i++;
+
 	if (fetch_sym) {
 		/** Set Akey for Symlink Value, will be empty if no symlink */
 		daos_iov_set(&sg_iovs[i], value, DFS_MAX_PATH);
@@ -337,6 +342,10 @@ fetch_entry(daos_handle_t oh, daos_handle_t th, const char *name,
 		return rc;
 	}
 
+	/** entries created without a policy use the defaults */
+	if (iods[INODE_AKEYS - 2].iod_size != sizeof(dfs_policy_t))
+		memset(&entry->policy, 0, sizeof(dfs_policy_t));
+
 	if (fetch_sym && S_ISLNK(entry->mode)) {
 		size_t sym_len = iods[INODE_AKEYS-1].iod_size;
 
@@ -430,6 +439,15 @@ insert_entry(daos_handle_t oh, daos_handle_t th, const char *name,
 	iods[i].iod_size = sizeof(time_t);
 	i++;
 
+	/** Add the policy if entry is a directory */
+	if (S_ISDIR(entry.mode)) {
+		daos_iov_set(&sg_iovs[i], &entry.policy, sizeof(dfs_policy_t));
+		daos_iov_set(&iods[i].iod_name, POLICY_NAME,
+			     strlen(POLICY_NAME));
+		iods[i].iod_size = sizeof(dfs_policy_t);
+		i++;
+	}
+
 	/** Add the symbolic link value if entry is a symlink */
 	if (S_ISLNK(entry.mode)) {
 		daos_iov_set(&sg_iovs[i], entry.value, strlen(entry.value) + 1);
@@ -659,6 +677,7 @@ open_file(dfs_t *dfs, daos_handle_t th, dfs_obj_t *parent, int flags,
 	struct dfs_entry	entry = {0};
 	bool			exists;
 	daos_size_t		elem_size, dkey_size;
+	daos_size_t		chunk_size;
 	int			daos_mode;
 	int			rc;
 
@@ -683,15 +702,21 @@ open_file(dfs_t *dfs, daos_handle_t th, dfs_obj_t *parent, int flags,
 			goto open_file;
 		}
 
-		/** Get new OID for the file */
+		/** Get new OID for the file, the parent policy applies */
+		if (cid == 0)
+			cid = parent->policy.dp_file_oclass;
 		rc = oid_gen(dfs, cid, true, &file->oid);
 		if (rc != 0)
 			return rc;
 		oid_cp(&entry.oid, file->oid);
 
+		chunk_size = parent->policy.dp_chunk_size;
+		if (chunk_size == 0)
+			chunk_size = STRIPE_SIZE;
+
 		/** Create array object for the file */
 		rc = daos_array_create(dfs->coh, file->oid, th, 1,
-				       STRIPE_SIZE, &file->oh, NULL);
+				       chunk_size, &file->oh, NULL);
 		if (rc != 0) {
 			D_ERROR("daos_array_create() failed (%d)\n", rc);
 			return rc;
@@ -759,7 +784,8 @@ open_file:
 
 /*
  * create a dir object. If caller passes parent obj, we check for existence of
- * object first.
+ * object first. The caller sets dir->policy to the one inherited from the
+ * parent, its dir object class applies if cid is 0.
  */
 static int
 create_dir(dfs_t *dfs, daos_handle_t th, daos_handle_t parent_oh,
@@ -780,6 +806,8 @@ create_dir(dfs_t *dfs, daos_handle_t th, daos_handle_t parent_oh,
 			return -DER_EXIST;
 	}
 
+	if (cid == 0)
+		cid = dir->policy.dp_dir_oclass;
 	rc = oid_gen(dfs, cid, false, &dir->oid);
 	if (rc != 0)
 		return rc;
@@ -809,6 +837,7 @@ open_dir(dfs_t *dfs, daos_handle_t th, daos_handle_t parent_oh, int flags,
 		entry.oid = dir->oid;
 		entry.mode = dir->mode;
 		entry.atime = entry.mtime = entry.ctime = time(NULL);
+		entry.policy = dir->policy;
 
 		rc = insert_entry(parent_oh, th, dir->name, entry);
 		if (rc != 0) {
@@ -850,6 +879,7 @@ open_dir(dfs_t *dfs, daos_handle_t th, daos_handle_t parent_oh, int flags,
 		return rc;
 	}
 	dir->mode = entry.mode;
+	dir->policy = entry.policy;
 	oid_cp(&dir->oid, entry.oid);
 
 	return rc;
@@ -982,9 +1012,6 @@ dfs_mount(daos_handle_t poh, daos_handle_t coh, int flags, dfs_t **_dfs)
 	dfs->poh = poh;
 	dfs->coh = coh;
 	dfs->amode = amode;
-	rc = D_MUTEX_INIT(&dfs->lock, NULL);
-	if (rc != 0)
-		return rc;
 
 	rc = daos_pool_query(poh, NULL, &pool_info, NULL, NULL);
 	if (rc) {
@@ -1009,9 +1036,6 @@ dfs_mount(daos_handle_t poh, daos_handle_t coh, int flags, dfs_t **_dfs)
 		D_GOTO(err_dfs, rc = -DER_INVAL);
 	}
 
-	dfs->oid.hi = 0;
-	dfs->oid.lo = 0;
-
 	/** Open special object on container for SB info */
 	dfs->super_oid.lo = RESERVED_LO;
 	dfs->super_oid.hi = SB_HI;
@@ -1026,11 +1050,11 @@ dfs_mount(daos_handle_t poh, daos_handle_t coh, int flags, dfs_t **_dfs)
 	D_DEBUG(DB_TRACE, "DFS super object %"PRIu64".%"PRIu64"\n",
 		dfs->super_oid.hi, dfs->super_oid.lo);
 
-	/** if RW, allocate an OID for the namespace */
+	/** if RW, start prefetching OIDs for the namespace */
 	if (amode == O_RDWR) {
-		rc = daos_cont_alloc_oids(coh, 1, &dfs->oid.lo, NULL);
+		rc = daos_cont_oid_alloc_init(coh, &dfs->oid_alloc);
 		if (rc) {
-			D_ERROR("daos_cont_alloc_oids() Failed (%d)\n", rc);
+			D_ERROR("daos_cont_oid_alloc_init() Failed (%d)\n", rc);
 			D_GOTO(err_tx, rc);
 		}
 	}
@@ -1046,41 +1070,10 @@ dfs_mount(daos_handle_t poh, daos_handle_t coh, int flags, dfs_t **_dfs)
 
 	rc = open_dir(dfs, th, dfs->super_oh, amode, 0, &dfs->root);
 	if (rc == 0) {
-		/** OID should not be 0 since this is an existing namespace. */
-		if (sb_exists && amode == O_RDWR &&
-		    dfs->oid.lo == RESERVED_LO) {
-			D_ERROR("OID should not be 0 in existing namespace\n");
-			D_GOTO(err_super, rc = -DER_INVAL);
-		}
-		D_DEBUG(DB_TRACE, "Namespace exists. OID lo = %"PRIu64".\n",
-			dfs->oid.lo);
+		D_DEBUG(DB_TRACE, "Namespace exists.\n");
 	} else if (rc == -DER_NONEXIST) {
 		D_DEBUG(DB_TRACE, "New Namespace, creating root object..\n");
 
-		if (amode == O_RDWR) {
-			/*
-			 * Set hi when we allocate the reserved oid. Account 0
-			 * for SB, 1 for root obj.
-			 */
-			if (dfs->oid.lo == RESERVED_LO)
-				dfs->oid.hi = ROOT_HI + 1;
-			/*
-			 * if lo is not 0 (reserved), we can use all the hi
-			 * ranks and we can start hi from 0. This happens when
-			 * multiple independent access is mounting the dfs at
-			 * the same time, and races between SB creation and oid
-			 * allocation can happen, leading us to here where the
-			 * mounter did not see the SB, but another one has raced
-			 * and allocated oid 0. One example is the MPI-IO file
-			 * per process case, where every process creates it's
-			 * own file in the same flat namespace.
-			 */
-			else
-				dfs->oid.hi = 0;
-		} else {
-			dfs->oid.hi = MAX_OID_HI;
-		}
-
 		/** Create the root object */
 		dfs->root.mode = S_IFDIR | 0777;
 		dfs->root.oid.lo = RESERVED_LO;
@@ -1136,6 +1129,8 @@ err_tx:
 		daos_tx_close(th, NULL);
 	}
 err_dfs:
+	if (dfs->oid_alloc)
+		daos_cont_oid_alloc_fini(dfs->oid_alloc);
 	D_FREE(dfs);
 	return rc;
 }
@@ -1149,7 +1144,8 @@ dfs_umount(dfs_t *dfs)
 	daos_obj_close(dfs->root.oh, NULL);
 	daos_obj_close(dfs->super_oh, NULL);
 
-	D_MUTEX_DESTROY(&dfs->lock);
+	if (dfs->oid_alloc)
+		daos_cont_oid_alloc_fini(dfs->oid_alloc);
 	D_FREE(dfs);
 
 	return 0;
@@ -1193,6 +1189,7 @@ dfs_mkdir(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
 	}
 
 	strcpy(new_dir.name, name);
+	new_dir.policy = parent->policy;
 	rc = create_dir(dfs, th, (parent ? parent->oh : DAOS_HDL_INVAL), 0,
 			&new_dir);
 	if (rc)
@@ -1201,6 +1198,7 @@ dfs_mkdir(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
 	entry.oid = new_dir.oid;
 	entry.mode = S_IFDIR | mode;
 	entry.atime = entry.mtime = entry.ctime = time(NULL);
+	entry.policy = new_dir.policy;
 
 	rc = insert_entry(parent->oh, th, name, entry);
 	if (rc != 0)
@@ -1394,6 +1392,7 @@ dfs_lookup(dfs_t *dfs, const char *path, int flags, dfs_obj_t **_obj,
 	oid_cp(&obj->oid, dfs->root.oid);
 	oid_cp(&obj->parent_oid, dfs->root.parent_oid);
 	obj->mode = dfs->root.mode;
+	obj->policy = dfs->root.policy;
 	strcpy(obj->name, dfs->root.name);
 	rc = daos_obj_open(dfs->coh, obj->oid, daos_mode, &obj->oh, NULL);
 	if (rc)
@@ -1516,6 +1515,7 @@ dfs_lookup_loop:
 		oid_cp(&parent.parent_oid, obj->parent_oid);
 		parent.oh = obj->oh;
 		parent.mode = entry.mode;
+		obj->policy = entry.policy;
 	}
 
 	if (mode)
@@ -1654,6 +1654,9 @@ dfs_open(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
 	strcpy(obj->name, name);
 	obj->mode = mode;
 	oid_cp(&obj->parent_oid, parent->oid);
+	/** a new directory inherits the policy of its parent */
+	if (S_ISDIR(mode) && (flags & O_CREAT))
+		obj->policy = parent->policy;
 
 	switch (mode & S_IFMT) {
 	case S_IFREG:
@@ -2053,6 +2056,102 @@ out:
 	return rc;
 }
 
+/** Check that the object class of a policy exists, 0 selects the default */
+static bool
+policy_oclass_valid(daos_oclass_id_t cid)
+{
+	daos_obj_id_t oid = {0};
+
+	if (cid == 0)
+		return true;
+
+	daos_obj_generate_id(&oid, 0, cid);
+	return daos_oclass_attr_find(oid) != NULL;
+}
+
+int
+dfs_set_policy(dfs_t *dfs, dfs_obj_t *obj, const dfs_policy_t *policy)
+{
+	daos_handle_t	th = DAOS_TX_NONE;
+	daos_sg_list_t	sgl;
+	daos_iov_t	sg_iov;
+	daos_iod_t	iod;
+	daos_key_t	dkey;
+	daos_handle_t	oh;
+	int		rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return -DER_INVAL;
+	if (dfs->amode != O_RDWR)
+		return -DER_NO_PERM;
+	if (obj == NULL || policy == NULL)
+		return -DER_INVAL;
+	if (!S_ISDIR(obj->mode))
+		return -DER_NOTDIR;
+	if (!policy_oclass_valid(policy->dp_dir_oclass) ||
+	    !policy_oclass_valid(policy->dp_file_oclass)) {
+		D_ERROR("Invalid object class in policy\n");
+		return -DER_INVAL;
+	}
+
+	rc = check_access(dfs, geteuid(), getegid(), obj->mode, W_OK);
+	if (rc) {
+		D_ERROR("Permission Denied.\n");
+		return rc;
+	}
+
+	/** Open parent object and update the policy in the entry of the dir */
+	rc = daos_obj_open(dfs->coh, obj->parent_oid, DAOS_OO_RW, &oh, NULL);
+	if (rc)
+		return rc;
+
+	/** set dkey as the entry name */
+	daos_iov_set(&dkey, (void *)obj->name, strlen(obj->name));
+
+	/** set akey as the policy attr name */
+	daos_iov_set(&iod.iod_name, POLICY_NAME, strlen(POLICY_NAME));
+	daos_csum_set(&iod.iod_kcsum, NULL, 0);
+	iod.iod_nr	= 1;
+	iod.iod_recxs	= NULL;
+	iod.iod_eprs	= NULL;
+	iod.iod_csums	= NULL;
+	iod.iod_type	= DAOS_IOD_SINGLE;
+	iod.iod_size	= sizeof(dfs_policy_t);
+
+	/** set sgl for update */
+	daos_iov_set(&sg_iov, (void *)policy, sizeof(dfs_policy_t));
+	sgl.sg_nr	= 1;
+	sgl.sg_nr_out	= 0;
+	sgl.sg_iovs	= &sg_iov;
+
+	rc = daos_obj_update(oh, th, &dkey, 1, &iod, &sgl, NULL);
+	if (rc) {
+		D_ERROR("Failed to update policy (rc = %d)\n", rc);
+		D_GOTO(out, rc);
+	}
+
+	obj->policy = *policy;
+	/** creates with a NULL parent use the mount's root object */
+	if (daos_obj_id_equal(obj->oid, dfs->root.oid))
+		dfs->root.policy = *policy;
+
+out:
+	daos_obj_close(oh, NULL);
+	return rc;
+}
+
+int
+dfs_get_policy(dfs_obj_t *obj, dfs_policy_t *policy)
+{
+	if (obj == NULL || policy == NULL)
+		return -DER_INVAL;
+	if (!S_ISDIR(obj->mode))
+		return -DER_NOTDIR;
+
+	*policy = obj->policy;
+	return 0;
+}
+
 int
 dfs_get_size(dfs_t *dfs, dfs_obj_t *obj, daos_size_t *size)
 {
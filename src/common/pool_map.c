@@ -69,6 +69,15 @@ struct pool_comp_sorter {
 	struct pool_component	**cs_comps;
 };
 
+/** # tracked target states, see pool_map_status_idx() */
+#define POOL_MAP_STATUS_NR	5
+/**
+ * Direct index tables are only built if the largest ID (or rank) is within
+ * this factor of the number of components, otherwise they waste too much
+ * memory and lookup falls back to binary search or scan.
+ */
+#define POOL_MAP_INDEX_SPARSE	4
+
 /** In memory data structure for pool map */
 struct pool_map {
 	/** protect the refcount */
@@ -91,7 +100,25 @@ struct pool_map {
 	 * NB: All components must be stored in contiguous buffer.
 	 */
 	struct pool_domain	*po_tree;
-
+	/**
+	 * Direct index of targets by ID, NULL if target IDs are too sparse,
+	 * in which case lookup falls back to po_target_sorter.
+	 */
+	struct pool_target	**po_tgt_index;
+	/** # slots in po_tgt_index, it is the maximum target ID plus one */
+	unsigned int		 po_tgt_index_nr;
+	/** Direct index of nodes by rank, NULL if ranks are too sparse */
+	struct pool_domain	**po_node_index;
+	/** # slots in po_node_index, it is the maximum rank plus one */
+	unsigned int		 po_node_index_nr;
+	/**
+	 * Bitmaps of targets in each state, indexed by the position of the
+	 * target in the contiguous target array, they are refreshed on
+	 * pool_map_set_version() and on pool map (re)initialisation.
+	 */
+	uint8_t			*po_tgt_status_bits[POOL_MAP_STATUS_NR];
+	/** # targets in each state */
+	unsigned int		 po_tgt_status_cnt[POOL_MAP_STATUS_NR];
 };
 
 static struct pool_comp_state_dict comp_state_dict[] = {
@@ -874,6 +901,138 @@ pool_tree_copy(struct pool_domain *dst, struct pool_domain *src)
 	pool_tree_build_ptrs(dst, &cntr);
 }
 
+/** index of \a status in po_tgt_status_bits, or -1 if it is not tracked */
+static int
+pool_map_status_idx(unsigned int status)
+{
+	int	idx;
+
+	for (idx = 0; idx < POOL_MAP_STATUS_NR; idx++) {
+		if (status == (1U << idx))
+			return idx;
+	}
+	return -1;
+}
+
+/**
+ * Rebuild the per-state target bitmaps and counters. Target states are
+ * changed in place by the callers, they always bump the pool map version
+ * by pool_map_set_version() afterwards, which calls this function.
+ */
+static void
+pool_map_status_refresh(struct pool_map *map)
+{
+	struct pool_target	*targets;
+	unsigned int		 nr;
+	unsigned int		 i;
+	int			 idx;
+
+	if (map->po_tgt_status_bits[0] == NULL)
+		return;
+
+	nr = pool_map_target_nr(map);
+	targets = pool_map_targets(map);
+	memset(map->po_tgt_status_bits[0], 0,
+	       POOL_MAP_STATUS_NR * howmany(nr, NBBY));
+	memset(map->po_tgt_status_cnt, 0, sizeof(map->po_tgt_status_cnt));
+
+	for (i = 0; i < nr; i++) {
+		idx = pool_map_status_idx(targets[i].ta_comp.co_status);
+		if (idx < 0)
+			continue;
+
+		setbit(map->po_tgt_status_bits[idx], i);
+		map->po_tgt_status_cnt[idx]++;
+	}
+}
+
+static void
+pool_map_index_fini(struct pool_map *map)
+{
+	if (map->po_tgt_index != NULL) {
+		D_FREE(map->po_tgt_index);
+		map->po_tgt_index_nr = 0;
+	}
+
+	if (map->po_node_index != NULL) {
+		D_FREE(map->po_node_index);
+		map->po_node_index_nr = 0;
+	}
+
+	if (map->po_tgt_status_bits[0] != NULL) {
+		D_FREE(map->po_tgt_status_bits[0]);
+		memset(map->po_tgt_status_bits, 0,
+		       sizeof(map->po_tgt_status_bits));
+	}
+}
+
+/**
+ * Build the direct index tables of a pool map: target ID to target, node
+ * rank to node, and the per-state target bitmaps. The ID and rank tables
+ * are optional, they are skipped if IDs or ranks are too sparse.
+ */
+static int
+pool_map_index_init(struct pool_map *map)
+{
+	struct pool_target	*targets;
+	struct pool_domain	*nodes;
+	unsigned int		 tgt_nr;
+	unsigned int		 node_nr;
+	unsigned int		 max_id;
+	unsigned int		 size;
+	unsigned int		 i;
+
+	tgt_nr = pool_map_target_nr(map);
+	targets = pool_map_targets(map);
+
+	for (i = 0, max_id = 0; i < tgt_nr; i++)
+		max_id = max(max_id, targets[i].ta_comp.co_id);
+
+	if (tgt_nr > 0 && max_id / POOL_MAP_INDEX_SPARSE < tgt_nr) {
+		D_ALLOC(map->po_tgt_index,
+			(max_id + 1) * sizeof(*map->po_tgt_index));
+		if (map->po_tgt_index == NULL)
+			goto failed;
+
+		map->po_tgt_index_nr = max_id + 1;
+		for (i = 0; i < tgt_nr; i++)
+			map->po_tgt_index[targets[i].ta_comp.co_id] =
+				&targets[i];
+	}
+
+	node_nr = pool_map_find_nodes(map, PO_COMP_ID_ALL, &nodes);
+	for (i = 0, max_id = 0; i < node_nr; i++)
+		max_id = max(max_id, nodes[i].do_comp.co_rank);
+
+	if (node_nr > 0 && max_id / POOL_MAP_INDEX_SPARSE < node_nr) {
+		D_ALLOC(map->po_node_index,
+			(max_id + 1) * sizeof(*map->po_node_index));
+		if (map->po_node_index == NULL)
+			goto failed;
+
+		map->po_node_index_nr = max_id + 1;
+		/* keep the first node if a rank appears more than once */
+		for (i = node_nr; i > 0; i--)
+			map->po_node_index[nodes[i - 1].do_comp.co_rank] =
+				&nodes[i - 1];
+	}
+
+	size = howmany(max(tgt_nr, 1U), NBBY);
+	D_ALLOC(map->po_tgt_status_bits[0], POOL_MAP_STATUS_NR * size);
+	if (map->po_tgt_status_bits[0] == NULL)
+		goto failed;
+
+	for (i = 1; i < POOL_MAP_STATUS_NR; i++)
+		map->po_tgt_status_bits[i] =
+			map->po_tgt_status_bits[i - 1] + size;
+
+	pool_map_status_refresh(map);
+	return 0;
+failed:
+	pool_map_index_fini(map);
+	return -DER_NOMEM;
+}
+
 /** free data members of a pool map */
 static void
 pool_map_finalise(struct pool_map *map)
@@ -882,6 +1041,7 @@ pool_map_finalise(struct pool_map *map)
 
 	D_DEBUG(DB_MGMT, "Release buffers for pool map\n");
 
+	pool_map_index_fini(map);
 	comp_sorter_fini(&map->po_target_sorter);
 
 	if (map->po_domain_sorters != NULL) {
@@ -993,6 +1153,10 @@ pool_map_initialise(struct pool_map *map, bool activate,
 	if (rc != 0)
 		goto failed;
 
+	rc = pool_map_index_init(map);
+	if (rc != 0)
+		goto failed;
+
 	return 0;
  failed:
 	D_DEBUG(DB_MGMT, "Failed to setup pool map %d\n", rc);
@@ -1414,6 +1578,254 @@ pool_map_create(struct pool_buf *buf, uint32_t version, struct pool_map **mapp)
 	return rc;
 }
 
+/**
+ * A delta is only worth sending if it is smaller than 1/POOL_MAP_DELTA_RATIO
+ * of the full pool map.
+ */
+#define POOL_MAP_DELTA_RATIO	4
+
+/**
+ * Call \a cb for all components of \a map in pool buffer order, i.e. domains
+ * layer by layer then targets, the fake root is skipped.
+ */
+static int
+pool_map_comp_walk(struct pool_map *map,
+		   int (*cb)(struct pool_component *comp, void *arg),
+		   void *arg)
+{
+	struct pool_domain	*doms;
+	struct pool_target	*tgts;
+	unsigned int		 nr;
+	int			 i;
+	int			 j;
+	int			 rc;
+
+	doms = map->po_tree[0].do_children;
+	for (i = 1; i < map->po_domain_layers; i++) {
+		nr = map->po_domain_sorters[i].cs_nr;
+		for (j = 0; j < nr; j++) {
+			rc = cb(&doms[j].do_comp, arg);
+			if (rc != 0)
+				return rc;
+		}
+		doms = doms[0].do_children;
+	}
+
+	tgts = map->po_tree[0].do_targets;
+	nr = map->po_tree[0].do_target_nr;
+	for (j = 0; j < nr; j++) {
+		rc = cb(&tgts[j].ta_comp, arg);
+		if (rc != 0)
+			return rc;
+	}
+	return 0;
+}
+
+struct pool_delta_arg {
+	/** all components of the previous map, in pool buffer order */
+	struct pool_component	**da_prev;
+	/** delta of the previous map, can be NULL */
+	struct pool_buf		 *da_prev_delta;
+	/** output buffer, only count changes if it is NULL */
+	struct pool_buf		 *da_buf;
+	unsigned int		  da_idx;
+	unsigned int		  da_delta_idx;
+	unsigned int		  da_changed;
+};
+
+static int
+pool_comp_collect_cb(struct pool_component *comp, void *arg)
+{
+	struct pool_component ***cursor = arg;
+
+	**cursor = comp;
+	(*cursor)++;
+	return 0;
+}
+
+static int
+pool_delta_cb(struct pool_component *comp, void *data)
+{
+	struct pool_delta_arg	*arg = data;
+	struct pool_component	*prev = arg->da_prev[arg->da_idx++];
+	struct pool_buf		*prev_delta = arg->da_prev_delta;
+	bool			 changed = false;
+
+	if (prev->co_type != comp->co_type || prev->co_id != comp->co_id)
+		return -DER_MISMATCH; /* new components */
+
+	/* components in the previous delta are in the same order */
+	if (prev_delta != NULL && arg->da_delta_idx < prev_delta->pb_nr) {
+		struct pool_component *dc;
+
+		dc = &prev_delta->pb_comps[arg->da_delta_idx];
+		if (dc->co_type == comp->co_type && dc->co_id == comp->co_id) {
+			arg->da_delta_idx++;
+			changed = true;
+		}
+	}
+
+	if (prev->co_status != comp->co_status ||
+	    prev->co_fseq != comp->co_fseq)
+		changed = true;
+
+	if (!changed)
+		return 0;
+
+	arg->da_changed++;
+	if (arg->da_buf != NULL)
+		return pool_buf_attach(arg->da_buf, comp, 1);
+	return 0;
+}
+
+/**
+ * Extract the delta of pool map \a map, which replaces pool map \a prev, into
+ * a pool buffer. The delta holds the current value of the components whose
+ * state changed since the base version of \a prev_delta, which is the delta
+ * extracted for \a prev, or since \a prev if \a prev_delta is NULL. It can be
+ * applied by pool_map_delta_apply() to any pool map not older than the base.
+ *
+ * Only component state transitions can be carried by a delta. -DER_MISMATCH
+ * is returned if components have been added, and -DER_OVERFLOW if the delta
+ * is not much smaller than the full map; the caller should send the full map
+ * extracted by pool_buf_extract() in both cases.
+ *
+ * \param prev		[IN]	The replaced pool map.
+ * \param map		[IN]	The new pool map.
+ * \param prev_delta	[IN]	Delta of \a prev, optional.
+ * \param buf_pp	[OUT]	The returned delta, should be freed by
+ *				pool_buf_free.
+ */
+int
+pool_map_delta_extract(struct pool_map *prev, struct pool_map *map,
+		       struct pool_buf *prev_delta, struct pool_buf **buf_pp)
+{
+	struct pool_delta_arg	 arg = { 0 };
+	struct pool_component	**cursor;
+	unsigned int		  total;
+	int			  i;
+	int			  rc;
+
+	if (pool_map_empty(prev) || pool_map_empty(map) ||
+	    prev->po_domain_layers != map->po_domain_layers ||
+	    prev->po_tree[0].do_target_nr != map->po_tree[0].do_target_nr)
+		return -DER_MISMATCH;
+
+	total = prev->po_tree[0].do_target_nr;
+	for (i = 1; i < prev->po_domain_layers; i++) {
+		if (prev->po_domain_sorters[i].cs_nr !=
+		    map->po_domain_sorters[i].cs_nr)
+			return -DER_MISMATCH;
+		total += prev->po_domain_sorters[i].cs_nr;
+	}
+
+	D_ALLOC_ARRAY(arg.da_prev, total);
+	if (arg.da_prev == NULL)
+		return -DER_NOMEM;
+
+	cursor = arg.da_prev;
+	pool_map_comp_walk(prev, pool_comp_collect_cb, &cursor);
+	arg.da_prev_delta = prev_delta;
+
+	/* count the changes first, then fill the buffer */
+	rc = pool_map_comp_walk(map, pool_delta_cb, &arg);
+	if (rc != 0)
+		goto out;
+
+	if (arg.da_changed * POOL_MAP_DELTA_RATIO >= total &&
+	    arg.da_changed != 0)
+		D_GOTO(out, rc = -DER_OVERFLOW);
+
+	arg.da_buf = pool_buf_alloc(arg.da_changed);
+	if (arg.da_buf == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	arg.da_idx = arg.da_delta_idx = arg.da_changed = 0;
+	rc = pool_map_comp_walk(map, pool_delta_cb, &arg);
+	if (rc != 0) {
+		pool_buf_free(arg.da_buf);
+		goto out;
+	}
+
+	D_DEBUG(DB_MGMT, "delta of pool map %u->%u: %u of %u components\n",
+		prev->po_version, map->po_version, arg.da_changed, total);
+	*buf_pp = arg.da_buf;
+out:
+	D_FREE(arg.da_prev);
+	return rc;
+}
+
+/**
+ * Create a pool map of \a version by applying the delta \a buf, extracted by
+ * pool_map_delta_extract(), to \a map. \a map should not be older than the
+ * base of the delta. Pool maps are shared by their users, so the changes are
+ * applied to a private copy rather than to \a map itself.
+ *
+ * \param map		[IN]	The pool map to apply the delta to.
+ * \param version	[IN]	Version of the new pool map.
+ * \param buf		[IN]	The delta.
+ * \param mapp		[OUT]	The returned pool map.
+ */
+int
+pool_map_delta_apply(struct pool_map *map, uint32_t version,
+		     struct pool_buf *buf, struct pool_map **mapp)
+{
+	struct pool_buf		*full;
+	struct pool_map		*new;
+	struct pool_component	*comp;
+	struct pool_component	*dst;
+	int			 i;
+	int			 rc;
+
+	if (version < map->po_version)
+		return -DER_STALE;
+
+	rc = pool_buf_extract(map, &full);
+	if (rc != 0)
+		return rc;
+
+	rc = pool_map_create(full, map->po_version, &new);
+	pool_buf_free(full);
+	if (rc != 0)
+		return rc;
+
+	for (i = 0; i < buf->pb_nr; i++) {
+		comp = &buf->pb_comps[i];
+		if (comp->co_type == PO_COMP_TP_TARGET) {
+			struct pool_target *tgt;
+
+			rc = pool_map_find_target(new, comp->co_id, &tgt);
+			dst = rc == 1 ? &tgt->ta_comp : NULL;
+		} else {
+			struct pool_domain *dom;
+
+			rc = pool_map_find_domain(new, comp->co_type,
+						  comp->co_id, &dom);
+			dst = rc == 1 ? &dom->do_comp : NULL;
+		}
+
+		if (dst == NULL) {
+			D_ERROR("%s[%u] of pool map delta does not exist\n",
+				pool_comp_name(comp), comp->co_id);
+			D_GOTO(failed, rc = -DER_NONEXIST);
+		}
+
+		D_DEBUG(DB_MGMT, "%s[%u]: status %u->%u, fseq %u->%u\n",
+			pool_comp_name(comp), comp->co_id, dst->co_status,
+			comp->co_status, dst->co_fseq, comp->co_fseq);
+		dst->co_status = comp->co_status;
+		dst->co_fseq = comp->co_fseq;
+	}
+
+	new->po_version = version;
+	pool_map_status_refresh(new);
+	*mapp = new;
+	return 0;
+failed:
+	pool_map_decref(new);
+	return rc;
+}
+
 /**
  * Destroy a pool map.
  */
@@ -1525,7 +1937,8 @@ pool_map_find_nodes(struct pool_map *map, uint32_t id,
 }
 
 /**
- * Find a target whose id equals to \a id by the binary search.
+ * Find a target whose id equals to \a id by the direct index, or by the
+ * binary search if target IDs are too sparse to be indexed.
  * If id is PO_COMP_ID_ALL, it returns the contiguously stored target array
  * to \a target_pp.
  *
@@ -1554,7 +1967,11 @@ pool_map_find_target(struct pool_map *map, uint32_t id,
 		return map->po_tree[0].do_target_nr;
 	}
 
-	target = comp_sorter_find_target(sorter, id);
+	if (map->po_tgt_index != NULL)
+		target = id < map->po_tgt_index_nr ?
+			 map->po_tgt_index[id] : NULL;
+	else
+		target = comp_sorter_find_target(sorter, id);
 	if (target == NULL)
 		return 0;
 
@@ -1578,12 +1995,16 @@ pool_map_find_node_by_rank(struct pool_map *map, uint32_t rank)
 	int			doms_cnt;
 	int			i;
 
+	if (map->po_node_index != NULL)
+		return rank < map->po_node_index_nr ?
+		       map->po_node_index[rank] : NULL;
+
 	doms_cnt = pool_map_find_nodes(map, PO_COMP_ID_ALL, &doms);
 	if (doms_cnt <= 0)
 		return NULL;
 
+	/* ranks are too sparse to be indexed */
 	for (i = 0; i < doms_cnt; i++) {
-		/* FIXME add rank sorter to the pool map */
 		if (doms[i].do_comp.co_rank == rank) {
 			found = &doms[i];
 			break;
@@ -1718,6 +2139,81 @@ matched_criteria(struct find_tgts_param *param,
 	return true;
 }
 
+/**
+ * Status based variant of pool_map_find_tgts(), it only visits targets in
+ * the requested states by walking the per-state bitmaps, and it can size
+ * the output array from the per-state counters without a counting pass.
+ */
+static int
+pool_map_find_tgts_indexed(struct pool_map *map,
+			   struct find_tgts_param *param,
+			   daos_sort_ops_t *sorter, struct pool_target **tgt_pp,
+			   unsigned int *tgt_cnt)
+{
+	struct pool_target	*targets = pool_map_targets(map);
+	uint8_t			*bits[POOL_MAP_STATUS_NR];
+	unsigned int		 total_cnt = pool_map_target_nr(map);
+	unsigned int		 bits_nr = 0;
+	unsigned int		 cnt = 0;
+	unsigned int		 idx = 0;
+	unsigned int		 i;
+	unsigned int		 j;
+	uint8_t			 byte;
+
+	for (i = 0; i < POOL_MAP_STATUS_NR; i++) {
+		if (!(param->ftp_status & (1U << i)) ||
+		    map->po_tgt_status_cnt[i] == 0)
+			continue;
+
+		bits[bits_nr++] = map->po_tgt_status_bits[i];
+		cnt += map->po_tgt_status_cnt[i];
+	}
+
+	if (cnt == 0)
+		return 0;
+
+	if (tgt_pp == NULL && !param->ftp_chk_max_fseq &&
+	    !param->ftp_chk_min_fseq) {
+		*tgt_cnt = cnt;
+		return 0;
+	}
+
+	/* the fseq criteria can only shrink the result */
+	if (tgt_pp != NULL) {
+		D_ALLOC(*tgt_pp, cnt * sizeof(*targets));
+		if (*tgt_pp == NULL)
+			return -DER_NOMEM;
+	}
+
+	for (i = 0; i < howmany(total_cnt, NBBY); i++) {
+		for (j = 0, byte = 0; j < bits_nr; j++)
+			byte |= bits[j][i];
+
+		for (j = i * NBBY; byte != 0; j++, byte >>= 1) {
+			if (!(byte & 1) || !matched_criteria(param,
+							     &targets[j]))
+				continue;
+
+			if (tgt_pp != NULL)
+				(*tgt_pp)[idx] = targets[j];
+			idx++;
+		}
+	}
+
+	*tgt_cnt = idx;
+	if (tgt_pp == NULL)
+		return 0;
+
+	if (idx == 0) {
+		D_FREE(*tgt_pp);
+		*tgt_pp = NULL;
+	} else if (sorter != NULL) {
+		daos_array_sort(*tgt_pp, idx, false, sorter);
+	}
+
+	return 0;
+}
+
 /**
  * Find array of targets which match the query criteria. Caller is
  * responsible for freeing the target array.
@@ -1749,6 +2245,10 @@ pool_map_find_tgts(struct pool_map *map, struct find_tgts_param *param,
 		return 0;
 	}
 
+	if (param->ftp_chk_status && map->po_tgt_status_bits[0] != NULL)
+		return pool_map_find_tgts_indexed(map, param, sorter, tgt_pp,
+						  tgt_cnt);
+
 	/* pool map won't be changed between the two scans */
 	total_cnt = pool_map_target_nr(map);
 	targets = pool_map_targets(map);
@@ -1813,8 +2313,7 @@ pool_map_find_failed_tgts(struct pool_map *map, struct pool_target **tgt_pp,
 }
 
 /**
- * Find all targets in DOWN state. Raft leader can use it drive target
- * rebuild one by one.
+ * Find all targets in UP or UPIN state.
  */
 int
 pool_map_find_up_tgts(struct pool_map *map, struct pool_target **tgt_pp,
@@ -1824,7 +2323,7 @@ pool_map_find_up_tgts(struct pool_map *map, struct pool_target **tgt_pp,
 
 	memset(&param, 0, sizeof(param));
 	param.ftp_chk_status = 1;
-	param.ftp_status = PO_COMP_ST_UP;
+	param.ftp_status = PO_COMP_ST_UP | PO_COMP_ST_UPIN;
 
 	return pool_map_find_tgts(map, &param, &fseq_sort_ops, tgt_pp,
 				  tgt_cnt);
@@ -1901,6 +2400,8 @@ pool_map_set_version(struct pool_map *map, uint32_t version)
 		return -DER_NO_PERM;
 	}
 
+	/* target states are changed in place before bumping the version */
+	pool_map_status_refresh(map);
 	if (map->po_version == version)
 		return 0;
 
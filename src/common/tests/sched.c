@@ -815,6 +815,87 @@ out:
 	return rc;
 }
 
+#define TASK_DELAY	100000	/* us */
+
+static int
+sched_test_7()
+{
+	tse_sched_t	sched;
+	tse_task_t	*task = NULL;
+	int		*counter = NULL;
+	bool		flag;
+	int		rc;
+
+	TSE_TEST_ENTRY("7", "reinit task with delay");
+
+	print_message("Init Scheduler\n");
+	rc = tse_sched_init(&sched, NULL, 0);
+	if (rc != 0) {
+		print_error("Failed to init scheduler: %d\n", rc);
+		D_GOTO(out, rc);
+	}
+
+	D_ALLOC_PTR(counter);
+	if (counter == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	print_message("Init task\n");
+	rc = tse_task_create(inc_func, &sched, counter, &task);
+	if (rc != 0) {
+		print_error("Failed to init task: %d\n", rc);
+		D_GOTO(out, rc);
+	}
+
+	rc = tse_task_schedule(task, false);
+	if (rc != 0) {
+		print_error("Failed to insert task in scheduler: %d\n", rc);
+		D_GOTO(out, rc);
+	}
+
+	tse_sched_progress(&sched);
+	if (*counter != 1) {
+		print_error("Task should have run once\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	print_message("Reinit task with %d us delay\n", TASK_DELAY);
+	rc = tse_task_reinit_with_delay(task, TASK_DELAY);
+	if (rc != 0) {
+		print_error("Failed to reinit task: %d\n", rc);
+		D_GOTO(out, rc);
+	}
+
+	tse_sched_progress(&sched);
+	if (*counter != 1) {
+		print_error("Task should not run before the delay\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	usleep(TASK_DELAY * 2);
+	tse_sched_progress(&sched);
+	if (*counter != 2) {
+		print_error("Task should run after the delay\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	tse_task_complete(task, 0);
+	task = NULL; /* lost my refcount */
+
+	flag = tse_sched_check_complete(&sched);
+	if (!flag) {
+		print_error("Scheduler should not have in-flight tasks\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+out:
+	if (task)
+		tse_task_decref(task);
+	if (counter)
+		D_FREE(counter);
+	TSE_TEST_EXIT(rc);
+	return rc;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -861,6 +942,12 @@ main(int argc, char **argv)
 		test_fail++;
 	}
 
+	rc = sched_test_7();
+	if (rc != 0) {
+		print_error("SCHED TEST 7 failed: %d\n", rc);
+		test_fail++;
+	}
+
 	if (test_fail)
 		print_error("ERROR, %d test(s) failed\n", test_fail);
 	else
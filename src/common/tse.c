@@ -45,6 +45,16 @@ struct tse_task_link {
 
 static void tse_sched_decref(struct tse_sched_private *dsp);
 
+/* monotonic time in us, for delayed tasks */
+static inline uint64_t
+tse_gettime_us(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
 int
 tse_sched_init(tse_sched_t *sched, tse_sched_comp_cb_t comp_cb,
 	       void *udata)
@@ -469,12 +479,20 @@ tse_sched_process_init(struct tse_sched_private *dsp)
 	struct tse_task_private		*dtp;
 	struct tse_task_private		*tmp;
 	d_list_t			list;
+	uint64_t			now = 0;
 	int				processed = 0;
 
 	D_INIT_LIST_HEAD(&list);
 	D_MUTEX_LOCK(&dsp->dsp_lock);
 	d_list_for_each_entry_safe(dtp, tmp, &dsp->dsp_init_list,
 				      dtp_list) {
+		if (dtp->dtp_wakeup_time != 0 && !dsp->dsp_cancelling) {
+			if (now == 0)
+				now = tse_gettime_us();
+			if (dtp->dtp_wakeup_time > now)
+				continue; /* delayed */
+		}
+
 		if (dtp->dtp_dep_cnt == 0 || dsp->dsp_cancelling) {
 			d_list_move_tail(&dtp->dtp_list, &list);
 			dsp->dsp_inflight++;
@@ -933,8 +951,8 @@ tse_task_schedule(tse_task_t *task, bool instant)
 	return rc;
 }
 
-int
-tse_task_reinit(tse_task_t *task)
+static int
+tse_task_reinit_internal(tse_task_t *task, uint64_t wakeup_time)
 {
 	struct tse_task_private		*dtp = tse_task2priv(task);
 	tse_sched_t			*sched = tse_task2sched(task);
@@ -972,6 +990,7 @@ tse_task_reinit(tse_task_t *task)
 	dtp->dtp_running = 0;
 	dtp->dtp_completing = 0;
 	dtp->dtp_completed = 0;
+	dtp->dtp_wakeup_time = wakeup_time;
 	/** Move back to init list */
 	d_list_move_tail(&dtp->dtp_list, &dsp->dsp_init_list);
 
@@ -986,6 +1005,18 @@ err_unlock:
 	return rc;
 }
 
+int
+tse_task_reinit(tse_task_t *task)
+{
+	return tse_task_reinit_internal(task, 0);
+}
+
+int
+tse_task_reinit_with_delay(tse_task_t *task, uint64_t delay)
+{
+	return tse_task_reinit_internal(task, tse_gettime_us() + delay);
+}
+
 int
 tse_task_list_add(tse_task_t *task, d_list_t *head)
 {
@@ -70,7 +70,7 @@ struct tse_task_private {
 					 dtp_completing:1,
 					/* task is in running state */
 					 dtp_running:1,
-					 dtp_dep_cnt:30;
+					 dtp_dep_cnt:29;
 	/* refcount of the task */
 	uint32_t			 dtp_refcnt;
 	/**
@@ -80,6 +80,11 @@ struct tse_task_private {
 	 * fit in.
 	 */
 	void				*dtp_priv;
+	/**
+	 * the task isn't run before this time (in us, see tse_gettime_us()),
+	 * zero if the task is not delayed, see tse_task_reinit_with_delay().
+	 */
+	uint64_t			 dtp_wakeup_time;
 	/**
 	 * reserved buffer for user to assign embedded parameters, it also can
 	 * be used as task stack space that can push/pop parameters to
@@ -69,14 +69,18 @@ dc_cont_fini(void)
  *   RSVC_CLIENT_PROCEED	OK; proceed to process the reply
  */
 static int
-cont_rsvc_client_complete_rpc(struct dc_pool *pool, const crt_endpoint_t *ep,
+cont_rsvc_client_complete_rpc(struct dc_pool *pool, crt_rpc_t *rpc,
 			      int rc_crt, struct cont_op_out *out,
 			      tse_task_t *task)
 {
-	int rc;
+	struct cont_op_in      *in = crt_req_get(rpc);
+	struct rsvc_client     *client;
+	int			rc;
 
 	D_MUTEX_LOCK(&pool->dp_client_lock);
-	rc = rsvc_client_complete_rpc(&pool->dp_client, ep, rc_crt, out->co_rc,
+	client = dc_pool_cont_client(pool, cont_svc_id(in->ci_uuid,
+						       pool->dp_cont_svc_nr));
+	rc = rsvc_client_complete_rpc(client, &rpc->cr_ep, rc_crt, out->co_rc,
 				      &out->co_hint);
 	D_MUTEX_UNLOCK(&pool->dp_client_lock);
 	if (rc == RSVC_CLIENT_RECHOOSE ||
@@ -89,6 +93,20 @@ cont_rsvc_client_complete_rpc(struct dc_pool *pool, const crt_endpoint_t *ep,
 	return RSVC_CLIENT_PROCEED;
 }
 
+/* Choose a replica of the container service that container \a uuid maps to. */
+static void
+cont_rsvc_client_choose(struct dc_pool *pool, const uuid_t uuid,
+			crt_endpoint_t *ep)
+{
+	struct rsvc_client *client;
+
+	D_MUTEX_LOCK(&pool->dp_client_lock);
+	client = dc_pool_cont_client(pool, cont_svc_id(uuid,
+						       pool->dp_cont_svc_nr));
+	rsvc_client_choose(client, ep);
+	D_MUTEX_UNLOCK(&pool->dp_client_lock);
+}
+
 struct cont_args {
 	struct dc_pool		*pool;
 	crt_rpc_t		*rpc;
@@ -102,7 +120,7 @@ cont_create_complete(tse_task_t *task, void *data)
 	struct cont_create_out *out = crt_reply_get(arg->rpc);
 	int			rc = task->dt_result;
 
-	rc = cont_rsvc_client_complete_rpc(pool, &arg->rpc->cr_ep, rc,
+	rc = cont_rsvc_client_complete_rpc(pool, arg->rpc, rc,
 					   &out->cco_op, task);
 	if (rc < 0)
 		D_GOTO(out, rc);
@@ -154,9 +172,7 @@ dc_cont_create(tse_task_t *task)
 		DP_UUID(pool->dp_pool), DP_UUID(args->uuid));
 
 	ep.ep_grp = pool->dp_group;
-	D_MUTEX_LOCK(&pool->dp_client_lock);
-	rsvc_client_choose(&pool->dp_client, &ep);
-	D_MUTEX_UNLOCK(&pool->dp_client_lock);
+	cont_rsvc_client_choose(pool, args->uuid, &ep);
 	rc = cont_req_create(daos_task2ctx(task), &ep, CONT_CREATE, &rpc);
 	if (rc != 0) {
 		D_ERROR("failed to create rpc: %d\n", rc);
@@ -197,7 +213,7 @@ cont_destroy_complete(tse_task_t *task, void *data)
 	struct cont_destroy_out	*out = crt_reply_get(arg->rpc);
 	int			 rc = task->dt_result;
 
-	rc = cont_rsvc_client_complete_rpc(pool, &arg->rpc->cr_ep, rc,
+	rc = cont_rsvc_client_complete_rpc(pool, arg->rpc, rc,
 					   &out->cdo_op, task);
 	if (rc < 0)
 		D_GOTO(out, rc);
@@ -253,9 +269,7 @@ dc_cont_destroy(tse_task_t *task)
 		DP_UUID(pool->dp_pool), DP_UUID(args->uuid), args->force);
 
 	ep.ep_grp = pool->dp_group;
-	D_MUTEX_LOCK(&pool->dp_client_lock);
-	rsvc_client_choose(&pool->dp_client, &ep);
-	D_MUTEX_UNLOCK(&pool->dp_client_lock);
+	cont_rsvc_client_choose(pool, args->uuid, &ep);
 	rc = cont_req_create(daos_task2ctx(task), &ep, CONT_DESTROY, &rpc);
 	if (rc != 0) {
 		D_ERROR("failed to create rpc: %d\n", rc);
@@ -362,7 +376,7 @@ cont_open_complete(tse_task_t *task, void *data)
 	bool			 put_cont = true;
 	int			 rc = task->dt_result;
 
-	rc = cont_rsvc_client_complete_rpc(pool, &arg->rpc->cr_ep, rc,
+	rc = cont_rsvc_client_complete_rpc(pool, arg->rpc, rc,
 					   &out->coo_op, task);
 	if (rc < 0)
 		D_GOTO(out, rc);
@@ -537,9 +551,7 @@ dc_cont_open(tse_task_t *task)
 		args->flags);
 
 	ep.ep_grp = pool->dp_group;
-	D_MUTEX_LOCK(&pool->dp_client_lock);
-	rsvc_client_choose(&pool->dp_client, &ep);
-	D_MUTEX_UNLOCK(&pool->dp_client_lock);
+	cont_rsvc_client_choose(pool, args->uuid, &ep);
 	rc = cont_req_create(daos_task2ctx(task), &ep, CONT_OPEN, &rpc);
 	if (rc != 0) {
 		D_ERROR("failed to create rpc: %d\n", rc);
@@ -597,7 +609,7 @@ cont_close_complete(tse_task_t *task, void *data)
 	struct dc_cont		*cont = arg->cca_cont;
 	int			 rc = task->dt_result;
 
-	rc = cont_rsvc_client_complete_rpc(pool, &arg->rpc->cr_ep, rc,
+	rc = cont_rsvc_client_complete_rpc(pool, arg->rpc, rc,
 					   &out->cco_op, task);
 	if (rc < 0)
 		D_GOTO(out, rc);
@@ -698,9 +710,7 @@ dc_cont_close(tse_task_t *task)
 	}
 
 	ep.ep_grp = pool->dp_group;
-	D_MUTEX_LOCK(&pool->dp_client_lock);
-	rsvc_client_choose(&pool->dp_client, &ep);
-	D_MUTEX_UNLOCK(&pool->dp_client_lock);
+	cont_rsvc_client_choose(pool, cont->dc_uuid, &ep);
 	rc = cont_req_create(daos_task2ctx(task), &ep, CONT_CLOSE, &rpc);
 	if (rc != 0) {
 		D_ERROR("failed to create rpc: %d\n", rc);
@@ -758,7 +768,7 @@ cont_query_complete(tse_task_t *task, void *data)
 	struct dc_cont		*cont = arg->cqa_cont;
 	int			 rc   = task->dt_result;
 
-	rc = cont_rsvc_client_complete_rpc(pool, &arg->rpc->cr_ep, rc,
+	rc = cont_rsvc_client_complete_rpc(pool, arg->rpc, rc,
 					   &out->cqo_op, task);
 	if (rc < 0)
 		D_GOTO(out, rc);
@@ -879,9 +889,7 @@ dc_cont_query(tse_task_t *task)
 		DP_UUID(cont->dc_cont_hdl));
 
 	ep.ep_grp  = pool->dp_group;
-	D_MUTEX_LOCK(&pool->dp_client_lock);
-	rsvc_client_choose(&pool->dp_client, &ep);
-	D_MUTEX_UNLOCK(&pool->dp_client_lock);
+	cont_rsvc_client_choose(pool, cont->dc_uuid, &ep);
 	rc = cont_req_create(daos_task2ctx(task), &ep, CONT_QUERY, &rpc);
 	if (rc != 0) {
 		D_ERROR("failed to create rpc: %d\n", rc);
@@ -1368,7 +1376,7 @@ cont_req_complete(tse_task_t *task, void *data)
 	struct cont_op_out	*op_out	 = crt_reply_get(args->cra_rpc);
 	int			 rc	 = task->dt_result;
 
-	rc = cont_rsvc_client_complete_rpc(pool, &args->cra_rpc->cr_ep,
+	rc = cont_rsvc_client_complete_rpc(pool, args->cra_rpc,
 					   rc, op_out, task);
 	if (rc < 0)
 		D_GOTO(out, rc);
@@ -1414,9 +1422,7 @@ cont_req_prepare(daos_handle_t coh, enum cont_operation opcode,
 	D_ASSERT(args->cra_pool != NULL);
 
 	ep.ep_grp  = args->cra_pool->dp_group;
-	D_MUTEX_LOCK(&args->cra_pool->dp_client_lock);
-	rsvc_client_choose(&args->cra_pool->dp_client, &ep);
-	D_MUTEX_UNLOCK(&args->cra_pool->dp_client_lock);
+	cont_rsvc_client_choose(args->cra_pool, args->cra_cont->dc_uuid, &ep);
 
 	rc = cont_req_create(ctx, &ep, opcode, &args->cra_rpc);
 	if (rc != 0) {
@@ -64,6 +64,27 @@ crt_proc_daos_epoch_range_t(crt_proc_t proc, daos_epoch_range_t *erange)
 	return 0;
 }
 
+static int
+crt_proc_struct_cont_tgt_open_rec(crt_proc_t proc,
+				  struct cont_tgt_open_rec *rec)
+{
+	int rc;
+
+	rc = crt_proc_uuid_t(proc, &rec->tor_pool_hdl);
+	if (rc != 0)
+		return -DER_HG;
+
+	rc = crt_proc_uuid_t(proc, &rec->tor_hdl);
+	if (rc != 0)
+		return -DER_HG;
+
+	rc = crt_proc_uint64_t(proc, &rec->tor_capas);
+	if (rc != 0)
+		return -DER_HG;
+
+	return 0;
+}
+
 static int
 crt_proc_struct_cont_tgt_close_rec(crt_proc_t proc,
 				   struct cont_tgt_close_rec *rec)
@@ -108,6 +129,10 @@ CRT_RPC_DEFINE(cont_tgt_epoch_discard, DAOS_ISEQ_CONT_TGT_EPOCH_DISCARD,
 		DAOS_OSEQ_CONT_TGT_EPOCH_DISCARD)
 CRT_RPC_DEFINE(cont_tgt_epoch_aggregate, DAOS_ISEQ_CONT_TGT_EPOCH_AGGREGATE,
 		DAOS_OSEQ_CONT_TGT_EPOCH_AGGREGATE)
+CRT_RPC_DEFINE(cont_svc_oid_fetch_add, DAOS_ISEQ_CONT_SVC_OID_FETCH_ADD,
+		DAOS_OSEQ_CONT_SVC_OID_FETCH_ADD)
+CRT_RPC_DEFINE(cont_svc_close, DAOS_ISEQ_CONT_SVC_CLOSE,
+		DAOS_OSEQ_CONT_SVC_CLOSE)
 
 /* Define for cont_rpcs[] array population below.
  * See CONT_PROTO_*_RPC_LIST macro definition
@@ -113,7 +113,13 @@
 	X(CONT_TGT_EPOCH_AGGREGATE,					\
 		0, &CQF_cont_tgt_epoch_aggregate,			\
 		ds_cont_tgt_epoch_aggregate_handler,			\
-		&ds_cont_tgt_epoch_aggregate_co_ops)
+		&ds_cont_tgt_epoch_aggregate_co_ops),			\
+	X(CONT_SVC_OID_FETCH_ADD,					\
+		0, &CQF_cont_svc_oid_fetch_add,				\
+		ds_cont_svc_oid_fetch_add_handler, NULL),		\
+	X(CONT_SVC_CLOSE,						\
+		0, &CQF_cont_svc_close,					\
+		ds_cont_svc_close_handler, NULL)
 
 /* Define for RPC enum population below */
 #define X(a, b, c, d, e) a
@@ -289,12 +295,16 @@ CRT_RPC_DECLARE(cont_snap_destroy, DAOS_ISEQ_CONT_EPOCH_OP,
 
 CRT_RPC_DECLARE(cont_tgt_destroy, DAOS_ISEQ_TGT_DESTROY, DAOS_OSEQ_TGT_DESTROY)
 
+struct cont_tgt_open_rec {
+	uuid_t		tor_pool_hdl;
+	uuid_t		tor_hdl;
+	uint64_t	tor_capas;
+};
+
 #define DAOS_ISEQ_TGT_OPEN	/* input fields */		 \
 	((uuid_t)		(toi_pool_uuid)		CRT_VAR) \
-	((uuid_t)		(toi_pool_hdl)		CRT_VAR) \
 	((uuid_t)		(toi_uuid)		CRT_VAR) \
-	((uuid_t)		(toi_hdl)		CRT_VAR) \
-	((uint64_t)		(toi_capas)		CRT_VAR)
+	((struct cont_tgt_open_rec) (toi_recs)		CRT_ARRAY)
 
 #define DAOS_OSEQ_TGT_OPEN	/* output fields */		 \
 				/* number of errors */		 \
@@ -350,6 +360,52 @@ CRT_RPC_DECLARE(cont_tgt_epoch_discard, DAOS_ISEQ_CONT_TGT_EPOCH_DISCARD,
 CRT_RPC_DECLARE(cont_tgt_epoch_aggregate, DAOS_ISEQ_CONT_TGT_EPOCH_AGGREGATE,
 		DAOS_OSEQ_CONT_TGT_EPOCH_AGGREGATE)
 
+/*
+ * Forwarded by the pool service leader to the leader of a container service
+ * with its own DB, for the container operations the pool service initiates.
+ */
+#define DAOS_ISEQ_CONT_SVC_OID_FETCH_ADD /* input fields */	 \
+	((uuid_t)		(csoi_pool)		CRT_VAR) \
+	((uuid_t)		(csoi_pool_hdl)		CRT_VAR) \
+	((uuid_t)		(csoi_cont)		CRT_VAR) \
+	((uuid_t)		(csoi_cont_hdl)		CRT_VAR) \
+				/* container service ID */	 \
+	((uint64_t)		(csoi_svc)		CRT_VAR) \
+	((uint64_t)		(csoi_num_oids)		CRT_VAR)
+
+#define DAOS_OSEQ_CONT_SVC_OID_FETCH_ADD /* output fields */	 \
+	((struct cont_op_out)	(csoo_op)		CRT_VAR) \
+	((uint64_t)		(csoo_oid)		CRT_VAR)
+
+CRT_RPC_DECLARE(cont_svc_oid_fetch_add, DAOS_ISEQ_CONT_SVC_OID_FETCH_ADD,
+		DAOS_OSEQ_CONT_SVC_OID_FETCH_ADD)
+
+#define DAOS_ISEQ_CONT_SVC_CLOSE /* input fields */		 \
+	((uuid_t)		(csci_pool)		CRT_VAR) \
+				/* container service ID */	 \
+	((uint64_t)		(csci_svc)		CRT_VAR) \
+	((uuid_t)		(csci_pool_hdls)	CRT_ARRAY)
+
+#define DAOS_OSEQ_CONT_SVC_CLOSE /* output fields */		 \
+	((struct cont_op_out)	(csco_op)		CRT_VAR)
+
+CRT_RPC_DECLARE(cont_svc_close, DAOS_ISEQ_CONT_SVC_CLOSE,
+		DAOS_OSEQ_CONT_SVC_CLOSE)
+
+/*
+ * Return the ID of the container service managing container \a cont_uuid in
+ * a pool whose container metadata is sharded over \a nr container services.
+ * Service 0 is the one combined with the pool service.
+ */
+static inline uint64_t
+cont_svc_id(const uuid_t cont_uuid, uint32_t nr)
+{
+	if (nr <= 1)
+		return 0;
+	return d_hash_murmur64((const unsigned char *)cont_uuid,
+			       sizeof(uuid_t), 1101U) % nr;
+}
+
 static inline int
 cont_req_create(crt_context_t crt_ctx, crt_endpoint_t *tgt_ep, crt_opcode_t opc,
 		crt_rpc_t **req)
@@ -41,6 +41,8 @@ init(void)
 	rc = ds_oid_iv_init();
 	if (rc)
 		D_GOTO(err, rc);
+
+	ds_cont_rsvc_class_register();
 	return 0;
 
 err:
@@ -50,6 +52,7 @@ err:
 static int
 fini(void)
 {
+	ds_cont_rsvc_class_unregister();
 	ds_oid_iv_fini();
 	return 0;
 }
@@ -57,10 +57,29 @@ cont_svc_init(struct cont_svc *svc, const uuid_t pool_uuid, uint64_t id,
 		D_GOTO(err, rc = dss_abterr2der(rc));
 	}
 
+	rc = ABT_mutex_create(&svc->cs_open_mutex);
+	if (rc != ABT_SUCCESS) {
+		D_ERROR("failed to create cs_open_mutex: %d\n", rc);
+		D_GOTO(err_lock, rc = dss_abterr2der(rc));
+	}
+
+	rc = ABT_cond_create(&svc->cs_open_cv);
+	if (rc != ABT_SUCCESS) {
+		D_ERROR("failed to create cs_open_cv: %d\n", rc);
+		D_GOTO(err_open_mutex, rc = dss_abterr2der(rc));
+	}
+
+	D_INIT_LIST_HEAD(&svc->cs_opens);
+	svc->cs_opening = false;
+
+	rc = ds_cont_epoch_idx_init(svc);
+	if (rc != 0)
+		D_GOTO(err_open_cv, rc);
+
 	/* cs_root */
 	rc = rdb_path_init(&svc->cs_root);
 	if (rc != 0)
-		D_GOTO(err_lock, rc);
+		D_GOTO(err_epoch_idx, rc);
 	rc = rdb_path_push(&svc->cs_root, &rdb_path_root_key);
 	if (rc != 0)
 		D_GOTO(err_root, rc);
@@ -89,6 +108,12 @@ err_conts:
 	rdb_path_fini(&svc->cs_conts);
 err_root:
 	rdb_path_fini(&svc->cs_root);
+err_epoch_idx:
+	ds_cont_epoch_idx_fini(svc);
+err_open_cv:
+	ABT_cond_free(&svc->cs_open_cv);
+err_open_mutex:
+	ABT_mutex_free(&svc->cs_open_mutex);
 err_lock:
 	ABT_rwlock_free(&svc->cs_lock);
 err:
@@ -98,9 +123,13 @@ err:
 static void
 cont_svc_fini(struct cont_svc *svc)
 {
+	D_ASSERT(d_list_empty(&svc->cs_opens));
 	rdb_path_fini(&svc->cs_hdls);
 	rdb_path_fini(&svc->cs_conts);
 	rdb_path_fini(&svc->cs_root);
+	ds_cont_epoch_idx_fini(svc);
+	ABT_cond_free(&svc->cs_open_cv);
+	ABT_mutex_free(&svc->cs_open_mutex);
 	ABT_rwlock_free(&svc->cs_lock);
 }
 
@@ -142,25 +171,346 @@ ds_cont_svc_step_up(struct cont_svc *svc)
 void
 ds_cont_svc_step_down(struct cont_svc *svc)
 {
-	D_ASSERT(svc->cs_pool != NULL);
-	ds_pool_put(svc->cs_pool);
+	/* A container service with its own DB may not have used cs_pool. */
+	D_ASSERT(svc->cs_pool != NULL || svc->cs_id != 0);
+	if (svc->cs_pool != NULL)
+		ds_pool_put(svc->cs_pool);
 	svc->cs_pool = NULL;
 }
 
+/*
+ * Container service with its own DB
+ *
+ * Container services other than service 0, which is combined with the pool
+ * service, are replicated services of their own, each on the pool service
+ * replicas. See ds_pool_svc_create.
+ */
+struct cont_svc_rsvc_id {
+	uuid_t			csi_pool;
+	uint64_t		csi_id;
+};
+
+struct cont_svc_rsvc {
+	struct ds_rsvc		csr_rsvc;
+	struct cont_svc_rsvc_id	csr_id;
+	struct cont_svc		csr_svc;
+};
+
+static struct cont_svc_rsvc *
+cont_svc_rsvc_obj(struct ds_rsvc *rsvc)
+{
+	return container_of(rsvc, struct cont_svc_rsvc, csr_rsvc);
+}
+
+static int
+cont_svc_name_cb(daos_iov_t *id, char **name)
+{
+	struct cont_svc_rsvc_id	*csi = id->iov_buf;
+	char			 uuid[DAOS_UUID_STR_SIZE];
+	char			*s;
+
+	if (id->iov_len != sizeof(*csi))
+		return -DER_INVAL;
+	D_ALLOC(s, DAOS_UUID_STR_SIZE + 32);
+	if (s == NULL)
+		return -DER_NOMEM;
+	uuid_unparse_lower(csi->csi_pool, uuid);
+	uuid[8] = '\0'; /* strlen(DF_UUID) */
+	snprintf(s, DAOS_UUID_STR_SIZE + 32, "%s/cont-"DF_U64, uuid,
+		 csi->csi_id);
+	*name = s;
+	return 0;
+}
+
+static int
+cont_svc_locate_cb(daos_iov_t *id, char **path)
+{
+	struct cont_svc_rsvc_id	*csi = id->iov_buf;
+	char			*s;
+
+	if (id->iov_len != sizeof(*csi))
+		return -DER_INVAL;
+	s = ds_pool_cont_svc_rdb_path(csi->csi_pool, csi->csi_id);
+	if (s == NULL)
+		return -DER_NOMEM;
+	*path = s;
+	return 0;
+}
+
+static int
+cont_svc_alloc_cb(daos_iov_t *id, struct ds_rsvc **rsvc)
+{
+	struct cont_svc_rsvc	*svc;
+	int			 rc;
+
+	if (id->iov_len != sizeof(svc->csr_id))
+		return -DER_INVAL;
+
+	D_ALLOC_PTR(svc);
+	if (svc == NULL)
+		return -DER_NOMEM;
+
+	memcpy(&svc->csr_id, id->iov_buf, sizeof(svc->csr_id));
+	daos_iov_set(&svc->csr_rsvc.s_id, &svc->csr_id, sizeof(svc->csr_id));
+
+	rc = cont_svc_init(&svc->csr_svc, svc->csr_id.csi_pool,
+			   svc->csr_id.csi_id, &svc->csr_rsvc);
+	if (rc != 0) {
+		D_FREE(svc);
+		return rc;
+	}
+
+	*rsvc = &svc->csr_rsvc;
+	return 0;
+}
+
+static void
+cont_svc_free_cb(struct ds_rsvc *rsvc)
+{
+	struct cont_svc_rsvc *svc = cont_svc_rsvc_obj(rsvc);
+
+	cont_svc_fini(&svc->csr_svc);
+	D_FREE(svc);
+}
+
+/*
+ * Unlike the pool service, a container service DB needs no arguments to be
+ * initialized, so a new leader of a new DB initializes the layout itself.
+ */
+static int
+cont_svc_init_db(struct cont_svc *svc)
+{
+	struct rdb_tx		tx;
+	struct rdb_kvs_attr	attr;
+	daos_iov_t		value;
+	uint64_t		id;
+	int			rc;
+
+	rc = rdb_tx_begin(svc->cs_rsvc->s_db, svc->cs_rsvc->s_term, &tx);
+	if (rc != 0)
+		return rc;
+	ABT_rwlock_wrlock(svc->cs_lock);
+
+	daos_iov_set(&value, &id, sizeof(id));
+	rc = rdb_tx_lookup(&tx, &svc->cs_root, &ds_cont_prop_svc_id, &value);
+	if (rc == 0) {
+		if (id != svc->cs_id) {
+			D_ERROR(DF_UUID": container service "DF_U64" found DB "
+				"of "DF_U64"\n", DP_UUID(svc->cs_pool_uuid),
+				svc->cs_id, id);
+			rc = -DER_PROTO;
+		}
+		D_GOTO(out, rc);
+	} else if (rc != -DER_NONEXIST) {
+		D_GOTO(out, rc);
+	}
+
+	D_DEBUG(DF_DSMS, DF_UUID": initializing container service "DF_U64"\n",
+		DP_UUID(svc->cs_pool_uuid), svc->cs_id);
+	attr.dsa_class = RDB_KVS_GENERIC;
+	attr.dsa_order = 8;
+	rc = rdb_tx_create_root(&tx, &attr);
+	if (rc != 0)
+		D_GOTO(out, rc);
+	id = svc->cs_id;
+	rc = rdb_tx_update(&tx, &svc->cs_root, &ds_cont_prop_svc_id, &value);
+	if (rc != 0)
+		D_GOTO(out, rc);
+	rc = ds_cont_init_metadata(&tx, &svc->cs_root, svc->cs_pool_uuid);
+	if (rc != 0)
+		D_GOTO(out, rc);
+	rc = rdb_tx_commit(&tx);
+out:
+	ABT_rwlock_unlock(svc->cs_lock);
+	rdb_tx_end(&tx);
+	return rc;
+}
+
+static int
+cont_svc_step_up_cb(struct ds_rsvc *rsvc)
+{
+	struct cont_svc	       *svc = &cont_svc_rsvc_obj(rsvc)->csr_svc;
+	d_rank_t		rank;
+	int			rc;
+
+	rc = cont_svc_init_db(svc);
+	if (rc != 0) {
+		D_ERROR(DF_UUID": failed to initialize container service "DF_U64
+			": %d\n", DP_UUID(svc->cs_pool_uuid), svc->cs_id, rc);
+		return rc;
+	}
+
+	/*
+	 * The pool may not be known on this node yet. cs_pool is looked up
+	 * when serving the first request. See cont_svc_lookup_leader.
+	 */
+	D_ASSERT(svc->cs_pool == NULL);
+
+	rc = crt_group_rank(NULL, &rank);
+	D_ASSERTF(rc == 0, "%d\n", rc);
+	D_PRINT(DF_UUID": rank %u became container service "DF_U64" leader "
+		DF_U64"\n", DP_UUID(svc->cs_pool_uuid), rank, svc->cs_id,
+		rsvc->s_term);
+	return 0;
+}
+
+static void
+cont_svc_step_down_cb(struct ds_rsvc *rsvc)
+{
+	struct cont_svc	       *svc = &cont_svc_rsvc_obj(rsvc)->csr_svc;
+	d_rank_t		rank;
+	int			rc;
+
+	ds_cont_svc_step_down(svc);
+
+	rc = crt_group_rank(NULL, &rank);
+	D_ASSERTF(rc == 0, "%d\n", rc);
+	D_PRINT(DF_UUID": rank %u no longer container service "DF_U64" leader "
+		DF_U64"\n", DP_UUID(svc->cs_pool_uuid), rank, svc->cs_id,
+		rsvc->s_term);
+}
+
+static void
+cont_svc_drain_cb(struct ds_rsvc *rsvc)
+{
+}
+
+static struct ds_rsvc_class cont_svc_rsvc_class = {
+	.sc_name	= cont_svc_name_cb,
+	.sc_locate	= cont_svc_locate_cb,
+	.sc_alloc	= cont_svc_alloc_cb,
+	.sc_free	= cont_svc_free_cb,
+	.sc_bootstrap	= NULL,
+	.sc_step_up	= cont_svc_step_up_cb,
+	.sc_step_down	= cont_svc_step_down_cb,
+	.sc_drain	= cont_svc_drain_cb
+};
+
+void
+ds_cont_rsvc_class_register(void)
+{
+	ds_rsvc_class_register(DS_RSVC_CLASS_CONT, &cont_svc_rsvc_class);
+}
+
+void
+ds_cont_rsvc_class_unregister(void)
+{
+	ds_rsvc_class_unregister(DS_RSVC_CLASS_CONT);
+}
+
+/**
+ * Start container service \a id (> 0) of pool \a pool_uuid. If \a create is
+ * false, all remaining input parameters are ignored; otherwise, create the
+ * replica first. See ds_rsvc_start for the return values.
+ *
+ * The leaders of the container services of a pool are preferably placed on
+ * different replicas, the leader of service \a id on the replica whose rank is
+ * the \a id-th, in rank order.
+ */
+int
+ds_cont_svc_start(const uuid_t pool_uuid, uint64_t id, uuid_t db_uuid,
+		  bool create, size_t size, d_rank_list_t *replicas)
+{
+	struct cont_svc_rsvc_id	csi;
+	struct ds_rsvc	       *rsvc;
+	daos_iov_t		iov;
+	int			rc;
+
+	D_ASSERT(id != 0);
+	uuid_copy(csi.csi_pool, pool_uuid);
+	csi.csi_id = id;
+	daos_iov_set(&iov, &csi, sizeof(csi));
+
+	rc = ds_rsvc_start(DS_RSVC_CLASS_CONT, &iov, db_uuid, create, size,
+			   replicas, NULL /* arg */);
+	if (rc != 0)
+		return rc;
+
+	rc = ds_rsvc_lookup(DS_RSVC_CLASS_CONT, &iov, &rsvc);
+	if (rc != 0)
+		return 0;
+	rc = ds_rsvc_prefer_leader(rsvc, id);
+	if (rc != 0)
+		D_WARN("%s: failed to set preferred leader: %d\n",
+		       rsvc->s_name, rc);
+	ds_rsvc_put(rsvc);
+	return 0;
+}
+
+/**
+ * Stop container service \a id (> 0) of pool \a pool_uuid, and if \a destroy
+ * is true, destroy the replica afterward. See ds_rsvc_stop for the return
+ * values.
+ */
+int
+ds_cont_svc_stop(const uuid_t pool_uuid, uint64_t id, bool destroy)
+{
+	struct cont_svc_rsvc_id	csi;
+	daos_iov_t		iov;
+
+	D_ASSERT(id != 0);
+	uuid_copy(csi.csi_pool, pool_uuid);
+	csi.csi_id = id;
+	daos_iov_set(&iov, &csi, sizeof(csi));
+	return ds_rsvc_stop(DS_RSVC_CLASS_CONT, &iov, destroy);
+}
+
 static int
 cont_svc_lookup_leader(uuid_t pool_uuid, uint64_t id, struct cont_svc **svcp,
 		       struct rsvc_hint *hint)
 {
+	struct cont_svc_rsvc_id	csi;
+	struct ds_rsvc	       *rsvc;
 	struct cont_svc	       *p;
+	struct ds_pool	       *pool;
+	daos_iov_t		iov;
 	int			rc;
 
-	D_ASSERTF(id == 0, DF_U64"\n", id);
-	rc = ds_pool_cont_svc_lookup_leader(pool_uuid, &p, hint);
+	if (id == 0) {
+		rc = ds_pool_cont_svc_lookup_leader(pool_uuid, &p, hint);
+		if (rc != 0)
+			return rc;
+		D_ASSERT(p != NULL);
+		*svcp = p;
+		return 0;
+	}
+
+	uuid_copy(csi.csi_pool, pool_uuid);
+	csi.csi_id = id;
+	daos_iov_set(&iov, &csi, sizeof(csi));
+	rc = ds_rsvc_lookup_leader(DS_RSVC_CLASS_CONT, &iov, &rsvc, hint);
 	if (rc != 0)
 		return rc;
-	D_ASSERT(p != NULL);
+	p = &cont_svc_rsvc_obj(rsvc)->csr_svc;
+
+	/*
+	 * Get the pool object, which may be created after this leader stepped
+	 * up, as well as its group for broadcasting to the pool targets.
+	 */
+	if (p->cs_pool == NULL) {
+		pool = ds_pool_lookup(pool_uuid);
+		if (pool == NULL) {
+			D_ERROR(DF_UUID": container service "DF_U64": pool not "
+				"found\n", DP_UUID(pool_uuid), id);
+			D_GOTO(err_rsvc, rc = -DER_NONEXIST);
+		}
+		rc = ds_pool_group_init(pool);
+		if (rc != 0) {
+			ds_pool_put(pool);
+			D_GOTO(err_rsvc, rc);
+		}
+		if (p->cs_pool == NULL)
+			p->cs_pool = pool;
+		else
+			ds_pool_put(pool);
+	}
+
 	*svcp = p;
 	return 0;
+
+err_rsvc:
+	ds_rsvc_put_leader(rsvc);
+	return rc;
 }
 
 static void
@@ -169,6 +519,86 @@ cont_svc_put_leader(struct cont_svc *svc)
 	ds_rsvc_put_leader(svc->cs_rsvc);
 }
 
+/*
+ * Send an RPC created by \a pack to the leader of container service \a id
+ * (> 0), which must have a replica on this node, i.e., this node is a pool
+ * service replica. If successful, the caller is responsible for
+ * crt_req_decref(*rpcp).
+ */
+static int
+cont_svc_forward(uuid_t pool_uuid, uint64_t id, crt_opcode_t opc,
+		 void (*pack)(crt_rpc_t *rpc, void *arg), void *arg,
+		 crt_rpc_t **rpcp)
+{
+	struct dss_module_info *info = dss_get_module_info();
+	struct cont_svc_rsvc_id	csi;
+	struct ds_rsvc	       *rsvc;
+	d_rank_list_t	       *ranks;
+	struct rsvc_client	client;
+	crt_endpoint_t		ep;
+	crt_rpc_t	       *rpc;
+	struct cont_op_out     *out;
+	daos_iov_t		iov;
+	int			tries;
+	int			rc;
+
+	uuid_copy(csi.csi_pool, pool_uuid);
+	csi.csi_id = id;
+	daos_iov_set(&iov, &csi, sizeof(csi));
+	rc = ds_rsvc_lookup(DS_RSVC_CLASS_CONT, &iov, &rsvc);
+	if (rc != 0) {
+		D_ERROR(DF_UUID": container service "DF_U64" not found: %d\n",
+			DP_UUID(pool_uuid), id, rc);
+		return rc;
+	}
+	rc = rdb_get_ranks(rsvc->s_db, &ranks);
+	ds_rsvc_put(rsvc);
+	if (rc != 0)
+		return rc;
+
+	rc = rsvc_client_init(&client, ranks);
+	daos_rank_list_free(ranks);
+	if (rc != 0)
+		return rc;
+
+	/* Give up after a few rounds over the replicas, e.g., no majority. */
+	tries = client.sc_ranks->rl_nr * 3;
+rechoose:
+	ep.ep_grp = NULL;
+	rsvc_client_choose(&client, &ep);
+	rc = cont_req_create(info->dmi_ctx, &ep, opc, &rpc);
+	if (rc != 0) {
+		D_ERROR(DF_UUID": failed to create rpc %u: %d\n",
+			DP_UUID(pool_uuid), opc, rc);
+		D_GOTO(out_client, rc);
+	}
+	pack(rpc, arg);
+
+	rc = dss_rpc_send(rpc);
+	out = crt_reply_get(rpc);
+	rc = rsvc_client_complete_rpc(&client, &ep, rc,
+				      rc == 0 ? out->co_rc : -DER_IO,
+				      rc == 0 ? &out->co_hint : NULL);
+	if (rc == RSVC_CLIENT_RECHOOSE) {
+		crt_req_decref(rpc);
+		if (--tries == 0)
+			D_GOTO(out_client, rc = -DER_TIMEDOUT);
+		dss_sleep(100 /* ms */);
+		D_GOTO(rechoose, rc);
+	}
+	rc = out->co_rc;
+	if (rc != 0) {
+		D_DEBUG(DF_DSMS, DF_UUID": container service "DF_U64": rpc %u: "
+			"%d\n", DP_UUID(pool_uuid), id, opc, rc);
+		crt_req_decref(rpc);
+		D_GOTO(out_client, rc);
+	}
+	*rpcp = rpc;
+out_client:
+	rsvc_client_fini(&client);
+	return rc;
+}
+
 int
 ds_cont_bcast_create(crt_context_t ctx, struct cont_svc *svc,
 		     crt_opcode_t opcode, crt_rpc_t **rpc)
@@ -585,6 +1015,7 @@ cont_destroy(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 	rc = rdb_tx_destroy_kvs(tx, &kvs, &ds_cont_prop_lres);
 	if (rc != 0)
 		D_GOTO(out_kvs, rc);
+	ds_cont_epoch_idx_evict(svc, in->cdi_op.ci_uuid);
 
 	/* Destroy the container attribute KVS. */
 	rc = rdb_tx_destroy_kvs(tx, &svc->cs_conts, &key);
@@ -694,29 +1125,29 @@ cont_put(struct cont *cont)
 }
 
 static int
-cont_open_bcast(crt_context_t ctx, struct cont *cont, const uuid_t pool_hdl,
-		const uuid_t cont_hdl, uint64_t capas)
+cont_open_bcast(crt_context_t ctx, struct cont_svc *svc, const uuid_t cont_uuid,
+		struct cont_tgt_open_rec recs[], int nrecs)
 {
 	struct cont_tgt_open_in	       *in;
 	struct cont_tgt_open_out       *out;
 	crt_rpc_t		       *rpc;
 	int				rc;
 
-	D_DEBUG(DF_DSMS, DF_CONT": bcasting: pool_hdl="DF_UUID" cont_hdl="
-		DF_UUID" capas="DF_X64"\n",
-		DP_CONT(cont->c_svc->cs_pool_uuid, cont->c_uuid),
-		DP_UUID(pool_hdl), DP_UUID(cont_hdl), capas);
+	D_DEBUG(DF_DSMS, DF_CONT": bcasting: recs[0].pool_hdl="DF_UUID
+		" recs[0].hdl="DF_UUID" recs[0].capas="DF_X64" nrecs=%d\n",
+		DP_CONT(svc->cs_pool_uuid, cont_uuid),
+		DP_UUID(recs[0].tor_pool_hdl), DP_UUID(recs[0].tor_hdl),
+		recs[0].tor_capas, nrecs);
 
-	rc = ds_cont_bcast_create(ctx, cont->c_svc, CONT_TGT_OPEN, &rpc);
+	rc = ds_cont_bcast_create(ctx, svc, CONT_TGT_OPEN, &rpc);
 	if (rc != 0)
 		D_GOTO(out, rc);
 
 	in = crt_req_get(rpc);
-	uuid_copy(in->toi_pool_uuid, cont->c_svc->cs_pool_uuid);
-	uuid_copy(in->toi_pool_hdl, pool_hdl);
-	uuid_copy(in->toi_uuid, cont->c_uuid);
-	uuid_copy(in->toi_hdl, cont_hdl);
-	in->toi_capas = capas;
+	uuid_copy(in->toi_pool_uuid, svc->cs_pool_uuid);
+	uuid_copy(in->toi_uuid, cont_uuid);
+	in->toi_recs.ca_arrays = recs;
+	in->toi_recs.ca_count = nrecs;
 
 	rc = dss_rpc_send(rpc);
 	if (rc != 0)
@@ -726,40 +1157,215 @@ cont_open_bcast(crt_context_t ctx, struct cont *cont, const uuid_t pool_hdl,
 	rc = out->too_rc;
 	if (rc != 0) {
 		D_ERROR(DF_CONT": failed to open %d targets\n",
-			DP_CONT(cont->c_svc->cs_pool_uuid, cont->c_uuid), rc);
+			DP_CONT(svc->cs_pool_uuid, cont_uuid), rc);
 		rc = -DER_IO;
 	}
 
 out_rpc:
 	crt_req_decref(rpc);
 out:
-	D_DEBUG(DF_DSMS, DF_CONT": bcasted: pool_hdl="DF_UUID" cont_hdl="DF_UUID
-		" capas="DF_X64": %d\n",
-		DP_CONT(cont->c_svc->cs_pool_uuid, cont->c_uuid),
-		DP_UUID(pool_hdl), DP_UUID(cont_hdl), capas, rc);
+	D_DEBUG(DF_DSMS, DF_CONT": bcasted: recs[0].hdl="DF_UUID" nrecs=%d: "
+		"%d\n", DP_CONT(svc->cs_pool_uuid, cont_uuid),
+		DP_UUID(recs[0].tor_hdl), nrecs, rc);
 	return rc;
 }
 
+/* cont_open_bcast_batch() call queued in cont_svc::cs_opens */
+struct cont_open_req {
+	d_list_t			cor_entry;	/* in cs_opens */
+	uuid_t				cor_cont;
+	struct cont_tgt_open_rec	cor_rec;
+	int				cor_rc;
+	bool				cor_done;	/* bcasted or failed */
+};
+
+/* Maximum number of handles in one CONT_TGT_OPEN, bounds the RPC size */
+#define CONT_OPEN_BCAST_RECS	64
+
+/*
+ * Broadcast the handles of a group of requests, one CONT_TGT_OPEN per
+ * container and up to CONT_OPEN_BCAST_RECS handles. If a broadcast of several
+ * handles fails, they are broadcast again one by one, so that one bad handle
+ * doesn't fail the other requests. The requests are removed from the group as
+ * they are done.
+ */
+static void
+cont_open_bcast_group(crt_context_t ctx, struct cont_svc *svc, d_list_t *group)
+{
+	struct cont_open_req	       *reqs[CONT_OPEN_BCAST_RECS];
+	struct cont_open_req	       *req;
+	struct cont_tgt_open_rec       *recs;
+	uuid_t				cont_uuid;
+	int				nrecs;
+	int				i;
+	int				rc;
+
+	D_ALLOC_ARRAY(recs, CONT_OPEN_BCAST_RECS);
+
+	while (!d_list_empty(group)) {
+		req = d_list_entry(group->next, struct cont_open_req,
+				   cor_entry);
+		uuid_copy(cont_uuid, req->cor_cont);
+
+		nrecs = 0;
+		d_list_for_each_entry(req, group, cor_entry) {
+			if (uuid_compare(req->cor_cont, cont_uuid) != 0)
+				continue;
+			reqs[nrecs++] = req;
+			if (nrecs == CONT_OPEN_BCAST_RECS)
+				break;
+		}
+
+		if (recs == NULL) {
+			rc = -DER_NOMEM;
+		} else {
+			for (i = 0; i < nrecs; i++)
+				recs[i] = reqs[i]->cor_rec;
+			rc = cont_open_bcast(ctx, svc, cont_uuid, recs, nrecs);
+		}
+
+		/* opening a handle again with the same capas is harmless */
+		for (i = 0; i < nrecs; i++) {
+			if (rc == 0 || nrecs == 1 || recs == NULL)
+				reqs[i]->cor_rc = rc;
+			else
+				reqs[i]->cor_rc = cont_open_bcast(ctx, svc,
+							cont_uuid,
+							&reqs[i]->cor_rec, 1);
+		}
+
+		ABT_mutex_lock(svc->cs_open_mutex);
+		for (i = 0; i < nrecs; i++) {
+			d_list_del_init(&reqs[i]->cor_entry);
+			reqs[i]->cor_done = true;
+		}
+		ABT_cond_broadcast(svc->cs_open_cv);
+		ABT_mutex_unlock(svc->cs_open_mutex);
+	}
+
+	if (recs != NULL)
+		D_FREE(recs);
+}
+
+/*
+ * Broadcast a new container handle to all targets. Concurrent callers are
+ * broadcast as a group: the first one yields once to let the others queue
+ * their handles, and then sends the CONT_TGT_OPENs on their behalf (see
+ * cont_open_bcast_group()), while new callers queue up for the next group.
+ * Each caller gets the result of the broadcast carrying its handle.
+ */
 static int
-cont_open(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl, struct cont *cont,
-	  crt_rpc_t *rpc)
+cont_open_bcast_batch(crt_context_t ctx, struct cont *cont,
+		      const uuid_t pool_hdl, const uuid_t cont_hdl,
+		      uint64_t capas)
+{
+	struct cont_svc	       *svc = cont->c_svc;
+	struct cont_open_req	req = {
+		.cor_rec.tor_capas	= capas
+	};
+	d_list_t		group;
+
+	uuid_copy(req.cor_cont, cont->c_uuid);
+	uuid_copy(req.cor_rec.tor_pool_hdl, pool_hdl);
+	uuid_copy(req.cor_rec.tor_hdl, cont_hdl);
+
+	ABT_mutex_lock(svc->cs_open_mutex);
+	d_list_add_tail(&req.cor_entry, &svc->cs_opens);
+	if (svc->cs_opening) {
+		while (!req.cor_done)
+			ABT_cond_wait(svc->cs_open_cv, svc->cs_open_mutex);
+		ABT_mutex_unlock(svc->cs_open_mutex);
+		return req.cor_rc;
+	}
+	svc->cs_opening = true;
+	ABT_mutex_unlock(svc->cs_open_mutex);
+
+	ABT_thread_yield();
+
+	D_INIT_LIST_HEAD(&group);
+	ABT_mutex_lock(svc->cs_open_mutex);
+	while (!d_list_empty(&svc->cs_opens)) {
+		d_list_splice_init(&svc->cs_opens, &group);
+		ABT_mutex_unlock(svc->cs_open_mutex);
+		cont_open_bcast_group(ctx, svc, &group);
+		ABT_mutex_lock(svc->cs_open_mutex);
+	}
+	svc->cs_opening = false;
+	ABT_mutex_unlock(svc->cs_open_mutex);
+
+	D_ASSERT(req.cor_done);
+	return req.cor_rc;
+}
+
+/*
+ * Broadcast the handle of a CONT_OPEN request under the read lock, so that
+ * concurrent opens can share a broadcast (see cont_open_bcast_batch()),
+ * before cont_open() records it under the write lock. Set *bcasted if the
+ * handle has been broadcast. Handles that exist already are left to
+ * cont_open().
+ */
+static int
+cont_open_prepare(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
+		  struct cont_svc *svc, crt_rpc_t *rpc, bool *bcasted)
 {
 	struct cont_open_in    *in = crt_req_get(rpc);
+	struct cont	       *cont;
 	daos_iov_t		key;
 	daos_iov_t		value;
 	struct container_hdl	chdl;
 	int			rc;
 
-	D_DEBUG(DF_DSMS, DF_CONT": processing rpc %p: hdl="DF_UUID" capas="
-		DF_X64"\n",
-		DP_CONT(pool_hdl->sph_pool->sp_uuid, in->coi_op.ci_uuid), rpc,
-		DP_UUID(in->coi_op.ci_hdl), in->coi_capas);
+	*bcasted = false;
 
 	/* Verify the pool handle capabilities. */
 	if ((in->coi_capas & DAOS_COO_RW) &&
 	    !(pool_hdl->sph_capas & DAOS_PC_RW) &&
 	    !(pool_hdl->sph_capas & DAOS_PC_EX))
-		D_GOTO(out, rc = -DER_NO_PERM);
+		return -DER_NO_PERM;
+
+	ABT_rwlock_rdlock(svc->cs_lock);
+
+	rc = cont_lookup(tx, svc, in->coi_op.ci_uuid, &cont);
+	if (rc != 0)
+		D_GOTO(out_lock, rc);
+
+	daos_iov_set(&key, in->coi_op.ci_hdl, sizeof(uuid_t));
+	daos_iov_set(&value, &chdl, sizeof(chdl));
+	rc = rdb_tx_lookup(tx, &svc->cs_hdls, &key, &value);
+	if (rc != -DER_NONEXIST)
+		D_GOTO(out_cont, rc);
+
+	rc = cont_open_bcast_batch(rpc->cr_ctx, cont, in->coi_op.ci_pool_hdl,
+				   in->coi_op.ci_hdl, in->coi_capas);
+	if (rc == 0)
+		*bcasted = true;
+
+out_cont:
+	cont_put(cont);
+out_lock:
+	ABT_rwlock_unlock(svc->cs_lock);
+	return rc;
+}
+
+/*
+ * Record a new container handle. If cont_open_prepare() has not broadcast the
+ * handle, e.g., because the handle was being closed concurrently, broadcast
+ * it here.
+ */
+static int
+cont_open(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl, struct cont *cont,
+	  crt_rpc_t *rpc, bool bcasted)
+{
+	struct cont_open_in    *in = crt_req_get(rpc);
+	daos_iov_t		key;
+	daos_iov_t		value;
+	struct container_hdl	chdl;
+	int			rc;
+
+	D_DEBUG(DF_DSMS, DF_CONT": processing rpc %p: hdl="DF_UUID" capas="
+		DF_X64"\n",
+		DP_CONT(pool_hdl->sph_pool->sp_uuid, in->coi_op.ci_uuid), rpc,
+		DP_UUID(in->coi_op.ci_hdl), in->coi_capas);
 
 	/* See if this container handle already exists. */
 	daos_iov_set(&key, in->coi_op.ci_hdl, sizeof(uuid_t));
@@ -775,10 +1381,13 @@ cont_open(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl, struct cont *cont,
 		D_GOTO(out, rc);
 	}
 
-	rc = cont_open_bcast(rpc->cr_ctx, cont, in->coi_op.ci_pool_hdl,
-			     in->coi_op.ci_hdl, in->coi_capas);
-	if (rc != 0)
-		D_GOTO(out, rc);
+	if (!bcasted) {
+		rc = cont_open_bcast_batch(rpc->cr_ctx, cont,
+					   in->coi_op.ci_pool_hdl,
+					   in->coi_op.ci_hdl, in->coi_capas);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	}
 
 	/* TODO: Rollback cont_open_bcast() on errors from now on. */
 
@@ -909,11 +1518,9 @@ cont_close_hdls(struct cont_svc *svc, struct cont_tgt_close_rec *recs,
 		if (rc != 0)
 			break;
 		rc = cont_close_one_hdl(&tx, svc, ctx, recs[i].tcr_hdl);
-		if (rc != 0) {
-			rdb_tx_end(&tx);
-			break;
-		}
-		rc = rdb_tx_commit(&tx);
+		if (rc == 0)
+			rc = rdb_tx_commit(&tx);
+		ds_cont_epoch_idx_end(svc, rc);
 		rdb_tx_end(&tx);
 		if (rc != 0)
 			break;
@@ -1639,34 +2246,19 @@ find_hdls_to_close(struct rdb_tx *tx, struct cont_svc *svc, uuid_t *pool_hdls,
 	return 0;
 }
 
-/*
- * Close container handles that are associated with "pool_hdls[n_pool_hdls]"
- * and managed by local container services.
- */
-int
-ds_cont_close_by_pool_hdls(uuid_t pool_uuid, uuid_t *pool_hdls, int n_pool_hdls,
-			   crt_context_t ctx)
+static int
+cont_svc_close_by_pool_hdls(struct cont_svc *svc, uuid_t *pool_hdls,
+			    int n_pool_hdls, crt_context_t ctx)
 {
-	struct cont_svc		       *svc;
 	struct rdb_tx			tx;
 	struct cont_tgt_close_rec      *recs;
 	size_t				recs_size;
 	int				nrecs;
 	int				rc;
 
-	D_DEBUG(DF_DSMS, DF_CONT": closing by %d pool hdls: pool_hdls[0]="
-		DF_UUID"\n", DP_CONT(pool_uuid, NULL), n_pool_hdls,
-		DP_UUID(pool_hdls[0]));
-
-	/* TODO: Do the following for all local container services. */
-	rc = cont_svc_lookup_leader(pool_uuid, 0 /* id */, &svc,
-				    NULL /* hint */);
-	if (rc != 0)
-		return rc;
-
 	rc = rdb_tx_begin(svc->cs_rsvc->s_db, svc->cs_rsvc->s_term, &tx);
 	if (rc != 0)
-		D_GOTO(out_svc, rc);
+		return rc;
 
 	ABT_rwlock_wrlock(svc->cs_lock);
 
@@ -1682,8 +2274,82 @@ ds_cont_close_by_pool_hdls(uuid_t pool_uuid, uuid_t *pool_hdls, int n_pool_hdls,
 out_lock:
 	ABT_rwlock_unlock(svc->cs_lock);
 	rdb_tx_end(&tx);
-out_svc:
-	cont_svc_put_leader(svc);
+	return rc;
+}
+
+struct close_fwd_arg {
+	uuid_t		cfa_pool;
+	uint64_t	cfa_svc;
+	uuid_t	       *cfa_pool_hdls;
+	int		cfa_n_pool_hdls;
+};
+
+static void
+close_fwd_pack(crt_rpc_t *rpc, void *varg)
+{
+	struct close_fwd_arg	       *arg = varg;
+	struct cont_svc_close_in       *in = crt_req_get(rpc);
+
+	uuid_copy(in->csci_pool, arg->cfa_pool);
+	in->csci_svc = arg->cfa_svc;
+	in->csci_pool_hdls.ca_arrays = arg->cfa_pool_hdls;
+	in->csci_pool_hdls.ca_count = arg->cfa_n_pool_hdls;
+}
+
+/*
+ * Close container handles that are associated with "pool_hdls[n_pool_hdls]"
+ * in all container services of the pool. Called on the pool service leader.
+ */
+int
+ds_cont_close_by_pool_hdls(uuid_t pool_uuid, uuid_t *pool_hdls, int n_pool_hdls,
+			   crt_context_t ctx)
+{
+	struct close_fwd_arg	arg;
+	struct cont_svc	       *svc;
+	struct ds_pool	       *pool;
+	uint32_t		nr = 1;
+	uint64_t		id;
+	int			rc = 0;
+
+	D_DEBUG(DF_DSMS, DF_CONT": closing by %d pool hdls: pool_hdls[0]="
+		DF_UUID"\n", DP_CONT(pool_uuid, NULL), n_pool_hdls,
+		DP_UUID(pool_hdls[0]));
+
+	pool = ds_pool_lookup(pool_uuid);
+	if (pool != NULL) {
+		nr = max(pool->sp_cont_svc_nr, 1);
+		ds_pool_put(pool);
+	}
+
+	for (id = 0; id < nr; id++) {
+		rc = cont_svc_lookup_leader(pool_uuid, id, &svc,
+					    NULL /* hint */);
+		if (rc == 0) {
+			rc = cont_svc_close_by_pool_hdls(svc, pool_hdls,
+							 n_pool_hdls, ctx);
+			cont_svc_put_leader(svc);
+		} else if (id != 0 &&
+			   (rc == -DER_NOTLEADER || rc == -DER_NONEXIST)) {
+			crt_rpc_t *rpc;
+
+			/* The leader is elsewhere. */
+			uuid_copy(arg.cfa_pool, pool_uuid);
+			arg.cfa_svc = id;
+			arg.cfa_pool_hdls = pool_hdls;
+			arg.cfa_n_pool_hdls = n_pool_hdls;
+			rc = cont_svc_forward(pool_uuid, id, CONT_SVC_CLOSE,
+					      close_fwd_pack, &arg, &rpc);
+			if (rc == 0)
+				crt_req_decref(rpc);
+		}
+		if (rc != 0) {
+			D_ERROR(DF_CONT": failed to close by pool hdls in "
+				"container service "DF_U64": %d\n",
+				DP_CONT(pool_uuid, NULL), id, rc);
+			break;
+		}
+	}
+
 	return rc;
 }
 
@@ -1734,9 +2400,6 @@ cont_op_with_cont(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 	int			rc;
 
 	switch (opc_get(rpc->cr_opc)) {
-	case CONT_OPEN:
-		rc = cont_open(tx, pool_hdl, cont, rpc);
-		break;
 	case CONT_CLOSE:
 		rc = cont_close(tx, pool_hdl, cont, rpc);
 		break;
@@ -1780,12 +2443,19 @@ cont_op_with_svc(struct ds_pool_hdl *pool_hdl, struct cont_svc *svc,
 	struct rdb_tx		tx;
 	crt_opcode_t		opc = opc_get(rpc->cr_opc);
 	struct cont	       *cont = NULL;
+	bool			bcasted = false;
 	int			rc;
 
 	rc = rdb_tx_begin(svc->cs_rsvc->s_db, svc->cs_rsvc->s_term, &tx);
 	if (rc != 0)
 		D_GOTO(out, rc);
 
+	if (opc == CONT_OPEN) {
+		rc = cont_open_prepare(&tx, pool_hdl, svc, rpc, &bcasted);
+		if (rc != 0)
+			D_GOTO(out_tx, rc);
+	}
+
 	/* TODO: Implement per-container locking. */
 	if (opc == CONT_QUERY || opc == CONT_ATTR_GET ||
 	    opc == CONT_ATTR_LIST || opc == CONT_EPOCH_DISCARD
@@ -1805,7 +2475,10 @@ cont_op_with_svc(struct ds_pool_hdl *pool_hdl, struct cont_svc *svc,
 		rc = cont_lookup(&tx, svc, in->ci_uuid, &cont);
 		if (rc != 0)
 			D_GOTO(out_lock, rc);
-		rc = cont_op_with_cont(&tx, pool_hdl, cont, rpc);
+		if (opc == CONT_OPEN)
+			rc = cont_open(&tx, pool_hdl, cont, rpc, bcasted);
+		else
+			rc = cont_op_with_cont(&tx, pool_hdl, cont, rpc);
 		cont_put(cont);
 	}
 	if (rc != 0)
@@ -1813,7 +2486,9 @@ cont_op_with_svc(struct ds_pool_hdl *pool_hdl, struct cont_svc *svc,
 
 	rc = rdb_tx_commit(&tx);
 out_lock:
+	ds_cont_epoch_idx_end(svc, rc);
 	ABT_rwlock_unlock(svc->cs_lock);
+out_tx:
 	rdb_tx_end(&tx);
 out:
 	return rc;
@@ -1829,6 +2504,7 @@ ds_cont_op_handler(crt_rpc_t *rpc)
 	crt_opcode_t		opc = opc_get(rpc->cr_opc);
 	daos_prop_t	       *prop = NULL;
 	struct cont_svc	       *svc;
+	uint64_t		id;
 	int			rc;
 
 	pool_hdl = ds_pool_hdl_lookup(in->ci_pool_hdl);
@@ -1839,13 +2515,9 @@ ds_cont_op_handler(crt_rpc_t *rpc)
 		DP_CONT(pool_hdl->sph_pool->sp_uuid, in->ci_uuid), rpc,
 		DP_UUID(in->ci_hdl), opc);
 
-	/*
-	 * TODO: How to map to the correct container service among those
-	 * running of this storage node? (Currently, there is only one, with ID
-	 * 0, colocated with the pool service.)
-	 */
-	rc = cont_svc_lookup_leader(pool_hdl->sph_pool->sp_uuid, 0 /* id */,
-				    &svc, &out->co_hint);
+	id = cont_svc_id(in->ci_uuid, pool_hdl->sph_pool->sp_cont_svc_nr);
+	rc = cont_svc_lookup_leader(pool_hdl->sph_pool->sp_uuid, id, &svc,
+				    &out->co_hint);
 	if (rc != 0)
 		D_GOTO(out_pool_hdl, rc);
 
@@ -1873,12 +2545,10 @@ out:
 	return;
 }
 
-int
-ds_cont_oid_fetch_add(uuid_t poh_uuid, uuid_t co_uuid, uuid_t coh_uuid,
-		      uint64_t num_oids, uint64_t *oid)
+static int
+cont_svc_oid_fetch_add(struct cont_svc *svc, uuid_t co_uuid, uuid_t coh_uuid,
+		       uint64_t num_oids, uint64_t *oid)
 {
-	struct ds_pool_hdl	*pool_hdl;
-	struct cont_svc		*svc;
 	struct rdb_tx		tx;
 	struct cont		*cont = NULL;
 	daos_iov_t		key;
@@ -1887,22 +2557,9 @@ ds_cont_oid_fetch_add(uuid_t poh_uuid, uuid_t co_uuid, uuid_t coh_uuid,
 	uint64_t		max_oid;
 	int			rc;
 
-	pool_hdl = ds_pool_hdl_lookup(poh_uuid);
-	if (pool_hdl == NULL)
-		D_GOTO(out, rc = -DER_NO_HDL);
-
-	/*
-	 * TODO: How to map to the correct container service among those
-	 * running of this storage node? (Currently, there is only one, with ID
-	 * 0, colocated with the pool service.)
-	 */
-	rc = cont_svc_lookup_leader(pool_hdl->sph_pool->sp_uuid, 0, &svc, NULL);
-	if (rc != 0)
-		D_GOTO(out_pool_hdl, rc);
-
 	rc = rdb_tx_begin(svc->cs_rsvc->s_db, svc->cs_rsvc->s_term, &tx);
 	if (rc != 0)
-		D_GOTO(out_svc, rc);
+		D_GOTO(out, rc);
 
 	ABT_rwlock_wrlock(svc->cs_lock);
 
@@ -1949,10 +2606,141 @@ out_cont:
 out_lock:
 	ABT_rwlock_unlock(svc->cs_lock);
 	rdb_tx_end(&tx);
-out_svc:
-	cont_svc_put_leader(svc);
+out:
+	return rc;
+}
+
+struct oid_fwd_arg {
+	uuid_t		ofa_pool;
+	uuid_t		ofa_pool_hdl;
+	uuid_t		ofa_cont;
+	uuid_t		ofa_cont_hdl;
+	uint64_t	ofa_svc;
+	uint64_t	ofa_num_oids;
+};
+
+static void
+oid_fwd_pack(crt_rpc_t *rpc, void *varg)
+{
+	struct oid_fwd_arg			*arg = varg;
+	struct cont_svc_oid_fetch_add_in	*in = crt_req_get(rpc);
+
+	uuid_copy(in->csoi_pool, arg->ofa_pool);
+	uuid_copy(in->csoi_pool_hdl, arg->ofa_pool_hdl);
+	uuid_copy(in->csoi_cont, arg->ofa_cont);
+	uuid_copy(in->csoi_cont_hdl, arg->ofa_cont_hdl);
+	in->csoi_svc = arg->ofa_svc;
+	in->csoi_num_oids = arg->ofa_num_oids;
+}
+
+int
+ds_cont_oid_fetch_add(uuid_t poh_uuid, uuid_t co_uuid, uuid_t coh_uuid,
+		      uint64_t num_oids, uint64_t *oid)
+{
+	struct ds_pool_hdl			*pool_hdl;
+	struct cont_svc				*svc;
+	struct cont_svc_oid_fetch_add_out	*out;
+	struct oid_fwd_arg			 arg;
+	crt_rpc_t				*rpc;
+	uint64_t				 id;
+	int					 rc;
+
+	pool_hdl = ds_pool_hdl_lookup(poh_uuid);
+	if (pool_hdl == NULL)
+		D_GOTO(out, rc = -DER_NO_HDL);
+
+	id = cont_svc_id(co_uuid, pool_hdl->sph_pool->sp_cont_svc_nr);
+	rc = cont_svc_lookup_leader(pool_hdl->sph_pool->sp_uuid, id, &svc,
+				    NULL /* hint */);
+	if (rc == 0) {
+		rc = cont_svc_oid_fetch_add(svc, co_uuid, coh_uuid, num_oids,
+					    oid);
+		cont_svc_put_leader(svc);
+		D_GOTO(out_pool_hdl, rc);
+	}
+	if (id == 0 || (rc != -DER_NOTLEADER && rc != -DER_NONEXIST))
+		D_GOTO(out_pool_hdl, rc);
+
+	/* The leader is elsewhere. */
+	uuid_copy(arg.ofa_pool, pool_hdl->sph_pool->sp_uuid);
+	uuid_copy(arg.ofa_pool_hdl, poh_uuid);
+	uuid_copy(arg.ofa_cont, co_uuid);
+	uuid_copy(arg.ofa_cont_hdl, coh_uuid);
+	arg.ofa_svc = id;
+	arg.ofa_num_oids = num_oids;
+	rc = cont_svc_forward(pool_hdl->sph_pool->sp_uuid, id,
+			      CONT_SVC_OID_FETCH_ADD, oid_fwd_pack, &arg, &rpc);
+	if (rc != 0)
+		D_GOTO(out_pool_hdl, rc);
+	out = crt_reply_get(rpc);
+	*oid = out->csoo_oid;
+	crt_req_decref(rpc);
+
 out_pool_hdl:
 	ds_pool_hdl_put(pool_hdl);
 out:
 	return rc;
 }
+
+/* Forwarded from the pool service leader by ds_cont_oid_fetch_add(). */
+void
+ds_cont_svc_oid_fetch_add_handler(crt_rpc_t *rpc)
+{
+	struct cont_svc_oid_fetch_add_in	*in = crt_req_get(rpc);
+	struct cont_svc_oid_fetch_add_out	*out = crt_reply_get(rpc);
+	struct cont_svc				*svc;
+	int					 rc;
+
+	D_DEBUG(DF_DSMS, DF_CONT": processing rpc %p: svc="DF_U64"\n",
+		DP_CONT(in->csoi_pool, in->csoi_cont), rpc, in->csoi_svc);
+
+	rc = cont_svc_lookup_leader(in->csoi_pool, in->csoi_svc, &svc,
+				    &out->csoo_op.co_hint);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	rc = cont_svc_oid_fetch_add(svc, in->csoi_cont, in->csoi_cont_hdl,
+				    in->csoi_num_oids, &out->csoo_oid);
+
+	ds_rsvc_set_hint(svc->cs_rsvc, &out->csoo_op.co_hint);
+	cont_svc_put_leader(svc);
+out:
+	D_DEBUG(DF_DSMS, DF_CONT": replying rpc %p: %d\n",
+		DP_CONT(in->csoi_pool, in->csoi_cont), rpc, rc);
+	out->csoo_op.co_rc = rc;
+	crt_reply_send(rpc);
+}
+
+/* Forwarded from the pool service leader by ds_cont_close_by_pool_hdls(). */
+void
+ds_cont_svc_close_handler(crt_rpc_t *rpc)
+{
+	struct cont_svc_close_in	*in = crt_req_get(rpc);
+	struct cont_svc_close_out	*out = crt_reply_get(rpc);
+	struct cont_svc			*svc;
+	int				 rc;
+
+	D_DEBUG(DF_DSMS, DF_CONT": processing rpc %p: svc="DF_U64" hdls=%zu\n",
+		DP_CONT(in->csci_pool, NULL), rpc, in->csci_svc,
+		in->csci_pool_hdls.ca_count);
+
+	if (in->csci_pool_hdls.ca_count == 0)
+		D_GOTO(out, rc = 0);
+
+	rc = cont_svc_lookup_leader(in->csci_pool, in->csci_svc, &svc,
+				    &out->csco_op.co_hint);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	rc = cont_svc_close_by_pool_hdls(svc, in->csci_pool_hdls.ca_arrays,
+					 in->csci_pool_hdls.ca_count,
+					 rpc->cr_ctx);
+
+	ds_rsvc_set_hint(svc->cs_rsvc, &out->csco_op.co_hint);
+	cont_svc_put_leader(svc);
+out:
+	D_DEBUG(DF_DSMS, DF_CONT": replying rpc %p: %d\n",
+		DP_CONT(in->csci_pool, NULL), rpc, rc);
+	out->csco_op.co_rc = rc;
+	crt_reply_send(rpc);
+}
@@ -77,29 +77,320 @@ ec_type2name(enum ec_type type)
 	return NULL;
 }
 
+/*
+ * Epoch index
+ *
+ * A container service caches, for each container it has served in the current
+ * term, the LRE and LHE counters and the snapshots in sorted arrays. The lowest
+ * epochs are then read in O(1), and counters and snapshots are found by binary
+ * search instead of by iterating the KVSs. The KVSs remain authoritative: an
+ * index is loaded from them on first use, updated along with them in the same
+ * TX, and evicted if that TX is not committed (see ds_cont_epoch_idx_end()).
+ * Indices are only used with cont_svc::cs_lock held for writing.
+ */
+
+struct eidx_ent {
+	daos_epoch_t	ee_epoch;
+	uint64_t	ee_count;
+};
+
+/* Epochs in ascending order */
+struct eidx_array {
+	struct eidx_ent	       *ea_ents;
+	int			ea_nr;
+	int			ea_cap;
+};
+
+struct cont_epoch_idx {
+	d_list_t		cei_entry;	/* in cs_epoch_idxs */
+	d_list_t		cei_link;	/* in cs_epoch_idx_list */
+	d_list_t		cei_dirty;	/* in cs_epoch_idx_dirty */
+	uuid_t			cei_uuid;
+	uint64_t		cei_term;	/* term loaded in */
+	struct eidx_array	cei_lres;
+	struct eidx_array	cei_lhes;
+	struct eidx_array	cei_snaps;	/* counts unused */
+};
+
+/* Return the position of the first epoch not lower than \a epoch. */
 static int
-ec_increment(struct rdb_tx *tx, struct cont *cont, enum ec_type type,
-	     uint64_t epoch)
+eidx_array_find(struct eidx_array *a, daos_epoch_t epoch)
 {
-	rdb_path_t     *kvs = ec_type2kvs(cont, type);
-	daos_iov_t	key;
-	daos_iov_t	value;
-	uint64_t	c = 0;
-	uint64_t	c_new;
-	int		rc;
+	int lo = 0;
+	int hi = a->ea_nr;
 
-	daos_iov_set(&key, &epoch, sizeof(epoch));
-	daos_iov_set(&value, &c, sizeof(c));
-	rc = rdb_tx_lookup(tx, kvs, &key, &value);
-	if (rc != 0 && rc != -DER_NONEXIST)
-		D_GOTO(out, rc);
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+
+		if (a->ea_ents[mid].ee_epoch < epoch)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+static inline bool
+eidx_array_has(struct eidx_array *a, int pos, daos_epoch_t epoch)
+{
+	return pos < a->ea_nr && a->ea_ents[pos].ee_epoch == epoch;
+}
+
+static int
+eidx_array_insert(struct eidx_array *a, int pos, daos_epoch_t epoch,
+		  uint64_t count)
+{
+	if (a->ea_nr == a->ea_cap) {
+		struct eidx_ent	*ents;
+		int		 cap = a->ea_cap == 0 ? 16 : a->ea_cap * 2;
+
+		D_REALLOC(ents, a->ea_ents, cap * sizeof(*ents));
+		if (ents == NULL)
+			return -DER_NOMEM;
+		a->ea_ents = ents;
+		a->ea_cap = cap;
+	}
+	memmove(&a->ea_ents[pos + 1], &a->ea_ents[pos],
+		(a->ea_nr - pos) * sizeof(*a->ea_ents));
+	a->ea_ents[pos].ee_epoch = epoch;
+	a->ea_ents[pos].ee_count = count;
+	a->ea_nr++;
+	return 0;
+}
+
+static void
+eidx_array_remove(struct eidx_array *a, int pos)
+{
+	D_ASSERTF(pos < a->ea_nr, "%d < %d\n", pos, a->ea_nr);
+	a->ea_nr--;
+	memmove(&a->ea_ents[pos], &a->ea_ents[pos + 1],
+		(a->ea_nr - pos) * sizeof(*a->ea_ents));
+}
+
+static inline struct cont_epoch_idx *
+cont_epoch_idx_obj(d_list_t *rlink)
+{
+	return container_of(rlink, struct cont_epoch_idx, cei_entry);
+}
+
+static bool
+cont_epoch_idx_key_cmp(struct d_hash_table *htable, d_list_t *rlink,
+		       const void *key, unsigned int ksize)
+{
+	D_ASSERTF(ksize == sizeof(uuid_t), "%u\n", ksize);
+	return uuid_compare(cont_epoch_idx_obj(rlink)->cei_uuid, key) == 0;
+}
+
+static d_hash_table_ops_t cont_epoch_idx_hash_ops = {
+	.hop_key_cmp	= cont_epoch_idx_key_cmp
+};
+
+static void
+cont_epoch_idx_free(struct cont_svc *svc, struct cont_epoch_idx *idx)
+{
+	bool deleted;
+
+	deleted = d_hash_rec_delete_at(&svc->cs_epoch_idxs, &idx->cei_entry);
+	D_ASSERT(deleted);
+	d_list_del(&idx->cei_link);
+	d_list_del(&idx->cei_dirty);
+	D_FREE(idx->cei_lres.ea_ents);
+	D_FREE(idx->cei_lhes.ea_ents);
+	D_FREE(idx->cei_snaps.ea_ents);
+	D_FREE(idx);
+}
+
+static int
+cont_epoch_idx_load_cb(daos_handle_t ih, daos_iov_t *key, daos_iov_t *val,
+		       void *varg)
+{
+	struct eidx_array      *a = varg;
+	daos_epoch_t		epoch;
+	uint64_t		count = 1;
+
+	D_ASSERTF(key->iov_len == sizeof(epoch), DF_U64"\n", key->iov_len);
+	memcpy(&epoch, key->iov_buf, sizeof(epoch));
+	/* Snapshot values are not counters. */
+	if (val->iov_len == sizeof(count))
+		memcpy(&count, val->iov_buf, sizeof(count));
+	/* KVSs are iterated in ascending order. */
+	return eidx_array_insert(a, a->ea_nr, epoch, count);
+}
+
+/*
+ * Look up the index of \a cont, loading it from the KVSs if it has not been
+ * loaded in the current term.
+ */
+static int
+cont_epoch_idx_get(struct rdb_tx *tx, struct cont *cont,
+		   struct cont_epoch_idx **idxp)
+{
+	struct cont_svc	       *svc = cont->c_svc;
+	struct cont_epoch_idx  *idx;
+	d_list_t	       *rlink;
+	int			rc;
+
+	rlink = d_hash_rec_find(&svc->cs_epoch_idxs, cont->c_uuid,
+				sizeof(uuid_t));
+	if (rlink != NULL) {
+		idx = cont_epoch_idx_obj(rlink);
+		if (idx->cei_term == svc->cs_rsvc->s_term)
+			goto out;
+		/* Other leaders may have updated the KVSs since. */
+		cont_epoch_idx_free(svc, idx);
+	}
+
+	D_ALLOC_PTR(idx);
+	if (idx == NULL)
+		return -DER_NOMEM;
+	D_INIT_LIST_HEAD(&idx->cei_link);
+	D_INIT_LIST_HEAD(&idx->cei_dirty);
+	uuid_copy(idx->cei_uuid, cont->c_uuid);
+	idx->cei_term = svc->cs_rsvc->s_term;
+
+	rc = rdb_tx_iterate(tx, &cont->c_lres, false /* !backward */,
+			    cont_epoch_idx_load_cb, &idx->cei_lres);
+	if (rc != 0)
+		D_GOTO(err, rc);
+	rc = rdb_tx_iterate(tx, &cont->c_lhes, false /* !backward */,
+			    cont_epoch_idx_load_cb, &idx->cei_lhes);
+	if (rc != 0)
+		D_GOTO(err, rc);
+	rc = rdb_tx_iterate(tx, &cont->c_snaps, false /* !backward */,
+			    cont_epoch_idx_load_cb, &idx->cei_snaps);
+	if (rc != 0)
+		D_GOTO(err, rc);
+
+	rc = d_hash_rec_insert(&svc->cs_epoch_idxs, idx->cei_uuid,
+			       sizeof(uuid_t), &idx->cei_entry,
+			       true /* exclusive */);
+	D_ASSERTF(rc == 0, "%d\n", rc);
+	d_list_add(&idx->cei_link, &svc->cs_epoch_idx_list);
+	D_DEBUG(DF_DSMS, DF_CONT": loaded epoch index: lres=%d lhes=%d "
+		"snaps=%d\n", DP_CONT(svc->cs_pool_uuid, cont->c_uuid),
+		idx->cei_lres.ea_nr, idx->cei_lhes.ea_nr,
+		idx->cei_snaps.ea_nr);
+out:
+	*idxp = idx;
+	return 0;
+
+err:
+	D_ERROR(DF_CONT": failed to load epoch index: %d\n",
+		DP_CONT(svc->cs_pool_uuid, cont->c_uuid), rc);
+	D_FREE(idx->cei_lres.ea_ents);
+	D_FREE(idx->cei_lhes.ea_ents);
+	D_FREE(idx->cei_snaps.ea_ents);
+	D_FREE(idx);
+	return rc;
+}
+
+/* Call before updating \a idx, so that it is evicted if the TX fails. */
+static void
+cont_epoch_idx_dirty(struct cont_svc *svc, struct cont_epoch_idx *idx)
+{
+	if (d_list_empty(&idx->cei_dirty))
+		d_list_add(&idx->cei_dirty, &svc->cs_epoch_idx_dirty);
+}
+
+int
+ds_cont_epoch_idx_init(struct cont_svc *svc)
+{
+	D_INIT_LIST_HEAD(&svc->cs_epoch_idx_list);
+	D_INIT_LIST_HEAD(&svc->cs_epoch_idx_dirty);
+	return d_hash_table_create_inplace(D_HASH_FT_NOLOCK, 4 /* bits */,
+					   NULL /* priv */,
+					   &cont_epoch_idx_hash_ops,
+					   &svc->cs_epoch_idxs);
+}
+
+void
+ds_cont_epoch_idx_fini(struct cont_svc *svc)
+{
+	struct cont_epoch_idx  *idx;
+	struct cont_epoch_idx  *tmp;
+
+	d_list_for_each_entry_safe(idx, tmp, &svc->cs_epoch_idx_list, cei_link)
+		cont_epoch_idx_free(svc, idx);
+	d_hash_table_destroy_inplace(&svc->cs_epoch_idxs, true /* force */);
+}
+
+/*
+ * End the use of the epoch indices by a TX, which has been committed if \a rc
+ * is 0. The indices updated by a TX that has not been committed are evicted.
+ */
+void
+ds_cont_epoch_idx_end(struct cont_svc *svc, int rc)
+{
+	struct cont_epoch_idx  *idx;
+	struct cont_epoch_idx  *tmp;
+
+	d_list_for_each_entry_safe(idx, tmp, &svc->cs_epoch_idx_dirty,
+				   cei_dirty) {
+		if (rc == 0)
+			d_list_del_init(&idx->cei_dirty);
+		else
+			cont_epoch_idx_free(svc, idx);
+	}
+}
+
+/* Evict the index of container \a cont_uuid, if any. */
+void
+ds_cont_epoch_idx_evict(struct cont_svc *svc, const uuid_t cont_uuid)
+{
+	d_list_t *rlink;
+
+	rlink = d_hash_rec_find(&svc->cs_epoch_idxs, cont_uuid,
+				sizeof(uuid_t));
+	if (rlink != NULL)
+		cont_epoch_idx_free(svc, cont_epoch_idx_obj(rlink));
+}
+
+static struct eidx_array *
+ec_type2array(struct cont_epoch_idx *idx, enum ec_type type)
+{
+	switch (type) {
+	case EC_LRE:
+		return &idx->cei_lres;
+	case EC_LHE:
+		return &idx->cei_lhes;
+	default:
+		D_ASSERT(0);
+	}
+	return NULL;
+}
+
+static int
+ec_increment(struct rdb_tx *tx, struct cont *cont, struct cont_epoch_idx *idx,
+	     enum ec_type type, uint64_t epoch)
+{
+	rdb_path_t	       *kvs = ec_type2kvs(cont, type);
+	struct eidx_array      *a = ec_type2array(idx, type);
+	daos_iov_t		key;
+	daos_iov_t		value;
+	uint64_t		c = 0;
+	uint64_t		c_new;
+	int			pos;
+	int			rc;
+
+	pos = eidx_array_find(a, epoch);
+	if (eidx_array_has(a, pos, epoch))
+		c = a->ea_ents[pos].ee_count;
 
 	c_new = c + 1;
 	if (c_new < c)
 		D_GOTO(out, rc = -DER_OVERFLOW);
 
+	daos_iov_set(&key, &epoch, sizeof(epoch));
 	daos_iov_set(&value, &c_new, sizeof(c_new));
 	rc = rdb_tx_update(tx, kvs, &key, &value);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	cont_epoch_idx_dirty(cont->c_svc, idx);
+	if (c == 0)
+		rc = eidx_array_insert(a, pos, epoch, c_new);
+	else
+		a->ea_ents[pos].ee_count = c_new;
 
 out:
 	if (rc != 0)
@@ -110,32 +401,41 @@ out:
 }
 
 static int
-ec_decrement(struct rdb_tx *tx, struct cont *cont, enum ec_type type,
-	     uint64_t epoch)
+ec_decrement(struct rdb_tx *tx, struct cont *cont, struct cont_epoch_idx *idx,
+	     enum ec_type type, uint64_t epoch)
 {
-	rdb_path_t     *kvs = ec_type2kvs(cont, type);
-	daos_iov_t	key;
-	daos_iov_t	value;
-	uint64_t	c = 0;
-	uint64_t	c_new;
-	int		rc;
+	rdb_path_t	       *kvs = ec_type2kvs(cont, type);
+	struct eidx_array      *a = ec_type2array(idx, type);
+	daos_iov_t		key;
+	daos_iov_t		value;
+	uint64_t		c = 0;
+	uint64_t		c_new;
+	int			pos;
+	int			rc;
 
-	daos_iov_set(&key, &epoch, sizeof(epoch));
-	daos_iov_set(&value, &c, sizeof(c));
-	rc = rdb_tx_lookup(tx, kvs, &key, &value);
-	if (rc != 0 && rc != -DER_NONEXIST)
-		D_GOTO(out, rc);
+	pos = eidx_array_find(a, epoch);
+	if (eidx_array_has(a, pos, epoch))
+		c = a->ea_ents[pos].ee_count;
 
 	c_new = c - 1;
 	if (c_new > c)
 		D_GOTO(out, rc = -DER_OVERFLOW);
 
+	daos_iov_set(&key, &epoch, sizeof(epoch));
 	if (c_new == 0) {
 		rc = rdb_tx_delete(tx, kvs, &key);
 	} else {
 		daos_iov_set(&value, &c_new, sizeof(c_new));
 		rc = rdb_tx_update(tx, kvs, &key, &value);
 	}
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	cont_epoch_idx_dirty(cont->c_svc, idx);
+	if (c_new == 0)
+		eidx_array_remove(a, pos);
+	else
+		a->ea_ents[pos].ee_count = c_new;
 
 out:
 	if (rc != 0)
@@ -167,98 +467,48 @@ ec_find_lowest(struct rdb_tx *tx, struct cont *cont, enum ec_type type,
 	return rc;
 }
 
-struct ec_decrement_iter_cb_arg {
-	daos_epoch_t	eda_decremented;
-	bool		eda_found;
-	daos_epoch_t	eda_lowest;
-};
-
-static int
-ec_decrement_iter_cb(daos_handle_t ih, daos_iov_t *key, daos_iov_t *val,
-		     void *varg)
+/* Return the lowest epoch of \a type in \a idx, or DAOS_EPOCH_MAX if none. */
+static inline daos_epoch_t
+ec_lowest(struct cont_epoch_idx *idx, enum ec_type type)
 {
-	struct ec_decrement_iter_cb_arg	       *arg = varg;
-	uint64_t			       *epoch = key->iov_buf;
-	uint64_t			       *counter = val->iov_buf;
+	struct eidx_array *a = ec_type2array(idx, type);
 
-	D_ASSERTF(key->iov_len == sizeof(epoch), DF_U64"\n", key->iov_len);
-	D_ASSERTF(val->iov_len == sizeof(counter), DF_U64"\n", val->iov_len);
-	/*
-	 * If this epoch will be deleted from the KVS, then use the second
-	 * lowest one.
-	 */
-	if (*epoch == arg->eda_decremented && *counter == 1)
-		return 0;
-	arg->eda_found = true;
-	arg->eda_lowest = *epoch;
-	return 1;
+	return a->ea_nr == 0 ? DAOS_EPOCH_MAX : a->ea_ents[0].ee_epoch;
 }
 
 /*
  * Decrement epoch \a dec, if not NULL, increment epoch \a inc, if not NULL,
  * and then find the lowest epoch, in the \a type KVS. If after the update(s)
  * the KVS will become empty, then \a emptyp returns true; otherwise, \a lowestp
- * returns the lowest epoch. This is a little bit tricky because rdb does not
- * support querying a TX's own uncommitted updates.
+ * returns the lowest epoch. Since rdb does not support querying a TX's own
+ * uncommitted updates, the lowest epoch is read from \a idx, which reflects
+ * them.
  */
 static int
 ec_update_and_find_lowest(struct rdb_tx *tx, struct cont *cont,
-			  enum ec_type type, const daos_epoch_t *dec,
-			  const daos_epoch_t *inc, bool *emptyp,
-			  daos_epoch_t *lowestp)
+			  struct cont_epoch_idx *idx, enum ec_type type,
+			  const daos_epoch_t *dec, const daos_epoch_t *inc,
+			  bool *emptyp, daos_epoch_t *lowestp)
 {
-	rdb_path_t     *kvs = ec_type2kvs(cont, type);
-	daos_epoch_t	lowest;
-	bool		empty = false;
-	int		rc;
+	struct eidx_array      *a = ec_type2array(idx, type);
+	int			rc;
 
-	/* Decrement and set lowest and empty. */
 	if (dec != NULL) {
-		struct ec_decrement_iter_cb_arg arg;
-
-		rc = ec_decrement(tx, cont, type, *dec);
+		rc = ec_decrement(tx, cont, idx, type, *dec);
 		if (rc != 0)
 			return rc;
-
-		arg.eda_decremented = *dec;
-		arg.eda_found = false;
-		arg.eda_lowest = 0;
-		rc = rdb_tx_iterate(tx, kvs, false /* !backward */,
-				    ec_decrement_iter_cb, &arg);
-		if (rc != 0) {
-			D_ERROR(DF_CONT": failed to iterate %s KVS: %d\n",
-				DP_CONT(cont->c_svc->cs_pool_uuid,
-					cont->c_uuid),
-				ec_type2name(type), rc);
-			return rc;
-		}
-		if (arg.eda_found)
-			lowest = arg.eda_lowest;
-		else
-			empty = true;
-	} else {
-		rc = ec_find_lowest(tx, cont, type, &lowest);
-		if (rc == -DER_NONEXIST)
-			empty = true;
-		else if (rc != 0)
-			return rc;
 	}
 
-	/* Increment and set lowest and empty. */
 	if (inc != NULL) {
-		rc = ec_increment(tx, cont, type, *inc);
+		rc = ec_increment(tx, cont, idx, type, *inc);
 		if (rc != 0)
 			return rc;
-
-		if (empty || lowest > *inc)
-			lowest = *inc;
-		empty = false;
 	}
 
 	if (emptyp != NULL)
-		*emptyp = empty;
-	if (lowestp != NULL && !empty)
-		*lowestp = lowest;
+		*emptyp = (a->ea_nr == 0);
+	if (lowestp != NULL && a->ea_nr > 0)
+		*lowestp = a->ea_ents[0].ee_epoch;
 	return 0;
 }
 
@@ -316,9 +566,10 @@ out:
 	return rc;
 }
 
+/* Read the global epoch state, using \a idx for GLRE and GLHE if not NULL. */
 static int
 read_epoch_prop(struct rdb_tx *tx, struct cont *cont,
-			struct epoch_prop *prop)
+		struct cont_epoch_idx *idx, struct epoch_prop *prop)
 {
 	daos_iov_t	value;
 	daos_epoch_t	ghce;
@@ -345,6 +596,12 @@ read_epoch_prop(struct rdb_tx *tx, struct cont *cont,
 		return rc;
 	}
 
+	if (idx != NULL) {
+		glre = ec_lowest(idx, EC_LRE);
+		glhe = ec_lowest(idx, EC_LHE);
+		goto out;
+	}
+
 	/* GLRE */
 	rc = ec_find_lowest(tx, cont, EC_LRE, &glre);
 	if (rc == -DER_NONEXIST)
@@ -359,6 +616,7 @@ read_epoch_prop(struct rdb_tx *tx, struct cont *cont,
 	else if (rc != 0)
 		return rc;
 
+out:
 	prop->ep_ghce = ghce;
 	prop->ep_ghpce = ghpce;
 	prop->ep_glre = glre;
@@ -444,12 +702,12 @@ read_snap_list(struct rdb_tx *tx, struct cont *cont,
 }
 
 static int
-trigger_aggregation(struct rdb_tx *tx,
+trigger_aggregation(struct cont_epoch_idx *idx,
 		    daos_epoch_t glre, daos_epoch_t glre_curr,
 		    daos_epoch_t ghce, struct cont *cont, crt_context_t ctx)
 {
-	daos_epoch_t		*snapshots;
-	int			 snap_count;
+	struct eidx_ent		*snapshots = idx->cei_snaps.ea_ents;
+	int			 snap_count = idx->cei_snaps.ea_nr;
 	daos_epoch_range_t	 target_range;
 	daos_epoch_range_t	*ranges;
 	int			 range_count;
@@ -467,19 +725,13 @@ trigger_aggregation(struct rdb_tx *tx,
 			 target_range.epr_lo, target_range.epr_hi);
 
 	/* Aggregate between all snapshots less than GLRE */
-	snap_count = -1; /* No upper limit */
-	rc = read_snap_list(tx, cont, &snapshots, &snap_count);
-	if (rc != 0)
-		goto out;
 	/* Start from highest snapshot less than old GLRE */
-	for (i = 0; i < snap_count &&
-	     snapshots[i] < target_range.epr_lo; ++i)
-		;
+	i = eidx_array_find(&idx->cei_snaps, target_range.epr_lo);
 	start = i - 1;
 
 	/* range_count will be at least `1` and at most `snap_count + 1` */
 	for (range_count = 1; i < snap_count &&
-	     snapshots[i] < target_range.epr_hi; ++range_count, ++i)
+	     snapshots[i].ee_epoch < target_range.epr_hi; ++range_count, ++i)
 	     ;
 
 	D_DEBUG(DF_DSMS, DF_CONT": snap_count=%d range_count=%d start=%d\n",
@@ -489,20 +741,18 @@ trigger_aggregation(struct rdb_tx *tx,
 	D_ALLOC_ARRAY(ranges, range_count);
 	if (ranges == NULL) {
 		rc = -DER_NOMEM;
-		goto out_snap;
+		goto out;
 	}
 
 	/* If start == -1, old GLRE is less than lowest snapshot */
-	ranges[0].epr_lo = start < 0 ? 0UL : snapshots[start];
+	ranges[0].epr_lo = start < 0 ? 0UL : snapshots[start].ee_epoch;
 	for (i = 1; i < range_count; ++i) {
-		ranges[i - 1].epr_hi = snapshots[start + i];
-		ranges[i].epr_lo = snapshots[start + i] + 1;
+		ranges[i - 1].epr_hi = snapshots[start + i].ee_epoch;
+		ranges[i].epr_lo = snapshots[start + i].ee_epoch + 1;
 	}
 	ranges[range_count - 1].epr_hi = target_range.epr_hi;
 	rc = epoch_aggregate_bcast(ctx, cont, ranges, range_count);
 	D_FREE(ranges);
-out_snap:
-	D_FREE(snapshots);
 out:
 	return rc;
 }
@@ -615,10 +865,15 @@ int
 ds_cont_epoch_init_hdl(struct rdb_tx *tx, struct cont *cont, uuid_t c_hdl,
 		       struct container_hdl *hdl)
 {
+	struct cont_epoch_idx  *idx;
 	struct epoch_prop	prop;
 	int			rc;
 
-	rc = read_epoch_prop(tx, cont, &prop);
+	rc = cont_epoch_idx_get(tx, cont, &idx);
+	if (rc != 0)
+		return rc;
+
+	rc = read_epoch_prop(tx, cont, idx, &prop);
 	if (rc != 0)
 		return rc;
 
@@ -630,7 +885,7 @@ ds_cont_epoch_init_hdl(struct rdb_tx *tx, struct cont *cont, uuid_t c_hdl,
 	hdl->ch_lhe = DAOS_EPOCH_MAX;
 
 	/* Determine the new GLRE and update the LRE KVS. */
-	rc = ec_update_and_find_lowest(tx, cont, EC_LRE, NULL /* dec */,
+	rc = ec_update_and_find_lowest(tx, cont, idx, EC_LRE, NULL /* dec */,
 				       &hdl->ch_lre /* inc */,
 				       NULL /* emptyp */, &prop.ep_glre);
 	if (rc != 0)
@@ -655,7 +910,7 @@ ds_cont_epoch_init_hdl(struct rdb_tx *tx, struct cont *cont, uuid_t c_hdl,
 	}
 
 	/* Determine the new GLHE and update the LHE KVS. */
-	rc = ec_update_and_find_lowest(tx, cont, EC_LHE, NULL /* dec */,
+	rc = ec_update_and_find_lowest(tx, cont, idx, EC_LHE, NULL /* dec */,
 				       &hdl->ch_lhe /* inc */,
 				       NULL /* emptyp */, &prop.ep_glhe);
 	if (rc != 0)
@@ -671,13 +926,18 @@ int
 ds_cont_epoch_fini_hdl(struct rdb_tx *tx, struct cont *cont,
 		       crt_context_t ctx, struct container_hdl *hdl)
 {
+	struct cont_epoch_idx  *idx;
 	struct epoch_prop	prop;
 	daos_epoch_t		glre;
 	bool			empty;
 	bool			slip_flag;
 	int			rc;
 
-	rc = read_epoch_prop(tx, cont, &prop);
+	rc = cont_epoch_idx_get(tx, cont, &idx);
+	if (rc != 0)
+		return rc;
+
+	rc = read_epoch_prop(tx, cont, idx, &prop);
 	if (rc != 0)
 		return rc;
 
@@ -688,16 +948,18 @@ ds_cont_epoch_fini_hdl(struct rdb_tx *tx, struct cont *cont,
 		return -DER_IO;
 
 	/* Determine the new GLRE and update the LRE KVS. */
-	rc = ec_update_and_find_lowest(tx, cont, EC_LRE, &hdl->ch_lre /* dec */,
-				       NULL /* inc */, &empty, &prop.ep_glre);
+	rc = ec_update_and_find_lowest(tx, cont, idx, EC_LRE,
+				       &hdl->ch_lre /* dec */, NULL /* inc */,
+				       &empty, &prop.ep_glre);
 	if (rc != 0)
 		return rc;
 	if (empty)
 		prop.ep_glre = DAOS_EPOCH_MAX;
 
 	/* Determine the new GLHE and update the LHE KVS. */
-	rc = ec_update_and_find_lowest(tx, cont, EC_LHE, &hdl->ch_lhe /* dec */,
-				       NULL /* inc */, &empty, &prop.ep_glhe);
+	rc = ec_update_and_find_lowest(tx, cont, idx, EC_LHE,
+				       &hdl->ch_lhe /* dec */, NULL /* inc */,
+				       &empty, &prop.ep_glhe);
 	if (rc != 0)
 		return rc;
 	if (empty)
@@ -712,7 +974,7 @@ ds_cont_epoch_fini_hdl(struct rdb_tx *tx, struct cont *cont,
 
 	/** once we have an aggregation daemon, mask this error message */
 	if (slip_flag)
-		rc = trigger_aggregation(tx, glre, prop.ep_glre, prop.ep_ghce,
+		rc = trigger_aggregation(idx, glre, prop.ep_glre, prop.ep_ghce,
 					 cont, ctx);
 
 	return rc;
@@ -723,6 +985,7 @@ ds_cont_epoch_hold(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 		   struct cont *cont, struct container_hdl *hdl, crt_rpc_t *rpc)
 {
 	struct cont_epoch_op_in	       *in = crt_req_get(rpc);
+	struct cont_epoch_idx	       *idx;
 	struct epoch_prop		prop;
 	daos_epoch_t			lhe = hdl->ch_lhe;
 	daos_iov_t			key;
@@ -740,7 +1003,11 @@ ds_cont_epoch_hold(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 	if (in->cei_epoch > DAOS_EPOCH_MAX)
 		D_GOTO(out, rc = -DER_OVERFLOW);
 
-	rc = read_epoch_prop(tx, cont, &prop);
+	rc = cont_epoch_idx_get(tx, cont, &idx);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	rc = read_epoch_prop(tx, cont, idx, &prop);
 	if (rc != 0)
 		D_GOTO(out, rc);
 
@@ -771,7 +1038,7 @@ ds_cont_epoch_hold(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 	if (rc != 0)
 		D_GOTO(out_hdl, rc);
 
-	rc = ec_update_and_find_lowest(tx, cont, EC_LHE, &lhe /* dec */,
+	rc = ec_update_and_find_lowest(tx, cont, idx, EC_LHE, &lhe /* dec */,
 				       &hdl->ch_lhe /* inc */,
 				       NULL /* emptyp */, &prop.ep_glhe);
 	if (rc != 0)
@@ -802,6 +1069,7 @@ ds_cont_epoch_slip(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 		   struct cont *cont, struct container_hdl *hdl, crt_rpc_t *rpc)
 {
 	struct cont_epoch_op_in	       *in = crt_req_get(rpc);
+	struct cont_epoch_idx	       *idx;
 	struct epoch_prop		prop;
 	daos_epoch_t			lre = hdl->ch_lre;
 	daos_epoch_t			glre;
@@ -816,7 +1084,11 @@ ds_cont_epoch_slip(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 	if (in->cei_epoch >= DAOS_EPOCH_MAX)
 		D_GOTO(out, rc = -DER_OVERFLOW);
 
-	rc = read_epoch_prop(tx, cont, &prop);
+	rc = cont_epoch_idx_get(tx, cont, &idx);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	rc = read_epoch_prop(tx, cont, idx, &prop);
 	if (rc != 0)
 		D_GOTO(out, rc);
 	glre = prop.ep_glre;
@@ -845,7 +1117,7 @@ ds_cont_epoch_slip(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 	if (rc != 0)
 		D_GOTO(out_hdl, rc);
 
-	rc = ec_update_and_find_lowest(tx, cont, EC_LRE, &lre /* dec */,
+	rc = ec_update_and_find_lowest(tx, cont, idx, EC_LRE, &lre /* dec */,
 				       &hdl->ch_lre /* inc */,
 				       NULL /* emptyp */, &prop.ep_glre);
 	if (rc != 0)
@@ -859,7 +1131,7 @@ ds_cont_epoch_slip(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 	 * we need to mask the return value, we need not
 	 * fail if aggregation bcast fails
 	 */
-	rc = trigger_aggregation(tx, glre, prop.ep_glre, prop.ep_ghce,
+	rc = trigger_aggregation(idx, glre, prop.ep_glre, prop.ep_ghce,
 				 cont, rpc->cr_ctx);
 out_hdl:
 	if (rc != 0)
@@ -938,7 +1210,7 @@ ds_cont_epoch_discard(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 		/* Discarding an unheld epoch is not allowed. */
 		D_GOTO(out, rc = -DER_EP_RO);
 
-	rc = read_epoch_prop(tx, cont, &prop);
+	rc = read_epoch_prop(tx, cont, NULL /* idx */, &prop);
 	if (rc != 0)
 		D_GOTO(out, rc);
 
@@ -961,6 +1233,7 @@ ds_cont_epoch_commit(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 		     crt_rpc_t *rpc, bool snapshot)
 {
 	struct cont_epoch_op_in	       *in = crt_req_get(rpc);
+	struct cont_epoch_idx	       *idx;
 	struct epoch_prop		prop;
 	daos_epoch_t			hce = hdl->ch_hce;
 	daos_epoch_t			lhe = hdl->ch_lhe;
@@ -988,7 +1261,11 @@ ds_cont_epoch_commit(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 	if (in->cei_epoch >= DAOS_EPOCH_MAX)
 		D_GOTO(out, rc = -DER_OVERFLOW);
 
-	rc = read_epoch_prop(tx, cont, &prop);
+	rc = cont_epoch_idx_get(tx, cont, &idx);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	rc = read_epoch_prop(tx, cont, idx, &prop);
 	if (rc != 0)
 		D_GOTO(out, rc);
 
@@ -1016,14 +1293,15 @@ ds_cont_epoch_commit(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 	if (rc != 0)
 		D_GOTO(out_hdl, rc);
 
-	rc = ec_update_and_find_lowest(tx, cont, EC_LHE, &lhe /* dec */,
+	rc = ec_update_and_find_lowest(tx, cont, idx, EC_LHE, &lhe /* dec */,
 				       &hdl->ch_lhe /* inc */,
 				       NULL /* emptyp */, &prop.ep_glhe);
 	if (rc != 0)
 		D_GOTO(out_hdl, rc);
 
 	if (!(hdl->ch_capas & DAOS_COO_NOSLIP)) {
-		rc = ec_update_and_find_lowest(tx, cont, EC_LRE, &lre /* dec */,
+		rc = ec_update_and_find_lowest(tx, cont, idx, EC_LRE,
+					       &lre /* dec */,
 					       &hdl->ch_lre /* inc */,
 					       NULL /* emptyp */,
 					       &prop.ep_glre);
@@ -1052,7 +1330,9 @@ ds_cont_epoch_commit(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 		D_GOTO(out_hdl, rc = -DER_IO);
 
 	if (snapshot) {
-		char		zero = 0;
+		struct eidx_array      *snaps = &idx->cei_snaps;
+		char			zero = 0;
+		int			pos;
 
 		daos_iov_set(&key, &in->cei_epoch, sizeof(in->cei_epoch));
 		daos_iov_set(&value, &zero, sizeof(zero));
@@ -1063,10 +1343,18 @@ ds_cont_epoch_commit(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 					cont->c_uuid), rc);
 			goto out;
 		}
+
+		pos = eidx_array_find(snaps, in->cei_epoch);
+		if (!eidx_array_has(snaps, pos, in->cei_epoch)) {
+			cont_epoch_idx_dirty(cont->c_svc, idx);
+			rc = eidx_array_insert(snaps, pos, in->cei_epoch, 1);
+			if (rc != 0)
+				goto out;
+		}
 	}
 
 	if (slip_flag) {
-		rc = trigger_aggregation(tx, glre, prop.ep_glre, prop.ep_ghce,
+		rc = trigger_aggregation(idx, glre, prop.ep_glre, prop.ep_ghce,
 					 cont, rpc->cr_ctx);
 		if (rc != 0) {
 			D_ERROR("Trigger aggregation from commit failed %d\n",
@@ -1088,56 +1376,44 @@ out:
 	return rc;
 }
 
-struct snap_destroy_iter_args {
-	daos_epoch_t		sda_find;
-	daos_epoch_t		sda_prev;
-	daos_epoch_range_t	sda_range;
-};
-
-static int
-snap_destroy_iter_cb(daos_handle_t ih, daos_iov_t *key, daos_iov_t *val,
-		     void *arg)
-{
-	struct snap_destroy_iter_args *i_args = arg;
-	daos_epoch_t *curr = key->iov_buf;
-
-	D_ASSERTF(key->iov_len == sizeof(daos_epoch_t),
-		  DF_U64"\n", key->iov_len);
-	if (*curr == i_args->sda_find)
-		i_args->sda_range.epr_lo = i_args->sda_prev;
-	else if (i_args->sda_find == i_args->sda_prev) {
-		if (i_args->sda_range.epr_hi > *curr)
-			i_args->sda_range.epr_hi = *curr;
-		return 1;
-	}
-	i_args->sda_prev = *curr;
-	return 0;
-}
-
 int
 ds_cont_snap_destroy(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 		    struct cont *cont, struct container_hdl *hdl,
 		    crt_rpc_t *rpc)
 {
 	struct cont_epoch_op_in		*in = crt_req_get(rpc);
-	struct snap_destroy_iter_args	 iter_args;
+	struct cont_epoch_idx		*idx;
+	struct eidx_array		*snaps;
+	daos_epoch_range_t		 range;
 	daos_iov_t			 key;
 	struct epoch_prop		 prop;
 	bool				 slip_flag;
+	int				 pos;
 	int				 rc;
 
 	D_DEBUG(DF_DSMS, DF_CONT": processing rpc %p: epoch="DF_U64"\n",
 		DP_CONT(pool_hdl->sph_pool->sp_uuid, in->cei_op.ci_uuid),
 		rpc, in->cei_epoch);
 
+	rc = cont_epoch_idx_get(tx, cont, &idx);
+	if (rc != 0)
+		goto out;
+
+	/* Destroying a nonexistent snapshot is a no-op. */
+	snaps = &idx->cei_snaps;
+	pos = eidx_array_find(snaps, in->cei_epoch);
+	if (!eidx_array_has(snaps, pos, in->cei_epoch))
+		goto out;
+
 	daos_iov_set(&key, &in->cei_epoch, sizeof(daos_epoch_t));
 	rc = rdb_tx_delete(tx, &cont->c_snaps, &key);
-	if (rc != 0) {
-		rc = 0;
+	if (rc != 0)
 		goto out;
-	}
+	cont_epoch_idx_dirty(cont->c_svc, idx);
+	eidx_array_remove(snaps, pos);
+
 	slip_flag = auto_slip_enabled();
-	rc = read_epoch_prop(tx, cont, &prop);
+	rc = read_epoch_prop(tx, cont, idx, &prop);
 	if (rc != 0)
 		goto out;
 	if (check_global_epoch_invariant(cont, &prop) != 0)
@@ -1148,19 +1424,15 @@ ds_cont_snap_destroy(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl,
 	if (!slip_flag || prop.ep_glre <= in->cei_epoch)
 		goto out;
 
-	iter_args.sda_find = in->cei_epoch;
-	iter_args.sda_prev = 0UL;
-	iter_args.sda_range.epr_lo = 0UL;
-	iter_args.sda_range.epr_hi = MIN(prop.ep_glre, prop.ep_ghce);
-	rc = rdb_tx_iterate(tx, &cont->c_snaps, false /* !backward */,
-			    snap_destroy_iter_cb, &iter_args);
-	if (rc != 0)
-		goto out;
+	/* Aggregate from the previous snapshot to the next one. */
+	range.epr_lo = pos > 0 ? snaps->ea_ents[pos - 1].ee_epoch : 0UL;
+	range.epr_hi = MIN(prop.ep_glre, prop.ep_ghce);
+	if (pos < snaps->ea_nr && snaps->ea_ents[pos].ee_epoch < range.epr_hi)
+		range.epr_hi = snaps->ea_ents[pos].ee_epoch;
 
 	D_DEBUG(DF_DSMS, "deleted="DF_U64" prev="DF_U64" next="DF_U64"\n",
-		in->cei_epoch, iter_args.sda_range.epr_lo,
-		iter_args.sda_range.epr_hi);
-	rc = epoch_aggregate_bcast(rpc->cr_ctx, cont, &iter_args.sda_range, 1);
+		in->cei_epoch, range.epr_lo, range.epr_hi);
+	rc = epoch_aggregate_bcast(rpc->cr_ctx, cont, &range, 1);
 out:
 	return rc;
 }
@@ -61,7 +61,9 @@ dsm_tls_get()
 /*
  * Container service
  *
- * Identified by a number unique within the pool.
+ * Identified by a number unique within the pool. Service 0 is colocated with
+ * the pool service; services 1 to nr - 1, if any, have their own DBs on the
+ * pool service replicas. See cont_svc_id().
  */
 struct cont_svc {
 	uuid_t			cs_pool_uuid;
@@ -72,6 +74,13 @@ struct cont_svc {
 	rdb_path_t		cs_conts;	/* container KVS */
 	rdb_path_t		cs_hdls;	/* container handle KVS */
 	struct ds_pool	       *cs_pool;
+	ABT_mutex		cs_open_mutex;
+	ABT_cond		cs_open_cv;	/* for cs_opens updates */
+	d_list_t		cs_opens;	/* cont_open_req queue */
+	bool			cs_opening;	/* cs_opens being bcasted */
+	struct d_hash_table	cs_epoch_idxs;	/* cont_epoch_idx hash */
+	d_list_t		cs_epoch_idx_list;  /* all cont_epoch_idxs */
+	d_list_t		cs_epoch_idx_dirty; /* updated by current TX */
 };
 
 /* Container descriptor */
@@ -98,7 +107,11 @@ struct oid_iv_range {
 /*
  * srv_container.c
  */
+void ds_cont_rsvc_class_register(void);
+void ds_cont_rsvc_class_unregister(void);
 void ds_cont_op_handler(crt_rpc_t *rpc);
+void ds_cont_svc_oid_fetch_add_handler(crt_rpc_t *rpc);
+void ds_cont_svc_close_handler(crt_rpc_t *rpc);
 int ds_cont_bcast_create(crt_context_t ctx, struct cont_svc *svc,
 			 crt_opcode_t opcode, crt_rpc_t **rpc);
 int ds_cont_oid_fetch_add(uuid_t poh_uuid, uuid_t co_uuid, uuid_t coh_uuid,
@@ -106,6 +119,10 @@ int ds_cont_oid_fetch_add(uuid_t poh_uuid, uuid_t co_uuid, uuid_t coh_uuid,
 /*
  * srv_epoch.c
  */
+int ds_cont_epoch_idx_init(struct cont_svc *svc);
+void ds_cont_epoch_idx_fini(struct cont_svc *svc);
+void ds_cont_epoch_idx_end(struct cont_svc *svc, int rc);
+void ds_cont_epoch_idx_evict(struct cont_svc *svc, const uuid_t cont_uuid);
 int ds_cont_epoch_init_hdl(struct rdb_tx *tx, struct cont *cont,
 			   uuid_t c_hdl, struct container_hdl *hdl);
 int ds_cont_epoch_fini_hdl(struct rdb_tx *tx, struct cont *cont,
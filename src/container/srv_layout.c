@@ -31,6 +31,7 @@
 /* Root KVS */
 RDB_STRING_KEY(ds_cont_prop_, conts);
 RDB_STRING_KEY(ds_cont_prop_, cont_handles);
+RDB_STRING_KEY(ds_cont_prop_, svc_id);
 
 /* Container properties KVS */
 RDB_STRING_KEY(ds_cont_prop_, ghce);
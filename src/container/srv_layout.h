@@ -39,6 +39,9 @@
  *         User Attributes KVS (GENERIC)
  *       ... (more container properties KVSs)
  *     Container handle KVS (GENERIC)
+ *
+ * A container service with its own database, i.e., with a nonzero ID, has the
+ * same layout, plus ds_cont_prop_svc_id in the root KVS.
  */
 
 #ifndef __CONTAINER_SRV_LAYOUT_H__
@@ -49,6 +52,7 @@
 /* Root KVS (RDB_KVS_GENERIC) */
 extern daos_iov_t ds_cont_prop_conts;		/* container KVS */
 extern daos_iov_t ds_cont_prop_cont_handles;	/* container handle KVS */
+extern daos_iov_t ds_cont_prop_svc_id;		/* uint64_t (own DB) */
 
 /*
  * Container KVS (RDB_KVS_GENERIC)
@@ -42,6 +42,7 @@
 
 #include <daos/rpc.h>
 #include <daos_srv/pool.h>
+#include <daos_srv/rebuild.h>
 #include <daos_srv/vos.h>
 #include "rpc.h"
 #include "srv_internal.h"
@@ -435,6 +436,13 @@ ds_cont_lookup_or_create(struct ds_cont_hdl *hdl, uuid_t cont_uuid)
 		return rc;
 	}
 
+	/* the container is empty, so its rebuild index is complete */
+	rc = ds_rebuild_obj_index_init(hdl->sch_cont->sc_hdl);
+	if (rc != 0)
+		D_WARN(DF_CONT": failed to init rebuild index, rebuild will "
+		       "scan all objects: %d\n",
+		       DP_CONT(hdl->sch_pool->spc_uuid, cont_uuid), rc);
+
 	return 1;
 }
 
@@ -544,16 +552,28 @@ err:
 }
 
 /*
- * Called via dss_collective() to establish the ds_cont_hdl object as well as
+ * Called via dss_collective() to establish the ds_cont_hdl objects as well as
  * the ds_cont object.
  */
 static int
 cont_open_one(void *vin)
 {
 	struct cont_tgt_open_in	       *in = vin;
+	struct cont_tgt_open_rec       *recs = in->toi_recs.ca_arrays;
+	int				i;
+	int				rc = 0;
 
-	return ds_cont_local_open(in->toi_pool_uuid, in->toi_hdl,
-				  in->toi_uuid, in->toi_capas, NULL);
+	for (i = 0; i < in->toi_recs.ca_count; i++) {
+		int rc_tmp;
+
+		rc_tmp = ds_cont_local_open(in->toi_pool_uuid, recs[i].tor_hdl,
+					    in->toi_uuid, recs[i].tor_capas,
+					    NULL);
+		if (rc_tmp != 0 && rc == 0)
+			rc = rc_tmp;
+	}
+
+	return rc;
 }
 
 void
@@ -561,15 +581,23 @@ ds_cont_tgt_open_handler(crt_rpc_t *rpc)
 {
 	struct cont_tgt_open_in	       *in = crt_req_get(rpc);
 	struct cont_tgt_open_out       *out = crt_reply_get(rpc);
+	struct cont_tgt_open_rec       *recs = in->toi_recs.ca_arrays;
 	int				rc;
 
-	D_DEBUG(DF_DSMS, DF_CONT": handling rpc %p: hdl="DF_UUID"\n",
-		DP_CONT(in->toi_pool_uuid, in->toi_uuid), rpc,
-		DP_UUID(in->toi_hdl));
+	if (in->toi_recs.ca_count == 0)
+		D_GOTO(out, rc = 0);
+
+	if (in->toi_recs.ca_arrays == NULL)
+		D_GOTO(out, rc = -DER_INVAL);
+
+	D_DEBUG(DF_DSMS, DF_CONT": handling rpc %p: recs[0].hdl="DF_UUID
+		" nrecs="DF_U64"\n", DP_CONT(in->toi_pool_uuid, in->toi_uuid),
+		rpc, DP_UUID(recs[0].tor_hdl), in->toi_recs.ca_count);
 
 	rc = dss_task_collective(cont_open_one, in, 0);
 	D_ASSERTF(rc == 0, "%d\n", rc);
 
+out:
 	out->too_rc = (rc == 0 ? 0 : 1);
 	D_DEBUG(DF_DSMS, DF_UUID": replying rpc %p: %d (%d)\n",
 		DP_UUID(in->toi_uuid), rpc, out->too_rc, rc);
@@ -833,6 +861,8 @@ cont_epoch_discard_one(void *vin)
 	rc = vos_discard(hdl->sch_cont->sc_hdl, &epr);
 	if (rc > 0)	/* Aborted */
 		rc = -DER_CANCELED;
+	else if (rc == 0)
+		ds_rebuild_obj_index_discard(hdl->sch_cont->sc_hdl, &epr);
 
 	D_DEBUG(DB_EPC, DF_CONT": Discard epoch "DF_U64", hdl="DF_UUID": %d\n",
 		DP_CONT(hdl->sch_pool->spc_uuid, hdl->sch_cont->sc_uuid),
@@ -1015,7 +1045,8 @@ out:
 	if (out->tao_rc != 0)
 		return;
 
-	rc = dss_thread_collective(cont_epoch_aggregate_one, &in_copy, 0);
+	rc = dss_thread_collective(cont_epoch_aggregate_one, &in_copy,
+				   DSS_COLL_FL_AGGREGATE);
 	if (rc != 0)
 		D_ERROR(DF_CONT": Aggregation failed: %d\n",
 			DP_CONT(in->tai_pool_uuid, in->tai_cont_uuid), rc);
@@ -270,6 +270,13 @@ enum {
 	DSS_KEY_FAIL_VALUE,
 	DSS_KEY_FAIL_NUM,
 	DSS_REBUILD_RES_PERCENTAGE,
+	DSS_SCHED_IO_WEIGHT,
+	DSS_SCHED_META_WEIGHT,
+	DSS_SCHED_AGG_WEIGHT,
+	DSS_SCHED_LAT_BUDGET,
+	DSS_REBUILD_PULL_DEPTH,
+	DSS_REBUILD_BANDWIDTH,
+	DSS_REBUILD_LAT_TARGET,
 	DSS_KEY_NUM,
 };
 
@@ -352,6 +359,9 @@ enum {
 #define DAOS_RDB_SKIP_APPENDENTRIES_FAIL (DAOS_FAIL_UNIT_TEST_GROUP_LOC | 0x19)
 
 #define DAOS_VOS_AGG_RANDOM_YIELD	(DAOS_FAIL_UNIT_TEST_GROUP_LOC | 0x1a)
+#define DAOS_REBUILD_NO_INDEX	(DAOS_FAIL_UNIT_TEST_GROUP_LOC | 0x1b)
+/* fail value is the number of container services of a new pool */
+#define DAOS_POOL_CONT_SVC_NR	(DAOS_FAIL_UNIT_TEST_GROUP_LOC | 0x1c)
 
 #define DAOS_FAIL_CHECK(id) daos_fail_check(id)
 
@@ -222,6 +222,9 @@ dc_task_get_opc(tse_task_t *task);
 #define dc_task_resched(task)					\
 	tse_task_reinit(task)
 
+#define dc_task_resched_delay(task, delay)			\
+	tse_task_reinit_with_delay(task, delay)
+
 void
 dc_task_list_sched(d_list_t *head, bool instant);
 
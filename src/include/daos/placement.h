@@ -36,10 +36,12 @@
 /** types of placement maps */
 typedef enum {
 	PL_TYPE_UNKNOWN,
-	/** only support ring map for the time being */
+	/** consistent hash ring, the default */
 	PL_TYPE_RING,
 	/** reserved */
 	PL_TYPE_PETALS,
+	/** jump consistent hash over fault domains */
+	PL_TYPE_JUMP,
 } pl_map_type_t;
 
 struct pl_map_init_attr {
@@ -49,6 +51,9 @@ struct pl_map_init_attr {
 			pool_comp_type_t	domain;
 			unsigned int		ring_nr;
 		} ia_ring;
+		struct pl_jump_init_attr {
+			pool_comp_type_t	domain;
+		} ia_jump;
 	};
 };
 
@@ -77,6 +82,8 @@ struct pl_obj_shard {
 struct pl_obj_layout {
 	uint32_t		 ol_ver;
 	uint32_t		 ol_nr;
+	/** references of pl_obj_layout_get() users and the layout cache */
+	uint32_t		 ol_ref;
 	struct pl_obj_shard	*ol_shards;
 };
 
@@ -101,6 +108,10 @@ int pl_obj_place(struct pl_map *map,
 		 struct daos_obj_shard_md *shard_md,
 		 struct pl_obj_layout **layout_pp);
 
+int pl_obj_layout_get(struct pl_map *map, struct daos_obj_md *md,
+		      struct pl_obj_layout **layout_pp);
+void pl_obj_layout_put(struct pl_obj_layout *layout);
+
 int pl_obj_find_rebuild(struct pl_map *map,
 			struct daos_obj_md *md,
 			struct daos_obj_shard_md *shard_md,
@@ -110,7 +121,7 @@ int pl_obj_find_rebuild(struct pl_map *map,
 int pl_obj_find_reint(struct pl_map *map,
 		      struct daos_obj_md *md,
 		      struct daos_obj_shard_md *shard_md,
-		      struct pl_target_grp *tgp_recov,
-		      uint32_t *tgt_reint);
+		      uint32_t reint_ver, uint32_t *tgt_id,
+		      uint32_t *shard_id, unsigned int array_size);
 
 #endif /* __DAOS_PLACEMENT_H__ */
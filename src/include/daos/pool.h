@@ -52,6 +52,12 @@ struct dc_pool {
 	crt_group_t	       *dp_group;
 	pthread_mutex_t		dp_client_lock;
 	struct rsvc_client	dp_client;
+	/*
+	 * clients of container services 1 to dp_cont_svc_nr - 1, which share
+	 * the replica ranks of the pool service; protected by dp_client_lock
+	 */
+	struct rsvc_client     *dp_cont_clients;
+	uint32_t		dp_cont_svc_nr;
 	uuid_t			dp_pool_hdl;
 	uint64_t		dp_capas;
 	pthread_rwlock_t	dp_map_lock;
@@ -63,6 +69,18 @@ struct dc_pool {
 	size_t			dp_map_sz;
 };
 
+/*
+ * Return the rsvc client of container service \a id, which is combined with
+ * the pool service if 0. Call with dp_client_lock held.
+ */
+static inline struct rsvc_client *
+dc_pool_cont_client(struct dc_pool *pool, uint64_t id)
+{
+	if (id == 0 || id >= pool->dp_cont_svc_nr)
+		return &pool->dp_client;
+	return &pool->dp_cont_clients[id - 1];
+}
+
 struct dc_pool *dc_hdl2pool(daos_handle_t hdl);
 void dc_pool_get(struct dc_pool *pool);
 void dc_pool_put(struct dc_pool *pool);
@@ -181,6 +181,11 @@ void pool_map_addref(struct pool_map *map);
 void pool_map_decref(struct pool_map *map);
 int  pool_map_extend(struct pool_map *map, uint32_t version,
 		     struct pool_buf *buf);
+int  pool_map_delta_extract(struct pool_map *prev, struct pool_map *map,
+			    struct pool_buf *prev_delta,
+			    struct pool_buf **buf_pp);
+int  pool_map_delta_apply(struct pool_map *map, uint32_t version,
+			  struct pool_buf *buf, struct pool_map **mapp);
 void pool_map_print(struct pool_map *map);
 
 int  pool_map_set_version(struct pool_map *map, uint32_t version);
@@ -238,6 +243,18 @@ pool_target_unavail(struct pool_target *tgt)
 	       tgt->ta_comp.co_status == PO_COMP_ST_DOWNOUT;
 }
 
+/**
+ * The target has been added back and its shards are being resynchronized
+ * from the other replicas, it is UP without a failure sequence until the
+ * reintegration is done and it turns to UPIN. Reads should skip it.
+ */
+static inline bool
+pool_target_reint(struct pool_target *tgt)
+{
+	return tgt->ta_comp.co_status == PO_COMP_ST_UP &&
+	       tgt->ta_comp.co_fseq == 0;
+}
+
 pool_comp_state_t pool_comp_str2state(const char *name);
 const char *pool_comp_state2str(pool_comp_state_t state);
 
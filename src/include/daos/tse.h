@@ -350,6 +350,20 @@ tse_task_register_cbs(tse_task_t *task, tse_task_cb_t prep_cb,
 int
 tse_task_reinit(tse_task_t *task);
 
+/**
+ * Reinitialize a task like tse_task_reinit(), the body function of the task
+ * won't be executed again until \a delay has passed, even if it has no
+ * dependency.
+ *
+ * \param task	[IN]	Task to reinitialize
+ * \param delay	[IN]	Delay in us
+ *
+ * \return		0 if success.
+ *			negative errno if it fails.
+ */
+int
+tse_task_reinit_with_delay(tse_task_t *task, uint64_t delay);
+
 void
 tse_task_addref(tse_task_t *task);
 
@@ -532,6 +532,49 @@ int
 daos_cont_alloc_oids(daos_handle_t coh, daos_size_t num_oids, uint64_t *oid,
 		     daos_event_t *ev);
 
+struct daos_oid_alloc;
+
+/**
+ * Create an ID allocator for a container. The allocator hands out unique IDs
+ * from ranges reserved with daos_cont_alloc_oids(), reserving the next range
+ * asynchronously when the current one runs low. The range size adapts to the
+ * rate of allocations. The allocator can be shared by multiple threads.
+ *
+ * \param[in]	coh	Container open handle, must stay open until the
+ *			allocator is finalized.
+ * \param[out]	alloc	Returned allocator.
+ *
+ * \return		0		Success
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_NOMEM	Out of memory
+ */
+int
+daos_cont_oid_alloc_init(daos_handle_t coh, struct daos_oid_alloc **alloc);
+
+/**
+ * Allocate a unique ID from an allocator. The call only blocks if no reserved
+ * ID is left, in which case it waits for the next range to be reserved.
+ *
+ * \param[in]	alloc	Allocator.
+ * \param[out]	oid	Returned unique ID.
+ *
+ * \return		0		Success
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_NO_HDL	Invalid container open handle
+ *			-DER_UNREACH	Network is unreachable
+ */
+int
+daos_cont_oid_alloc(struct daos_oid_alloc *alloc, uint64_t *oid);
+
+/**
+ * Finalize an allocator, waiting for the range reservation in flight if any.
+ * The IDs left in the reserved ranges are discarded.
+ *
+ * \param[in]	alloc	Allocator.
+ */
+int
+daos_cont_oid_alloc_fini(struct daos_oid_alloc *alloc);
+
 /**
  * Rollback to a specific persistent snapshot.
  *
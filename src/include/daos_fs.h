@@ -43,6 +43,20 @@ extern "C" {
 typedef struct dfs_obj dfs_obj_t;
 typedef struct dfs dfs_t;
 
+/**
+ * Object class and chunk size policy of a directory. It applies to the objects
+ * created in the directory, and is inherited by new subdirectories. Zero
+ * fields select the defaults.
+ */
+typedef struct {
+	/** Object class of new subdirectories (default MAX_RW) */
+	daos_oclass_id_t	dp_dir_oclass;
+	/** Object class of new files (default MAX_RW) */
+	daos_oclass_id_t	dp_file_oclass;
+	/** Array chunk size of new files (default 1MiB) */
+	daos_size_t		dp_chunk_size;
+} dfs_policy_t;
+
 /**
  * Mount a file system over DAOS. The pool and container handle must remain
  * connected/open until after dfs_umount() is called; otherwise access to the
@@ -101,8 +115,9 @@ dfs_lookup(dfs_t *dfs, const char *path, int flags, dfs_obj_t **obj,
  * \param[in]	name	Link name of the object to create/open.
  * \param[in]	mode	mode_t (permissions + type).
  * \param[in]	flags	Access flags (O_RDONLY, O_RDWR, O_EXCL, O_CREAT).
- * \param[in]	cid	DAOS object class id (pass 0 for default MAX_RW).
- *			Valid on create only; ignored otherwise.
+ * \param[in]	cid	DAOS object class id (pass 0 for the policy of the
+ *			parent, see dfs_policy_t). Valid on create only;
+ *			ignored otherwise.
  * \param[in]	value	Symlink value (NULL if not syml).
  * \param[out]	obj	Pointer to object opened.
  *
@@ -382,6 +397,31 @@ dfs_access(dfs_t *dfs, dfs_obj_t *parent, const char *name, int mask);
 int
 dfs_chmod(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode);
 
+/**
+ * Set the object class and chunk size policy of a directory. The policy is
+ * stored with the directory entry and applies to objects created afterwards;
+ * existing subdirectories keep the policy they inherited.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	obj	Open directory object.
+ * \param[in]	policy	New policy.
+ *
+ * \return		0 on Success. Negative on Failure.
+ */
+int
+dfs_set_policy(dfs_t *dfs, dfs_obj_t *obj, const dfs_policy_t *policy);
+
+/**
+ * Retrieve the object class and chunk size policy of an open directory.
+ *
+ * \param[in]	obj	Open directory object.
+ * \param[out]	policy	Policy of the directory.
+ *
+ * \return		0 on Success. Negative on Failure.
+ */
+int
+dfs_get_policy(dfs_obj_t *obj, dfs_policy_t *policy);
+
 /**
  * Sync to commit the latest epoch on the container. This applies to the entire
  * namespace and not to a particular file/directory.
@@ -326,6 +326,42 @@ void bio_iod_free(struct bio_desc *biod);
  */
 int bio_iod_prep(struct bio_desc *biod);
 
+/*
+ * Split-phase version of bio_iod_prep(), it prepares the SG lists and submits
+ * the NVMe reads for fetch operation, but doesn't wait for their completion,
+ * so the caller can do other work while the DMA is in flight. The caller must
+ * call bio_iod_wait() before accessing the data.
+ *
+ * \param biod       [IN]	io descriptor
+ *
+ * \return			Zero on success, negative value on error
+ */
+int bio_iod_prep_nowait(struct bio_desc *biod);
+
+/*
+ * Wait for all the inflight NVMe DMA transfers of the io descriptor, which
+ * are submitted by bio_iod_prep_nowait() or bio_iod_flush().
+ *
+ * \param biod       [IN]	io descriptor
+ *
+ * \return			Zero on success, negative value on error
+ */
+int bio_iod_wait(struct bio_desc *biod);
+
+/*
+ * Notify that one SG list of the update io descriptor has been filled (by
+ * RDMA transfer or local copy), the DMA buffer regions that are completely
+ * filled are written back to NVMe device without waiting for completion, so
+ * the write back of an SG list can be overlapped with the transfer of next
+ * ones. bio_iod_post() writes back the remaining regions and waits for all.
+ *
+ * \param biod       [IN]	io descriptor
+ * \param sgl_idx    [IN]	index of the filled SG list
+ *
+ * \return			Zero on success, negative value on error
+ */
+int bio_iod_flush(struct bio_desc *biod, unsigned int sgl_idx);
+
 /*
  * Post operation after the RDMA transfer or local copy done for the io
  * descriptor.
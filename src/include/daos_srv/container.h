@@ -44,6 +44,9 @@ int ds_cont_svc_init(struct cont_svc **svcp, const uuid_t pool_uuid,
 void ds_cont_svc_fini(struct cont_svc **svcp);
 void ds_cont_svc_step_up(struct cont_svc *svc);
 void ds_cont_svc_step_down(struct cont_svc *svc);
+int ds_cont_svc_start(const uuid_t pool_uuid, uint64_t id, uuid_t db_uuid,
+		      bool create, size_t size, d_rank_list_t *replicas);
+int ds_cont_svc_stop(const uuid_t pool_uuid, uint64_t id, bool destroy);
 
 /*
  * Per-thread container (memory) object
@@ -404,20 +404,59 @@ struct dss_acc_task {
  */
 int dss_acc_offload(struct dss_acc_task *at_args);
 
-/** Different type of ES pools, there are 3 pools for now
+/** Different type of ES pools, there are 4 pools for now
  *
  *  DSS_POOL_PRIV     Private pool: I/O requests will be added to this pool.
  *  DSS_POOL_SHARE    Shared pool: Other requests and ULT created during
  *                    processing rpc.
  *  DSS_POOL_REBUILD  rebuild pool: pools specially for rebuild tasks.
+ *  DSS_POOL_AGGREGATE aggregation pool: background aggregation ULTs.
+ *
+ * Each pool is a scheduling class, the scheduler shares the xstream among
+ * the non-empty pools by their weights, see DSS_SCHED_*_WEIGHT.
  */
 enum {
 	DSS_POOL_PRIV,
 	DSS_POOL_SHARE,
 	DSS_POOL_REBUILD,
+	DSS_POOL_AGGREGATE,
 	DSS_POOL_CNT,
 };
 
+/** Collective flag: run the collective ULTs in the aggregation pool */
+#define DSS_COLL_FL_AGGREGATE	(1U << 0)
+
+bool dss_xstream_is_busy(void);
+uint64_t dss_xstream_io_delay(void);
+
+/** ULT suspended in the xstream scheduler by dss_ult_sleep() */
+struct dss_sleep_ult {
+	ABT_thread		 dsu_thread;
+	struct dss_xstream	*dsu_dx;
+	/* ABT_get_wtime() to be woken up at */
+	double			 dsu_expire;
+	/* link on the sleep list of dsu_dx, empty when not sleeping */
+	d_list_t		 dsu_link;
+};
+
+static inline void
+dss_sleep_ult_init(struct dss_sleep_ult *dsu)
+{
+	memset(dsu, 0, sizeof(*dsu));
+	D_INIT_LIST_HEAD(&dsu->dsu_link);
+}
+
+void dss_ult_sleep(struct dss_sleep_ult *dsu, double expire);
+void dss_ult_wakeup(struct dss_sleep_ult *dsu);
+
+/** upper limit of DSS_REBUILD_PULL_DEPTH */
+#define DSS_REBUILD_PULL_DEPTH_MAX	64
+
+/** rebuild pull tunables, see DSS_REBUILD_* in dss_parameters_set() */
+extern unsigned int dss_rebuild_pull_depth;
+extern unsigned int dss_rebuild_bandwidth;
+extern unsigned int dss_rebuild_lat_target;
+
 /* DAOS object API on the server side */
 int ds_obj_open(daos_handle_t coh, daos_obj_id_t oid,
 		unsigned int mode, daos_handle_t *oh);
@@ -432,11 +471,12 @@ int ds_obj_fetch(daos_handle_t oh, daos_epoch_t epoch,
 		 daos_key_t *dkey, unsigned int nr,
 		 daos_iod_t *iods, daos_sg_list_t *sgls,
 		 daos_iom_t *maps);
-int ds_obj_list_obj(daos_handle_t oh, daos_epoch_t epoch, daos_key_t *dkey,
-		daos_key_t *akey, daos_size_t *size, uint32_t *nr,
-		daos_key_desc_t *kds, daos_epoch_range_t *eprs,
-		d_sg_list_t *sgl, daos_anchor_t *anchor,
-		daos_anchor_t *dkey_anchor, daos_anchor_t *akey_anchor);
+int ds_obj_list_obj(daos_handle_t oh, daos_epoch_t epoch,
+		    daos_epoch_t epoch_lo, daos_key_t *dkey, daos_key_t *akey,
+		    daos_size_t *size, uint32_t *nr, daos_key_desc_t *kds,
+		    daos_epoch_range_t *eprs, d_sg_list_t *sgl,
+		    daos_anchor_t *anchor, daos_anchor_t *dkey_anchor,
+		    daos_anchor_t *akey_anchor);
 
 struct dss_enum_arg {
 	bool			fill_recxs;	/* type == S||R */
@@ -48,6 +48,7 @@ struct ds_pool {
 	uint32_t		sp_map_version;	/* temporary */
 	crt_group_t	       *sp_group;
 	struct ds_iv_ns		*sp_iv_ns;
+	uint32_t		sp_cont_svc_nr;	/* # of container svcs */
 };
 
 struct ds_pool_create_arg {
@@ -119,9 +120,12 @@ int ds_pool_map_buf_get(uuid_t uuid, d_iov_t *iov, uint32_t *map_ver);
 
 int ds_pool_tgt_exclude_out(uuid_t pool_uuid, struct pool_target_id_list *list);
 int ds_pool_tgt_exclude(uuid_t pool_uuid, struct pool_target_id_list *list);
+int ds_pool_tgt_add_in(uuid_t pool_uuid, struct pool_target_id_list *list);
 
 int ds_pool_tgt_map_update(struct ds_pool *pool, struct pool_buf *buf,
 			   unsigned int map_version);
+int ds_pool_tgt_map_update_delta(struct ds_pool *pool, struct pool_buf *buf,
+				 unsigned int base, unsigned int map_version);
 
 /*
  * TODO: Make the following internal functions of ds_pool after merging in
@@ -157,10 +161,15 @@ typedef int (*obj_iter_cb_t)(uuid_t cont_uuid, daos_unit_oid_t oid,
 			     daos_epoch_t eph, void *arg);
 int ds_pool_obj_iter(uuid_t pool_uuid, obj_iter_cb_t callback, void *arg);
 
+typedef int (*pool_iter_cb_t)(daos_handle_t ph, uuid_t co_uuid, void *arg);
+int ds_pool_cont_iter(daos_handle_t ph, pool_iter_cb_t callback, void *arg);
+
 struct cont_svc;
 struct rsvc_hint;
 int ds_pool_cont_svc_lookup_leader(uuid_t pool_uuid, struct cont_svc **svc,
 				   struct rsvc_hint *hint);
+char *ds_pool_cont_svc_rdb_path(const uuid_t pool_uuid, uint64_t id);
+int ds_pool_group_init(struct ds_pool *pool);
 
 int ds_pool_iv_ns_update(struct ds_pool *pool, unsigned int master_rank,
 			 d_iov_t *iv_iov, unsigned int iv_ns_id);
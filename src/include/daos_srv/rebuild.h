@@ -32,16 +32,31 @@
 #define REBUILD_ENV            "DAOS_REBUILD"
 #define REBUILD_ENV_DISABLED   "no"
 
+/* Rebuild operations */
+typedef enum {
+	/* rebuild the shards of the failed targets on the spare targets */
+	RB_OP_FAIL,
+	/* resync the shards of the targets being reintegrated */
+	RB_OP_REINT,
+} daos_rebuild_opc_t;
+
 bool is_rebuild_container(uuid_t pool_uuid, uuid_t coh_uuid);
 bool is_rebuild_pool(uuid_t pool_uuid, uuid_t poh_uuid);
 
 int ds_rebuild_schedule(const uuid_t uuid, uint32_t map_ver,
-			struct pool_target_id_list *tgts_failed,
-			d_rank_list_t *svc_list);
+			struct pool_target_id_list *tgts,
+			d_rank_list_t *svc_list, daos_rebuild_opc_t op);
 int ds_rebuild_query(uuid_t pool_uuid,
 		     struct daos_rebuild_status *status);
 int ds_rebuild_regenerate_task(struct ds_pool *pool, d_rank_list_t *svc_list);
 int ds_rebuild_pool_map_update(struct ds_pool *pool);
 void ds_rebuild_leader_stop_all(void);
 void ds_rebuild_leader_stop(const uuid_t pool_uuid, unsigned int version);
+int ds_rebuild_obj_index_init(daos_handle_t coh);
+void ds_rebuild_obj_index_insert(uuid_t pool_uuid, daos_handle_t coh,
+				 daos_unit_oid_t oid, uint32_t map_ver);
+void ds_rebuild_obj_index_punch(uuid_t pool_uuid, daos_handle_t coh,
+				daos_unit_oid_t oid, uint32_t map_ver,
+				daos_epoch_t epoch);
+void ds_rebuild_obj_index_discard(daos_handle_t coh, daos_epoch_range_t *epr);
 #endif
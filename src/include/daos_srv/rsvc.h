@@ -39,6 +39,7 @@
 enum ds_rsvc_class_id {
 	DS_RSVC_CLASS_MGMT,
 	DS_RSVC_CLASS_POOL,
+	DS_RSVC_CLASS_CONT,
 	DS_RSVC_CLASS_COUNT
 };
 
@@ -134,5 +135,6 @@ int ds_rsvc_lookup_leader(enum ds_rsvc_class_id class, daos_iov_t *id,
 void ds_rsvc_put(struct ds_rsvc *svc);
 void ds_rsvc_put_leader(struct ds_rsvc *svc);
 void ds_rsvc_set_hint(struct ds_rsvc *svc, struct rsvc_hint *hint);
+int ds_rsvc_prefer_leader(struct ds_rsvc *svc, unsigned int idx);
 
 #endif /* DAOS_SRV_RSVC_H */
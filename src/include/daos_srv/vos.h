@@ -457,6 +457,17 @@ vos_update_begin(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_t epoch,
 int
 vos_update_end(daos_handle_t ioh, uint32_t pm_ver, daos_key_t *dkey, int err);
 
+/**
+ * Check if the object of the update had no key when the update began, i.e.
+ * the object is created by this update.
+ *
+ * \param ioh	[IN]	The I/O handle created by \a vos_update_begin
+ *
+ * \return		true if the object is new
+ */
+bool
+vos_update_obj_new(daos_handle_t ioh);
+
 /**
  * Get the I/O descriptor.
  *
@@ -482,6 +482,8 @@ typedef struct {
 	daos_anchor_t		*dkey_anchor;
 	daos_anchor_t		*akey_anchor;
 	uint32_t		*versions;
+	/* only enumerate the changes at or after this epoch */
+	daos_epoch_t		epoch_lo;
 	bool			incr_order;
 } daos_obj_list_obj_t;
 
@@ -237,6 +237,17 @@ struct daos_rebuild_status {
 	uint64_t		rs_obj_nr;
 	/** # rebuilt records, it's non-zero only if rs_done is 1 */
 	uint64_t		rs_rec_nr;
+	/**
+	 * # estimated to-be-rebuilt bytes, it increases while scanners are
+	 * still discovering objects, see rs_toberb_obj_nr.
+	 */
+	uint64_t		rs_toberb_size;
+	/** # rebuilt bytes */
+	uint64_t		rs_size;
+	/** average rebuild rate in bytes per second */
+	uint64_t		rs_rate;
+	/** estimated seconds to finish the rebuild, zero if done or unknown */
+	uint64_t		rs_eta;
 };
 
 /**
@@ -171,9 +171,9 @@ ds_obj_fetch(daos_handle_t oh, daos_epoch_t epoch,
 }
 
 int
-ds_obj_list_obj(daos_handle_t oh, daos_epoch_t epoch, daos_key_t *dkey,
-		daos_key_t *akey, daos_size_t *size, uint32_t *nr,
-		daos_key_desc_t *kds, daos_epoch_range_t *eprs,
+ds_obj_list_obj(daos_handle_t oh, daos_epoch_t epoch, daos_epoch_t epoch_lo,
+		daos_key_t *dkey, daos_key_t *akey, daos_size_t *size,
+		uint32_t *nr, daos_key_desc_t *kds, daos_epoch_range_t *eprs,
 		d_sg_list_t *sgl, daos_anchor_t *anchor,
 		daos_anchor_t *dkey_anchor, daos_anchor_t *akey_anchor)
 {
@@ -186,9 +186,9 @@ ds_obj_list_obj(daos_handle_t oh, daos_epoch_t epoch, daos_key_t *dkey,
 	if (rc)
 		return rc;
 
-	rc = dc_obj_list_obj_task_create(oh, th, dkey, akey, size, nr, kds,
-					 eprs, sgl, anchor, dkey_anchor,
-					 akey_anchor, true, NULL,
+	rc = dc_obj_list_obj_task_create(oh, th, epoch_lo, dkey, akey, size,
+					 nr, kds, eprs, sgl, anchor,
+					 dkey_anchor, akey_anchor, true, NULL,
 					 dss_tse_scheduler(), &task);
 	if (rc)
 		return rc;
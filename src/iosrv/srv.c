@@ -93,6 +93,45 @@ unsigned int	dss_sys_xs_nr = DAOS_TGT0_OFFSET;
 #define REBUILD_DEFAULT_SCHEDULE_RATIO 30
 unsigned int	dss_rebuild_res_percentage = REBUILD_DEFAULT_SCHEDULE_RATIO;
 
+#define REBUILD_DEFAULT_PULL_DEPTH	8
+#define REBUILD_DEFAULT_LAT_TARGET	2000
+/** max # dkeys being pulled concurrently by the rebuild puller of a target */
+unsigned int	dss_rebuild_pull_depth = REBUILD_DEFAULT_PULL_DEPTH;
+/** rebuild bandwidth limit of each target in MB/s, zero means unlimited */
+unsigned int	dss_rebuild_bandwidth;
+/**
+ * Foreground I/O queueing delay (in us) above which rebuild pullers back off,
+ * zero disables the back off.
+ */
+unsigned int	dss_rebuild_lat_target = REBUILD_DEFAULT_LAT_TARGET;
+
+/**
+ * Scheduling weight of each ULT pool. When several pools have runnable ULTs,
+ * each of them gets a share of the xstream proportional to its weight, the
+ * rebuild weight is dss_rebuild_res_percentage.
+ *
+ * TODO: per-container QoS shares. All I/O ULTs of a target are queued in one
+ * FIFO DSS_POOL_PRIV pool, so the containers can't be given their own shares
+ * of the I/O weight without a custom Argobots pool keeping one queue per open
+ * container, whose pop callback would apply the same stride scheduling as
+ * dss_sched_unit_pop() among the containers.
+ */
+#define DSS_SCHED_IO_WEIGHT_DEFAULT	50
+#define DSS_SCHED_META_WEIGHT_DEFAULT	10
+#define DSS_SCHED_AGG_WEIGHT_DEFAULT	10
+static unsigned int	dss_sched_weights[DSS_POOL_CNT] = {
+	[DSS_POOL_PRIV]		= DSS_SCHED_IO_WEIGHT_DEFAULT,
+	[DSS_POOL_SHARE]	= DSS_SCHED_META_WEIGHT_DEFAULT,
+	[DSS_POOL_AGGREGATE]	= DSS_SCHED_AGG_WEIGHT_DEFAULT,
+};
+
+/**
+ * Latency budget (in us) of the queued I/O requests of a xstream, new I/O
+ * requests are rejected with -DER_BUSY once the estimated queueing delay
+ * exceeds it. Zero disables the admission control.
+ */
+static unsigned int	dss_sched_lat_budget;
+
 /** Per-xstream configuration data */
 struct dss_xstream {
 	ABT_future	dx_shutdown;
@@ -113,6 +152,14 @@ struct dss_xstream {
 	int		dx_ctx_id;
 	bool		dx_main_xs;	/* true for main XS */
 	bool		dx_comm;	/* true with cart context */
+	/* moving average of the run time (us) of an I/O ULT between yields,
+	 * used to estimate the queueing delay for admission control.
+	 */
+	uint32_t	dx_io_cost;
+	/* NUMA node of the cores the xstream is bound to */
+	int		dx_numa_node;
+	/* ULTs suspended by dss_ult_sleep(), sorted by dsu_expire */
+	d_list_t	dx_sleep_list;
 };
 
 struct dss_xstream_data {
@@ -129,12 +176,27 @@ struct dss_xstream_data {
 	/** barrier for all ULTs to enter handling loop */
 	ABT_cond		  xd_ult_barrier;
 	ABT_mutex		  xd_mutex;
+	/**
+	 * Fan-out groups of the collectives: VOS target IDs sorted by NUMA
+	 * node, group i is [xd_coll_grps[i], xd_coll_grps[i + 1]) of them.
+	 */
+	int			 *xd_coll_tids;
+	int			 *xd_coll_grps;
+	int			  xd_coll_grp_nr;
 };
 
 static struct dss_xstream_data	xstream_data;
 
+/** Virtual time granted to a pool for running one ULT with weight 1 */
+#define DSS_SCHED_STRIDE	(1U << 20)
+
 struct sched_data {
-    uint32_t event_freq;
+	uint32_t		 event_freq;
+	struct dss_xstream	*sd_dx;
+	/* virtual time of the last scheduled ULT */
+	uint64_t		 sd_vtime;
+	/* virtual time when each pool is eligible to run again */
+	uint64_t		 sd_pass[DSS_POOL_CNT];
 };
 
 static int
@@ -157,66 +219,96 @@ dss_sched_init(ABT_sched sched, ABT_sched_config config)
 	return ret;
 }
 
-static ABT_unit
-normal_unit_pop(ABT_pool *pools, ABT_pool *pool)
+static unsigned int
+dss_sched_weight(int pool_idx)
 {
-	ABT_unit unit;
+	unsigned int weight;
 
-	/* Let's pop I/O request ULT first */
-	ABT_pool_pop(pools[DSS_POOL_PRIV], &unit);
-	if (unit != ABT_UNIT_NULL) {
-		*pool = pools[DSS_POOL_PRIV];
-		return unit;
-	}
-
-	/* Other request and ollective ULT or created ULT */
-	ABT_pool_pop(pools[DSS_POOL_SHARE], &unit);
-	if (unit != ABT_UNIT_NULL) {
-		*pool = pools[DSS_POOL_SHARE];
-		return unit;
-	}
+	if (pool_idx == DSS_POOL_REBUILD)
+		weight = dss_rebuild_res_percentage;
+	else
+		weight = dss_sched_weights[pool_idx];
 
-	return ABT_UNIT_NULL;
+	/* never starve a class completely */
+	return weight == 0 ? 1 : weight;
 }
 
+/**
+ * Choose ULT from the pools by weighted fair queuing (stride scheduling):
+ * every non-empty pool has a virtual pass, the pool with the smallest pass
+ * runs next and its pass advances by DSS_SCHED_STRIDE / weight. A pool which
+ * was idle restarts from the current virtual time, so it can't accumulate
+ * credits to starve the others once it becomes busy.
+ *
+ * Ties are broken by pool index, so I/O requests go first.
+ */
 static ABT_unit
-rebuild_unit_pop(ABT_pool *pools, ABT_pool *pool)
+dss_sched_unit_pop(struct sched_data *data, ABT_pool *pools, ABT_pool *pool)
 {
-	ABT_unit unit;
+	ABT_unit	unit;
+	uint64_t	pass;
+	uint64_t	min_pass = 0;
+	size_t		size;
+	int		idx = -1;
+	int		rc;
+	int		i;
+
+	for (i = 0; i < DSS_POOL_CNT; i++) {
+		rc = ABT_pool_get_size(pools[i], &size);
+		if (rc != ABT_SUCCESS || size == 0)
+			continue;
 
-	ABT_pool_pop(pools[DSS_POOL_REBUILD], &unit);
-	if (unit != ABT_UNIT_NULL) {
-		*pool = pools[DSS_POOL_REBUILD];
-		return unit;
+		pass = max(data->sd_pass[i], data->sd_vtime);
+		if (idx < 0 || pass < min_pass) {
+			min_pass = pass;
+			idx = i;
+		}
 	}
 
-	return ABT_UNIT_NULL;
+	if (idx < 0)
+		return ABT_UNIT_NULL;
+
+	/* the shared pools can be drained by the other xstreams meanwhile */
+	ABT_pool_pop(pools[idx], &unit);
+	if (unit == ABT_UNIT_NULL)
+		return ABT_UNIT_NULL;
+
+	data->sd_vtime = min_pass;
+	data->sd_pass[idx] = min_pass +
+			     DSS_SCHED_STRIDE / dss_sched_weight(idx);
+	*pool = pools[idx];
+	return unit;
 }
 
-/**
- * Choose ULT from the pool. Note: the rebuild ULT will be
- * be choosen by dss_rebuild_res_percentage.
- *
- * XXX we may change the sequence later once we have more cases.
- */
-static ABT_unit
-dss_sched_unit_pop(ABT_pool *pools, ABT_pool *pool)
+/** Account the run time of an I/O ULT into the moving average */
+static void
+dss_sched_io_cost_update(struct dss_xstream *dx, double start)
 {
-	size_t	 rebuild_cnt;
-	int	 rc;
+	uint32_t cost;
 
-	rc = ABT_pool_get_total_size(pools[DSS_POOL_REBUILD],
-				     &rebuild_cnt);
-	if (rc != ABT_SUCCESS)
-		return ABT_UNIT_NULL;
+	cost = (ABT_get_wtime() - start) * 1000000;
+	/* cost = 7/8 old + 1/8 new */
+	dx->dx_io_cost = dx->dx_io_cost - (dx->dx_io_cost >> 3) + (cost >> 3);
+}
 
-	if (rebuild_cnt == 0 ||
-	    rand() % 100 >= dss_rebuild_res_percentage)
-		return normal_unit_pop(pools, pool);
-	else
-		return rebuild_unit_pop(pools, pool);
+/** Resume the sleeping ULTs whose time is up */
+static void
+dss_sched_wakeup(struct dss_xstream *dx)
+{
+	struct dss_sleep_ult	*dsu;
+	struct dss_sleep_ult	*tmp;
+	double			 now;
 
-	return ABT_UNIT_NULL;
+	if (d_list_empty(&dx->dx_sleep_list))
+		return;
+
+	now = ABT_get_wtime();
+	d_list_for_each_entry_safe(dsu, tmp, &dx->dx_sleep_list, dsu_link) {
+		if (dsu->dsu_expire > now)
+			break;
+		d_list_del_init(&dsu->dsu_link);
+		ABT_thread_resume(dsu->dsu_thread);
+	}
 }
 
 static void
@@ -238,10 +330,25 @@ dss_sched_run(ABT_sched sched)
 	}
 
 	while (1) {
+		dss_sched_wakeup(p_data->sd_dx);
 		/* Execute one work unit from the scheduler's pool */
-		unit = dss_sched_unit_pop(pools, &pool);
-		if (unit != ABT_UNIT_NULL && pool != ABT_UNIT_NULL)
-			ABT_xstream_run_unit(unit, pool);
+		unit = dss_sched_unit_pop(p_data, pools, &pool);
+		if (unit != ABT_UNIT_NULL && pool != ABT_UNIT_NULL) {
+			/*
+			 * I/O cost feeds both admission control and the
+			 * rebuild puller throttle.
+			 */
+			if (pool == pools[DSS_POOL_PRIV] &&
+			    (dss_sched_lat_budget != 0 ||
+			     dss_rebuild_lat_target != 0)) {
+				double start = ABT_get_wtime();
+
+				ABT_xstream_run_unit(unit, pool);
+				dss_sched_io_cost_update(p_data->sd_dx, start);
+			} else {
+				ABT_xstream_run_unit(unit, pool);
+			}
+		}
 		if (++work_count >= p_data->event_freq) {
 			ABT_bool stop;
 
@@ -271,8 +378,9 @@ dss_sched_free(ABT_sched sched)
  * Create scheduler
  */
 static int
-dss_sched_create(ABT_pool *pools, int pool_num, ABT_sched *new_sched)
+dss_sched_create(struct dss_xstream *dx, ABT_sched *new_sched)
 {
+	struct sched_data	*p_data;
 	int			ret;
 	ABT_sched_config	config;
 	ABT_sched_config_var	cv_event_freq = {
@@ -294,14 +402,105 @@ dss_sched_create(ABT_pool *pools, int pool_num, ABT_sched *new_sched)
 	if (ret != ABT_SUCCESS)
 		return dss_abterr2der(ret);
 
-	ret = ABT_sched_create(&sched_def, pool_num, pools, config,
+	ret = ABT_sched_create(&sched_def, DSS_POOL_CNT, dx->dx_pools, config,
 			       new_sched);
 	ABT_sched_config_free(&config);
+	if (ret != ABT_SUCCESS)
+		return dss_abterr2der(ret);
 
-	return dss_abterr2der(ret);
+	/* the scheduler can't run before the xstream is created */
+	ABT_sched_get_data(*new_sched, (void **)&p_data);
+	p_data->sd_dx = dx;
+	return 0;
 }
 
 
+/**
+ * Estimate the queueing delay of a new I/O request on the current xstream
+ * from the number of runnable I/O ULTs and their average run time.
+ *
+ * \return		estimated delay in us.
+ */
+uint64_t
+dss_xstream_io_delay(void)
+{
+	struct dss_xstream	*dx;
+	size_t			 size;
+	int			 rc;
+
+	dx = dss_get_module_info()->dmi_xstream;
+	rc = ABT_pool_get_size(dx->dx_pools[DSS_POOL_PRIV], &size);
+	if (rc != ABT_SUCCESS)
+		return 0;
+
+	return (uint64_t)size * dx->dx_io_cost;
+}
+
+/**
+ * Admission control for I/O requests. A new I/O request should be rejected
+ * with -DER_BUSY (and retried by client) if its estimated queueing delay
+ * exceeds the latency budget, instead of being queued behind the others.
+ *
+ * \return		true if the current xstream is overloaded.
+ */
+bool
+dss_xstream_is_busy(void)
+{
+	if (dss_sched_lat_budget == 0)
+		return false;
+
+	return dss_xstream_io_delay() > dss_sched_lat_budget;
+}
+
+/**
+ * Suspend the calling ULT until \a expire, or until dss_ult_wakeup() is
+ * called on \a dsu. Unlike dss_sleep() or ABT_cond_timedwait(), the ULT is
+ * not in any pool while sleeping, so it costs the xstream nothing: the
+ * scheduler resumes it once ABT_get_wtime() reaches \a expire.
+ *
+ * \param[in] dsu	sleep descriptor, initialized by dss_sleep_ult_init()
+ * \param[in] expire	ABT_get_wtime() to sleep until
+ */
+void
+dss_ult_sleep(struct dss_sleep_ult *dsu, double expire)
+{
+	struct dss_xstream	*dx = dss_get_module_info()->dmi_xstream;
+	struct dss_sleep_ult	*tmp;
+
+	D_ASSERT(d_list_empty(&dsu->dsu_link));
+	if (ABT_get_wtime() >= expire)
+		return;
+
+	ABT_thread_self(&dsu->dsu_thread);
+	dsu->dsu_dx = dx;
+	dsu->dsu_expire = expire;
+	d_list_for_each_entry_reverse(tmp, &dx->dx_sleep_list, dsu_link) {
+		if (tmp->dsu_expire <= expire)
+			break;
+	}
+	d_list_add(&dsu->dsu_link, &tmp->dsu_link);
+	/* no yield since the insert, the scheduler can't have resumed us */
+	ABT_self_suspend();
+}
+
+/**
+ * Wake up a ULT sleeping in dss_ult_sleep() before its time is up, nothing
+ * is done if it isn't sleeping. Must be called on the xstream of the
+ * sleeping ULT, as the sleep list isn't locked.
+ *
+ * \param[in] dsu	sleep descriptor passed to dss_ult_sleep()
+ */
+void
+dss_ult_wakeup(struct dss_sleep_ult *dsu)
+{
+	if (d_list_empty(&dsu->dsu_link))
+		return;
+
+	D_ASSERT(dsu->dsu_dx == dss_get_module_info()->dmi_xstream);
+	d_list_del_init(&dsu->dsu_link);
+	ABT_thread_resume(dsu->dsu_thread);
+}
+
 static dss_abt_pool_choose_cb_t abt_pool_choose_cbs[DAOS_MAX_MODULE];
 
 /**
@@ -516,6 +715,23 @@ signal:
 	}
 }
 
+/** Return the first NUMA node of \a cpus, 0 if it's unknown */
+static int
+dss_cpuset2numa(hwloc_cpuset_t cpus)
+{
+	hwloc_nodeset_t	nodes;
+	int		node;
+
+	nodes = hwloc_bitmap_alloc();
+	if (nodes == NULL)
+		return 0;
+
+	hwloc_cpuset_to_nodeset(dss_topo, cpus, nodes);
+	node = hwloc_bitmap_first(nodes);
+	hwloc_bitmap_free(nodes);
+	return node < 0 ? 0 : node;
+}
+
 static inline struct dss_xstream *
 dss_xstream_alloc(hwloc_cpuset_t cpus)
 {
@@ -547,6 +763,8 @@ dss_xstream_alloc(hwloc_cpuset_t cpus)
 	dx->dx_xstream	= ABT_XSTREAM_NULL;
 	dx->dx_sched	= ABT_SCHED_NULL;
 	dx->dx_progress	= ABT_THREAD_NULL;
+	dx->dx_numa_node = dss_cpuset2numa(cpus);
+	D_INIT_LIST_HEAD(&dx->dx_sleep_list);
 
 	return dx;
 
@@ -592,8 +810,8 @@ dss_start_one_xstream(hwloc_cpuset_t cpus, int xs_id)
 	for (i = 0; i < DSS_POOL_CNT; i++) {
 		ABT_pool_access access;
 
-		access = (i == DSS_POOL_SHARE || i == DSS_POOL_REBUILD) ?
-			 ABT_POOL_ACCESS_MPSC : ABT_POOL_ACCESS_PRIV;
+		access = (i == DSS_POOL_PRIV) ?
+			 ABT_POOL_ACCESS_PRIV : ABT_POOL_ACCESS_MPSC;
 
 		rc = ABT_pool_create_basic(ABT_POOL_FIFO, access, ABT_TRUE,
 					   &dx->dx_pools[i]);
@@ -615,7 +833,7 @@ dss_start_one_xstream(hwloc_cpuset_t cpus, int xs_id)
 	dx->dx_comm	= comm;
 	dx->dx_main_xs	= xs_id >= dss_sys_xs_nr && xs_offset == 0;
 
-	rc = dss_sched_create(dx->dx_pools, DSS_POOL_CNT, &dx->dx_sched);
+	rc = dss_sched_create(dx, &dx->dx_sched);
 	if (rc != 0) {
 		D_ERROR("create scheduler fails: %d\n", rc);
 		D_GOTO(out_pool, rc);
@@ -744,6 +962,74 @@ dss_xstreams_open_barrier(void)
 	ABT_mutex_unlock(xstream_data.xd_mutex);
 }
 
+/** Maximum number of xstreams a collective ULT fans out to */
+#define DSS_COLL_FANOUT		8
+
+static inline int
+dss_tgt2numa(int tid)
+{
+	return xstream_data.xd_xs_ptrs[DSS_MAIN_XS_ID(tid)]->dx_numa_node;
+}
+
+/**
+ * Split the main xstreams into the fan-out groups of the collectives. Targets
+ * on the same NUMA node are grouped together, so the second level of the
+ * fan-out and the completion of each group stay on the same node.
+ */
+static int
+dss_coll_groups_init(void)
+{
+	int	*tids;
+	int	*grps;
+	int	 nr = 0;
+	int	 i;
+	int	 j;
+
+	D_ALLOC_ARRAY(tids, dss_tgt_nr);
+	D_ALLOC_ARRAY(grps, dss_tgt_nr + 1);
+	if (tids == NULL || grps == NULL) {
+		if (tids != NULL)
+			D_FREE(tids);
+		if (grps != NULL)
+			D_FREE(grps);
+		return -DER_NOMEM;
+	}
+
+	/* insertion sort by NUMA node, the order of targets is kept */
+	for (i = 0; i < dss_tgt_nr; i++) {
+		for (j = i; j > 0; j--) {
+			if (dss_tgt2numa(tids[j - 1]) <= dss_tgt2numa(i))
+				break;
+			tids[j] = tids[j - 1];
+		}
+		tids[j] = i;
+	}
+
+	for (i = 0; i < dss_tgt_nr; i++) {
+		if (i == 0 || i - grps[nr - 1] == DSS_COLL_FANOUT ||
+		    dss_tgt2numa(tids[i]) != dss_tgt2numa(tids[i - 1]))
+			grps[nr++] = i;
+	}
+	grps[nr] = dss_tgt_nr;
+
+	D_DEBUG(DB_TRACE, "%d targets in %d collective groups\n", dss_tgt_nr,
+		nr);
+	xstream_data.xd_coll_tids = tids;
+	xstream_data.xd_coll_grps = grps;
+	xstream_data.xd_coll_grp_nr = nr;
+	return 0;
+}
+
+static void
+dss_coll_groups_fini(void)
+{
+	if (xstream_data.xd_coll_tids != NULL)
+		D_FREE(xstream_data.xd_coll_tids);
+	if (xstream_data.xd_coll_grps != NULL)
+		D_FREE(xstream_data.xd_coll_grps);
+	xstream_data.xd_coll_grp_nr = 0;
+}
+
 static bool
 dss_xstreams_empty(void)
 {
@@ -786,6 +1072,8 @@ dss_xstreams_init()
 	}
 	D_DEBUG(DB_TRACE, "%d execution streams successfully started\n",
 		dss_tgt_nr);
+
+	rc = dss_coll_groups_init();
 failed:
 	dss_xstreams_open_barrier();
 	if (dss_xstreams_empty()) /* started nothing */
@@ -897,7 +1185,9 @@ dss_ult_create(void (*func)(void *), void *arg, int ult_type, int tgt_idx,
 	       size_t stack_size, ABT_thread *ult)
 {
 	return dss_ult_pool_create(func, arg, dss_tgt2xs(ult_type, tgt_idx),
-				   stack_size, ult, DSS_POOL_SHARE);
+				   stack_size, ult,
+				   ult_type == DSS_ULT_AGGREGATE ?
+				   DSS_POOL_AGGREGATE : DSS_POOL_SHARE);
 }
 
 /* Create the pool in the rebuild pool */
@@ -939,14 +1229,6 @@ dss_ult_create_all(void (*func)(void *), void *arg)
 	return rc;
 }
 
-struct aggregator_arg_type {
-	struct dss_stream_arg_type	at_args;
-	void				(*at_reduce)(void *a_args,
-						     void *s_args);
-	int				at_rc;
-	int				at_xs_nr;
-};
-
 /**
  * Collective operations among all server xstreams
  */
@@ -1037,51 +1319,119 @@ free:
 	return rc;
 }
 
+/*
+ * A collective is fanned out in two levels: the caller creates one ULT (or
+ * tasklet) on the leader of each group, which creates the ones of the other
+ * members of its group before running its own share. Completion is counted
+ * with atomics, the last finishing xstream wakes up the caller, which then
+ * runs the reduce callbacks, so they are never called concurrently.
+ */
 struct collective_arg {
-	struct dss_future_arg		ca_future;
+	int				(*ca_func)(void *);
+	void				*ca_func_arg;
+	struct dss_stream_arg_type	*ca_streams;
+	int				 ca_pool_idx;
+	bool				 ca_thread;
+	/* number of xstreams not done yet */
+	int				 ca_pending;
+	/* number of failed xstreams and the first error */
+	int				 ca_nfailed;
+	int				 ca_rc;
+	ABT_eventual			 ca_eventual;
+};
+
+struct collective_grp_arg {
+	struct collective_arg		*cga_carg;
+	int				 cga_grp;
 };
 
+static void
+collective_done(struct collective_arg *carg, struct dss_stream_arg_type *stream)
+{
+	ABT_eventual	eventual = carg->ca_eventual;
+	int		rc = stream->st_rc;
+
+	if (rc != 0) {
+		int	zero = 0;
+
+		__atomic_add_fetch(&carg->ca_nfailed, 1, __ATOMIC_RELAXED);
+		__atomic_compare_exchange_n(&carg->ca_rc, &zero, rc, false,
+					    __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+	}
+
+	/* carg can be released by the caller once the last one is done */
+	if (__atomic_sub_fetch(&carg->ca_pending, 1, __ATOMIC_ACQ_REL) == 0)
+		ABT_eventual_set(eventual, NULL, 0);
+}
+
 static void
 collective_func(void *varg)
 {
-	struct dss_stream_arg_type	*a_args	= varg;
-	struct collective_arg		*carg	= a_args->st_coll_args;
-	struct dss_future_arg		*f_arg	= &carg->ca_future;
-	int				rc;
+	struct dss_stream_arg_type	*stream	= varg;
+	struct collective_arg		*carg	= stream->st_coll_args;
 
-	/** Update just the rc value */
-	a_args->st_rc = f_arg->dfa_func(f_arg->dfa_arg);
+	stream->st_rc = carg->ca_func(carg->ca_func_arg);
+	collective_done(carg, stream);
+}
 
-	rc = ABT_future_set(f_arg->dfa_future, (void *)a_args);
-	if (rc != ABT_SUCCESS)
-		D_ERROR("future set failure %d\n", rc);
+static int
+collective_create(struct collective_arg *carg, int tid, void (*func)(void *),
+		  void *arg)
+{
+	struct dss_xstream	*dx = dss_xstream_get(DSS_MAIN_XS_ID(tid));
+	ABT_pool		 pool = dx->dx_pools[carg->ca_pool_idx];
+	int			 rc;
+
+	if (carg->ca_thread)
+		rc = ABT_thread_create(pool, func, arg, ABT_THREAD_ATTR_NULL,
+				       NULL);
+	else
+		rc = ABT_task_create(pool, func, arg, NULL);
+
+	return rc == ABT_SUCCESS ? 0 : dss_abterr2der(rc);
 }
 
-/* Reduce the return codes into the first element. */
+/* Fail all xstreams of group @grp */
 static void
-collective_reduce(void **arg)
+collective_grp_fail(struct collective_arg *carg, int grp, int rc)
 {
-	struct aggregator_arg_type	*aggregator;
 	struct dss_stream_arg_type	*stream;
-	int				*nfailed;
+	int				 end;
 	int				 i;
 
-	aggregator = (struct aggregator_arg_type *)arg[0];
-	nfailed = &aggregator->at_args.st_rc;
+	end = xstream_data.xd_coll_grps[grp + 1];
+	for (i = xstream_data.xd_coll_grps[grp]; i < end; i++) {
+		stream = &carg->ca_streams[xstream_data.xd_coll_tids[i]];
+		stream->st_rc = rc;
+		collective_done(carg, stream);
+	}
+}
 
-	for (i = 1; i < aggregator->at_xs_nr + 1; i++) {
-		stream = (struct dss_stream_arg_type *)arg[i];
-		if (stream->st_rc != 0) {
-			if (aggregator->at_rc == 0)
-				aggregator->at_rc = stream->st_rc;
-			(*nfailed)++;
-		}
+/* Run on the group leader: fan out to the group, then run its own share */
+static void
+collective_grp_func(void *varg)
+{
+	struct collective_grp_arg	*garg = varg;
+	struct collective_arg		*carg = garg->cga_carg;
+	struct dss_stream_arg_type	*stream;
+	int				 start;
+	int				 end;
+	int				 i;
+	int				 rc;
 
-		/** optional custom aggregator call provided across streams */
-		if (aggregator->at_reduce)
-			aggregator->at_reduce(aggregator->at_args.st_arg,
-					      stream->st_arg);
+	start = xstream_data.xd_coll_grps[garg->cga_grp];
+	end = xstream_data.xd_coll_grps[garg->cga_grp + 1];
+	for (i = start + 1; i < end; i++) {
+		stream = &carg->ca_streams[xstream_data.xd_coll_tids[i]];
+		rc = collective_create(carg, xstream_data.xd_coll_tids[i],
+				       collective_func, stream);
+		if (rc != 0) {
+			stream->st_rc = rc;
+			collective_done(carg, stream);
+		}
 	}
+
+	collective_func(&carg->ca_streams[xstream_data.xd_coll_tids[start]]);
 }
 
 static int
@@ -1090,14 +1440,14 @@ dss_collective_reduce_internal(struct dss_coll_ops *ops,
 			       int flag)
 {
 	struct collective_arg		carg;
+	struct collective_grp_arg	*gargs;
 	struct dss_coll_stream_args	*stream_args;
 	struct dss_stream_arg_type	*stream;
-	struct aggregator_arg_type	aggregator;
-	struct dss_xstream		*dx;
-	ABT_future			future;
+	int				grp_nr;
 	int				xs_nr;
 	int				rc;
 	int				tid;
+	int				i;
 
 	if (ops == NULL || args == NULL || ops->co_func == NULL) {
 		D_DEBUG(DB_MD, "mandatory args mising dss_collective_reduce");
@@ -1110,77 +1460,72 @@ dss_collective_reduce_internal(struct dss_coll_ops *ops,
 		return -DER_INVAL;
 	}
 
-	if (dss_tgt_nr == 0) {
+	if (dss_tgt_nr == 0 || xstream_data.xd_coll_grp_nr == 0) {
 		/* May happen when the server is shutting down. */
 		D_DEBUG(DB_TRACE, "no xstreams\n");
 		return -DER_CANCELED;
 	}
 
 	xs_nr = dss_tgt_nr;
+	grp_nr = xstream_data.xd_coll_grp_nr;
 	stream_args = &args->ca_stream_args;
-	D_ALLOC_ARRAY(stream_args->csa_streams, xs_nr);
+	/* one allocation for the arguments of all xstreams and groups */
+	D_ALLOC(stream_args->csa_streams,
+		xs_nr * sizeof(*stream) + grp_nr * sizeof(*gargs));
 	if (stream_args->csa_streams == NULL)
 		return -DER_NOMEM;
+	gargs = (struct collective_grp_arg *)&stream_args->csa_streams[xs_nr];
 
-	/*
-	 * Use the first, extra element of the value array to store the number
-	 * of failed tasks.
-	 */
-	rc = ABT_future_create(xs_nr + 1, collective_reduce, &future);
+	rc = ABT_eventual_create(0, &carg.ca_eventual);
 	if (rc != ABT_SUCCESS)
 		D_GOTO(out_streams, rc = dss_abterr2der(rc));
 
-	carg.ca_future.dfa_future = future;
-	carg.ca_future.dfa_func	= ops->co_func;
-	carg.ca_future.dfa_arg	= args->ca_func_args;
-	carg.ca_future.dfa_status = 0;
-
-	memset(&aggregator, 0, sizeof(aggregator));
-	aggregator.at_xs_nr = xs_nr;
-	if (ops->co_reduce) {
-		aggregator.at_args.st_arg = args->ca_aggregator;
-		aggregator.at_reduce	  = ops->co_reduce;
-	}
+	carg.ca_func	 = ops->co_func;
+	carg.ca_func_arg = args->ca_func_args;
+	carg.ca_streams	 = stream_args->csa_streams;
+	carg.ca_thread	 = create_ult;
+	carg.ca_pool_idx = (flag & DSS_COLL_FL_AGGREGATE) ?
+			   DSS_POOL_AGGREGATE : DSS_POOL_SHARE;
+	carg.ca_pending	 = xs_nr;
+	carg.ca_nfailed	 = 0;
+	carg.ca_rc	 = 0;
 
 	if (ops->co_reduce_arg_alloc)
 		for (tid = 0; tid < xs_nr; tid++) {
 			stream = &stream_args->csa_streams[tid];
 			rc = ops->co_reduce_arg_alloc(stream,
-						     aggregator.at_args.st_arg);
+						      args->ca_aggregator);
 			if (rc)
-				D_GOTO(out_future, rc);
+				D_GOTO(out_eventual, rc);
 		}
 
-	rc = ABT_future_set(future, (void *)&aggregator);
-	D_ASSERTF(rc == ABT_SUCCESS, "%d\n", rc);
-
-	for (tid = 0; tid < xs_nr; tid++) {
-		stream			= &stream_args->csa_streams[tid];
-		stream->st_coll_args	= &carg;
-
-		dx = dss_xstream_get(DSS_MAIN_XS_ID(tid));
-		if (create_ult)
-			rc = ABT_thread_create(dx->dx_pools[DSS_POOL_SHARE],
-					       collective_func, stream,
-					       ABT_THREAD_ATTR_NULL, NULL);
-		else
-			rc = ABT_task_create(dx->dx_pools[DSS_POOL_SHARE],
-					     collective_func, stream, NULL);
+	for (tid = 0; tid < xs_nr; tid++)
+		stream_args->csa_streams[tid].st_coll_args = &carg;
 
-		if (rc != ABT_SUCCESS) {
-			aggregator.at_args.st_rc = dss_abterr2der(rc);
-			rc = ABT_future_set(future,
-					    (void *)&aggregator);
-			D_ASSERTF(rc == ABT_SUCCESS, "%d\n", rc);
-		}
+	for (i = 0; i < grp_nr; i++) {
+		/* the first target of the group is the leader */
+		tid = xstream_data.xd_coll_tids[xstream_data.xd_coll_grps[i]];
+		gargs[i].cga_carg = &carg;
+		gargs[i].cga_grp = i;
+		rc = collective_create(&carg, tid, collective_grp_func,
+				       &gargs[i]);
+		if (rc != 0)
+			collective_grp_fail(&carg, i, rc);
 	}
 
-	ABT_future_wait(future);
+	ABT_eventual_wait(carg.ca_eventual, NULL);
+
+	if (ops->co_reduce)
+		for (tid = 0; tid < xs_nr; tid++)
+			ops->co_reduce(args->ca_aggregator,
+				       stream_args->csa_streams[tid].st_arg);
 
-	rc = aggregator.at_rc;
+	D_DEBUG(DB_TRACE, "%d of %d xstreams failed\n", carg.ca_nfailed,
+		xs_nr);
+	rc = carg.ca_rc;
 
-out_future:
-	ABT_future_free(&future);
+out_eventual:
+	ABT_eventual_free(&carg.ca_eventual);
 
 	if (ops->co_reduce_arg_free)
 		for (tid = 0; tid < xs_nr; tid++)
@@ -1203,7 +1548,7 @@ out_streams:
  *				server xstreams.
  * \param[in] args		All arguments required for dss_collective
  *				including func args.
- * \param[in] flag		collective flag, reserved for future usage.
+ * \param[in] flag		collective flag, DSS_COLL_FL_*.
  *
  * \return			number of failed xstreams or error code
  */
@@ -1225,7 +1570,7 @@ dss_task_collective_reduce(struct dss_coll_ops *ops,
  *				server xstreams.
  * \param[in] args		All arguments required for dss_collective
  *				including func args.
- * \param[in] flag		collective flag, reserved for future usage.
+ * \param[in] flag		collective flag, DSS_COLL_FL_*.
  *
  * \return			number of failed xstreams or error code
  */
@@ -1324,7 +1669,7 @@ dss_acc_offload(struct dss_acc_task *at_args)
  *
  * \param[in] func	function to be executed
  * \param[in] arg	argument to be passed to \a func
- * \param[in] flag	collective flag, reserved for future usage.
+ * \param[in] flag	collective flag, DSS_COLL_FL_*.
  *
  * \return		number of failed xstreams or error code
  */
@@ -1340,7 +1685,7 @@ dss_task_collective(int (*func)(void *), void *arg, int flag)
  *
  * \param[in] func	function to be executed
  * \param[in] arg	argument to be passed to \a func
- * \param[in] flag	collective flag, reserved for future usage.
+ * \param[in] flag	collective flag, DSS_COLL_FL_*.
  *
  * \return		number of failed xstreams or error code
  */
@@ -1525,6 +1870,7 @@ dss_parameters_set(unsigned int key_id, uint64_t value)
 		break;
 	case DSS_KEY_FAIL_NUM:
 		daos_fail_num_set(value);
+		break;
 	case DSS_REBUILD_RES_PERCENTAGE:
 		if (value >= 100) {
 			D_ERROR("invalid value "DF_U64"\n", value);
@@ -1534,6 +1880,58 @@ dss_parameters_set(unsigned int key_id, uint64_t value)
 		D_WARN("set rebuild percentage to "DF_U64"\n", value);
 		dss_rebuild_res_percentage = value;
 		break;
+	case DSS_SCHED_IO_WEIGHT:
+	case DSS_SCHED_META_WEIGHT:
+	case DSS_SCHED_AGG_WEIGHT:
+		if (value >= 100) {
+			D_ERROR("invalid value "DF_U64"\n", value);
+			rc = -DER_INVAL;
+			break;
+		}
+		D_WARN("set scheduling weight %u to "DF_U64"\n", key_id,
+		       value);
+		if (key_id == DSS_SCHED_IO_WEIGHT)
+			dss_sched_weights[DSS_POOL_PRIV] = value;
+		else if (key_id == DSS_SCHED_META_WEIGHT)
+			dss_sched_weights[DSS_POOL_SHARE] = value;
+		else
+			dss_sched_weights[DSS_POOL_AGGREGATE] = value;
+		break;
+	case DSS_SCHED_LAT_BUDGET:
+		if (value > UINT32_MAX) {
+			D_ERROR("invalid value "DF_U64"\n", value);
+			rc = -DER_INVAL;
+			break;
+		}
+		D_WARN("set I/O latency budget to "DF_U64" us\n", value);
+		dss_sched_lat_budget = value;
+		break;
+	case DSS_REBUILD_PULL_DEPTH:
+		if (value == 0 || value > DSS_REBUILD_PULL_DEPTH_MAX) {
+			D_ERROR("invalid value "DF_U64"\n", value);
+			rc = -DER_INVAL;
+			break;
+		}
+		D_WARN("set rebuild pull depth to "DF_U64"\n", value);
+		dss_rebuild_pull_depth = value;
+		break;
+	case DSS_REBUILD_BANDWIDTH:
+	case DSS_REBUILD_LAT_TARGET:
+		if (value > UINT32_MAX) {
+			D_ERROR("invalid value "DF_U64"\n", value);
+			rc = -DER_INVAL;
+			break;
+		}
+		if (key_id == DSS_REBUILD_BANDWIDTH) {
+			D_WARN("set rebuild bandwidth to "DF_U64" MB/s\n",
+			       value);
+			dss_rebuild_bandwidth = value;
+		} else {
+			D_WARN("set rebuild latency target to "DF_U64" us\n",
+			       value);
+			dss_rebuild_lat_target = value;
+		}
+		break;
 	default:
 		D_ERROR("invalid key_id %d\n", key_id);
 		rc = -DER_INVAL;
@@ -1568,6 +1966,7 @@ dss_srv_fini(bool force)
 		/* fall through */
 	case XD_INIT_XSTREAMS:
 		dss_xstreams_fini(force);
+		dss_coll_groups_fini();
 		/* fall through */
 	case XD_INIT_NVME:
 		bio_nvme_fini();
@@ -1712,7 +2111,7 @@ dss_dump_ABT_state()
 				rc, dx, dx->dx_xstream, dx->dx_sched);
 
 		/* only DSS_POOL_CNT (DSS_POOL_PRIV/DSS_POOL_SHARE/
-		 * DSS_POOL_REBUILD) per sched/xstream
+		 * DSS_POOL_REBUILD/DSS_POOL_AGGREGATE) per sched/xstream
 		 */
 		rc = ABT_sched_get_num_pools(dx->dx_sched, &num_pools);
 		if (rc != ABT_SUCCESS) {
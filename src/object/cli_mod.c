@@ -33,6 +33,36 @@
 #include "obj_internal.h"
 
 bool	srv_io_dispatch = true;
+bool	cli_enum_parallel = true;
+unsigned int	cli_rpc_eager_size = OBJ_RPC_EAGER_SIZE;
+
+/**
+ * Pick the eager message size of the fabric. cart doesn't report the
+ * unexpected message size of the provider, so it can't be derived from the
+ * provider in use: it is taken from DAOS_RPC_EAGER_SIZE, which should match
+ * the unexpected message size configured for the provider on both client and
+ * servers. I/O is sent inline when its data fits in this size minus the RPC
+ * headers and the encoded dkey, iods and recxs, see obj_shard_rw().
+ */
+static void
+obj_rpc_eager_size_init(void)
+{
+	unsigned int	size = OBJ_RPC_EAGER_SIZE;
+
+	d_getenv_int("DAOS_RPC_EAGER_SIZE", &size);
+	if (size < OBJ_RPC_EAGER_SIZE) {
+		D_WARN("Eager size %u is too small, use %u\n", size,
+		       OBJ_RPC_EAGER_SIZE);
+		size = OBJ_RPC_EAGER_SIZE;
+	} else if (size > OBJ_RPC_EAGER_SIZE_MAX) {
+		D_WARN("Eager size %u is too large, use %u\n", size,
+		       OBJ_RPC_EAGER_SIZE_MAX);
+		size = OBJ_RPC_EAGER_SIZE_MAX;
+	}
+
+	cli_rpc_eager_size = size;
+	D_DEBUG(DB_IO, "RPC eager size %u\n", cli_rpc_eager_size);
+}
 
 /**
  * Initialize object interface
@@ -48,6 +78,12 @@ dc_obj_init(void)
 	else
 		D_DEBUG(DB_IO, "Server IO dispatch disabled.\n");
 
+	d_getenv_bool("DAOS_ENUM_PARALLEL", &cli_enum_parallel);
+	D_DEBUG(DB_IO, "Parallel dkey enumeration %s.\n",
+		cli_enum_parallel ? "enabled" : "disabled");
+
+	obj_rpc_eager_size_init();
+
 	rc = daos_rpc_register(&obj_proto_fmt, OBJ_PROTO_CLI_COUNT,
 				NULL, DAOS_OBJ_MODULE);
 	if (rc != 0)
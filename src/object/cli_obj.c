@@ -127,13 +127,92 @@ obj_layout_free(struct dc_object *obj)
 	obj->cob_shards = NULL;
 }
 
+/**
+ * Batch of dkeys prefetched from one redundancy group in a dkey enumeration.
+ *
+ * A batch is fetched from a cursor of the group, i.e. the shard and anchor
+ * that the user anchor holds when the caller reaches that point, and is only
+ * handed out as a whole to the call made with the same cursor. The user
+ * anchor is therefore always a cursor of the serial enumeration, whatever
+ * happens to the prefetched batches.
+ */
+struct obj_enum_grp {
+	/** cursor the batch is fetched from */
+	daos_anchor_t		 eg_start;
+	/** cursor after the batch */
+	daos_anchor_t		 eg_anchor;
+	daos_epoch_t		 eg_epoch;
+	/** fetched key descriptors */
+	daos_key_desc_t		*eg_kds;
+	uint32_t		 eg_kds_cap;
+	/** in/out key number of the fetch */
+	uint32_t		 eg_nr;
+	/** fetched keys */
+	d_iov_t			 eg_iov;
+	d_sg_list_t		 eg_sgl;
+	/** in-flight fetch of the group */
+	tse_task_t		*eg_task;
+	/** result of the fetch, and pool map version it replied */
+	int			 eg_rc;
+	unsigned int		 eg_map_ver;
+	/** a batch is fetched or being fetched, cleared once handed out */
+	bool			 eg_valid;
+	/** the first batch of the group has been prefetched */
+	bool			 eg_started;
+};
+
+/**
+ * Prefetch context of a dkey enumeration. The per-group anchors are as large
+ * as daos_anchor_t itself and can't be packed in the user anchor, so it only
+ * carries the ID of this context in da_padding. A context which has been
+ * recycled, or lost by closing the object, only costs the prefetched batches:
+ * the enumeration goes on from the cursor in the user anchor.
+ */
+struct obj_enum_ctx {
+	/** link on dc_object::cob_enum_ctxs */
+	d_list_t		 ec_link;
+	uint32_t		 ec_id;
+	/** calls running on the context + in-flight group fetches */
+	uint32_t		 ec_ref;
+	uint32_t		 ec_grp_nr;
+	/** parameters of the last call, used by prefetch */
+	daos_epoch_t		 ec_epoch;
+	uint32_t		 ec_kds_nr;
+	daos_size_t		 ec_buf_size;
+	struct obj_enum_grp	 ec_grps[0];
+};
+
+/** cached enumeration contexts per object */
+#define OBJ_ENUM_CTX_MAX	8
+
+static void
+obj_enum_ctx_free(struct obj_enum_ctx *ctx)
+{
+	int	i;
+
+	D_ASSERT(ctx->ec_ref == 0);
+	for (i = 0; i < ctx->ec_grp_nr; i++) {
+		D_FREE(ctx->ec_grps[i].eg_kds);
+		D_FREE(ctx->ec_grps[i].eg_iov.iov_buf);
+	}
+	D_FREE(ctx);
+}
+
 static void
 obj_free(struct d_hlink *hlink)
 {
-	struct dc_object *obj;
+	struct dc_object	*obj;
+	struct obj_enum_ctx	*ctx;
+	struct obj_enum_ctx	*tmp;
 
 	obj = container_of(hlink, struct dc_object, cob_hlink);
 	D_ASSERT(daos_hhash_link_empty(&obj->cob_hlink));
+	/* in-flight fetches hold a refcount on the object */
+	d_list_for_each_entry_safe(ctx, tmp, &obj->cob_enum_ctxs, ec_link) {
+		d_list_del(&ctx->ec_link);
+		obj_enum_ctx_free(ctx);
+	}
+	D_MUTEX_DESTROY(&obj->cob_enum_lock);
 	obj_layout_free(obj);
 	D_SPIN_DESTROY(&obj->cob_spin);
 	D_RWLOCK_DESTROY(&obj->cob_lock);
@@ -154,6 +233,7 @@ obj_alloc(void)
 		return NULL;
 
 	daos_hhash_hlink_init(&obj->cob_hlink, &obj_h_ops);
+	D_INIT_LIST_HEAD(&obj->cob_enum_ctxs);
 	return obj;
 }
 
@@ -237,10 +317,10 @@ obj_layout_create(struct dc_object *obj)
 		D_GOTO(out, rc = -DER_INVAL);
 	}
 
-	rc = pl_obj_place(map, &obj->cob_md, NULL, &layout);
-	pl_map_decref(map);
+	rc = pl_obj_layout_get(map, &obj->cob_md, &layout);
 	if (rc != 0) {
 		D_DEBUG(DB_PL, "Failed to generate object layout\n");
+		pl_map_decref(map);
 		D_GOTO(out, rc);
 	}
 	D_DEBUG(DB_PL, "Place object on %d targets ver %d\n", layout->ol_nr,
@@ -263,8 +343,11 @@ obj_layout_create(struct dc_object *obj)
 		obj_shard->do_rebuilding = layout->ol_shards[i].po_rebuilding;
 	}
 out:
-	if (layout)
-		pl_obj_layout_free(layout);
+	if (layout) {
+		/* a cached layout lives as long as the placement map */
+		pl_obj_layout_put(layout);
+		pl_map_decref(map);
+	}
 	return rc;
 }
 
@@ -661,6 +744,10 @@ dc_obj_open(tse_task_t *task)
 	if (rc != 0)
 		D_GOTO(out, rc);
 
+	rc = D_MUTEX_INIT(&obj->cob_enum_lock, NULL);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
 	/* it is a local operation for now, does not require event */
 	rc = dc_obj_fetch_md(args->oid, &obj->cob_md);
 	if (rc != 0)
@@ -846,8 +933,14 @@ dc_obj_layout_refresh(daos_handle_t oh)
 	return 0;
 }
 
+/**
+ * Retry the object task \a task. The pool map is refreshed first if
+ * \a map_refresh is true, and the retry waits for \a delay (in us) if it
+ * is not zero.
+ */
 static int
-obj_retry_cb(tse_task_t *task, struct dc_object *obj, bool io_retry)
+obj_retry_cb(tse_task_t *task, struct dc_object *obj, bool io_retry,
+	     bool map_refresh, uint64_t delay)
 {
 	tse_sched_t	 *sched = tse_task2sched(task);
 	tse_task_t	 *pool_task = NULL;
@@ -859,30 +952,38 @@ obj_retry_cb(tse_task_t *task, struct dc_object *obj, bool io_retry)
 		return result;
 
 	/* Add pool map update task */
-	rc = obj_pool_query_task(sched, obj, &pool_task);
-	if (rc != 0)
-		D_GOTO(err, rc);
+	if (map_refresh) {
+		rc = obj_pool_query_task(sched, obj, &pool_task);
+		if (rc != 0)
+			D_GOTO(err, rc);
+	}
 
 	if (io_retry) {
 		/* Let's reset task result before retry */
-		rc = dc_task_resched(task);
+		if (delay != 0)
+			rc = dc_task_resched_delay(task, delay);
+		else
+			rc = dc_task_resched(task);
 		if (rc != 0) {
 			D_ERROR("Failed to re-init task (%p)\n", task);
 			D_GOTO(err, rc);
 		}
 
-		rc = dc_task_depend(task, 1, &pool_task);
-		if (rc != 0) {
-			D_ERROR("Failed to add dependency on pool "
-				 "query task (%p)\n", pool_task);
-			D_GOTO(err, rc);
+		if (pool_task != NULL) {
+			rc = dc_task_depend(task, 1, &pool_task);
+			if (rc != 0) {
+				D_ERROR("Failed to add dependency on pool "
+					 "query task (%p)\n", pool_task);
+				D_GOTO(err, rc);
+			}
 		}
 	}
 
-	D_DEBUG(DB_IO, "Retrying task=%p for err=%d, io_retry=%d\n",
-		 task, result, io_retry);
+	D_DEBUG(DB_IO, "Retrying task=%p for err=%d, io_retry=%d, delay="
+		DF_U64"\n", task, result, io_retry, delay);
 	/* ignore returned value, error is reported by comp_cb */
-	dc_task_schedule(pool_task, io_retry);
+	if (pool_task != NULL)
+		dc_task_schedule(pool_task, io_retry);
 
 	return 0;
 err:
@@ -901,8 +1002,16 @@ struct obj_auxi_args {
 	uint32_t			 map_ver_req;
 	uint32_t			 map_ver_reply;
 	uint32_t			 io_retry:1,
-					 shard_task_scheded:1;
+					 shard_task_scheded:1,
+					 /* a shard got -DER_BUSY */
+					 io_busy:1,
+					 /* a shard got another retry error */
+					 map_refresh:1,
+					 /* served from a prefetched batch */
+					 enum_hit:1;
 	int				 result;
+	/* number of -DER_BUSY retries in a row */
+	uint32_t			 busy_cnt;
 	d_list_t			 shard_task_head;
 	tse_task_t			*obj_task;
 	struct daos_obj_shard_tgt	*fw_shard_tgts;
@@ -925,8 +1034,16 @@ struct obj_list_arg {
 	daos_anchor_t		*anchor;	/* anchor for record */
 	daos_anchor_t		*dkey_anchor;	/* anchor for dkey */
 	daos_anchor_t		*akey_anchor;	/* anchor for akey */
+	/* dkey enumeration with prefetch only */
+	struct obj_enum_ctx	*ctx;
+	uint32_t		*nr;
+	daos_key_desc_t		*kds;
+	daos_sg_list_t		*sgl;
 };
 
+static void obj_list_dkey_ctx_cb(tse_task_t *task, struct obj_list_arg *arg,
+				 struct obj_auxi_args *obj_auxi);
+
 struct shard_update_args {
 	struct shard_auxi_args	 auxi;
 	daos_epoch_t		 epoch;
@@ -957,6 +1074,10 @@ shard_result_process(tse_task_t *task, void *arg)
 	} else if (obj_retry_error(ret)) {
 		D_DEBUG(DB_IO, "shard %d ret %d.\n", shard_auxi->shard, ret);
 		obj_auxi->io_retry = 1;
+		if (ret == -DER_BUSY)
+			obj_auxi->io_busy = 1;
+		else
+			obj_auxi->map_refresh = 1;
 	} else {
 		/* for un-retryable failure, set the err to whole obj IO */
 		D_DEBUG(DB_IO, "shard %d ret %d.\n", shard_auxi->shard, ret);
@@ -1002,6 +1123,30 @@ obj_list_dkey_cb(tse_task_t *task, struct obj_list_arg *arg, unsigned int opc)
 	}
 }
 
+/* backoff of the first -DER_BUSY retry in us, doubled on each retry */
+#define OBJ_BUSY_DELAY_MIN	1000
+/* at most 1000 << 10 us, about 1 second */
+#define OBJ_BUSY_DELAY_SHIFT	10
+
+/**
+ * Return the backoff before retrying an I/O rejected with -DER_BUSY by the
+ * admission control of the server, see dss_xstream_is_busy(). It grows
+ * exponentially with the retries in a row, and is jittered so that clients
+ * backing off at the same time don't retry at the same time.
+ */
+static uint64_t
+obj_busy_delay(struct obj_auxi_args *obj_auxi)
+{
+	uint64_t	delay;
+
+	delay = OBJ_BUSY_DELAY_MIN << min(obj_auxi->busy_cnt,
+					  OBJ_BUSY_DELAY_SHIFT);
+	if (obj_auxi->busy_cnt < OBJ_BUSY_DELAY_SHIFT)
+		obj_auxi->busy_cnt++;
+
+	return delay / 2 + random() % (delay / 2);
+}
+
 static int
 obj_comp_cb(tse_task_t *task, void *data)
 {
@@ -1011,13 +1156,18 @@ obj_comp_cb(tse_task_t *task, void *data)
 	d_list_t		*head = NULL;
 	bool			 pm_stale = false;
 	bool			 io_retry = false;
+	bool			 map_refresh;
+	uint64_t		 delay = 0;
 
 	obj_auxi = tse_task_stack_pop(task, sizeof(*obj_auxi));
 	switch (obj_auxi->opc) {
 	case DAOS_OBJ_DKEY_RPC_ENUMERATE:
 		arg = data;
 		obj = arg->obj;
-		obj_list_dkey_cb(task, arg, obj_auxi->opc);
+		if (arg->ctx != NULL)
+			obj_list_dkey_ctx_cb(task, arg, obj_auxi);
+		else
+			obj_list_dkey_cb(task, arg, obj_auxi->opc);
 		break;
 	case DAOS_OBJ_RPC_ENUMERATE:
 		arg = data;
@@ -1053,6 +1203,8 @@ obj_comp_cb(tse_task_t *task, void *data)
 		D_ASSERT(!d_list_empty(head));
 		obj_auxi->result = 0;
 		obj_auxi->io_retry = 0;
+		obj_auxi->io_busy = 0;
+		obj_auxi->map_refresh = 0;
 		tse_task_list_traverse(head, shard_result_process, obj_auxi);
 		/* for stale pm version, retry the obj IO at there will check
 		 * if need to retry shard IO.
@@ -1074,9 +1226,25 @@ obj_comp_cb(tse_task_t *task, void *data)
 	if (obj_retry_error(task->dt_result) || obj_auxi->io_retry)
 		io_retry = true;
 
+	/*
+	 * A busy target needs time rather than a new pool map, only refresh
+	 * the map for other errors.
+	 */
+	map_refresh = pm_stale || obj_auxi->map_refresh ||
+		      (obj_retry_error(task->dt_result) &&
+		       task->dt_result != -DER_BUSY);
+	if (task->dt_result == -DER_BUSY || obj_auxi->io_busy)
+		delay = obj_busy_delay(obj_auxi);
+	else
+		obj_auxi->busy_cnt = 0;
+	obj_auxi->io_busy = 0;
+	obj_auxi->map_refresh = 0;
+
 	if (pm_stale || io_retry)
-		obj_retry_cb(task, obj, io_retry);
-	else if (task->dt_result == 0)
+		obj_retry_cb(task, obj, io_retry, map_refresh, delay);
+
+	/* a stale map alone doesn't retry, keep the error of this round */
+	if (!io_retry && task->dt_result == 0)
 		task->dt_result = obj_auxi->result;
 
 	if (!io_retry) {
@@ -1520,9 +1688,463 @@ out_task:
 	return rc;
 }
 
+struct shard_list_args {
+	struct shard_auxi_args	 la_auxi;
+	struct obj_enum_ctx	*la_ctx;
+	struct obj_enum_grp	*la_grp;
+	daos_epoch_t		 la_epoch;
+};
+
+static int
+shard_list_task(tse_task_t *task)
+{
+	struct shard_list_args	*args;
+	struct obj_enum_grp	*grp;
+	struct dc_obj_shard	*obj_shard;
+	int			 rc;
+
+	args = tse_task_buf_embedded(task, sizeof(*args));
+	grp = args->la_grp;
+
+	rc = obj_shard_open(args->la_auxi.obj, args->la_auxi.shard,
+			    args->la_auxi.map_ver, &obj_shard);
+	if (rc != 0) {
+		tse_task_complete(task, rc);
+		return rc;
+	}
+
+	rc = dc_obj_shard_list(obj_shard, DAOS_OBJ_DKEY_RPC_ENUMERATE,
+			       args->la_epoch, 0, NULL, NULL, DAOS_IOD_NONE,
+			       NULL, &grp->eg_nr, grp->eg_kds, &grp->eg_sgl,
+			       NULL, NULL, NULL, &grp->eg_anchor, NULL,
+			       &args->la_auxi.map_ver, task);
+
+	obj_shard_close(obj_shard);
+	return rc;
+}
+
+static int
+shard_list_comp_cb(tse_task_t *task, void *data)
+{
+	struct shard_list_args	*args = *((struct shard_list_args **)data);
+	struct dc_object	*obj = args->la_auxi.obj;
+	struct obj_enum_grp	*grp = args->la_grp;
+
+	D_MUTEX_LOCK(&obj->cob_enum_lock);
+	grp->eg_rc = task->dt_result;
+	grp->eg_map_ver = args->la_auxi.map_ver;
+	D_DEBUG(DB_IO, "shard %u prefetched %u keys: rc %d\n",
+		args->la_auxi.shard, grp->eg_nr, task->dt_result);
+
+	D_ASSERT(grp->eg_task == task);
+	grp->eg_task = NULL;
+	D_ASSERT(args->la_ctx->ec_ref > 0);
+	args->la_ctx->ec_ref--;
+	D_MUTEX_UNLOCK(&obj->cob_enum_lock);
+
+	obj_decref(obj);
+	return 0;
+}
+
+static inline uint32_t
+obj_anchor2grp(struct dc_object *obj, daos_anchor_t *anchor)
+{
+	return dc_obj_anchor2shard(anchor) / obj_get_grp_size(obj);
+}
+
+/**
+ * Create the task prefetching the batch of group \a grp_idx at \a cursor.
+ * The task isn't scheduled, caller should schedule it after releasing
+ * cob_enum_lock.
+ */
+static int
+obj_enum_grp_fetch(struct dc_object *obj, struct obj_enum_ctx *ctx,
+		   uint32_t grp_idx, daos_anchor_t *cursor,
+		   unsigned int map_ver, tse_sched_t *sched, tse_task_t **taskp)
+{
+	struct obj_enum_grp	*grp = &ctx->ec_grps[grp_idx];
+	struct shard_list_args	*args;
+	tse_task_t		*task;
+	int			 shard;
+	int			 rc;
+
+	D_ASSERT(grp->eg_task == NULL);
+	if (grp->eg_kds_cap < ctx->ec_kds_nr) {
+		D_FREE(grp->eg_kds);
+		grp->eg_kds_cap = 0;
+		D_ALLOC_ARRAY(grp->eg_kds, ctx->ec_kds_nr);
+		if (grp->eg_kds == NULL)
+			return -DER_NOMEM;
+		grp->eg_kds_cap = ctx->ec_kds_nr;
+	}
+
+	if (grp->eg_iov.iov_buf_len < ctx->ec_buf_size) {
+		D_FREE(grp->eg_iov.iov_buf);
+		grp->eg_iov.iov_buf_len = 0;
+		D_ALLOC(grp->eg_iov.iov_buf, ctx->ec_buf_size);
+		if (grp->eg_iov.iov_buf == NULL)
+			return -DER_NOMEM;
+		grp->eg_iov.iov_buf_len = ctx->ec_buf_size;
+	}
+
+	/* same shard selection as the serial enumeration */
+	shard = obj_grp_valid_shard_get(obj, dc_obj_anchor2shard(cursor),
+					map_ver, DAOS_OBJ_DKEY_RPC_ENUMERATE);
+	if (shard < 0)
+		return shard;
+
+	rc = tse_task_create(shard_list_task, sched, NULL, &task);
+	if (rc != 0)
+		return rc;
+
+	args = tse_task_buf_embedded(task, sizeof(*args));
+	args->la_auxi.obj	= obj;
+	args->la_auxi.shard	= shard;
+	args->la_auxi.target	= obj_shard2tgtid(obj, shard);
+	args->la_auxi.map_ver	= map_ver;
+	args->la_ctx		= ctx;
+	args->la_grp		= grp;
+	args->la_epoch		= ctx->ec_epoch;
+
+	rc = tse_task_register_comp_cb(task, shard_list_comp_cb, &args,
+				       sizeof(args));
+	if (rc != 0) {
+		tse_task_complete(task, rc);
+		return rc;
+	}
+
+	enum_anchor_copy(&grp->eg_start, cursor);
+	enum_anchor_copy(&grp->eg_anchor, cursor);
+	dc_obj_shard2anchor(&grp->eg_anchor, shard);
+	grp->eg_epoch		= ctx->ec_epoch;
+	grp->eg_nr		= ctx->ec_kds_nr;
+	grp->eg_iov.iov_len	= 0;
+	grp->eg_sgl.sg_nr_out	= 0;
+	grp->eg_rc		= 0;
+	grp->eg_valid		= true;
+	grp->eg_started		= true;
+	grp->eg_task		= task;
+	ctx->ec_ref++;
+	/* released by shard_list_comp_cb */
+	obj_addref(obj);
+
+	*taskp = task;
+	return 0;
+}
+
+/** Check if the batch of \a grp answers a call at \a cursor */
+static bool
+obj_enum_grp_match(struct dc_object *obj, struct obj_enum_grp *grp,
+		   daos_anchor_t *cursor, daos_epoch_t epoch)
+{
+	if (!grp->eg_valid || grp->eg_epoch != epoch ||
+	    grp->eg_start.da_type != cursor->da_type ||
+	    obj_anchor2grp(obj, &grp->eg_start) != obj_anchor2grp(obj, cursor))
+		return false;
+
+	return daos_anchor_is_zero(cursor) ||
+	       memcmp(grp->eg_start.da_buf, cursor->da_buf,
+		      sizeof(cursor->da_buf)) == 0;
+}
+
+/**
+ * Prefetch the first batch of the groups after the one at \a cursor, and the
+ * next batch of the group at \a cursor if \a cur is true. The tasks are added
+ * to \a head, caller should schedule them after releasing cob_enum_lock.
+ */
+static void
+obj_enum_prefetch(struct dc_object *obj, struct obj_enum_ctx *ctx,
+		  daos_anchor_t *cursor, bool cur, unsigned int map_ver,
+		  tse_sched_t *sched, d_list_t *head)
+{
+	daos_anchor_t	 start;
+	uint32_t	 grp_idx;
+	int		 i;
+	int		 rc;
+
+	if (daos_anchor_is_eof(cursor))
+		return;
+
+	grp_idx = obj_anchor2grp(obj, cursor);
+	for (i = grp_idx; i < ctx->ec_grp_nr; i++) {
+		struct obj_enum_grp	*grp = &ctx->ec_grps[i];
+		daos_anchor_t		*at = cursor;
+		tse_task_t		*task;
+
+		if (grp->eg_task != NULL)
+			continue;
+
+		if (i == grp_idx) {
+			if (!cur || obj_enum_grp_match(obj, grp, cursor,
+						       ctx->ec_epoch))
+				continue;
+		} else {
+			if (grp->eg_started)
+				continue;
+			memset(&start, 0, sizeof(start));
+			daos_anchor_set_zero(&start);
+			dc_obj_shard2anchor(&start,
+					    i * obj_get_grp_size(obj));
+			start.da_padding = ctx->ec_id;
+			at = &start;
+		}
+
+		rc = obj_enum_grp_fetch(obj, ctx, i, at, map_ver, sched,
+					&task);
+		if (rc != 0) {
+			/* not fatal, the caller fetches the keys itself */
+			D_DEBUG(DB_IO, "prefetch of group %d failed: %d\n",
+				i, rc);
+			continue;
+		}
+		tse_task_list_add(task, head);
+	}
+}
+
+/**
+ * Find the enumeration context referenced by \a anchor, or create a new one
+ * and point \a anchor to it. NULL is returned if it cannot be allocated, the
+ * enumeration then goes on without prefetch.
+ */
+static struct obj_enum_ctx *
+obj_enum_ctx_get(struct dc_object *obj, daos_anchor_t *anchor)
+{
+	struct obj_enum_ctx	*ctx;
+	struct obj_enum_ctx	*tmp;
+	int			 grp_nr;
+	int			 i;
+
+	grp_nr = obj->cob_shards_nr / obj_get_grp_size(obj);
+
+	D_MUTEX_LOCK(&obj->cob_enum_lock);
+	/* a zero anchor on the first shard starts a new enumeration */
+	if (!daos_anchor_is_zero(anchor) || dc_obj_anchor2shard(anchor) != 0) {
+		d_list_for_each_entry(ctx, &obj->cob_enum_ctxs, ec_link) {
+			if (ctx->ec_id == anchor->da_padding &&
+			    ctx->ec_grp_nr == grp_nr)
+				goto found;
+		}
+		D_DEBUG(DB_IO, "enumeration context %u of "DF_OID" is gone\n",
+			anchor->da_padding, DP_OID(obj->cob_md.omd_id));
+	}
+
+	/* abandoned enumerations are only released on object close, so
+	 * recycle the oldest idle context if there are too many of them.
+	 */
+	if (obj->cob_enum_nr >= OBJ_ENUM_CTX_MAX) {
+		d_list_for_each_entry_safe(ctx, tmp, &obj->cob_enum_ctxs,
+					   ec_link) {
+			if (ctx->ec_ref != 0)
+				continue;
+
+			d_list_del(&ctx->ec_link);
+			obj->cob_enum_nr--;
+			obj_enum_ctx_free(ctx);
+			break;
+		}
+	}
+
+	D_ALLOC(ctx, sizeof(*ctx) + grp_nr * sizeof(ctx->ec_grps[0]));
+	if (ctx == NULL)
+		goto out;
+
+	ctx->ec_id = ++obj->cob_enum_id;
+	ctx->ec_grp_nr = grp_nr;
+	for (i = 0; i < grp_nr; i++) {
+		struct obj_enum_grp *grp = &ctx->ec_grps[i];
+
+		grp->eg_sgl.sg_nr = 1;
+		grp->eg_sgl.sg_iovs = &grp->eg_iov;
+	}
+	d_list_add_tail(&ctx->ec_link, &obj->cob_enum_ctxs);
+	obj->cob_enum_nr++;
+	anchor->da_padding = ctx->ec_id;
+	D_DEBUG(DB_IO, "new enumeration context %u of "DF_OID", grp_nr %d\n",
+		ctx->ec_id, DP_OID(obj->cob_md.omd_id), grp_nr);
+found:
+	ctx->ec_ref++;
+out:
+	D_MUTEX_UNLOCK(&obj->cob_enum_lock);
+	return ctx;
+}
+
+/** Release the reference of a call on \a ctx, with cob_enum_lock held */
+static bool
+obj_enum_ctx_put_locked(struct dc_object *obj, struct obj_enum_ctx *ctx,
+			daos_anchor_t *anchor)
+{
+	D_ASSERT(ctx->ec_ref > 0);
+	ctx->ec_ref--;
+	if (!daos_anchor_is_eof(anchor) || ctx->ec_ref != 0)
+		return false;
+
+	d_list_del(&ctx->ec_link);
+	obj->cob_enum_nr--;
+	return true;
+}
+
+/**
+ * Serve a dkey enumeration call at \a anchor from the batch prefetched by
+ * its group, and prefetch the groups it hasn't reached yet. Return true if
+ * the call is served from the batch, the keys are then handed out by
+ * obj_list_dkey_ctx_cb() once the batch has been fetched.
+ */
+static bool
+obj_list_dkey_prefetched(tse_task_t *task, struct dc_object *obj,
+			 struct obj_enum_ctx *ctx, daos_epoch_t epoch,
+			 uint32_t nr, daos_size_t buf_size,
+			 daos_anchor_t *anchor, unsigned int map_ver,
+			 struct obj_auxi_args *obj_auxi)
+{
+	tse_sched_t		*sched = tse_task2sched(task);
+	struct obj_enum_grp	*grp;
+	d_list_t		 head;
+	uint32_t		 grp_idx;
+	bool			 wait = false;
+	int			 rc;
+
+	grp_idx = obj_anchor2grp(obj, anchor);
+	if (grp_idx >= ctx->ec_grp_nr)
+		return false;
+
+	D_INIT_LIST_HEAD(&head);
+	D_MUTEX_LOCK(&obj->cob_enum_lock);
+	ctx->ec_epoch = epoch;
+	ctx->ec_kds_nr = nr;
+	ctx->ec_buf_size = buf_size;
+
+	grp = &ctx->ec_grps[grp_idx];
+	if (obj_enum_grp_match(obj, grp, anchor, epoch)) {
+		if (grp->eg_task == NULL) {
+			obj_auxi->enum_hit = 1;
+		} else if (tse_task2sched(grp->eg_task) == sched) {
+			/* the task completes with the fetch */
+			rc = tse_task_register_deps(task, 1, &grp->eg_task);
+			if (rc == 0) {
+				obj_auxi->enum_hit = 1;
+				wait = true;
+			}
+		}
+		/* otherwise prefetched by a caller with another scheduler,
+		 * fetch the keys rather than blocking on it.
+		 */
+	}
+	obj_enum_prefetch(obj, ctx, anchor, false, map_ver, sched, &head);
+	D_MUTEX_UNLOCK(&obj->cob_enum_lock);
+
+	tse_task_list_sched(&head, true);
+	if (obj_auxi->enum_hit && !wait)
+		tse_task_complete(task, 0);
+
+	return obj_auxi->enum_hit;
+}
+
+/**
+ * Copy the batch of \a grp to the buffers of the caller and move its anchor
+ * past the batch. Return false if the batch can't be handed out.
+ */
+static bool
+obj_enum_grp_handout(struct obj_enum_grp *grp, struct obj_list_arg *arg)
+{
+	d_iov_t		*iov = &arg->sgl->sg_iovs[0];
+	daos_size_t	 len = 0;
+	int		 i;
+
+	if (!grp->eg_valid || grp->eg_task != NULL || grp->eg_rc != 0 ||
+	    grp->eg_nr > *arg->nr)
+		return false;
+
+	for (i = 0; i < grp->eg_nr; i++)
+		len += grp->eg_kds[i].kd_key_len + grp->eg_kds[i].kd_csum_len;
+	/* the caller buffer shrank since the prefetch */
+	if (len > iov->iov_buf_len)
+		return false;
+
+	memcpy(arg->kds, grp->eg_kds, grp->eg_nr * sizeof(*arg->kds));
+	memcpy(iov->iov_buf, grp->eg_iov.iov_buf, len);
+	iov->iov_len = len;
+	arg->sgl->sg_nr_out = 1;
+	*arg->nr = grp->eg_nr;
+	enum_anchor_copy(arg->dkey_anchor, &grp->eg_anchor);
+	return true;
+}
+
+/**
+ * Completion of a dkey enumeration call with a prefetch context: hand out
+ * the prefetched batch, or move to the next group like the serial
+ * enumeration, then prefetch from the new cursor.
+ */
+static void
+obj_list_dkey_ctx_cb(tse_task_t *task, struct obj_list_arg *arg,
+		     struct obj_auxi_args *obj_auxi)
+{
+	struct dc_object	*obj = arg->obj;
+	struct obj_enum_ctx	*ctx = arg->ctx;
+	daos_anchor_t		*anchor = arg->dkey_anchor;
+	d_list_t		 head;
+	bool			 release;
+
+	D_INIT_LIST_HEAD(&head);
+	D_MUTEX_LOCK(&obj->cob_enum_lock);
+	if (obj_auxi->enum_hit) {
+		struct obj_enum_grp *grp;
+
+		obj_auxi->enum_hit = 0;
+		grp = &ctx->ec_grps[obj_anchor2grp(obj, anchor)];
+		/* a failed prefetch is propagated to the task, ignore it and
+		 * fetch the keys from the cursor instead.
+		 */
+		if (!obj_enum_grp_handout(grp, arg)) {
+			D_DEBUG(DB_IO, "prefetched batch unusable: %d/%d\n",
+				grp->eg_rc, task->dt_result);
+			grp->eg_valid = false;
+			task->dt_result = 0;
+			obj_auxi->io_retry = 1;
+			goto out;
+		}
+		grp->eg_valid = false;
+		task->dt_result = 0;
+		if (obj_auxi->map_ver_reply < grp->eg_map_ver)
+			obj_auxi->map_ver_reply = grp->eg_map_ver;
+	}
+
+	obj_list_dkey_cb(task, arg, obj_auxi->opc);
+	if (task->dt_result != 0)
+		goto out;
+
+	anchor->da_padding = ctx->ec_id;
+	obj_enum_prefetch(obj, ctx, anchor, true, obj_auxi->map_ver_req,
+			  tse_task2sched(task), &head);
+out:
+	release = obj_enum_ctx_put_locked(obj, ctx, anchor);
+	D_MUTEX_UNLOCK(&obj->cob_enum_lock);
+
+	tse_task_list_sched(&head, true);
+	if (release)
+		obj_enum_ctx_free(ctx);
+}
+
+/**
+ * Dkeys of objects with more than one redundancy group are enumerated with
+ * prefetch, keys are packed in a single iov.
+ */
+static bool
+obj_list_dkey_prefetch_ok(struct dc_object *obj, daos_key_desc_t *kds,
+			  daos_sg_list_t *sgl)
+{
+	if (!cli_enum_parallel)
+		return false;
+
+	if (kds == NULL || sgl == NULL || sgl->sg_nr != 1 ||
+	    sgl->sg_iovs == NULL)
+		return false;
+
+	return obj->cob_shards_nr / obj_get_grp_size(obj) > 1;
+}
+
 static int
 dc_obj_list_internal(daos_handle_t oh, uint32_t op, daos_handle_t th,
-		     daos_key_t *dkey, daos_key_t *akey,
+		     daos_epoch_t epoch_lo, daos_key_t *dkey, daos_key_t *akey,
 		     daos_iod_type_t type, daos_size_t *size,
 		     uint32_t *nr, daos_key_desc_t *kds,
 		     daos_sg_list_t *sgl, daos_recx_t *recxs,
@@ -1533,6 +2155,7 @@ dc_obj_list_internal(daos_handle_t oh, uint32_t op, daos_handle_t th,
 	struct dc_object	*obj;
 	struct dc_obj_shard	*obj_shard;
 	struct obj_auxi_args	*obj_auxi;
+	struct obj_enum_ctx	*ctx = NULL;
 	unsigned int		 map_ver;
 	struct obj_list_arg	 list_args;
 	uint64_t		 dkey_hash;
@@ -1554,16 +2177,35 @@ dc_obj_list_internal(daos_handle_t oh, uint32_t op, daos_handle_t th,
 	if (obj == NULL)
 		D_GOTO(out_task, rc = -DER_NO_HDL);
 
+	if (op == DAOS_OBJ_DKEY_RPC_ENUMERATE &&
+	    obj_list_dkey_prefetch_ok(obj, kds, sgl))
+		ctx = obj_enum_ctx_get(obj, dkey_anchor);
+
 	list_args.obj = obj;
 	list_args.anchor = anchor;
 	list_args.dkey_anchor = dkey_anchor;
 	list_args.akey_anchor = akey_anchor;
+	list_args.ctx = ctx;
+	list_args.nr = nr;
+	list_args.kds = kds;
+	list_args.sgl = sgl;
 
 	obj_auxi = tse_task_stack_push(task, sizeof(*obj_auxi));
 	obj_auxi->opc = op;
+	obj_auxi->enum_hit = 0;
 	rc = tse_task_register_comp_cb(task, obj_comp_cb, &list_args,
 				       sizeof(list_args));
 	if (rc != 0) {
+		if (ctx != NULL) {
+			bool release;
+
+			D_MUTEX_LOCK(&obj->cob_enum_lock);
+			release = obj_enum_ctx_put_locked(obj, ctx,
+							  dkey_anchor);
+			D_MUTEX_UNLOCK(&obj->cob_enum_lock);
+			if (release)
+				obj_enum_ctx_free(ctx);
+		}
 		/* NB: process_rc_cb() will release refcount in other cases */
 		obj_decref(obj);
 		D_GOTO(out_task, rc);
@@ -1573,6 +2215,17 @@ dc_obj_list_internal(daos_handle_t oh, uint32_t op, daos_handle_t th,
 	if (rc)
 		D_GOTO(out_task, rc);
 
+	if (ctx != NULL) {
+		obj_auxi->io_retry = 0;
+		obj_auxi->result = 0;
+		obj_auxi->map_ver_req = map_ver;
+		obj_auxi->map_ver_reply = map_ver;
+		if (obj_list_dkey_prefetched(task, obj, ctx, epoch, *nr,
+					     sgl->sg_iovs[0].iov_buf_len,
+					     dkey_anchor, map_ver, obj_auxi))
+			return 0;
+	}
+
 	if (dkey == NULL) {
 		if (op != DAOS_OBJ_DKEY_RPC_ENUMERATE &&
 		    op != DAOS_OBJ_RPC_ENUMERATE) {
@@ -1600,8 +2253,8 @@ dc_obj_list_internal(daos_handle_t oh, uint32_t op, daos_handle_t th,
 
 	obj_auxi->map_ver_req = map_ver;
 	obj_auxi->map_ver_reply = map_ver;
-	rc = dc_obj_shard_list(obj_shard, op, epoch, dkey, akey, type,
-			       size, nr, kds, sgl, recxs, eprs, anchor,
+	rc = dc_obj_shard_list(obj_shard, op, epoch, epoch_lo, dkey, akey,
+			       type, size, nr, kds, sgl, recxs, eprs, anchor,
 			       dkey_anchor, akey_anchor,
 			       &obj_auxi->map_ver_reply, task);
 
@@ -1625,7 +2278,7 @@ dc_obj_list_dkey(tse_task_t *task)
 	D_ASSERTF(args != NULL, "Task Argument OPC does not match DC OPC\n");
 
 	return dc_obj_list_internal(args->oh, DAOS_OBJ_DKEY_RPC_ENUMERATE,
-				    args->th, NULL, NULL, DAOS_IOD_NONE,
+				    args->th, 0, NULL, NULL, DAOS_IOD_NONE,
 				    NULL, args->nr, args->kds, args->sgl,
 				    NULL, NULL, NULL, args->anchor, NULL,
 				    true, task);
@@ -1640,7 +2293,7 @@ dc_obj_list_akey(tse_task_t *task)
 	D_ASSERTF(args != NULL, "Task Argument OPC does not match DC OPC\n");
 
 	return dc_obj_list_internal(args->oh, DAOS_OBJ_AKEY_RPC_ENUMERATE,
-				    args->th, args->dkey, NULL,
+				    args->th, 0, args->dkey, NULL,
 				    DAOS_IOD_NONE, NULL, args->nr, args->kds,
 				    args->sgl, NULL, NULL, NULL, NULL,
 				    args->anchor, true, task);
@@ -1655,7 +2308,8 @@ dc_obj_list_obj(tse_task_t *task)
 	D_ASSERTF(args != NULL, "Task Argument OPC does not match DC OPC\n");
 
 	return dc_obj_list_internal(args->oh, DAOS_OBJ_RPC_ENUMERATE,
-				    args->th, args->dkey, args->akey,
+				    args->th, args->epoch_lo, args->dkey,
+				    args->akey,
 				    DAOS_IOD_NONE, args->size, args->nr,
 				    args->kds, args->sgl, NULL, args->eprs,
 				    args->anchor, args->dkey_anchor,
@@ -1671,7 +2325,7 @@ dc_obj_list_rec(tse_task_t *task)
 	D_ASSERTF(args != NULL, "Task Argument OPC does not match DC OPC\n");
 
 	return dc_obj_list_internal(args->oh, DAOS_OBJ_RECX_RPC_ENUMERATE,
-				    args->th, args->dkey, args->akey,
+				    args->th, 0, args->dkey, args->akey,
 				    args->type, args->size, args->nr,
 				    NULL, NULL, args->recxs, args->eprs,
 				    args->anchor, NULL, NULL, args->incr_order,
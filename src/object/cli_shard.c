@@ -112,6 +112,8 @@ struct obj_rw_args {
 	crt_rpc_t		*rpc;
 	daos_handle_t		*hdlp;
 	daos_sg_list_t		*rwaa_sgls;
+	/* packed inline payload of update, see obj_shard_rw_pack() */
+	daos_sg_list_t		*rwaa_packed;
 	struct dc_obj_shard	*dobj;
 	unsigned int		*map_ver;
 };
@@ -246,6 +248,8 @@ dc_rw_cb(tse_task_t *task, void *arg)
 out:
 	obj_shard_rw_bulk_fini(rw_args->rpc);
 	crt_req_decref(rw_args->rpc);
+	if (rw_args->rwaa_packed != NULL)
+		D_FREE(rw_args->rwaa_packed);
 	obj_shard_decref(rw_args->dobj);
 	dc_pool_put((struct dc_pool *)rw_args->hdlp);
 
@@ -306,6 +310,110 @@ out:
 	return rc;
 }
 
+/**
+ * Encoded size of the request descriptors (dkey, iods and forwarding
+ * targets), they share the eager message with the inline data.
+ */
+static daos_size_t
+obj_rw_desc_size(daos_key_t *dkey, unsigned int nr, daos_iod_t *iods,
+		 uint32_t fw_cnt)
+{
+	daos_size_t	size;
+	int		i;
+
+	size = dkey->iov_len + fw_cnt * sizeof(struct daos_obj_shard_tgt);
+	for (i = 0; i < nr; i++) {
+		size += sizeof(iods[i]) + iods[i].iod_name.iov_len;
+		if (iods[i].iod_recxs != NULL)
+			size += iods[i].iod_nr * sizeof(*iods[i].iod_recxs);
+		if (iods[i].iod_eprs != NULL)
+			size += iods[i].iod_nr * sizeof(*iods[i].iod_eprs);
+	}
+
+	return size;
+}
+
+/** Whether the update payload should be packed before sending it inline */
+static bool
+obj_shard_rw_packable(enum obj_rpc_opc opc, unsigned int nr,
+		      daos_sg_list_t *sgls)
+{
+	int	i;
+
+	if (opc != DAOS_OBJ_RPC_UPDATE || sgls == NULL)
+		return false;
+
+	for (i = 0; i < nr; i++) {
+		if (sgls[i].sg_nr > 1)
+			return true;
+	}
+	return false;
+}
+
+/** Size of the update payload once packed by obj_shard_rw_pack() */
+static daos_size_t
+obj_shard_rw_packed_size(unsigned int nr, daos_sg_list_t *sgls)
+{
+	daos_size_t	size = 0;
+	int		i;
+
+	for (i = 0; i < nr; i++) {
+		size += daos_sgl_data_len(&sgls[i]);
+		size += sizeof(sgls[i].sg_nr) + sizeof(sgls[i].sg_nr_out);
+		size += sizeof(sgls[i].sg_iovs[0].iov_len) +
+			sizeof(sgls[i].sg_iovs[0].iov_buf_len);
+	}
+
+	return size;
+}
+
+/**
+ * Copy the data of each sgl of an inline update into a single iov, all of
+ * them backed by one contiguous buffer. Small multi-iov updates then encode
+ * and decode one iov per iod instead of one per fragment, and the server
+ * doesn't allocate an iov array for each of them.
+ */
+static int
+obj_shard_rw_pack(unsigned int nr, daos_sg_list_t *sgls,
+		  daos_sg_list_t **packed)
+{
+	daos_sg_list_t	*psgls;
+	d_iov_t		*piovs;
+	char		*buf;
+	daos_size_t	 size = 0;
+	int		 i;
+	int		 j;
+
+	for (i = 0; i < nr; i++)
+		size += daos_sgl_data_len(&sgls[i]);
+
+	D_ALLOC(psgls, nr * (sizeof(*psgls) + sizeof(*piovs)) + size);
+	if (psgls == NULL)
+		return -DER_NOMEM;
+
+	piovs = (d_iov_t *)&psgls[nr];
+	buf = (char *)&piovs[nr];
+	for (i = 0; i < nr; i++) {
+		psgls[i].sg_nr = 1;
+		psgls[i].sg_nr_out = 1;
+		psgls[i].sg_iovs = &piovs[i];
+		piovs[i].iov_buf = buf;
+		for (j = 0; j < sgls[i].sg_nr; j++) {
+			d_iov_t	*iov = &sgls[i].sg_iovs[j];
+
+			if (iov->iov_len == 0)
+				continue;
+			memcpy(buf, iov->iov_buf, iov->iov_len);
+			buf += iov->iov_len;
+			piovs[i].iov_len += iov->iov_len;
+		}
+		piovs[i].iov_buf_len = piovs[i].iov_len;
+	}
+
+	*packed = psgls;
+	return 0;
+}
+
 static struct dc_pool *
 obj_shard_ptr2pool(struct dc_obj_shard *shard)
 {
@@ -332,11 +440,15 @@ obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 	crt_endpoint_t		tgt_ep;
 	uuid_t			cont_hdl_uuid;
 	uuid_t			cont_uuid;
+	daos_sg_list_t	       *packed = NULL;
 	daos_size_t		data_size;
 	daos_size_t		buf_size;
 	daos_size_t		sgls_size;
+	daos_size_t		inline_max;
+	daos_size_t		desc_size;
 	uint64_t		dkey_hash;
 	bool			do_bulk = false;
+	bool			do_pack = false;
 	int			rc;
 
 	tse_task_stack_pop_data(task, &dkey_hash, sizeof(dkey_hash));
@@ -404,13 +516,28 @@ obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 	 * if need bulk transferring.
 	 */
 	data_size = sgls_size;
+	if (obj_shard_rw_packable(opc, nr, sgls)) {
+		do_pack = true;
+		data_size = obj_shard_rw_packed_size(nr, sgls);
+	}
+
+	/* Inline data shares the eager message with the descriptors, so the
+	 * threshold shrinks with the number of iods and recxs.
+	 */
+	desc_size = obj_rw_desc_size(dkey, nr, iods, fw_cnt);
+	if (cli_rpc_eager_size > OBJ_RPC_HDR_RESERVE + desc_size)
+		inline_max = cli_rpc_eager_size - OBJ_RPC_HDR_RESERVE -
+			     desc_size;
+	else
+		inline_max = 0;
 
 	D_DEBUG(DB_TRACE, "opc %d "DF_UOID" %d %s rank %d tag %d eph "
-		DF_U64" data_size "DF_U64"\n", opc, DP_UOID(shard->do_id),
-		(int)dkey->iov_len, (char *)dkey->iov_buf, tgt_ep.ep_rank,
-		tgt_ep.ep_tag, epoch, data_size);
+		DF_U64" data_size "DF_U64" inline_max "DF_U64"\n", opc,
+		DP_UOID(shard->do_id), (int)dkey->iov_len,
+		(char *)dkey->iov_buf, tgt_ep.ep_rank, tgt_ep.ep_tag, epoch,
+		data_size, inline_max);
 
-	do_bulk = data_size >= OBJ_BULK_LIMIT;
+	do_bulk = data_size >= inline_max;
 	if (do_bulk) {
 		bool forward = fw_shard_tgts != NULL;
 
@@ -422,11 +549,17 @@ obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 		orw->orw_sgls.ca_arrays = NULL;
 	} else {
 		/* Transfer data inline */
+		if (do_pack) {
+			rc = obj_shard_rw_pack(nr, sgls, &packed);
+			if (rc != 0)
+				D_GOTO(out_req, rc);
+		}
+
 		if (sgls != NULL)
 			orw->orw_sgls.ca_count = nr;
 		else
 			orw->orw_sgls.ca_count = 0;
-		orw->orw_sgls.ca_arrays = sgls;
+		orw->orw_sgls.ca_arrays = packed != NULL ? packed : sgls;
 		orw->orw_bulks.ca_count = 0;
 		orw->orw_bulks.ca_arrays = NULL;
 	}
@@ -436,6 +569,7 @@ obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 	rw_args.hdlp = (daos_handle_t *)pool;
 	rw_args.map_ver = map_ver;
 	rw_args.dobj = shard;
+	rw_args.rwaa_packed = packed;
 	/* remember the sgl to copyout the data inline for fetch */
 	rw_args.rwaa_sgls = (opc == DAOS_OBJ_RPC_FETCH) ? sgls : NULL;
 
@@ -464,6 +598,8 @@ out_args:
 		obj_shard_rw_bulk_fini(req);
 out_req:
 	crt_req_decref(req);
+	if (packed != NULL)
+		D_FREE(packed);
 out_pool:
 	dc_pool_put(pool);
 out_obj:
@@ -718,7 +854,8 @@ out:
 
 int
 dc_obj_shard_list(struct dc_obj_shard *obj_shard, unsigned int opc,
-		  daos_epoch_t epoch, daos_key_t *dkey, daos_key_t *akey,
+		  daos_epoch_t epoch, daos_epoch_t epoch_lo,
+		  daos_key_t *dkey, daos_key_t *akey,
 		  daos_iod_type_t type, daos_size_t *size, uint32_t *nr,
 		  daos_key_desc_t *kds, daos_sg_list_t *sgl,
 		  daos_recx_t *recxs, daos_epoch_range_t *eprs,
@@ -770,6 +907,7 @@ dc_obj_shard_list(struct dc_obj_shard *obj_shard, unsigned int opc,
 	oei->oei_oid		= obj_shard->do_id;
 	oei->oei_map_ver	= *map_ver;
 	oei->oei_epoch		= epoch;
+	oei->oei_epoch_lo	= epoch_lo;
 	oei->oei_nr		= *nr;
 	oei->oei_rec_type	= type;
 	uuid_copy(oei->oei_co_hdl, cont_hdl_uuid);
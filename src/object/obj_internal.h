@@ -51,6 +51,10 @@
 extern bool	cli_bypass_rpc;
 /** Switch of server-side IO dispatch */
 extern bool	srv_io_dispatch;
+/** Switch of parallel multi-group dkey enumeration */
+extern bool	cli_enum_parallel;
+/** Eager message size of the fabric, bounds the inline I/O size */
+extern unsigned int	cli_rpc_eager_size;
 
 /** client object shard */
 struct dc_obj_shard {
@@ -100,6 +104,15 @@ struct dc_object {
 	unsigned int		cob_shards_nr;
 	/** shard object ptrs */
 	struct dc_obj_shard	*cob_shards;
+
+	/** cob_enum_lock protects the dkey enumeration contexts */
+	pthread_mutex_t		 cob_enum_lock;
+	/** list of dkey enumeration prefetch contexts (obj_enum_ctx) */
+	d_list_t		 cob_enum_ctxs;
+	/** number of contexts on cob_enum_ctxs */
+	unsigned int		 cob_enum_nr;
+	/** ID generator of enumeration contexts */
+	uint32_t		 cob_enum_id;
 };
 
 static inline void
@@ -131,7 +144,8 @@ int dc_obj_shard_fetch(struct dc_obj_shard *shard, daos_epoch_t epoch,
 
 int
 dc_obj_shard_list(struct dc_obj_shard *obj_shard, unsigned int opc,
-		  daos_epoch_t epoch, daos_key_t *dkey, daos_key_t *akey,
+		  daos_epoch_t epoch, daos_epoch_t epoch_lo,
+		  daos_key_t *dkey, daos_key_t *akey,
 		  daos_iod_type_t type, daos_size_t *size, uint32_t *nr,
 		  daos_key_desc_t *kds, daos_sg_list_t *sgl,
 		  daos_recx_t *recxs, daos_epoch_range_t *eprs,
@@ -156,7 +170,7 @@ static inline bool
 obj_retry_error(int err)
 {
 	return err == -DER_TIMEDOUT || err == -DER_STALE ||
-	       daos_crt_network_error(err);
+	       err == -DER_BUSY || daos_crt_network_error(err);
 }
 
 void obj_shard_decref(struct dc_obj_shard *shard);
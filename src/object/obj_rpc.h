@@ -42,6 +42,15 @@
  */
 #define OBJ_BULK_LIMIT	(3584) /* (3K + 512) bytes */
 
+/* Default eager (unexpected) message size of the fabric, the inline
+ * update/fetch threshold is derived from it, see obj_shard_rw().
+ */
+#define OBJ_RPC_EAGER_SIZE	(4096)
+/* Upper bound of the eager message size that can be configured */
+#define OBJ_RPC_EAGER_SIZE_MAX	(65536)
+/* Reserved for cart/HG headers and the fixed fields of the RPC */
+#define OBJ_RPC_HDR_RESERVE	(512)
+
 /*
  * RPC operation codes
  *
@@ -141,6 +150,7 @@ CRT_RPC_DECLARE(obj_fetch, DAOS_ISEQ_OBJ_RW, DAOS_OSEQ_OBJ_RW)
 	((uuid_t)		(oei_co_hdl)		CRT_VAR) \
 	((uuid_t)		(oei_co_uuid)		CRT_VAR) \
 	((uint64_t)		(oei_epoch)		CRT_VAR) \
+	((uint64_t)		(oei_epoch_lo)		CRT_VAR) \
 	((uint32_t)		(oei_map_ver)		CRT_VAR) \
 	((uint32_t)		(oei_nr)		CRT_VAR) \
 	((uint32_t)		(oei_rec_type)		CRT_VAR) \
@@ -307,6 +307,7 @@ dc_obj_list_recx_task_create(daos_handle_t oh, daos_handle_t th,
 
 int
 dc_obj_list_obj_task_create(daos_handle_t oh, daos_handle_t th,
+			    daos_epoch_t epoch_lo,
 			    daos_key_t *dkey, daos_key_t *akey,
 			    daos_size_t *size, uint32_t *nr,
 			    daos_key_desc_t *kds, daos_epoch_range_t *eprs,
@@ -336,6 +337,7 @@ dc_obj_list_obj_task_create(daos_handle_t oh, daos_handle_t th,
 	args->anchor	= anchor;
 	args->dkey_anchor = dkey_anchor;
 	args->akey_anchor = akey_anchor;
+	args->epoch_lo	= epoch_lo;
 	args->incr_order = incr_order;
 
 	return 0;
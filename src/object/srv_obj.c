@@ -116,9 +116,35 @@ struct ds_bulk_async_args {
 	int		result;
 };
 
+/**
+ * Per SG list bulk state. For update, each SG list is written back to NVMe
+ * as soon as all its bulks complete, to overlap with the transfer of others.
+ */
+struct ds_bulk_sgl_args {
+	struct ds_bulk_async_args	*sa_args;
+	/* io descriptor to flush, NULL if no flush is needed */
+	struct bio_desc			*sa_biod;
+	unsigned int			 sa_idx;
+	int				 sa_inflight;
+};
+
+static void
+bulk_sgl_put(struct ds_bulk_sgl_args *sgl_arg)
+{
+	D_ASSERT(sgl_arg->sa_inflight > 0);
+	sgl_arg->sa_inflight--;
+	if (sgl_arg->sa_biod == NULL || sgl_arg->sa_inflight != 0 ||
+	    sgl_arg->sa_args->result != 0)
+		return;
+
+	/* On failure, the regions are written back by bio_iod_post() */
+	bio_iod_flush(sgl_arg->sa_biod, sgl_arg->sa_idx);
+}
+
 static int
 bulk_complete_cb(const struct crt_bulk_cb_info *cb_info)
 {
+	struct ds_bulk_sgl_args		*sgl_arg;
 	struct ds_bulk_async_args	*arg;
 	struct crt_bulk_desc		*bulk_desc;
 	crt_rpc_t			*rpc;
@@ -130,7 +156,8 @@ bulk_complete_cb(const struct crt_bulk_cb_info *cb_info)
 	bulk_desc = cb_info->bci_bulk_desc;
 	local_bulk_hdl = bulk_desc->bd_local_hdl;
 	rpc = bulk_desc->bd_rpc;
-	arg = (struct ds_bulk_async_args *)cb_info->bci_arg;
+	sgl_arg = (struct ds_bulk_sgl_args *)cb_info->bci_arg;
+	arg = sgl_arg->sa_args;
 	/**
 	 * Note: only one thread will access arg.result, so
 	 * it should be safe here.
@@ -138,6 +165,8 @@ bulk_complete_cb(const struct crt_bulk_cb_info *cb_info)
 	if (arg->result == 0)
 		arg->result = cb_info->bci_rc;
 
+	bulk_sgl_put(sgl_arg);
+
 	D_ASSERT(arg->bulks_inflight > 0);
 	arg->bulks_inflight--;
 	if (arg->bulks_inflight == 0)
@@ -194,6 +223,9 @@ ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
 		 daos_sg_list_t **sgls, int sgl_nr)
 {
 	struct ds_bulk_async_args arg = { 0 };
+	struct ds_bulk_sgl_args	sgl_one = { 0 };
+	struct ds_bulk_sgl_args	*sgl_args = NULL;
+	struct ds_bulk_sgl_args	*sgl_arg;
 	crt_bulk_opid_t		bulk_opid;
 	crt_bulk_perm_t		bulk_perm;
 	int			i, rc, *status, ret;
@@ -203,6 +235,11 @@ ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
 	if (rc != 0)
 		return dss_abterr2der(rc);
 
+	/* Write back each SG list once it's pulled, for multi-iod update */
+	if (bulk_op == CRT_BULK_GET && sgls == NULL && sgl_nr > 1)
+		D_ALLOC_ARRAY(sgl_args, sgl_nr);
+	sgl_one.sa_args = &arg;
+
 	D_DEBUG(DB_IO, "bulk_op:%d sgl_nr%d\n", bulk_op, sgl_nr);
 
 	for (i = 0; i < sgl_nr; i++) {
@@ -215,6 +252,17 @@ ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
 		if (remote_bulks[i] == NULL)
 			continue;
 
+		if (sgl_args != NULL) {
+			sgl_arg = &sgl_args[i];
+			sgl_arg->sa_args = &arg;
+			sgl_arg->sa_biod = vos_ioh2desc(ioh);
+			sgl_arg->sa_idx = i;
+		} else {
+			sgl_arg = &sgl_one;
+		}
+		/* hold the SG list until all its bulks are issued */
+		sgl_arg->sa_inflight++;
+
 		if (sgls != NULL) {
 			sgl = sgls[i];
 		} else {
@@ -226,8 +274,10 @@ ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
 
 			sgl = &tmp_sgl;
 			rc = bio_sgl_convert(bsgl, sgl);
-			if (rc)
+			if (rc) {
+				sgl_arg->sa_inflight--;
 				break;
+			}
 		}
 
 		if (daos_io_bypass & IOBP_SRV_BULK) {
@@ -295,16 +345,18 @@ ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
 			bulk_desc.bd_local_off	= 0;
 
 			arg.bulks_inflight++;
+			sgl_arg->sa_inflight++;
 			if (bulk_bind)
 				rc = crt_bulk_bind_transfer(&bulk_desc,
-					bulk_complete_cb, &arg, &bulk_opid);
+					bulk_complete_cb, sgl_arg, &bulk_opid);
 			else
 				rc = crt_bulk_transfer(&bulk_desc,
-					bulk_complete_cb, &arg, &bulk_opid);
+					bulk_complete_cb, sgl_arg, &bulk_opid);
 			if (rc < 0) {
 				D_ERROR("crt_bulk_transfer %d error (%d).\n",
 					i, rc);
 				arg.bulks_inflight--;
+				sgl_arg->sa_inflight--;
 				crt_bulk_free(local_bulk_hdl);
 				crt_req_decref(rpc);
 				break;
@@ -312,6 +364,10 @@ ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
 			offset += length;
 		}
 next:
+		if (rc == 0)
+			bulk_sgl_put(sgl_arg);
+		else
+			sgl_arg->sa_inflight--;
 		if (sgls == NULL)
 			daos_sgl_fini(sgl, false);
 		if (rc)
@@ -326,6 +382,8 @@ next:
 		rc = ret ? dss_abterr2der(ret) : *status;
 
 	ABT_eventual_free(&arg.eventual);
+	if (sgl_args != NULL)
+		D_FREE(sgl_args);
 	return rc;
 }
 
@@ -654,6 +712,13 @@ ds_obj_rw_local_hdlr(crt_rpc_t *rpc, uint32_t tag, struct ds_cont_hdl *cont_hdl,
 				DP_UOID(orw->orw_oid), rc);
 			goto out;
 		}
+
+		/* index the new shard before its data is committed */
+		if (vos_update_obj_new(*ioh))
+			ds_rebuild_obj_index_insert(
+					cont_hdl->sch_pool->spc_uuid,
+					cont->sc_hdl, orw->orw_oid,
+					orw->orw_map_ver);
 	} else {
 		bool size_fetch = (!rma && orw->orw_sgls.ca_arrays == NULL);
 
@@ -666,10 +731,21 @@ ds_obj_rw_local_hdlr(crt_rpc_t *rpc, uint32_t tag, struct ds_cont_hdl *cont_hdl,
 				DP_UOID(orw->orw_oid), rc);
 			goto out;
 		}
+	}
+
+	/* Submit NVMe reads for fetch, and prepare the reply meanwhile */
+	biod = vos_ioh2desc(*ioh);
+	rc = update ? bio_iod_prep(biod) : bio_iod_prep_nowait(biod);
+	if (rc) {
+		D_ERROR(DF_UOID" bio_iod_prep failed: %d.\n",
+			DP_UOID(orw->orw_oid), rc);
+		goto out;
+	}
 
+	if (!update) {
 		rc = ds_obj_update_sizes_in_reply(rpc);
 		if (rc != 0)
-			goto out;
+			goto post;
 
 		if (rma) {
 			orwo->orw_sgls.ca_count = 0;
@@ -677,19 +753,18 @@ ds_obj_rw_local_hdlr(crt_rpc_t *rpc, uint32_t tag, struct ds_cont_hdl *cont_hdl,
 
 			rc = ds_obj_update_nrs_in_reply(rpc, *ioh, NULL);
 			if (rc != 0)
-				goto out;
+				goto post;
 		} else {
 			orwo->orw_sgls.ca_count = orw->orw_sgls.ca_count;
 			orwo->orw_sgls.ca_arrays = orw->orw_sgls.ca_arrays;
 		}
-	}
 
-	biod = vos_ioh2desc(*ioh);
-	rc = bio_iod_prep(biod);
-	if (rc) {
-		D_ERROR(DF_UOID" bio_iod_prep failed: %d.\n",
-			DP_UOID(orw->orw_oid), rc);
-		goto out;
+		rc = bio_iod_wait(biod);
+		if (rc) {
+			D_ERROR(DF_UOID" NVMe read failed: %d.\n",
+				DP_UOID(orw->orw_oid), rc);
+			goto post;
+		}
 	}
 
 	if (rma) {
@@ -706,6 +781,7 @@ ds_obj_rw_local_hdlr(crt_rpc_t *rpc, uint32_t tag, struct ds_cont_hdl *cont_hdl,
 			DP_UOID(orw->orw_oid), rc);
 	}
 
+post:
 	err = bio_iod_post(biod);
 	rc = rc ? : err;
 out:
@@ -760,6 +836,13 @@ ds_obj_rw_handler(crt_rpc_t *rpc)
 			D_GOTO(out, rc = -DER_STALE);
 	}
 
+	/* shed the load before any data transfer, client will retry */
+	if (!dispatch && dss_xstream_is_busy()) {
+		D_DEBUG(DB_IO, "rpc %p: xstream %d busy\n", rpc,
+			dss_get_module_info()->dmi_xs_id);
+		D_GOTO(out, rc = -DER_BUSY);
+	}
+
 	/* dispatch to other tgts when needed */
 	if (dispatch) {
 		rc = ds_obj_req_disp_prepare(rpc->cr_opc,
@@ -899,7 +982,8 @@ ds_iter_vos(crt_rpc_t *rpc, struct vos_iter_anchors *anchors,
 		/* object iteration for rebuild */
 		D_ASSERT(opc == DAOS_OBJ_RPC_ENUMERATE);
 		type = VOS_ITER_DKEY;
-		param.ip_epr.epr_lo = 0;
+		/* only the changes since oei_epoch_lo, for reintegration */
+		param.ip_epr.epr_lo = oei->oei_epoch_lo;
 		param.ip_epc_expr = VOS_IT_EPC_RE;
 		recursive = true;
 		enum_arg->chk_key2big = true;
@@ -1158,6 +1242,11 @@ ds_obj_punch_local_hdlr(struct obj_punch_in *opi, crt_opcode_t opc,
 		rc = vos_obj_punch(cont->sc_hdl, opi->opi_oid,
 				   opi->opi_epoch, opi->opi_map_ver, 0,
 				   NULL, 0, NULL);
+		if (rc == 0)
+			ds_rebuild_obj_index_punch(
+					cont_hdl->sch_pool->spc_uuid,
+					cont->sc_hdl, opi->opi_oid,
+					opi->opi_map_ver, opi->opi_epoch);
 		break;
 	case DAOS_OBJ_RPC_PUNCH_DKEYS:
 	case DAOS_OBJ_RPC_PUNCH_AKEYS:
@@ -0,0 +1,770 @@
+/**
+ * (C) Copyright 2016-2018 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * This file is part of DSR
+ *
+ * src/placement/jump_map.c
+ *
+ * Placement map based on jump consistent hash (Lamping & Veach).
+ *
+ * Each shard is hashed to a fault domain of the pool map, then hashed again
+ * to a target within that domain. Jump consistent hash only moves 1/(n + 1)
+ * of the keys when the n + 1th bucket is appended, so extending the pool
+ * with new domains, or new targets at the end of a domain, relocates close
+ * to the minimum amount of data. Selecting a bucket takes O(log n) steps,
+ * and no per-map ring or hash table has to be built.
+ */
+#define D_LOGFAC	DD_FAC(placement)
+
+#include "pl_map.h"
+
+/** jump consistent hash placement map */
+struct pl_jump_map {
+	/** common body */
+	struct pl_map		 jmp_map;
+	/** fault domain */
+	pool_comp_type_t	 jmp_domain;
+	/** number of domains */
+	unsigned int		 jmp_domain_nr;
+	/** total number of targets */
+	unsigned int		 jmp_target_nr;
+	/** domains which have targets, in pool map order */
+	struct pool_domain	**jmp_domains;
+};
+
+/** placement of an object, or of one group when a shard is specified */
+struct jump_obj_placement {
+	/** hashed object ID */
+	uint64_t		jop_key;
+	unsigned int		jop_grp_size;
+	unsigned int		jop_grp_nr;
+	/** first shard ID of the layout */
+	unsigned int		jop_shard_id;
+};
+
+/** per-shard state of the group being placed */
+struct jump_shard {
+	/** target of the shard, NULL if it can't be placed */
+	struct pool_target	*js_tgt;
+	/** index of the domain in pl_jump_map::jmp_domains */
+	unsigned int		 js_dom;
+};
+
+struct jump_failed_shard {
+	d_list_t		jfs_list;
+	uint32_t		jfs_shard_idx;
+	uint32_t		jfs_fseq;
+	uint32_t		jfs_tgt_id;
+	uint8_t			jfs_status;
+};
+
+/** rehash this many times before probing domains linearly */
+#define JUMP_REHASH_MAX		8
+
+static inline struct pl_jump_map *
+pl_map2jmap(struct pl_map *map)
+{
+	return container_of(map, struct pl_jump_map, jmp_map);
+}
+
+/** 64-bit finalizer, spreads all input bits over the output */
+static inline uint64_t
+jump_mix64(uint64_t key)
+{
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+	return key;
+}
+
+/**
+ * Jump consistent hash, return a bucket in [0, @bucket_nr) for @key in
+ * O(log(@bucket_nr)) steps.
+ */
+static inline unsigned int
+jump_consistent_hash(uint64_t key, unsigned int bucket_nr)
+{
+	int64_t	b = -1;
+	int64_t	j = 0;
+
+	while (j < bucket_nr) {
+		b = j;
+		key = key * 2862933555777941757ULL + 1;
+		j = (b + 1) * ((double)(1LL << 31) /
+			       (double)((key >> 33) + 1));
+	}
+	return b;
+}
+
+/** key of the @attempt'th selection for shard @shard of the object */
+static inline uint64_t
+jump_shard_key(struct jump_obj_placement *jop, unsigned int shard,
+	       unsigned int attempt)
+{
+	return jump_mix64(jop->jop_key + ((uint64_t)shard << 32) + attempt);
+}
+
+static bool
+jump_domain_used(struct jump_shard *shards, unsigned int nr,
+		 unsigned int skip, unsigned int dom)
+{
+	unsigned int i;
+
+	for (i = 0; i < nr; i++) {
+		if (i != skip && shards[i].js_tgt != NULL &&
+		    shards[i].js_dom == dom)
+			return true;
+	}
+	return false;
+}
+
+/**
+ * Select a domain for @key, the domains of the group shards in @shards
+ * (except the shard @skip) are excluded so replicas of a group never share
+ * a fault domain. The caller guarantees at least one domain is eligible.
+ */
+static unsigned int
+jump_domain_select(struct pl_jump_map *jmap, uint64_t key,
+		   struct jump_shard *shards, unsigned int nr,
+		   unsigned int skip)
+{
+	unsigned int	dom;
+	unsigned int	i;
+
+	for (i = 0;; i++) {
+		dom = jump_consistent_hash(key, jmap->jmp_domain_nr);
+		if (!jump_domain_used(shards, nr, skip, dom))
+			return dom;
+		if (i == JUMP_REHASH_MAX)
+			break;
+		key = jump_mix64(key + i + 1);
+	}
+
+	/* Crowded group, probe from the last selection so it terminates */
+	for (i = 1; i < jmap->jmp_domain_nr; i++) {
+		unsigned int probe = (dom + i) % jmap->jmp_domain_nr;
+
+		if (!jump_domain_used(shards, nr, skip, probe))
+			return probe;
+	}
+	D_ASSERTF(0, "no domain for shard, nr %u, domain_nr %u\n",
+		  nr, jmap->jmp_domain_nr);
+	return dom;
+}
+
+/** select a target within domain @dom for @key */
+static struct pool_target *
+jump_target_select(struct pl_jump_map *jmap, uint64_t key, unsigned int dom)
+{
+	struct pool_domain *domain = jmap->jmp_domains[dom];
+	unsigned int	    idx;
+
+	idx = jump_consistent_hash(jump_mix64(key ^ domain->do_comp.co_id),
+				   domain->do_target_nr);
+	return &domain->do_targets[idx];
+}
+
+/** find the domain index of @tgt, only for the special object classes */
+static int
+jump_target2domain(struct pl_jump_map *jmap, struct pool_target *tgt)
+{
+	struct pool_domain *domain;
+	unsigned int	    i;
+
+	for (i = 0; i < jmap->jmp_domain_nr; i++) {
+		domain = jmap->jmp_domains[i];
+		if (tgt >= domain->do_targets &&
+		    tgt < domain->do_targets + domain->do_target_nr)
+			return i;
+	}
+	return -DER_NONEXIST;
+}
+
+static int
+jump_map_build(struct pl_jump_map *jmap, struct pl_map_init_attr *mia)
+{
+	struct pool_domain *doms;
+	unsigned int	    dom_nr;
+	unsigned int	    ver;
+	int		    i;
+	int		    rc;
+
+	D_ASSERT(jmap->jmp_map.pl_poolmap != NULL);
+	jmap->jmp_domain = mia->ia_jump.domain;
+
+	rc = pool_map_find_domain(jmap->jmp_map.pl_poolmap, jmap->jmp_domain,
+				  PO_COMP_ID_ALL, &doms);
+	if (rc <= 0)
+		return rc == 0 ? -DER_INVAL : rc;
+
+	dom_nr = rc;
+	D_ALLOC_ARRAY(jmap->jmp_domains, dom_nr);
+	if (jmap->jmp_domains == NULL)
+		return -DER_NOMEM;
+
+	/*
+	 * Keep the pool map order, new domains are appended to the pool map,
+	 * which is what jump consistent hash needs to move minimum data.
+	 */
+	ver = pl_map_version(&jmap->jmp_map);
+	for (i = 0; i < dom_nr; i++) {
+		if (doms[i].do_comp.co_ver > ver || doms[i].do_target_nr == 0)
+			continue;
+
+		D_DEBUG(DB_PL, "Found %d targets for %s[%d]\n",
+			doms[i].do_target_nr, pool_domain_name(&doms[i]),
+			doms[i].do_comp.co_id);
+
+		jmap->jmp_domains[jmap->jmp_domain_nr++] = &doms[i];
+		jmap->jmp_target_nr += doms[i].do_target_nr;
+	}
+
+	if (jmap->jmp_domain_nr == 0)
+		return -DER_INVAL;
+
+	D_DEBUG(DB_PL, "Built jump map: domains %u, targets %u\n",
+		jmap->jmp_domain_nr, jmap->jmp_target_nr);
+	return 0;
+}
+
+static void jump_map_destroy(struct pl_map *map);
+
+/**
+ * Create a jump consistent hash placement map
+ */
+static int
+jump_map_create(struct pool_map *poolmap, struct pl_map_init_attr *mia,
+		struct pl_map **mapp)
+{
+	struct pl_jump_map *jmap;
+	int		    rc;
+
+	D_DEBUG(DB_PL, "Create jump map: domain %s\n",
+		pool_comp_type2str(mia->ia_jump.domain));
+
+	D_ALLOC_PTR(jmap);
+	if (jmap == NULL)
+		return -DER_NOMEM;
+
+	pool_map_addref(poolmap);
+	jmap->jmp_map.pl_poolmap = poolmap;
+
+	rc = jump_map_build(jmap, mia);
+	if (rc != 0) {
+		jump_map_destroy(&jmap->jmp_map);
+		return rc;
+	}
+
+	*mapp = &jmap->jmp_map;
+	return 0;
+}
+
+static void
+jump_map_destroy(struct pl_map *map)
+{
+	struct pl_jump_map *jmap = pl_map2jmap(map);
+
+	if (jmap->jmp_domains != NULL)
+		D_FREE(jmap->jmp_domains);
+
+	if (jmap->jmp_map.pl_poolmap)
+		pool_map_decref(jmap->jmp_map.pl_poolmap);
+
+	D_FREE(jmap);
+}
+
+static void
+jump_map_print(struct pl_map *map)
+{
+	struct pl_jump_map *jmap = pl_map2jmap(map);
+	struct pool_domain *domain;
+	int		    i;
+
+	D_PRINT("jump map: ver %d, domains %u, targets %u\n",
+		pl_map_version(map), jmap->jmp_domain_nr, jmap->jmp_target_nr);
+
+	for (i = 0; i < jmap->jmp_domain_nr; i++) {
+		domain = jmap->jmp_domains[i];
+		D_PRINT("  %s[%d]: targets %u\n", pool_domain_name(domain),
+			domain->do_comp.co_id, domain->do_target_nr);
+	}
+}
+
+/** locate the target of the special object classes by rank and index */
+static int
+jump_obj_spec_target(struct pl_jump_map *jmap, daos_obj_id_t oid,
+		     struct pool_target **tgt_pp)
+{
+	struct pool_target	*tgts;
+	unsigned int		 tgts_nr;
+	d_rank_t		 rank;
+	int			 tgt;
+	unsigned int		 pos;
+
+	tgts = pool_map_targets(jmap->jmp_map.pl_poolmap);
+	tgts_nr = pool_map_target_nr(jmap->jmp_map.pl_poolmap);
+	rank = daos_oclass_sr_get_rank(oid);
+	tgt = daos_oclass_st_get_tgt(oid);
+	for (pos = 0; pos < tgts_nr; pos++) {
+		if (rank == tgts[pos].ta_comp.co_rank &&
+		    tgt == tgts[pos].ta_comp.co_index)
+			break;
+	}
+	if (pos == tgts_nr)
+		return -DER_INVAL;
+
+	D_DEBUG(DB_PL, "create obj with rank/tgt %d/%d\n", rank, tgt);
+	*tgt_pp = &tgts[pos];
+	return 0;
+}
+
+static inline bool
+jump_obj_is_spec(daos_obj_id_t oid)
+{
+	return daos_obj_id2class(oid) == DAOS_OC_R3S_SPEC_RANK ||
+	       daos_obj_id2class(oid) == DAOS_OC_R1S_SPEC_RANK ||
+	       daos_obj_id2class(oid) == DAOS_OC_R2S_SPEC_RANK;
+}
+
+/** calculate the jump map placement for the object */
+static int
+jump_obj_placement_get(struct pl_jump_map *jmap, struct daos_obj_md *md,
+		       struct daos_obj_shard_md *shard_md,
+		       struct jump_obj_placement *jop)
+{
+	struct daos_oclass_attr	*oc_attr;
+	daos_obj_id_t		 oid;
+
+	oid = md->omd_id;
+	oc_attr = daos_oclass_attr_find(oid);
+	if (oc_attr == NULL) {
+		D_ERROR("Can not find obj class, invlaid oid="DF_OID"\n",
+			DP_OID(oid));
+		return -DER_INVAL;
+	}
+
+	jop->jop_key = jump_mix64(oid.lo ^ jump_mix64(oid.hi));
+
+	jop->jop_grp_size = daos_oclass_grp_size(oc_attr);
+	D_ASSERT(jop->jop_grp_size != 0);
+	if (jop->jop_grp_size == DAOS_OBJ_REPL_MAX)
+		jop->jop_grp_size = jmap->jmp_domain_nr;
+
+	if (jop->jop_grp_size > jmap->jmp_domain_nr) {
+		D_ERROR("obj="DF_OID": group size (%u) is larger than "
+			"domain nr (%u)\n", DP_OID(oid),
+			jop->jop_grp_size, jmap->jmp_domain_nr);
+		return -DER_INVAL;
+	}
+
+	if (shard_md == NULL) {
+		unsigned int grp_max = jmap->jmp_target_nr / jop->jop_grp_size;
+
+		if (grp_max == 0)
+			grp_max = 1;
+
+		jop->jop_grp_nr = daos_oclass_grp_nr(oc_attr, md);
+		if (jop->jop_grp_nr > grp_max)
+			jop->jop_grp_nr = grp_max;
+		jop->jop_shard_id = 0;
+	} else {
+		jop->jop_grp_nr = 1;
+		jop->jop_shard_id = pl_obj_shard2grp_head(shard_md, oc_attr);
+	}
+
+	D_DEBUG(DB_PL, "obj="DF_OID"/%u grp_size=%u grp_nr=%d\n",
+		DP_OID(oid), jop->jop_shard_id, jop->jop_grp_size,
+		jop->jop_grp_nr);
+	return 0;
+}
+
+/** add one failed shard into remap list, sorted by fseq */
+static int
+jump_remap_alloc_one(d_list_t *remap_list, unsigned int shard_idx,
+		     struct pool_target *tgt)
+{
+	struct jump_failed_shard *f_new;
+	struct jump_failed_shard *f_shard;
+	d_list_t		 *tmp;
+
+	D_ALLOC_PTR(f_new);
+	if (f_new == NULL)
+		return -DER_NOMEM;
+
+	f_new->jfs_shard_idx = shard_idx;
+	f_new->jfs_fseq = tgt->ta_comp.co_fseq;
+	f_new->jfs_status = tgt->ta_comp.co_status;
+	f_new->jfs_tgt_id = -1;
+
+	d_list_for_each_prev(tmp, remap_list) {
+		f_shard = d_list_entry(tmp, struct jump_failed_shard,
+				       jfs_list);
+		if (f_new->jfs_fseq < f_shard->jfs_fseq)
+			continue;
+		d_list_add(&f_new->jfs_list, tmp);
+		return 0;
+	}
+	d_list_add(&f_new->jfs_list, remap_list);
+	return 0;
+}
+
+static void
+jump_remap_free_all(d_list_t *remap_list)
+{
+	struct jump_failed_shard *f_shard, *f_tmp;
+
+	d_list_for_each_entry_safe(f_shard, f_tmp, remap_list, jfs_list) {
+		d_list_del_init(&f_shard->jfs_list);
+		D_FREE(f_shard);
+	}
+}
+
+/**
+ * Select a spare target for the failed shard @f_shard of the group being
+ * placed. Spares are probed by rehashing the shard key, in a different
+ * domain from the other shards of the group. Failure semantics are the same
+ * as the ring map: a spare that failed before the shard is skipped, a spare
+ * that failed after it takes over the failure sequence and the search goes
+ * on, and a spare that failed after the object version ends the search.
+ */
+static struct pool_target *
+jump_remap_one(struct pl_jump_map *jmap, struct daos_obj_md *md,
+	       struct jump_obj_placement *jop, struct jump_shard *shards,
+	       unsigned int grp_idx, struct jump_failed_shard *f_shard)
+{
+	struct pool_target	*spare;
+	unsigned int		 shard;
+	unsigned int		 attempt;
+	unsigned int		 dom;
+	unsigned int		 i;
+	uint64_t		 key;
+
+	if (jmap->jmp_target_nr <= jop->jop_grp_size)
+		return NULL;
+
+	shard = jop->jop_shard_id + f_shard->jfs_shard_idx;
+	for (attempt = 1; attempt <= jmap->jmp_target_nr; attempt++) {
+		key = jump_shard_key(jop, shard, attempt);
+		dom = jump_domain_select(jmap, key, shards, jop->jop_grp_size,
+					 grp_idx);
+		spare = jump_target_select(jmap, key, dom);
+
+		for (i = 0; i < jop->jop_grp_size; i++) {
+			if (shards[i].js_tgt == spare)
+				break;
+		}
+		if (i < jop->jop_grp_size)
+			continue;
+
+		if (!pool_target_unavail(spare)) {
+			shards[grp_idx].js_dom = dom;
+			return spare;
+		}
+
+		/* Already taken over by this shard, or failed earlier */
+		if (spare->ta_comp.co_fseq <= f_shard->jfs_fseq)
+			continue;
+
+		if (spare->ta_comp.co_fseq > md->omd_ver) {
+			D_DEBUG(DB_PL, DF_OID", fseq %d rank %d ver %d\n",
+				DP_OID(md->omd_id), spare->ta_comp.co_fseq,
+				spare->ta_comp.co_rank, md->omd_ver);
+			return NULL;
+		}
+
+		f_shard->jfs_fseq = spare->ta_comp.co_fseq;
+		f_shard->jfs_status = spare->ta_comp.co_status;
+	}
+	return NULL;
+}
+
+/**
+ * Place one group: select a distinct domain and a target for each shard,
+ * then remap the shards on unavailable targets. The failed shards are moved
+ * to @remap_list.
+ */
+static int
+jump_obj_grp_fill(struct pl_jump_map *jmap, struct daos_obj_md *md,
+		  struct jump_obj_placement *jop, unsigned int grp,
+		  struct jump_shard *shards, struct pl_obj_layout *layout,
+		  d_list_t *remap_list)
+{
+	struct jump_failed_shard *f_shard;
+	struct pool_target	 *tgt;
+	struct pl_obj_shard	 *l_shard;
+	d_list_t		  grp_list;
+	unsigned int		  shard;
+	unsigned int		  j;
+	unsigned int		  k;
+	int			  rc = 0;
+
+	D_INIT_LIST_HEAD(&grp_list);
+	memset(shards, 0, sizeof(*shards) * jop->jop_grp_size);
+
+	for (j = 0; j < jop->jop_grp_size; j++) {
+		uint64_t key;
+
+		k = grp * jop->jop_grp_size + j;
+		shard = jop->jop_shard_id + k;
+		key = jump_shard_key(jop, shard, 0);
+
+		if (shard == 0 && jump_obj_is_spec(md->omd_id)) {
+			rc = jump_obj_spec_target(jmap, md->omd_id, &tgt);
+			if (rc == 0)
+				rc = jump_target2domain(jmap, tgt);
+			if (rc < 0) {
+				D_ERROR("special oid "DF_OID" failed: rc %d\n",
+					DP_OID(md->omd_id), rc);
+				D_GOTO(out, rc);
+			}
+			shards[j].js_dom = rc;
+			rc = 0;
+		} else {
+			shards[j].js_dom = jump_domain_select(jmap, key, shards,
+							      j, -1);
+			tgt = jump_target_select(jmap, key, shards[j].js_dom);
+		}
+		shards[j].js_tgt = tgt;
+
+		layout->ol_shards[k].po_shard  = shard;
+		layout->ol_shards[k].po_target = tgt->ta_comp.co_id;
+		/* Being resynced, update it but read from the others */
+		if (pool_target_reint(tgt))
+			layout->ol_shards[k].po_rebuilding = 1;
+
+		if (pool_target_unavail(tgt)) {
+			rc = jump_remap_alloc_one(&grp_list, k, tgt);
+			if (rc)
+				D_GOTO(out, rc);
+		}
+	}
+
+	d_list_for_each_entry(f_shard, &grp_list, jfs_list) {
+		j = f_shard->jfs_shard_idx - grp * jop->jop_grp_size;
+		l_shard = &layout->ol_shards[f_shard->jfs_shard_idx];
+
+		tgt = jump_remap_one(jmap, md, jop, shards, j, f_shard);
+		if (tgt == NULL) {
+			l_shard->po_shard = -1;
+			l_shard->po_target = -1;
+			continue;
+		}
+
+		shards[j].js_tgt = tgt;
+		l_shard->po_target = tgt->ta_comp.co_id;
+		/* Mark the shard as 'rebuilding' so that read will skip it */
+		if (f_shard->jfs_status == PO_COMP_ST_DOWN) {
+			l_shard->po_rebuilding = 1;
+			f_shard->jfs_tgt_id = tgt->ta_comp.co_id;
+		}
+	}
+out:
+	d_list_splice_init(&grp_list, remap_list);
+	return rc;
+}
+
+static int
+jump_obj_layout_fill(struct pl_map *map, struct daos_obj_md *md,
+		     struct jump_obj_placement *jop,
+		     struct pl_obj_layout *layout, d_list_t *remap_list)
+{
+	struct pl_jump_map	*jmap = pl_map2jmap(map);
+	struct jump_shard	*shards;
+	unsigned int		 i;
+	int			 rc = 0;
+
+	layout->ol_ver = pl_map_version(map);
+
+	D_ALLOC_ARRAY(shards, jop->jop_grp_size);
+	if (shards == NULL)
+		return -DER_NOMEM;
+
+	for (i = 0; i < jop->jop_grp_nr; i++) {
+		rc = jump_obj_grp_fill(jmap, md, jop, i, shards, layout,
+				       remap_list);
+		if (rc)
+			break;
+	}
+
+	D_FREE(shards);
+	if (rc) {
+		D_ERROR("jump_obj_layout_fill failed, rc %d.\n", rc);
+		jump_remap_free_all(remap_list);
+	}
+	return rc;
+}
+
+static int
+jump_obj_place(struct pl_map *map, struct daos_obj_md *md,
+	       struct daos_obj_shard_md *shard_md,
+	       struct pl_obj_layout **layout_pp)
+{
+	struct jump_obj_placement  jop;
+	struct pl_obj_layout	  *layout;
+	d_list_t		   remap_list;
+	int			   rc;
+
+	rc = jump_obj_placement_get(pl_map2jmap(map), md, shard_md, &jop);
+	if (rc)
+		return rc;
+
+	rc = pl_obj_layout_alloc(jop.jop_grp_size * jop.jop_grp_nr, &layout);
+	if (rc)
+		return rc;
+
+	D_INIT_LIST_HEAD(&remap_list);
+	rc = jump_obj_layout_fill(map, md, &jop, layout, &remap_list);
+	if (rc) {
+		pl_obj_layout_free(layout);
+		return rc;
+	}
+
+	*layout_pp = layout;
+	jump_remap_free_all(&remap_list);
+	return 0;
+}
+
+/** see \a pl_obj_find_rebuild */
+static int
+jump_obj_find_rebuild(struct pl_map *map, struct daos_obj_md *md,
+		      struct daos_obj_shard_md *shard_md,
+		      uint32_t rebuild_ver, uint32_t *tgt_id,
+		      uint32_t *shard_idx, unsigned int array_size)
+{
+	struct jump_obj_placement  jop;
+	struct pl_obj_layout	  *layout;
+	d_list_t		   remap_list;
+	struct jump_failed_shard  *f_shard;
+	struct pl_obj_shard	  *l_shard;
+	int			   idx = 0;
+	int			   rc;
+
+	/* Caller should guarantee the pl_map is uptodate */
+	if (pl_map_version(map) < rebuild_ver) {
+		D_ERROR("pl_map version(%u) < rebuild version(%u)\n",
+			pl_map_version(map), rebuild_ver);
+		return -DER_INVAL;
+	}
+
+	rc = jump_obj_placement_get(pl_map2jmap(map), md, shard_md, &jop);
+	if (rc)
+		return rc;
+
+	if (jop.jop_grp_size == 1) {
+		D_DEBUG(DB_PL, "Not replicated object "DF_OID"\n",
+			DP_OID(md->omd_id));
+		return 0;
+	}
+
+	rc = pl_obj_layout_alloc(jop.jop_grp_size * jop.jop_grp_nr, &layout);
+	if (rc)
+		return rc;
+
+	D_INIT_LIST_HEAD(&remap_list);
+	rc = jump_obj_layout_fill(map, md, &jop, layout, &remap_list);
+	if (rc)
+		goto out;
+
+	/* The list is sorted per group, so check all of the failed shards */
+	d_list_for_each_entry(f_shard, &remap_list, jfs_list) {
+		l_shard = &layout->ol_shards[f_shard->jfs_shard_idx];
+
+		if (f_shard->jfs_fseq > rebuild_ver)
+			continue;
+
+		if (f_shard->jfs_status == PO_COMP_ST_DOWN) {
+			if (l_shard->po_shard != -1) {
+				D_ASSERT(f_shard->jfs_tgt_id != -1);
+				D_ASSERT(idx < array_size);
+				tgt_id[idx] = f_shard->jfs_tgt_id;
+				shard_idx[idx] = l_shard->po_shard;
+				idx++;
+			}
+		} else if (f_shard->jfs_tgt_id != -1) {
+			rc = -DER_ALREADY;
+			D_ERROR(""DF_OID" rebuild is done for "
+				"fseq:%d(status:%d)? rbd_ver:%d rc %d\n",
+				DP_OID(md->omd_id), f_shard->jfs_fseq,
+				f_shard->jfs_status, rebuild_ver, rc);
+		}
+	}
+out:
+	jump_remap_free_all(&remap_list);
+	pl_obj_layout_free(layout);
+	return rc ? rc : idx;
+}
+
+/** see \a pl_obj_find_reint */
+static int
+jump_obj_find_reint(struct pl_map *map, struct daos_obj_md *md,
+		    struct daos_obj_shard_md *shard_md,
+		    uint32_t reint_ver, uint32_t *tgt_id,
+		    uint32_t *shard_idx, unsigned int array_size)
+{
+	struct jump_obj_placement  jop;
+	struct pl_obj_layout	  *layout;
+	d_list_t		   remap_list;
+	int			   rc;
+
+	/* Caller should guarantee the pl_map is uptodate */
+	if (pl_map_version(map) < reint_ver) {
+		D_ERROR("pl_map version(%u) < reint version(%u)\n",
+			pl_map_version(map), reint_ver);
+		return -DER_INVAL;
+	}
+
+	rc = jump_obj_placement_get(pl_map2jmap(map), md, shard_md, &jop);
+	if (rc)
+		return rc;
+
+	if (jop.jop_grp_size == 1) {
+		D_DEBUG(DB_PL, "Not replicated object "DF_OID"\n",
+			DP_OID(md->omd_id));
+		return 0;
+	}
+
+	rc = pl_obj_layout_alloc(jop.jop_grp_size * jop.jop_grp_nr, &layout);
+	if (rc)
+		return rc;
+
+	D_INIT_LIST_HEAD(&remap_list);
+	rc = jump_obj_layout_fill(map, md, &jop, layout, &remap_list);
+	if (rc == 0)
+		rc = pl_obj_layout_find_reint(map, layout, reint_ver, tgt_id,
+					      shard_idx, array_size);
+
+	jump_remap_free_all(&remap_list);
+	pl_obj_layout_free(layout);
+	return rc;
+}
+
+struct pl_map_ops	jump_map_ops = {
+	.o_create		= jump_map_create,
+	.o_destroy		= jump_map_destroy,
+	.o_print		= jump_map_print,
+	.o_obj_place		= jump_obj_place,
+	.o_obj_find_rebuild	= jump_obj_find_rebuild,
+	.o_obj_find_reint	= jump_obj_find_reint,
+};
@@ -31,6 +31,7 @@
 #include <gurt/hash.h>
 
 extern struct pl_map_ops	ring_map_ops;
+extern struct pl_map_ops	jump_map_ops;
 
 /** dictionary for all unknown placement maps */
 struct pl_map_dict {
@@ -49,6 +50,11 @@ static struct pl_map_dict pl_maps[] = {
 		.pd_ops		= &ring_map_ops,
 		.pd_name	= "ring",
 	},
+	{
+		.pd_type	= PL_TYPE_JUMP,
+		.pd_ops		= &jump_map_ops,
+		.pd_name	= "jump",
+	},
 	{
 		.pd_type	= PL_TYPE_UNKNOWN,
 		.pd_ops		= NULL,
@@ -88,6 +94,13 @@ pl_map_create_inited(struct pool_map *pool_map, struct pl_map_init_attr *mia,
 		return rc;
 	}
 
+	rc = D_SPIN_INIT(&map->pl_lcache_lock, PTHREAD_PROCESS_PRIVATE);
+	if (rc != 0) {
+		D_SPIN_DESTROY(&map->pl_lock);
+		dict->pd_ops->o_destroy(map);
+		return rc;
+	}
+
 	map->pl_ref  = 1; /* for the caller */
 	map->pl_connects = 0;
 	map->pl_type = mia->ia_type;
@@ -98,6 +111,165 @@ pl_map_create_inited(struct pool_map *pool_map, struct pl_map_init_attr *mia,
 	return 0;
 }
 
+/** number of slots of the layout cache of a placement map */
+#define PL_LCACHE_BITS		14
+#define PL_LCACHE_SIZE		(1U << PL_LCACHE_BITS)
+/** number of slots probed for a layout */
+#define PL_LCACHE_PROBE		4
+
+/**
+ * Cached layout of an object.
+ *
+ * A placement map is generated for each pool map version, so the layout of
+ * an object only depends on its ID and the pool map version in its metadata
+ * while the map is alive. The cache is a direct-mapped table with a short
+ * linear probe. When all probed slots are taken, a victim is chosen by CLOCK:
+ * a slot that has not been hit since the last sweep is replaced. The cache
+ * and each caller hold a reference on the layout, so an evicted layout is
+ * freed by its last pl_obj_layout_put().
+ *
+ * Lookups don't take any lock. A reader announces itself in ls_readers of the
+ * slot and skips the slot if ls_busy is set. Inserts and evictions are
+ * serialized by pl_lcache_lock, and the writer sets ls_busy and waits for the
+ * readers of the slot to leave before replacing its layout. As both sides
+ * set their own flag before checking the other's, either the reader sees
+ * ls_busy and misses, or the writer waits for it to take its reference, so a
+ * layout is never freed under a reader.
+ */
+struct pl_layout_slot {
+	/** lookups in progress on the slot */
+	uint32_t		 ls_readers;
+	/** the slot is being replaced */
+	uint32_t		 ls_busy;
+	/** referenced since the last sweep */
+	bool			 ls_used;
+	uint32_t		 ls_md_ver;
+	daos_obj_id_t		 ls_oid;
+	/** NULL if the slot is free */
+	struct pl_obj_layout	*ls_layout;
+};
+
+static inline unsigned int
+pl_lcache_hash(daos_obj_id_t oid)
+{
+	return daos_u64_hash(oid.lo ^ daos_u64_hash(oid.hi, 64),
+			     PL_LCACHE_BITS);
+}
+
+static inline struct pl_layout_slot *
+pl_lcache_slot(struct pl_layout_slot *slots, unsigned int hash, int i)
+{
+	return &slots[(hash + i) & (PL_LCACHE_SIZE - 1)];
+}
+
+static inline bool
+pl_lcache_match(struct pl_layout_slot *slot, struct daos_obj_md *md)
+{
+	return slot->ls_oid.lo == md->omd_id.lo &&
+	       slot->ls_oid.hi == md->omd_id.hi &&
+	       slot->ls_md_ver == md->omd_ver;
+}
+
+static void
+pl_lcache_destroy(struct pl_map *map)
+{
+	struct pl_layout_slot	*slot;
+	int			 i;
+
+	if (map->pl_lcache == NULL)
+		return;
+
+	for (i = 0; i < PL_LCACHE_SIZE; i++) {
+		slot = &map->pl_lcache[i];
+		if (slot->ls_layout != NULL)
+			pl_obj_layout_put(slot->ls_layout);
+	}
+	D_FREE(map->pl_lcache);
+}
+
+/**
+ * Look up the layout of @md in the cache, lock-free. A reference is taken on
+ * the returned layout.
+ */
+static struct pl_obj_layout *
+pl_lcache_lookup(struct pl_layout_slot *slots, unsigned int hash,
+		 struct daos_obj_md *md)
+{
+	struct pl_layout_slot	*slot;
+	struct pl_obj_layout	*layout = NULL;
+	bool			 found = false;
+	int			 i;
+
+	for (i = 0; i < PL_LCACHE_PROBE && !found; i++) {
+		slot = pl_lcache_slot(slots, hash, i);
+		__atomic_add_fetch(&slot->ls_readers, 1, __ATOMIC_SEQ_CST);
+		if (__atomic_load_n(&slot->ls_busy, __ATOMIC_SEQ_CST) == 0) {
+			layout = slot->ls_layout;
+			if (layout != NULL && pl_lcache_match(slot, md)) {
+				__atomic_store_n(&slot->ls_used, true,
+						 __ATOMIC_RELAXED);
+				__atomic_add_fetch(&layout->ol_ref, 1,
+						   __ATOMIC_RELAXED);
+				found = true;
+			}
+		}
+		__atomic_sub_fetch(&slot->ls_readers, 1, __ATOMIC_RELEASE);
+	}
+	return found ? layout : NULL;
+}
+
+/** Replace the layout of @slot, the caller should hold pl_lcache_lock. */
+static struct pl_obj_layout *
+pl_lcache_slot_set(struct pl_layout_slot *slot, struct pl_obj_layout *layout,
+		   struct daos_obj_md *md)
+{
+	struct pl_obj_layout	*old = slot->ls_layout;
+
+	__atomic_store_n(&slot->ls_busy, 1, __ATOMIC_SEQ_CST);
+	while (__atomic_load_n(&slot->ls_readers, __ATOMIC_SEQ_CST) != 0)
+		;
+	slot->ls_oid = md->omd_id;
+	slot->ls_md_ver = md->omd_ver;
+	slot->ls_used = true;
+	slot->ls_layout = layout;
+	__atomic_store_n(&slot->ls_busy, 0, __ATOMIC_RELEASE);
+	return old;
+}
+
+/**
+ * Insert @layout into the cache, the caller should hold pl_lcache_lock.
+ * Return the evicted layout, or @layout itself if the layout is already
+ * cached.
+ */
+static struct pl_obj_layout *
+pl_lcache_insert(struct pl_layout_slot *slots, unsigned int hash,
+		 struct pl_obj_layout *layout, struct daos_obj_md *md)
+{
+	struct pl_layout_slot	*slot;
+	int			 i;
+
+	for (i = 0; i < PL_LCACHE_PROBE; i++) {
+		slot = pl_lcache_slot(slots, hash, i);
+		if (slot->ls_layout == NULL)
+			return pl_lcache_slot_set(slot, layout, md);
+		if (pl_lcache_match(slot, md))
+			return layout;
+	}
+
+	/* CLOCK: give recently used slots a second chance */
+	for (i = 0; i < PL_LCACHE_PROBE; i++) {
+		slot = pl_lcache_slot(slots, hash, i);
+		if (!__atomic_load_n(&slot->ls_used, __ATOMIC_RELAXED))
+			break;
+		__atomic_store_n(&slot->ls_used, false, __ATOMIC_RELAXED);
+	}
+
+	if (i == PL_LCACHE_PROBE) /* all used, replace the first one */
+		slot = pl_lcache_slot(slots, hash, 0);
+
+	return pl_lcache_slot_set(slot, layout, md);
+}
+
 /**
  * Destroy a placement map
  */
@@ -108,6 +280,8 @@ pl_map_destroy(struct pl_map *map)
 	D_ASSERT(map->pl_ops != NULL);
 	D_ASSERT(map->pl_ops->o_destroy != NULL);
 
+	pl_lcache_destroy(map);
+	D_SPIN_DESTROY(&map->pl_lcache_lock);
 	D_SPIN_DESTROY(&map->pl_lock);
 	map->pl_ops->o_destroy(map);
 }
@@ -137,6 +311,70 @@ pl_obj_place(struct pl_map *map, struct daos_obj_md *md,
 	return map->pl_ops->o_obj_place(map, md, shard_md, layout_pp);
 }
 
+/**
+ * Return the layout of the object @md from the layout cache of @map, the
+ * layout is computed and cached on miss. The returned layout is read-only
+ * and should be released by pl_obj_layout_put().
+ */
+int
+pl_obj_layout_get(struct pl_map *map, struct daos_obj_md *md,
+		  struct pl_obj_layout **layout_pp)
+{
+	struct pl_layout_slot	*slots;
+	struct pl_layout_slot	*spare = NULL;
+	struct pl_obj_layout	*layout = NULL;
+	struct pl_obj_layout	*old;
+	unsigned int		 hash;
+	int			 rc;
+
+	hash = pl_lcache_hash(md->omd_id);
+	slots = __atomic_load_n(&map->pl_lcache, __ATOMIC_ACQUIRE);
+	if (slots != NULL)
+		layout = pl_lcache_lookup(slots, hash, md);
+	if (layout != NULL) {
+		*layout_pp = layout;
+		return 0;
+	}
+
+	rc = pl_obj_place(map, md, NULL, &layout);
+	if (rc != 0)
+		return rc;
+
+	layout->ol_ref = 1; /* for the caller */
+	*layout_pp = layout;
+
+	if (slots == NULL) {
+		D_ALLOC_ARRAY(slots, PL_LCACHE_SIZE);
+		if (slots == NULL)
+			return 0; /* just don't cache it */
+	}
+
+	layout->ol_ref++; /* for the cache */
+	D_SPIN_LOCK(&map->pl_lcache_lock);
+	if (map->pl_lcache == NULL) {
+		__atomic_store_n(&map->pl_lcache, slots, __ATOMIC_RELEASE);
+	} else if (map->pl_lcache != slots) {
+		spare = slots; /* lost the race to allocate the table */
+		slots = map->pl_lcache;
+	}
+	old = pl_lcache_insert(slots, hash, layout, md);
+	D_SPIN_UNLOCK(&map->pl_lcache_lock);
+
+	D_FREE(spare);
+
+	if (old != NULL)
+		pl_obj_layout_put(old);
+	return 0;
+}
+
+/** release a layout returned by pl_obj_layout_get() */
+void
+pl_obj_layout_put(struct pl_obj_layout *layout)
+{
+	if (__atomic_sub_fetch(&layout->ol_ref, 1, __ATOMIC_ACQ_REL) == 0)
+		pl_obj_layout_free(layout);
+}
+
 /**
  * Check if the provided object has any shard needs to be rebuilt for the
  * given rebuild version @rebuild_ver.
@@ -170,25 +408,70 @@ pl_obj_find_rebuild(struct pl_map *map, struct daos_obj_md *md,
 }
 
 /**
- * Check if the provided object shard needs to be built on the reintegrated
- * targets @tgp_reint.
+ * Check if the provided object has any shard on the targets being
+ * reintegrated up to version @reint_ver, these shards should be resynced
+ * from the other replicas of the group.
+ *
+ * \param  map [IN]		pl_map this check is performed on
+ * \param  md  [IN]		object metadata
+ * \param  shard_md [IN]	shard metadata (optional)
+ * \param  reint_ver [IN]	current reintegration version
+ * \param  tgt_id [OUT]		reintegrated target ids
+ * \param  shard_id [OUT]	shard ids to be resynced
+ * \param  array_size [IN]	array size of tgt_id & shard_id
  *
- * \return	1	Build the object on the returned target @tgt_reint.
- *		0	Skip this object.
+ * \return	> 0	the array size of tgt_id & shard_id.
+ *		0	No shard on the reintegrated targets.
  *		-ve	error code.
  */
 int
 pl_obj_find_reint(struct pl_map *map, struct daos_obj_md *md,
 		  struct daos_obj_shard_md *shard_md,
-		  struct pl_target_grp *tgp_reint, uint32_t *tgt_reint)
+		  uint32_t reint_ver, uint32_t *tgt_id,
+		  uint32_t *shard_id, unsigned int array_size)
 {
 	D_ASSERT(map->pl_ops != NULL);
 
 	if (!map->pl_ops->o_obj_find_reint)
 		return -DER_NOSYS;
 
-	return map->pl_ops->o_obj_find_reint(map, md, shard_md, tgp_reint,
-					     tgt_reint);
+	return map->pl_ops->o_obj_find_reint(map, md, shard_md, reint_ver,
+					     tgt_id, shard_id, array_size);
+}
+
+/**
+ * Collect the shards of @layout on the targets being reintegrated up to
+ * version @reint_ver, it is shared by the placement maps which mark these
+ * shards as rebuilding.
+ */
+int
+pl_obj_layout_find_reint(struct pl_map *map, struct pl_obj_layout *layout,
+			 uint32_t reint_ver, uint32_t *tgt_id,
+			 uint32_t *shard_id, unsigned int array_size)
+{
+	struct pool_target	*tgt;
+	unsigned int		 i;
+	int			 idx = 0;
+	int			 rc;
+
+	for (i = 0; i < layout->ol_nr; i++) {
+		struct pl_obj_shard *l_shard = &layout->ol_shards[i];
+
+		if (!l_shard->po_rebuilding || l_shard->po_target == -1)
+			continue;
+
+		rc = pool_map_find_target(map->pl_poolmap, l_shard->po_target,
+					  &tgt);
+		D_ASSERT(rc == 1);
+		if (!pool_target_reint(tgt) || tgt->ta_comp.co_ver > reint_ver)
+			continue;
+
+		D_ASSERT(idx < array_size);
+		tgt_id[idx] = l_shard->po_target;
+		shard_id[idx] = l_shard->po_shard;
+		idx++;
+	}
+	return idx;
 }
 
 void
@@ -291,7 +574,39 @@ pl_map_attr_init(struct pool_map *po_map, pl_map_type_t type,
 		mia->ia_ring.domain  = DSR_RING_DOMAIN;
 		mia->ia_ring.ring_nr = 1;
 		break;
+
+	case PL_TYPE_JUMP:
+		mia->ia_type	     = PL_TYPE_JUMP;
+		mia->ia_jump.domain  = DSR_RING_DOMAIN;
+		break;
+	}
+}
+
+/**
+ * Type of the placement maps generated for pools. It can be changed by
+ * setting DAOS_PL_TYPE to the name of a placement map, the value must be
+ * the same on all servers and clients.
+ */
+static pl_map_type_t	pl_default_type = PL_TYPE_RING;
+
+static void
+pl_default_type_init(void)
+{
+	struct pl_map_dict	*dict;
+	char			*env;
+
+	env = getenv("DAOS_PL_TYPE");
+	if (env == NULL)
+		return;
+
+	for (dict = &pl_maps[0]; dict->pd_type != PL_TYPE_UNKNOWN; dict++) {
+		if (strcasecmp(dict->pd_name, env) == 0) {
+			D_DEBUG(DB_PL, "Use %s placement map\n", env);
+			pl_default_type = dict->pd_type;
+			return;
+		}
 	}
+	D_ERROR("Unknown placement map %s, use %s\n", env, pl_maps[0].pd_name);
 }
 
 struct pl_map *
@@ -370,6 +685,7 @@ pl_htable_init()
 	 * be destroyed.
 	 */
 	D_ASSERT(pl_htable.ht_ops == NULL);
+	pl_default_type_init();
 	return d_hash_table_create_inplace(D_HASH_FT_NOLOCK,
 					   PL_HTABLE_BITS, NULL,
 					   &pl_hash_ops, &pl_htable);
@@ -428,7 +744,7 @@ pl_map_update(uuid_t uuid, struct pool_map *pool_map, bool connect)
 	}
 
 	if (!link) {
-		pl_map_attr_init(pool_map, PL_TYPE_RING, &mia);
+		pl_map_attr_init(pool_map, pl_default_type, &mia);
 		rc = pl_map_create_inited(pool_map, &mia, &map);
 		if (rc != 0)
 			D_GOTO(out, rc);
@@ -443,7 +759,7 @@ pl_map_update(uuid_t uuid, struct pool_map *pool_map, bool connect)
 			D_GOTO(out, rc = 0);
 		}
 
-		pl_map_attr_init(pool_map, PL_TYPE_RING, &mia);
+		pl_map_attr_init(pool_map, pl_default_type, &mia);
 		rc = pl_map_create_inited(pool_map, &mia, &map);
 		if (rc != 0) {
 			d_hash_rec_decref(&pl_htable, link);
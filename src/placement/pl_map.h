@@ -32,6 +32,7 @@
 #include <daos/placement.h>
 
 struct pl_map_ops;
+struct pl_layout_slot;
 
 /** common header of all placement map */
 struct pl_map {
@@ -51,6 +52,10 @@ struct pl_map {
 	struct pool_map		*pl_poolmap;
 	/** placement map operations */
 	struct pl_map_ops       *pl_ops;
+	/** serialize inserts and evictions of the object layout cache */
+	pthread_spinlock_t	 pl_lcache_lock;
+	/** object layout cache, allocated on first use */
+	struct pl_layout_slot	*pl_lcache;
 };
 
 /**
@@ -80,13 +85,20 @@ struct pl_map_ops {
 				      uint32_t *tgt_rank,
 				      uint32_t *shard_id,
 				      unsigned int array_size);
+	/** see \a pl_obj_find_reint */
 	int	(*o_obj_find_reint)(struct pl_map *map,
 				    struct daos_obj_md *md,
 				    struct daos_obj_shard_md *shard_md,
-				    struct pl_target_grp *tgp_reint,
-				    uint32_t *tgt_reint);
+				    uint32_t reint_ver,
+				    uint32_t *tgt_id,
+				    uint32_t *shard_id,
+				    unsigned int array_size);
 };
 
+int pl_obj_layout_find_reint(struct pl_map *map, struct pl_obj_layout *layout,
+			     uint32_t reint_ver, uint32_t *tgt_id,
+			     uint32_t *shard_id, unsigned int array_size);
+
 unsigned int pl_obj_shard2grp_head(struct daos_obj_shard_md *shard_md,
 				   struct daos_oclass_attr *oc_attr);
 unsigned int pl_obj_shard2grp_index(struct daos_obj_shard_md *shard_md,
@@ -1262,6 +1262,9 @@ ring_obj_layout_fill(struct pl_map *map, struct daos_obj_md *md,
 			tgt = &tgts[pos];
 			layout->ol_shards[k].po_shard  = rop->rop_shard_id + k;
 			layout->ol_shards[k].po_target = tgt->ta_comp.co_id;
+			/* Being resynced, update it but read from the others */
+			if (pool_target_reint(tgt))
+				layout->ol_shards[k].po_rebuilding = 1;
 
 			if (pool_target_unavail(tgt)) {
 				rc = ring_remap_alloc_one(remap_list, k, tgt);
@@ -1406,15 +1409,61 @@ out:
 	return rc ? rc : idx;
 }
 
-/** see \a dsr_obj_find_reint */
+/** see \a pl_obj_find_reint */
 int
 ring_obj_find_reint(struct pl_map *map, struct daos_obj_md *md,
 		    struct daos_obj_shard_md *shard_md,
-		    struct pl_target_grp *tgp_reint,
-		    uint32_t *tgt_reint)
+		    uint32_t reint_ver, uint32_t *tgt_id,
+		    uint32_t *shard_idx, unsigned int array_size)
 {
-	D_ERROR("Unsupported\n");
-	return -DER_NOSYS;
+	struct ring_obj_placement  rop;
+	struct pl_ring_map	  *rimap = pl_map2rimap(map);
+	struct pl_obj_layout	  *layout;
+	struct pl_obj_layout	   layout_on_stack;
+	struct pl_obj_shard	   shards_on_stack[SHARDS_ON_STACK_COUNT];
+	d_list_t		   remap_list;
+	unsigned int		   shards_count;
+	int			   rc;
+
+	/* Caller should guarantee the pl_map is uptodate */
+	if (pl_map_version(map) < reint_ver) {
+		D_ERROR("pl_map version(%u) < reint version(%u)\n",
+			pl_map_version(map), reint_ver);
+		return -DER_INVAL;
+	}
+
+	rc = ring_obj_placement_get(rimap, md, shard_md, &rop);
+	if (rc)
+		return rc;
+
+	if (rop.rop_grp_size == 1) {
+		D_DEBUG(DB_PL, "Not replicated object "DF_OID"\n",
+			DP_OID(md->omd_id));
+		return 0;
+	}
+
+	shards_count = rop.rop_grp_size * rop.rop_grp_nr;
+	if (shards_count > SHARDS_ON_STACK_COUNT) {
+		rc = pl_obj_layout_alloc(shards_count, &layout);
+		if (rc)
+			return rc;
+	} else {
+		layout = &layout_on_stack;
+		memset(shards_on_stack, 0, sizeof(shards_on_stack));
+		layout->ol_nr = shards_count;
+		layout->ol_shards = shards_on_stack;
+	}
+
+	D_INIT_LIST_HEAD(&remap_list);
+	rc = ring_obj_layout_fill(map, md, &rop, layout, &remap_list);
+	if (rc == 0)
+		rc = pl_obj_layout_find_reint(map, layout, reint_ver, tgt_id,
+					      shard_idx, array_size);
+
+	ring_remap_free_all(&remap_list);
+	if (shards_count > SHARDS_ON_STACK_COUNT)
+		pl_obj_layout_free(layout);
+	return rc;
 }
 
 struct pl_map_ops	ring_map_ops = {
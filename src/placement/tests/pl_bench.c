@@ -0,0 +1,703 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * pl_bench: placement map simulator
+ *
+ * It builds a synthetic pool map in the same shape as the pool service does
+ * (racks, nodes and targets), places a large number of objects and reports
+ * the load balance and the placement throughput. A list of events can then
+ * be applied to the pool map, e.g. failing targets, reintegrating them or
+ * adding nodes, and the fraction of shards moved by each event is reported.
+ */
+#define D_LOGFAC	DD_FAC(tests)
+
+#include <getopt.h>
+#include <math.h>
+#include <time.h>
+#include <daos/common.h>
+#include <daos/object.h>
+#include <daos/placement.h>
+
+/** placed targets of all objects, for comparing two pool map versions */
+struct plb_layouts {
+	/* targets of all shards, -1 for no target */
+	uint32_t	*pl_tgts;
+	/* start of the shards of each object in pl_tgts */
+	uint64_t	*pl_offs;
+	uint64_t	 pl_shard_nr;
+};
+
+static pl_map_type_t		 plb_type = PL_TYPE_RING;
+static daos_oclass_id_t		 plb_oclass = DAOS_OC_R3_RW;
+static unsigned int		 plb_rack_nr;
+static unsigned int		 plb_node_nr = 16;
+static unsigned int		 plb_tgt_nr = 8;
+static uint64_t			 plb_obj_nr = 1000000;
+static uint32_t			 plb_ver = 1;
+static bool			 plb_verbose;
+
+/*
+ * Components of the nodes and targets indexed by their IDs, the pool map is
+ * regenerated from them on every change. Node i is in rack i % plb_rack_nr.
+ */
+static struct pool_component	*plb_nodes;
+static struct pool_component	*plb_tgts;
+
+static double
+plb_time_now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static unsigned int
+plb_all_tgt_nr(void)
+{
+	return plb_node_nr * plb_tgt_nr;
+}
+
+static bool
+plb_tgt_avail(unsigned int id)
+{
+	return plb_tgts[id].co_status == PO_COMP_ST_UP ||
+	       plb_tgts[id].co_status == PO_COMP_ST_UPIN;
+}
+
+static void
+plb_comp_init(struct pool_component *comp, pool_comp_type_t type,
+	      unsigned int idx, unsigned int id, unsigned int rank,
+	      unsigned int nr, uint32_t ver)
+{
+	memset(comp, 0, sizeof(*comp));
+	comp->co_type	= type;
+	comp->co_status	= PO_COMP_ST_UPIN;
+	comp->co_index	= idx;
+	comp->co_id	= id;
+	comp->co_rank	= rank;
+	comp->co_ver	= ver;
+	comp->co_fseq	= 1;
+	comp->co_nr	= nr;
+}
+
+/**
+ * Add @nr nodes at version @ver, the targets of the new nodes are UP because
+ * they are not in the layouts of the existing objects yet.
+ */
+static int
+plb_nodes_add(unsigned int nr, uint32_t ver)
+{
+	struct pool_component	*nodes;
+	struct pool_component	*tgts;
+	unsigned int		 node_nr = plb_node_nr + nr;
+	unsigned int		 i;
+	unsigned int		 j;
+
+	D_ALLOC_ARRAY(nodes, node_nr);
+	D_ALLOC_ARRAY(tgts, node_nr * plb_tgt_nr);
+	if (nodes == NULL || tgts == NULL) {
+		if (nodes != NULL)
+			D_FREE(nodes);
+		if (tgts != NULL)
+			D_FREE(tgts);
+		return -DER_NOMEM;
+	}
+
+	if (plb_nodes != NULL) {
+		memcpy(nodes, plb_nodes, sizeof(*nodes) * plb_node_nr);
+		memcpy(tgts, plb_tgts, sizeof(*tgts) * plb_all_tgt_nr());
+		D_FREE(plb_nodes);
+		D_FREE(plb_tgts);
+	}
+
+	for (i = plb_node_nr; i < node_nr; i++) {
+		plb_comp_init(&nodes[i], PO_COMP_TP_NODE, i, i, i, plb_tgt_nr,
+			      ver);
+		for (j = 0; j < plb_tgt_nr; j++) {
+			struct pool_component *comp;
+
+			comp = &tgts[i * plb_tgt_nr + j];
+			plb_comp_init(comp, PO_COMP_TP_TARGET, j,
+				      i * plb_tgt_nr + j, i, 1, ver);
+			if (ver > 1)
+				comp->co_status = PO_COMP_ST_UP;
+		}
+	}
+
+	plb_nodes = nodes;
+	plb_tgts = tgts;
+	plb_node_nr = node_nr;
+	return 0;
+}
+
+/** Generate the pool buffer, the nodes and targets are grouped by racks */
+static struct pool_buf *
+plb_buf_gen(void)
+{
+	struct pool_component	 comp;
+	struct pool_buf		*buf;
+	unsigned int		 rack_nr = max(plb_rack_nr, 1U);
+	unsigned int		 i;
+	unsigned int		 j;
+	unsigned int		 k;
+	int			 rc;
+
+	buf = pool_buf_alloc(plb_rack_nr + plb_node_nr + plb_all_tgt_nr());
+	if (buf == NULL)
+		return NULL;
+
+	for (i = 0; i < plb_rack_nr; i++) {
+		plb_comp_init(&comp, PO_COMP_TP_RACK, i, i, 0,
+			      plb_node_nr / plb_rack_nr +
+			      (i < plb_node_nr % plb_rack_nr), 1);
+		rc = pool_buf_attach(buf, &comp, 1);
+		if (rc)
+			D_GOTO(failed, rc);
+	}
+
+	for (i = 0; i < rack_nr; i++) {
+		for (j = i; j < plb_node_nr; j += rack_nr) {
+			rc = pool_buf_attach(buf, &plb_nodes[j], 1);
+			if (rc)
+				D_GOTO(failed, rc);
+		}
+	}
+
+	for (i = 0; i < rack_nr; i++) {
+		for (j = i; j < plb_node_nr; j += rack_nr) {
+			k = j * plb_tgt_nr;
+			rc = pool_buf_attach(buf, &plb_tgts[k], plb_tgt_nr);
+			if (rc)
+				D_GOTO(failed, rc);
+		}
+	}
+	return buf;
+failed:
+	D_PRINT("failed to generate pool buffer: %d\n", rc);
+	pool_buf_free(buf);
+	return NULL;
+}
+
+static int
+plb_map_create(struct pool_map **po_mapp, struct pl_map **pl_mapp)
+{
+	struct pl_map_init_attr	 mia;
+	struct pool_buf		*buf;
+	pool_comp_type_t	 domain;
+	int			 rc;
+
+	buf = plb_buf_gen();
+	if (buf == NULL)
+		return -DER_NOMEM;
+
+	rc = pool_map_create(buf, plb_ver, po_mapp);
+	if (rc)
+		D_GOTO(out, rc);
+
+	/* replicas are spread over racks, or nodes if there is no rack */
+	domain = plb_rack_nr > 0 ? PO_COMP_TP_RACK : PO_COMP_TP_NODE;
+	memset(&mia, 0, sizeof(mia));
+	mia.ia_type = plb_type;
+	if (plb_type == PL_TYPE_RING) {
+		mia.ia_ring.domain  = domain;
+		mia.ia_ring.ring_nr = 1;
+	} else {
+		mia.ia_jump.domain  = domain;
+	}
+
+	rc = pl_map_create(*po_mapp, &mia, pl_mapp);
+	if (rc) {
+		pool_map_decref(*po_mapp);
+		*po_mapp = NULL;
+	}
+out:
+	pool_buf_free(buf);
+	return rc;
+}
+
+static void
+plb_layouts_free(struct plb_layouts *lo)
+{
+	if (lo->pl_tgts != NULL)
+		D_FREE(lo->pl_tgts);
+	if (lo->pl_offs != NULL)
+		D_FREE(lo->pl_offs);
+	lo->pl_shard_nr = 0;
+}
+
+static int
+plb_layouts_add(struct plb_layouts *lo, uint64_t *cap,
+		struct pl_obj_layout *layout)
+{
+	unsigned int	i;
+
+	if (lo->pl_shard_nr + layout->ol_nr > *cap) {
+		uint32_t	*tgts;
+		uint64_t	 new_cap = *cap * 2 + layout->ol_nr;
+
+		D_REALLOC(tgts, lo->pl_tgts, new_cap * sizeof(*tgts));
+		if (tgts == NULL)
+			return -DER_NOMEM;
+		lo->pl_tgts = tgts;
+		*cap = new_cap;
+	}
+
+	for (i = 0; i < layout->ol_nr; i++)
+		lo->pl_tgts[lo->pl_shard_nr++] = layout->ol_shards[i].po_target;
+	return 0;
+}
+
+/**
+ * Place all objects, record their targets in @lo and print the load balance
+ * and the placement rate.
+ */
+static int
+plb_place_all(struct pl_map *pl_map, struct plb_layouts *lo)
+{
+	struct pl_obj_layout	*layout;
+	struct daos_obj_md	 md;
+	uint32_t		*loads;
+	uint64_t		 cap;
+	uint64_t		 i;
+	unsigned int		 tgt_nr = 0;
+	unsigned int		 rebuilding = 0;
+	uint64_t		 placed = 0;
+	uint32_t		 ld_min = UINT32_MAX;
+	uint32_t		 ld_max = 0;
+	double			 mean;
+	double			 var = 0;
+	double			 start;
+	double			 duration;
+	int			 rc = 0;
+
+	D_ALLOC_ARRAY(loads, plb_all_tgt_nr());
+	D_ALLOC_ARRAY(lo->pl_offs, plb_obj_nr + 1);
+	if (loads == NULL || lo->pl_offs == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	cap = plb_obj_nr;
+	D_ALLOC_ARRAY(lo->pl_tgts, cap);
+	if (lo->pl_tgts == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	start = plb_time_now();
+	for (i = 0; i < plb_obj_nr; i++) {
+		unsigned int j;
+
+		memset(&md, 0, sizeof(md));
+		md.omd_id.lo = i;
+		daos_obj_generate_id(&md.omd_id, 0, plb_oclass);
+		md.omd_ver = plb_ver;
+
+		rc = pl_obj_place(pl_map, &md, NULL, &layout);
+		if (rc) {
+			D_PRINT("failed to place object "DF_OID": %d\n",
+				DP_OID(md.omd_id), rc);
+			D_GOTO(out, rc);
+		}
+
+		lo->pl_offs[i] = lo->pl_shard_nr;
+		rc = plb_layouts_add(lo, &cap, layout);
+		for (j = 0; j < layout->ol_nr; j++) {
+			struct pl_obj_shard *shard = &layout->ol_shards[j];
+
+			if (shard->po_target == -1)
+				continue;
+			D_ASSERT(shard->po_target < plb_all_tgt_nr());
+			loads[shard->po_target]++;
+			if (shard->po_rebuilding)
+				rebuilding++;
+		}
+		pl_obj_layout_free(layout);
+		if (rc)
+			D_GOTO(out, rc);
+	}
+	duration = plb_time_now() - start;
+	lo->pl_offs[plb_obj_nr] = lo->pl_shard_nr;
+
+	/* load of the targets which can take shards */
+	for (i = 0; i < plb_all_tgt_nr(); i++) {
+		if (!plb_tgt_avail(i))
+			continue;
+		tgt_nr++;
+		placed += loads[i];
+		ld_min = min(ld_min, loads[i]);
+		ld_max = max(ld_max, loads[i]);
+	}
+	D_ASSERT(tgt_nr > 0);
+
+	mean = (double)placed / tgt_nr;
+	for (i = 0; i < plb_all_tgt_nr(); i++) {
+		if (!plb_tgt_avail(i))
+			continue;
+		var += (loads[i] - mean) * (loads[i] - mean);
+	}
+	var /= tgt_nr;
+
+	D_PRINT("\tplaced   : "DF_U64" objects, "DF_U64" shards in %.3f sec "
+		"(%.0f layouts/sec)\n", plb_obj_nr, lo->pl_shard_nr, duration,
+		plb_obj_nr / duration);
+	D_PRINT("\tbalance  : %u targets, shards per target mean %.1f "
+		"stddev %.2f (%.2f%%) min %u max %u\n", tgt_nr, mean,
+		sqrt(var), mean > 0 ? sqrt(var) * 100 / mean : 0, ld_min,
+		ld_max);
+	if (rebuilding > 0)
+		D_PRINT("\tresync   : %u shards being rebuilt\n", rebuilding);
+out:
+	if (loads != NULL)
+		D_FREE(loads);
+	if (rc)
+		plb_layouts_free(lo);
+	return rc;
+}
+
+/** Print the fraction of shards which are placed differently in @cur */
+static void
+plb_layouts_diff(struct plb_layouts *prev, struct plb_layouts *cur)
+{
+	uint64_t	moved = 0;
+	uint64_t	i;
+
+	for (i = 0; i < plb_obj_nr; i++) {
+		uint64_t	p_nr = prev->pl_offs[i + 1] - prev->pl_offs[i];
+		uint64_t	c_nr = cur->pl_offs[i + 1] - cur->pl_offs[i];
+		uint64_t	j;
+
+		for (j = 0; j < c_nr; j++) {
+			if (j >= p_nr ||
+			    prev->pl_tgts[prev->pl_offs[i] + j] !=
+			    cur->pl_tgts[cur->pl_offs[i] + j])
+				moved++;
+		}
+	}
+
+	D_PRINT("\tmoved    : "DF_U64" of "DF_U64" shards (%.3f%%)\n", moved,
+		cur->pl_shard_nr,
+		cur->pl_shard_nr > 0 ? moved * 100.0 / cur->pl_shard_nr : 0);
+}
+
+/** Pick @nr random targets in @status, return the number of picked ones */
+static unsigned int
+plb_tgts_pick(unsigned int status, unsigned int nr, unsigned int *ids)
+{
+	unsigned int	*cands;
+	unsigned int	 cnt = 0;
+	unsigned int	 i;
+
+	D_ALLOC_ARRAY(cands, plb_all_tgt_nr());
+	if (cands == NULL)
+		return 0;
+
+	for (i = 0; i < plb_all_tgt_nr(); i++) {
+		if (plb_tgts[i].co_status & status)
+			cands[cnt++] = i;
+	}
+
+	/* partial Fisher-Yates shuffle */
+	nr = min(nr, cnt);
+	for (i = 0; i < nr; i++) {
+		unsigned int j = i + rand() % (cnt - i);
+
+		ids[i] = cands[j];
+		cands[j] = cands[i];
+	}
+	D_FREE(cands);
+	return nr;
+}
+
+/**
+ * Apply one event to the components, it is in the format of "op:nr", op can
+ * be fail, reint or add. Failed targets are reintegrated in random order,
+ * added targets are nodes.
+ */
+static int
+plb_event_apply(char *event)
+{
+	unsigned int	*ids = NULL;
+	unsigned int	 nr;
+	unsigned int	 i;
+	char		*op;
+	char		*val;
+	int		 rc = 0;
+
+	op = event;
+	val = strchr(event, ':');
+	if (val == NULL || val[1] == '\0') {
+		D_PRINT("invalid event %s\n", event);
+		return -DER_INVAL;
+	}
+	*val++ = '\0';
+	nr = strtoul(val, NULL, 0);
+	if (nr == 0) {
+		D_PRINT("invalid number of event %s\n", op);
+		return -DER_INVAL;
+	}
+
+	plb_ver++;
+	if (strcasecmp(op, "add") == 0) {
+		D_PRINT("\nadd %u nodes (%u targets), version %u\n", nr,
+			nr * plb_tgt_nr, plb_ver);
+		return plb_nodes_add(nr, plb_ver);
+	}
+
+	D_ALLOC_ARRAY(ids, nr);
+	if (ids == NULL)
+		return -DER_NOMEM;
+
+	if (strcasecmp(op, "fail") == 0) {
+		nr = plb_tgts_pick(PO_COMP_ST_UP | PO_COMP_ST_UPIN, nr, ids);
+		D_PRINT("\nfail %u targets, version %u\n", nr, plb_ver);
+		for (i = 0; i < nr; i++) {
+			struct pool_component *comp = &plb_tgts[ids[i]];
+
+			comp->co_status = PO_COMP_ST_DOWN;
+			comp->co_fseq = plb_ver;
+		}
+	} else if (strcasecmp(op, "reint") == 0) {
+		nr = plb_tgts_pick(PO_COMP_ST_DOWN | PO_COMP_ST_DOWNOUT, nr,
+				   ids);
+		D_PRINT("\nreintegrate %u targets, version %u\n", nr, plb_ver);
+		for (i = 0; i < nr; i++) {
+			struct pool_component *comp = &plb_tgts[ids[i]];
+
+			comp->co_status = PO_COMP_ST_UP;
+			comp->co_fseq = 0;
+			comp->co_ver = plb_ver;
+		}
+	} else {
+		D_PRINT("unknown event %s\n", op);
+		rc = -DER_INVAL;
+	}
+
+	if (plb_verbose) {
+		for (i = 0; i < nr; i++)
+			D_PRINT("%u ", ids[i]);
+		D_PRINT("\n");
+	}
+	D_FREE(ids);
+	return rc;
+}
+
+static int
+plb_run(struct plb_layouts *cur)
+{
+	struct pool_map	*po_map;
+	struct pl_map	*pl_map;
+	int		 rc;
+
+	rc = plb_map_create(&po_map, &pl_map);
+	if (rc) {
+		D_PRINT("failed to create the maps: %d\n", rc);
+		return rc;
+	}
+
+	if (plb_verbose)
+		pl_map_print(pl_map);
+
+	rc = plb_place_all(pl_map, cur);
+	pl_map_decref(pl_map);
+	pool_map_decref(po_map);
+	return rc;
+}
+
+static void
+plb_print_usage(void)
+{
+	printf("pl_bench -- placement map simulator\n\
+\n\
+Description:\n\
+	The pl_bench utility places objects on a synthetic pool map and\n\
+	reports the load balance, the placement rate and the fraction of\n\
+	shards moved by pool map changes.\n\
+\n\
+The options are as follows:\n\
+-h	Print this help message.\n\
+\n\
+-t ring|jump\n\
+	Type of placement map, the default value is 'ring'.\n\
+\n\
+-r number\n\
+	Number of racks, replicas are placed in different racks. Nodes are\n\
+	the fault domains if it is 0, which is the default value.\n\
+\n\
+-n number\n\
+	Number of nodes, the default value is 16.\n\
+\n\
+-g number\n\
+	Number of targets per node, the default value is 8.\n\
+\n\
+-o number\n\
+	Number of objects, the number can have 'k' or 'm' as postfix which\n\
+	stands for kilo or million. The default value is 1m.\n\
+\n\
+-c name\n\
+	Object class name, e.g. repl_3_rw (the default), repl_2_small_rw.\n\
+\n\
+-e op:number[,op:number...]\n\
+	Events applied in order after the initial placement, op can be:\n\
+	fail  : fail random targets.\n\
+	reint : reintegrate random failed targets.\n\
+	add   : add nodes.\n\
+	E.g. -e fail:8,reint:8,add:2\n\
+\n\
+-s number\n\
+	Seed of the random target selection.\n\
+\n\
+-v	Print the placement map and the selected targets.\n");
+}
+
+static struct option plb_ops[] = {
+	{ "type",	required_argument,	NULL,	't' },
+	{ "racks",	required_argument,	NULL,	'r' },
+	{ "nodes",	required_argument,	NULL,	'n' },
+	{ "targets",	required_argument,	NULL,	'g' },
+	{ "objs",	required_argument,	NULL,	'o' },
+	{ "class",	required_argument,	NULL,	'c' },
+	{ "events",	required_argument,	NULL,	'e' },
+	{ "seed",	required_argument,	NULL,	's' },
+	{ "verbose",	no_argument,		NULL,	'v' },
+	{ "help",	no_argument,		NULL,	'h' },
+	{ NULL,		0,			NULL,	0   },
+};
+
+int
+main(int argc, char **argv)
+{
+	struct plb_layouts	 prev = { 0 };
+	struct plb_layouts	 cur = { 0 };
+	char			*events = NULL;
+	char			*event;
+	char			*saveptr;
+	unsigned int		 seed = time(NULL);
+	unsigned int		 node_nr;
+	int			 oclass;
+	int			 rc;
+
+	while ((rc = getopt_long(argc, argv, "t:r:n:g:o:c:e:s:vh",
+				 plb_ops, NULL)) != -1) {
+		char	*endp;
+
+		switch (rc) {
+		default:
+			fprintf(stderr, "Unknown option %c\n", rc);
+			return -1;
+		case 'h':
+			plb_print_usage();
+			return 0;
+		case 't':
+			if (!strcasecmp(optarg, "ring")) {
+				plb_type = PL_TYPE_RING;
+			} else if (!strcasecmp(optarg, "jump")) {
+				plb_type = PL_TYPE_JUMP;
+			} else {
+				fprintf(stderr, "unknown type %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'r':
+			plb_rack_nr = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			plb_node_nr = strtoul(optarg, NULL, 0);
+			break;
+		case 'g':
+			plb_tgt_nr = strtoul(optarg, NULL, 0);
+			break;
+		case 'o':
+			plb_obj_nr = strtoull(optarg, &endp, 0);
+			if (*endp == 'k' || *endp == 'K')
+				plb_obj_nr *= 1000;
+			else if (*endp == 'm' || *endp == 'M')
+				plb_obj_nr *= 1000 * 1000;
+			break;
+		case 'c':
+			oclass = daos_oclass_name2id(optarg);
+			if (oclass < 0) {
+				fprintf(stderr, "unknown class %s\n", optarg);
+				return -1;
+			}
+			plb_oclass = oclass;
+			break;
+		case 'e':
+			events = optarg;
+			break;
+		case 's':
+			seed = strtoul(optarg, NULL, 0);
+			break;
+		case 'v':
+			plb_verbose = true;
+			break;
+		}
+	}
+
+	if (plb_node_nr == 0 || plb_tgt_nr == 0 || plb_obj_nr == 0 ||
+	    plb_rack_nr > plb_node_nr) {
+		fprintf(stderr, "invalid pool map or object number\n");
+		return -1;
+	}
+
+	rc = daos_debug_init(NULL);
+	if (rc != 0)
+		return rc;
+
+	srand(seed);
+	D_PRINT("%s map, %u racks, %u nodes, %u targets per node, seed %u\n",
+		plb_type == PL_TYPE_RING ? "ring" : "jump", plb_rack_nr,
+		plb_node_nr, plb_tgt_nr, seed);
+
+	node_nr = plb_node_nr;
+	plb_node_nr = 0;
+	rc = plb_nodes_add(node_nr, plb_ver);
+	if (rc)
+		D_GOTO(out, rc);
+
+	D_PRINT("\ninitial placement, version %u\n", plb_ver);
+	rc = plb_run(&cur);
+	if (rc)
+		D_GOTO(out, rc);
+
+	event = events == NULL ? NULL : strtok_r(events, ",", &saveptr);
+	for (; event != NULL; event = strtok_r(NULL, ",", &saveptr)) {
+		rc = plb_event_apply(event);
+		if (rc)
+			D_GOTO(out, rc);
+
+		plb_layouts_free(&prev);
+		prev = cur;
+		memset(&cur, 0, sizeof(cur));
+		rc = plb_run(&cur);
+		if (rc)
+			D_GOTO(out, rc);
+		plb_layouts_diff(&prev, &cur);
+	}
+out:
+	plb_layouts_free(&prev);
+	plb_layouts_free(&cur);
+	if (plb_nodes != NULL)
+		D_FREE(plb_nodes);
+	if (plb_tgts != NULL)
+		D_FREE(plb_tgts);
+	daos_debug_fini();
+	return rc;
+}
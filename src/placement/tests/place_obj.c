@@ -134,6 +134,21 @@ plt_add_tgt(uint32_t id)
 	plt_set_tgt_status(id, PO_COMP_ST_UP, po_ver);
 }
 
+/* add back a target whose shards are resynced by reintegration */
+static void
+plt_reint_tgt(uint32_t id)
+{
+	struct pool_target	*target;
+	int			 rc;
+
+	po_ver++;
+	plt_set_tgt_status(id, PO_COMP_ST_UP, po_ver);
+	rc = pool_map_find_target(po_map, id, &target);
+	D_ASSERT(rc == 1);
+	target->ta_comp.co_fseq = 0;
+	target->ta_comp.co_ver = po_ver;
+}
+
 static void
 plt_spare_tgts_get(uuid_t pl_uuid, daos_obj_id_t oid, uint32_t *failed_tgts,
 		   int failed_cnt, uint32_t *spare_tgt_ranks,
@@ -166,6 +181,91 @@ plt_spare_tgts_get(uuid_t pl_uuid, daos_obj_id_t oid, uint32_t *failed_tgts,
 		plt_add_tgt(failed_tgts[i]);
 }
 
+/** jump map: failing a target only moves the shard on it */
+static void
+plt_jump_map_test(daos_obj_id_t oid)
+{
+	struct pl_map_init_attr	 mia;
+	struct pl_obj_layout	*lo_1;
+	struct pl_obj_layout	*lo_2;
+	struct daos_obj_md	 md = { 0 };
+	uint32_t		 tgts[SPARE_MAX_NUM];
+	uint32_t		 shards[SPARE_MAX_NUM];
+	uint32_t		 failed;
+	int			 nr;
+	int			 i;
+	int			 j;
+	int			 rc;
+
+	D_PRINT("\ntest jump map placement ...\n");
+	mia.ia_type	    = PL_TYPE_JUMP;
+	mia.ia_jump.domain  = PO_COMP_TP_RACK;
+
+	rc = pl_map_create(po_map, &mia, &pl_map);
+	D_ASSERT(rc == 0);
+	pl_map_print(pl_map);
+
+	plt_obj_place(oid, &lo_1);
+	plt_obj_layout_check(lo_1);
+	/* replicas never share a domain */
+	for (i = 0; i < lo_1->ol_nr; i++) {
+		for (j = i + 1; j < lo_1->ol_nr; j++)
+			D_ASSERT(lo_1->ol_shards[i].po_target / TARGET_PER_DOM
+				 != lo_1->ol_shards[j].po_target /
+				 TARGET_PER_DOM);
+	}
+
+	failed = lo_1->ol_shards[0].po_target;
+	plt_fail_tgt(failed);
+	plt_obj_place(oid, &lo_2);
+	plt_obj_layout_check(lo_2);
+	D_ASSERT(lo_2->ol_shards[0].po_target != failed);
+	D_ASSERT(lo_2->ol_shards[0].po_rebuilding);
+	for (i = 1; i < lo_1->ol_nr; i++)
+		D_ASSERT(lo_1->ol_shards[i].po_target ==
+			 lo_2->ol_shards[i].po_target);
+	pl_obj_layout_free(lo_2);
+
+	plt_add_tgt(failed);
+	plt_obj_place(oid, &lo_2);
+	D_ASSERT(pt_obj_layout_match(lo_1, lo_2));
+	pl_obj_layout_free(lo_2);
+
+	/* the reintegrated target is back in place but skipped by reads */
+	D_PRINT("\ntest jump map reintegration ...\n");
+	plt_fail_tgt(failed);
+	plt_reint_tgt(failed);
+	plt_obj_place(oid, &lo_2);
+	D_ASSERT(pt_obj_layout_match(lo_1, lo_2));
+	D_ASSERT(lo_2->ol_shards[0].po_rebuilding);
+	for (i = 1; i < lo_2->ol_nr; i++)
+		D_ASSERT(!lo_2->ol_shards[i].po_rebuilding);
+
+	dc_obj_fetch_md(oid, &md);
+	md.omd_ver = po_ver;
+	nr = pl_obj_find_reint(pl_map, &md, NULL, po_ver, tgts, shards,
+			       SPARE_MAX_NUM);
+	D_ASSERT(nr == 1);
+	D_ASSERT(tgts[0] == failed);
+	D_ASSERT(shards[0] == lo_2->ol_shards[0].po_shard);
+	pl_obj_layout_free(lo_2);
+
+	/* nothing to resync once the target is in */
+	po_ver++;
+	plt_set_tgt_status(failed, PO_COMP_ST_UPIN, po_ver);
+	plt_obj_place(oid, &lo_2);
+	D_ASSERT(!lo_2->ol_shards[0].po_rebuilding);
+	md.omd_ver = po_ver;
+	nr = pl_obj_find_reint(pl_map, &md, NULL, po_ver, tgts, shards,
+			       SPARE_MAX_NUM);
+	D_ASSERT(nr == 0);
+
+	pl_obj_layout_free(lo_1);
+	pl_obj_layout_free(lo_2);
+	pl_map_decref(pl_map);
+	pl_map = NULL;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -319,6 +419,7 @@ main(int argc, char **argv)
 	D_ASSERT(spare_tgt_ranks[1] == spare_tgt_candidate[3]);
 	D_ASSERT(spare_tgt_ranks[2] == spare_tgt_candidate[4]);
 
+	plt_jump_map_test(oid);
 
 	pl_obj_layout_free(lo_1);
 	pl_obj_layout_free(lo_2);
@@ -82,6 +82,13 @@ pool_free(struct d_hlink *hlink)
 	if (pool->dp_map != NULL)
 		pool_map_decref(pool->dp_map);
 
+	if (pool->dp_cont_clients != NULL) {
+		int i;
+
+		for (i = 0; i < pool->dp_cont_svc_nr - 1; i++)
+			rsvc_client_fini(&pool->dp_cont_clients[i]);
+		D_FREE(pool->dp_cont_clients);
+	}
 	rsvc_client_fini(&pool->dp_client);
 	if (pool->dp_group != NULL)
 		daos_group_detach(pool->dp_group);
@@ -260,11 +267,13 @@ out:
 
 /*
  * Using "map_buf", "map_version", and "mode", update "pool->dp_map" and fill
- * "tgts" and/or "info", "prop" if not NULL.
+ * "tgts" and/or "info", "prop" if not NULL. If "delta_base" is not zero,
+ * "map_buf" is the delta of the pool map since that version.
  */
 static int
 process_query_reply(struct dc_pool *pool, struct pool_buf *map_buf,
-		    uint32_t map_version, uint32_t uid, uint32_t gid,
+		    uint32_t map_version, uint32_t delta_base,
+		    uint32_t uid, uint32_t gid,
 		    uint32_t mode, uint32_t leader_rank,
 		    struct daos_pool_space *ps, struct daos_rebuild_status *rs,
 		    d_rank_list_t *tgts, daos_pool_info_t *info,
@@ -272,18 +281,41 @@ process_query_reply(struct dc_pool *pool, struct pool_buf *map_buf,
 		    bool connect)
 {
 	struct pool_map	       *map;
+	unsigned int		ntargets = 0;
+	unsigned int		nnodes = 0;
 	int			rc;
 
-	rc = pool_map_create(map_buf, map_version, &map);
-	if (rc != 0) {
-		D_ERROR("failed to create local pool map: %d\n", rc);
-		return rc;
+	if (delta_base == 0) {
+		rc = pool_map_create(map_buf, map_version, &map);
+		if (rc != 0) {
+			D_ERROR("failed to create local pool map: %d\n", rc);
+			return rc;
+		}
+		D_RWLOCK_WRLOCK(&pool->dp_map_lock);
+	} else {
+		/* server guarantees that our map is not older than the base */
+		D_RWLOCK_WRLOCK(&pool->dp_map_lock);
+		D_ASSERT(pool->dp_map != NULL);
+		if (pool_map_get_version(pool->dp_map) >= map_version) {
+			map = pool->dp_map;
+			pool_map_addref(map);
+			rc = 0;
+		} else {
+			rc = pool_map_delta_apply(pool->dp_map, map_version,
+						  map_buf, &map);
+		}
+		if (rc != 0) {
+			D_ERROR("failed to apply pool map delta %u->%u: %d\n",
+				delta_base, map_version, rc);
+			D_GOTO(out_unlock, rc);
+		}
 	}
 
-	D_RWLOCK_WRLOCK(&pool->dp_map_lock);
 	rc = pool_map_update(pool, map, map_version, connect);
-	if (rc)
+	if (rc) {
+		pool_map_decref(map);
 		D_GOTO(out_unlock, rc);
+	}
 
 	/* Scan all targets for info->pi_ndisabled and/or tgts. */
 	if (info != NULL || tgts != NULL) {
@@ -306,6 +338,8 @@ process_query_reply(struct dc_pool *pool, struct pool_buf *map_buf,
 		}
 		rc = 0;
 	}
+	ntargets = pool_map_target_nr(map);
+	nnodes = pool_map_node_nr(map);
 	pool_map_decref(map); /* NB: protected by pool::dp_map_lock */
 out_unlock:
 	D_RWLOCK_UNLOCK(&pool->dp_map_lock);
@@ -317,8 +351,8 @@ out_unlock:
 		D_ASSERT(ps != NULL);
 		D_ASSERT(rs != NULL);
 		uuid_copy(info->pi_uuid, pool->dp_pool);
-		info->pi_ntargets	= map_buf->pb_target_nr;
-		info->pi_nnodes		= map_buf->pb_node_nr;
+		info->pi_ntargets	= ntargets;
+		info->pi_nnodes		= nnodes;
 		info->pi_map_ver	= map_version;
 		info->pi_uid		= uid;
 		info->pi_gid		= gid;
@@ -331,6 +365,48 @@ out_unlock:
 	return rc;
 }
 
+/*
+ * Initialize the clients of the \a nr - 1 container services other than the
+ * one combined with the pool service. They have the same replicas as the pool
+ * service.
+ */
+static int
+pool_cont_clients_init(struct dc_pool *pool, uint32_t nr)
+{
+	struct rsvc_client     *clients;
+	int			i;
+	int			rc = 0;
+
+	D_ASSERT(pool->dp_cont_clients == NULL);
+	if (nr <= 1) {
+		pool->dp_cont_svc_nr = 1;
+		return 0;
+	}
+
+	D_ALLOC_ARRAY(clients, nr - 1);
+	if (clients == NULL)
+		return -DER_NOMEM;
+
+	D_MUTEX_LOCK(&pool->dp_client_lock);
+	for (i = 0; i < nr - 1; i++) {
+		rc = rsvc_client_init(&clients[i], pool->dp_client.sc_ranks);
+		if (rc != 0)
+			break;
+	}
+	if (rc == 0) {
+		pool->dp_cont_clients = clients;
+		pool->dp_cont_svc_nr = nr;
+	}
+	D_MUTEX_UNLOCK(&pool->dp_client_lock);
+
+	if (rc != 0) {
+		while (--i >= 0)
+			rsvc_client_fini(&clients[i]);
+		D_FREE(clients);
+	}
+	return rc;
+}
+
 /*
  * Returns:
  *
@@ -409,7 +485,8 @@ pool_connect_cp(tse_task_t *task, void *data)
 	}
 
 	rc = process_query_reply(pool, map_buf, pco->pco_op.po_map_version,
-				 pco->pco_uid, pco->pco_gid, pco->pco_mode,
+				 0 /* delta_base */, pco->pco_uid, pco->pco_gid,
+				 pco->pco_mode,
 				 pco->pco_op.po_hint.sh_rank,
 				 &pco->pco_space, &pco->pco_rebuild_st,
 				 NULL /* tgts */, info, NULL, NULL, true);
@@ -419,6 +496,10 @@ pool_connect_cp(tse_task_t *task, void *data)
 		D_GOTO(out, rc);
 	}
 
+	rc = pool_cont_clients_init(pool, pco->pco_cont_svc_nr);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
 	/* add pool to hhash */
 	dc_pool_hdl_link(pool);
 	dc_pool2hdl(pool, arg->hdlp);
@@ -765,7 +846,8 @@ out_task:
 struct dc_pool_glob {
 	/* magic number, DC_POOL_GLOB_MAGIC */
 	uint32_t	dpg_magic;
-	uint32_t	dpg_padding;
+	/* number of container services */
+	uint32_t	dpg_cont_svc_nr;
 	/* pool group_id, uuid, and capas */
 	char		dpg_group_id[CRT_GROUP_ID_MAX_LEN];
 	uuid_t		dpg_pool;
@@ -818,7 +900,7 @@ swap_pool_glob(struct dc_pool_glob *pool_glob)
 	D_ASSERT(pool_glob != NULL);
 
 	D_SWAP32S(&pool_glob->dpg_magic);
-	/* skip pool_glob->dpg_padding */
+	D_SWAP32S(&pool_glob->dpg_cont_svc_nr);
 	/* skip pool_glob->dpg_group_id[] */
 	/* skip pool_glob->dpg_pool (uuid_t) */
 	/* skip pool_glob->dpg_pool_hdl (uuid_t) */
@@ -882,6 +964,7 @@ dc_pool_l2g(daos_handle_t poh, daos_iov_t *glob)
 	/* init pool global handle */
 	pool_glob = (struct dc_pool_glob *)glob->iov_buf;
 	pool_glob->dpg_magic = DC_POOL_GLOB_MAGIC;
+	pool_glob->dpg_cont_svc_nr = pool->dp_cont_svc_nr;
 	strncpy(pool_glob->dpg_group_id, pool->dp_group->cg_grpid,
 		sizeof(pool_glob->dpg_group_id) - 1);
 	pool_glob->dpg_group_id[sizeof(pool_glob->dpg_group_id) - 1] = '\0';
@@ -965,6 +1048,10 @@ dc_pool_g2l(struct dc_pool_glob *pool_glob, size_t len, daos_handle_t *poh)
 		D_GOTO(out, rc);
 	D_ASSERTF(rc == client_len, "%d == %zu\n", rc, client_len);
 
+	rc = pool_cont_clients_init(pool, pool_glob->dpg_cont_svc_nr);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
 	rc = pool_map_create(map_buf, pool_glob->dpg_map_version,
 			     &pool->dp_map);
 	if (rc != 0) {
@@ -1272,7 +1359,8 @@ pool_query_cb(tse_task_t *task, void *data)
 
 	rc = process_query_reply(arg->dqa_pool, map_buf,
 				 out->pqo_op.po_map_version,
-				 out->pqo_uid, out->pqo_gid, out->pqo_mode,
+				 out->pqo_map_delta_base, out->pqo_uid,
+				 out->pqo_gid, out->pqo_mode,
 				 out->pqo_op.po_hint.sh_rank,
 				 &out->pqo_space, &out->pqo_rebuild_st,
 				 arg->dqa_tgts, arg->dqa_info,
@@ -1375,6 +1463,11 @@ dc_pool_query(tse_task_t *task)
 	uuid_copy(in->pqi_op.pi_uuid, pool->dp_pool);
 	uuid_copy(in->pqi_op.pi_hdl, pool->dp_pool_hdl);
 	in->pqi_query_bits = pool_query_bits(args->prop);
+	/* the pool service can send the pool map delta since this version */
+	D_RWLOCK_RDLOCK(&pool->dp_map_lock);
+	in->pqi_map_version = pool->dp_map == NULL ?
+			      0 : pool_map_get_version(pool->dp_map);
+	D_RWLOCK_UNLOCK(&pool->dp_map_lock);
 
 	/** +1 for args */
 	crt_req_addref(rpc);
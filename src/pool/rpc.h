@@ -70,6 +70,9 @@
 	X(POOL_EXCLUDE_OUT,						\
 		0, &CQF_pool_exclude_out,				\
 		ds_pool_update_handler, NULL),				\
+	X(POOL_ADD_IN,							\
+		0, &CQF_pool_add_in,					\
+		ds_pool_update_handler, NULL),				\
 	X(POOL_SVC_STOP,						\
 		0, &CQF_pool_svc_stop,					\
 		ds_pool_svc_stop_handler, NULL),			\
@@ -150,7 +153,8 @@ CRT_RPC_DECLARE(pool_op, DAOS_ISEQ_POOL_OP, DAOS_OSEQ_POOL_OP)
 	((d_rank_list_t)	(pri_tgt_ranks)		CRT_PTR) \
 	((daos_prop_t)		(pri_prop)		CRT_PTR) \
 	((uint32_t)		(pri_ndomains)		CRT_VAR) \
-	((uint32_t)		(pri_padding)		CRT_VAR) \
+				/* number of container services */ \
+	((uint32_t)		(pri_cont_svc_nr)	CRT_VAR) \
 	((int32_t)		(pri_domains)		CRT_ARRAY)
 
 #define DAOS_OSEQ_POOL_CREATE	/* output fields */		 \
@@ -172,6 +176,9 @@ CRT_RPC_DECLARE(pool_create, DAOS_ISEQ_POOL_CREATE, DAOS_OSEQ_POOL_CREATE)
 	((uint32_t)		(pco_mode)		CRT_VAR) \
 	/* only set on -DER_TRUNC */				 \
 	((uint32_t)		(pco_map_buf_size)	CRT_VAR) \
+				/* number of container services */ \
+	((uint32_t)		(pco_cont_svc_nr)	CRT_VAR) \
+	((uint32_t)		(pco_padding)		CRT_VAR) \
 	((struct daos_pool_space) (pco_space)		CRT_VAR) \
 	((struct daos_rebuild_status) (pco_rebuild_st)	CRT_VAR)
 
@@ -199,7 +206,9 @@ CRT_RPC_DECLARE(pool_disconnect, DAOS_ISEQ_POOL_DISCONNECT,
 #define DAOS_ISEQ_POOL_QUERY	/* input fields */		 \
 	((struct pool_op_in)	(pqi_op)		CRT_VAR) \
 	((crt_bulk_t)		(pqi_map_bulk)		CRT_VAR) \
-	((uint64_t)		(pqi_query_bits)	CRT_VAR)
+	((uint64_t)		(pqi_query_bits)	CRT_VAR) \
+	/* version of the client pool map, 0 if none */		 \
+	((uint32_t)		(pqi_map_version)	CRT_VAR)
 
 #define DAOS_OSEQ_POOL_QUERY	/* output fields */		 \
 	((struct pool_op_out)	(pqo_op)		CRT_VAR) \
@@ -208,6 +217,8 @@ CRT_RPC_DECLARE(pool_disconnect, DAOS_ISEQ_POOL_DISCONNECT,
 	((uint32_t)		(pqo_mode)		CRT_VAR) \
 	/* only set on -DER_TRUNC */				 \
 	((uint32_t)		(pqo_map_buf_size)	CRT_VAR) \
+	/* base version if the bulk holds a map delta */	 \
+	((uint32_t)		(pqo_map_delta_base)	CRT_VAR) \
 	((daos_prop_t)		(pqo_prop)		CRT_PTR) \
 	((struct daos_pool_space) (pqo_space)		CRT_VAR) \
 	((struct daos_rebuild_status) (pqo_rebuild_st)	CRT_VAR)
@@ -285,6 +296,8 @@ CRT_RPC_DECLARE(pool_exclude, DAOS_ISEQ_POOL_TGT_UPDATE,
 		DAOS_OSEQ_POOL_TGT_UPDATE)
 CRT_RPC_DECLARE(pool_exclude_out, DAOS_ISEQ_POOL_TGT_UPDATE,
 		DAOS_OSEQ_POOL_TGT_UPDATE)
+CRT_RPC_DECLARE(pool_add_in, DAOS_ISEQ_POOL_TGT_UPDATE,
+		DAOS_OSEQ_POOL_TGT_UPDATE)
 
 #define DAOS_ISEQ_POOL_EVICT	/* input fields */		 \
 	((struct pool_op_in)	(pvi_op)		CRT_VAR)
@@ -309,7 +322,7 @@ CRT_RPC_DECLARE(pool_svc_stop, DAOS_ISEQ_POOL_SVC_STOP, DAOS_OSEQ_POOL_SVC_STOP)
 	((uint32_t)		(tci_map_version)	CRT_VAR) \
 	((uint32_t)		(tci_iv_ns_id)		CRT_VAR) \
 	((uint32_t)		(tci_master_rank)	CRT_VAR) \
-	((uint32_t)		(tci_pad)		CRT_VAR) \
+	((uint32_t)		(tci_cont_svc_nr)	CRT_VAR) \
 	((daos_iov_t)		(tci_iv_ctxt)		CRT_VAR)
 
 #define DAOS_OSEQ_POOL_TGT_CONNECT /* output fields */		 \
@@ -353,7 +366,8 @@ CRT_RPC_DECLARE(pool_tgt_update_map, DAOS_ISEQ_POOL_TGT_UPDATE_MAP,
 	((uuid_t)		(dai_dbid)		CRT_VAR) \
 	((uuid_t)		(dai_pool)		CRT_VAR) \
 	((uint32_t)		(dai_flags)		CRT_VAR) \
-	((uint32_t)		(dai_padding)		CRT_VAR) \
+				/* container service ID or 0 */ \
+	((uint32_t)		(dai_cont_svc)		CRT_VAR) \
 	((uint64_t)		(dai_size)		CRT_VAR) \
 	((d_rank_list_t)	(dai_ranks)		CRT_PTR)
 
@@ -55,6 +55,12 @@ struct pool_iv_entry {
 	uuid_t		piv_pool_uuid;
 	uint32_t	piv_pool_map_ver;
 	uint32_t	piv_master_rank;
+	/**
+	 * If non-zero, piv_pool_buf is the delta of the pool map since this
+	 * version rather than the full map, see pool_map_delta_extract().
+	 */
+	uint32_t	piv_delta_base;
+	uint32_t	piv_padding;
 	struct pool_buf	piv_pool_buf;
 };
 
@@ -68,6 +74,10 @@ int ds_pool_svc_start(uuid_t uuid, bool create, uuid_t db_uuid, size_t size,
 int ds_pool_svc_start_all(void);
 int ds_pool_svc_stop(uuid_t uuid, bool destroy);
 int ds_pool_svc_stop_all(void);
+int ds_pool_cont_svc_start(const uuid_t pool_uuid, uint64_t id, bool create,
+			   uuid_t db_uuid, size_t size,
+			   d_rank_list_t *replicas);
+int ds_pool_cont_svc_stop_all(const uuid_t pool_uuid, bool destroy);
 void ds_pool_create_handler(crt_rpc_t *rpc);
 void ds_pool_connect_handler(crt_rpc_t *rpc);
 void ds_pool_disconnect_handler(crt_rpc_t *rpc);
@@ -105,8 +115,8 @@ void ds_pool_child_purge(struct pool_tls *tls);
  */
 
 int ds_pool_rdb_dist_start(const uuid_t dbid, const uuid_t pool_uuid,
-			   const d_rank_list_t *ranks, bool create,
-			   bool bootstrap, size_t size);
+			   uint32_t cont_svc, const d_rank_list_t *ranks,
+			   bool create, bool bootstrap, size_t size);
 int ds_pool_rdb_dist_stop(const uuid_t pool_uuid, const d_rank_list_t *ranks,
 			  bool destroy);
 void ds_pool_rdb_start_handler(crt_rpc_t *rpc);
@@ -135,5 +145,6 @@ int ds_pool_iv_fini(void);
 int pool_iv_update(void *ns, struct pool_iv_entry *pool_iv,
 		   unsigned int shortcut, unsigned int sync_mode);
 int pool_iv_fetch(void *ns, struct pool_iv_entry *pool_iv);
+int pool_iv_map_fetch(struct ds_pool *pool);
 
 #endif /* __POOL_SRV_INTERNAL_H__ */
@@ -38,20 +38,35 @@ pool_iv_ent_size(int nr)
 	       sizeof(struct pool_buf);
 }
 
+/*
+ * IV values are fixed size buffers, a fetch can't learn the size of the map
+ * from a -DER_TRUNC reply like a client does, so they are sized for the
+ * largest map: XXX one node plus POOL_IV_MAP_TGTS_PER_RANK targets for each
+ * rank of the primary group.
+ */
+#define POOL_IV_MAP_TGTS_PER_RANK	19
+
+/* Number of pool buf components an IV value has room for */
+static int
+pool_iv_map_nr(void)
+{
+	uint32_t	rank_nr;
+
+	crt_group_size(NULL, &rank_nr);
+	return (int)rank_nr * (1 + POOL_IV_MAP_TGTS_PER_RANK);
+}
+
 static int
 pool_iv_value_alloc_internal(d_sg_list_t *sgl)
 {
 	uint32_t	buf_size;
-	uint32_t	pool_nr;
 	int		rc;
 
 	rc = daos_sgl_init(sgl, 1);
 	if (rc)
 		return rc;
 
-	/* XXX Let's use primary group  + 1 domain per target now. */
-	crt_group_size(NULL, &pool_nr);
-	buf_size = pool_iv_ent_size((int)pool_nr * 2 * 10);
+	buf_size = pool_iv_ent_size(pool_iv_map_nr());
 	D_ALLOC(sgl->sg_iovs[0].iov_buf, buf_size);
 	if (sgl->sg_iovs[0].iov_buf == NULL)
 		D_GOTO(free, rc = -DER_NOMEM);
@@ -114,6 +129,7 @@ pool_iv_ent_copy(d_sg_list_t *dst, d_sg_list_t *src)
 	dst_iv->piv_master_rank = src_iv->piv_master_rank;
 	uuid_copy(dst_iv->piv_pool_uuid, src_iv->piv_pool_uuid);
 	dst_iv->piv_pool_map_ver = src_iv->piv_pool_map_ver;
+	dst_iv->piv_delta_base = src_iv->piv_delta_base;
 
 	if (src_iv->piv_pool_buf.pb_nr > 0) {
 		int src_len = pool_buf_size(src_iv->piv_pool_buf.pb_nr);
@@ -135,11 +151,77 @@ pool_iv_ent_copy(d_sg_list_t *dst, d_sg_list_t *src)
 	return 0;
 }
 
+/*
+ * Copy the full pool map cached in the ds_pool of \a src_iv to \a dst. The
+ * IV root is the pool service leader, whose cached map is always current.
+ */
+static int
+pool_iv_ent_copy_map(d_sg_list_t *dst, struct pool_iv_entry *src_iv)
+{
+	struct pool_iv_entry	*dst_iv = dst->sg_iovs[0].iov_buf;
+	struct ds_pool		*pool;
+	struct pool_buf		*buf = NULL;
+	uint32_t		 map_ver = 0;
+	int			 dst_len;
+	int			 rc;
+
+	pool = ds_pool_lookup(src_iv->piv_pool_uuid);
+	if (pool == NULL)
+		return -DER_NONEXIST;
+
+	ABT_rwlock_rdlock(pool->sp_lock);
+	if (pool->sp_map != NULL) {
+		rc = pool_buf_extract(pool->sp_map, &buf);
+		map_ver = pool_map_get_version(pool->sp_map);
+	} else {
+		rc = -DER_NONEXIST;
+	}
+	ABT_rwlock_unlock(pool->sp_lock);
+	ds_pool_put(pool);
+	if (rc != 0)
+		return rc;
+
+	dst_len = dst->sg_iovs[0].iov_buf_len - sizeof(*dst_iv) +
+		  sizeof(struct pool_buf);
+	if (dst_len < pool_buf_size(buf->pb_nr)) {
+		D_ERROR("dst %d\n src %d\n", dst_len,
+			(int)pool_buf_size(buf->pb_nr));
+		D_GOTO(out, rc = -DER_REC2BIG);
+	}
+
+	dst_iv->piv_master_rank = src_iv->piv_master_rank;
+	uuid_copy(dst_iv->piv_pool_uuid, src_iv->piv_pool_uuid);
+	dst_iv->piv_pool_map_ver = map_ver;
+	dst_iv->piv_delta_base = 0;
+	memcpy(&dst_iv->piv_pool_buf, buf, pool_buf_size(buf->pb_nr));
+	dst->sg_iovs[0].iov_len = pool_iv_ent_size(buf->pb_nr);
+out:
+	pool_buf_free(buf);
+	return rc;
+}
+
 static int
 pool_iv_ent_fetch(struct ds_iv_entry *entry, d_sg_list_t *dst, d_sg_list_t *src,
 		  void **priv)
 {
-	return pool_iv_ent_copy(dst, src);
+	struct pool_iv_entry	*src_iv = src->sg_iovs[0].iov_buf;
+	d_rank_t		 rank;
+	int			 rc;
+
+	/*
+	 * A fetch is for the full map. If the cached value is a delta or a
+	 * bare version, forward the fetch to the root, which has the map.
+	 */
+	if (src_iv->piv_delta_base == 0 && src_iv->piv_pool_buf.pb_nr > 0)
+		return pool_iv_ent_copy(dst, src);
+
+	rc = crt_group_rank(NULL, &rank);
+	if (rc != 0)
+		return rc;
+	if (rank != entry->ns->iv_master_rank)
+		return -DER_IVCB_FORWARD;
+
+	return pool_iv_ent_copy_map(dst, src_iv);
 }
 
 static int
@@ -170,9 +252,15 @@ pool_iv_ent_refresh(d_sg_list_t *dst, d_sg_list_t *src, int ref_rc, void **priv)
 		return 0;
 	}
 
-	rc = ds_pool_tgt_map_update(pool, src_iv->piv_pool_buf.pb_nr > 0 ?
-				    &src_iv->piv_pool_buf : NULL,
-				    src_iv->piv_pool_map_ver);
+	if (src_iv->piv_delta_base != 0)
+		rc = ds_pool_tgt_map_update_delta(pool, &src_iv->piv_pool_buf,
+						  src_iv->piv_delta_base,
+						  src_iv->piv_pool_map_ver);
+	else
+		rc = ds_pool_tgt_map_update(pool,
+					    src_iv->piv_pool_buf.pb_nr > 0 ?
+					    &src_iv->piv_pool_buf : NULL,
+					    src_iv->piv_pool_map_ver);
 	ds_pool_put(pool);
 
 	return rc;
@@ -221,6 +309,33 @@ pool_iv_fetch(void *ns, struct pool_iv_entry *pool_iv)
 	return rc;
 }
 
+/*
+ * Fetch the full pool map of \a pool from the IV root, for a target whose
+ * cached map is too old to apply a delta. The map is installed by
+ * pool_iv_ent_refresh() once the fetched value reaches this node.
+ */
+int
+pool_iv_map_fetch(struct ds_pool *pool)
+{
+	struct pool_iv_entry	*iv_entry;
+	int			 nr;
+	int			 rc;
+
+	if (pool->sp_iv_ns == NULL)
+		return 0;
+
+	nr = pool_iv_map_nr();
+	D_ALLOC(iv_entry, pool_iv_ent_size(nr));
+	if (iv_entry == NULL)
+		return -DER_NOMEM;
+
+	iv_entry->piv_pool_buf.pb_nr = nr;
+	rc = pool_iv_fetch(pool->sp_iv_ns, iv_entry);
+
+	D_FREE(iv_entry);
+	return rc;
+}
+
 int
 pool_iv_update(void *ns, struct pool_iv_entry *pool_iv,
 	       unsigned int shortcut, unsigned int sync_mode)
@@ -40,6 +40,7 @@ RDB_STRING_KEY(ds_pool_prop_, space_rb);
 RDB_STRING_KEY(ds_pool_prop_, self_heal);
 RDB_STRING_KEY(ds_pool_prop_, reclaim);
 RDB_STRING_KEY(ds_pool_prop_, nhandles);
+RDB_STRING_KEY(ds_pool_prop_, cont_svc_nr);
 
 /** pool handle KVS */
 RDB_STRING_KEY(ds_pool_prop_, handles);
@@ -52,6 +52,10 @@
  *                 Bit: 31      3N    2N      N      0
  *                       v       v     v      v      v
  *   ds_pool_prop_mode:  [padding][user][group][other]
+ *
+ * ds_pool_prop_cont_svc_nr stores the number of container services the
+ * container metadata is sharded over. Container service 0 is combined with
+ * the pool service; the others have their own DBs. If absent, it's 1.
  */
 extern daos_iov_t ds_pool_prop_uid;		/* uint32_t */
 extern daos_iov_t ds_pool_prop_gid;		/* uint32_t */
@@ -64,6 +68,7 @@ extern daos_iov_t ds_pool_prop_space_rb;	/* uint64_t */
 extern daos_iov_t ds_pool_prop_self_heal;	/* uint64_t */
 extern daos_iov_t ds_pool_prop_reclaim;		/*  uint64_t */
 extern daos_iov_t ds_pool_prop_nhandles;	/* uint32_t */
+extern daos_iov_t ds_pool_prop_cont_svc_nr;	/* uint32_t (optional) */
 
 /** pool handle KVS */
 extern daos_iov_t ds_pool_prop_handles;		/* pool handle KVS */
@@ -59,6 +59,11 @@ struct pool_svc {
 	rdb_path_t		ps_handles;	/* pool handle KVS */
 	rdb_path_t		ps_user;	/* pool user attributes KVS */
 	struct ds_pool	       *ps_pool;
+	/* pool map delta, see pool_svc_delta_update() */
+	struct pool_buf	       *ps_delta;	/* changes since base */
+	uint32_t		ps_delta_base;	/* 0 if no base */
+	uint32_t		ps_delta_ver;	/* version ps_delta leads to */
+	uint32_t		ps_map_pushed;	/* map version pushed in term */
 };
 
 static struct pool_svc *
@@ -292,6 +297,55 @@ pool_svc_rdb_uuid_remove(const uuid_t pool_uuid)
 	return rc;
 }
 
+/* Return the RDB path of container service \a id (> 0). */
+char *
+ds_pool_cont_svc_rdb_path(const uuid_t pool_uuid, uint64_t id)
+{
+	char	suffix[32];
+
+	snprintf(suffix, sizeof(suffix), "-cont-"DF_U64, id);
+	return pool_svc_rdb_path_common(pool_uuid, suffix);
+}
+
+/* Return the RDB UUID file path of container service \a id (> 0). */
+static char *
+cont_svc_rdb_uuid_path(const uuid_t pool_uuid, uint64_t id)
+{
+	char	suffix[32];
+
+	snprintf(suffix, sizeof(suffix), "-cont-"DF_U64"-uuid", id);
+	return pool_svc_rdb_path_common(pool_uuid, suffix);
+}
+
+static int
+cont_svc_rdb_uuid_store(const uuid_t pool_uuid, uint64_t id,
+			const uuid_t uuid)
+{
+	char   *path;
+	int	rc;
+
+	path = cont_svc_rdb_uuid_path(pool_uuid, id);
+	if (path == NULL)
+		return -DER_NOMEM;
+	rc = uuid_store(path, uuid);
+	D_FREE(path);
+	return rc;
+}
+
+static int
+cont_svc_rdb_uuid_load(const uuid_t pool_uuid, uint64_t id, uuid_t uuid)
+{
+	char   *path;
+	int	rc;
+
+	path = cont_svc_rdb_uuid_path(pool_uuid, id);
+	if (path == NULL)
+		return -DER_NOMEM;
+	rc = uuid_load(path, uuid);
+	D_FREE(path);
+	return rc;
+}
+
 /*
  * Called by mgmt module on every storage node belonging to this pool.
  * "path" is the directory under which the VOS and metadata files shall be.
@@ -634,6 +688,34 @@ get_md_cap(void)
 	return (size_t)n << 20;
 }
 
+/* Number of container services of a new pool; see DAOS_CONT_SVC_NR. */
+static uint32_t
+get_cont_svc_nr(const d_rank_list_t *ranks)
+{
+	char   *v;
+	int	n;
+
+	if (DAOS_FAIL_CHECK(DAOS_POOL_CONT_SVC_NR)) {
+		n = daos_fail_value_get();
+		if (n < 1)
+			return 1;
+		goto out;
+	}
+
+	v = getenv("DAOS_CONT_SVC_NR");
+	if (v == NULL)
+		return 1;
+	n = atoi(v);
+	if (n < 1) {
+		D_ERROR("invalid DAOS_CONT_SVC_NR %s; using 1\n", v);
+		return 1;
+	}
+out:
+	if (n > ranks->rl_nr)
+		n = ranks->rl_nr;
+	return n;
+}
+
 /**
  * Create a (combined) pool(/container) service. This method shall be called on
  * a single storage node in the pool. "target_uuids" shall be an array of the
@@ -653,6 +735,9 @@ get_md_cap(void)
  * \param[in,out]	svc_addrs	\a svc_addrs.rl_nr inputs how many
  *					replicas shall be created; returns the
  *					list of pool service replica ranks
+ *
+ * If DAOS_CONT_SVC_NR is greater than 1, the additional container services
+ * are created on the same replica ranks, each with its own DB.
  */
 int
 ds_pool_svc_create(const uuid_t pool_uuid, unsigned int uid, unsigned int gid,
@@ -669,6 +754,8 @@ ds_pool_svc_create(const uuid_t pool_uuid, unsigned int uid, unsigned int gid,
 	crt_rpc_t	       *rpc;
 	struct pool_create_in  *in;
 	struct pool_create_out *out;
+	uint32_t		cont_svc_nr;
+	uint32_t		i;
 	int			rc;
 
 	D_ASSERTF(ntargets == target_addrs->rl_nr, "ntargets=%u num=%u\n",
@@ -680,12 +767,25 @@ ds_pool_svc_create(const uuid_t pool_uuid, unsigned int uid, unsigned int gid,
 		D_GOTO(out, rc);
 
 	uuid_generate(rdb_uuid);
-	rc = ds_pool_rdb_dist_start(rdb_uuid, pool_uuid, ranks,
-				    true /* create */, true /* bootstrap */,
-				    get_md_cap());
+	rc = ds_pool_rdb_dist_start(rdb_uuid, pool_uuid, 0 /* cont_svc */,
+				    ranks, true /* create */,
+				    true /* bootstrap */, get_md_cap());
 	if (rc != 0)
 		D_GOTO(out_ranks, rc);
 
+	cont_svc_nr = get_cont_svc_nr(ranks);
+	for (i = 1; i < cont_svc_nr; i++) {
+		uuid_t cont_rdb_uuid;
+
+		uuid_generate(cont_rdb_uuid);
+		rc = ds_pool_rdb_dist_start(cont_rdb_uuid, pool_uuid, i, ranks,
+					    true /* create */,
+					    true /* bootstrap */,
+					    get_md_cap());
+		if (rc != 0)
+			D_GOTO(out_creation, rc);
+	}
+
 	rc = rsvc_client_init(&client, ranks);
 	if (rc != 0)
 		D_GOTO(out_creation, rc);
@@ -714,6 +814,7 @@ rechoose:
 	in->pri_ndomains = ndomains;
 	in->pri_domains.ca_count = ndomains;
 	in->pri_domains.ca_arrays = (int *)domains;
+	in->pri_cont_svc_nr = cont_svc_nr;
 
 	/* Send the POOL_CREATE request. */
 	rc = dss_rpc_send(rpc);
@@ -906,11 +1007,23 @@ err:
 	return rc;
 }
 
+/* Forget the pool map delta, the next update will send the full map. */
+static void
+pool_svc_delta_reset(struct pool_svc *svc)
+{
+	if (svc->ps_delta != NULL)
+		pool_buf_free(svc->ps_delta);
+	svc->ps_delta = NULL;
+	svc->ps_delta_base = 0;
+	svc->ps_delta_ver = 0;
+}
+
 static void
 pool_svc_free_cb(struct ds_rsvc *rsvc)
 {
 	struct pool_svc *svc = pool_svc_obj(rsvc);
 
+	pool_svc_delta_reset(svc);
 	ds_cont_svc_fini(&svc->ps_cont_svc);
 	rdb_path_fini(&svc->ps_user);
 	rdb_path_fini(&svc->ps_handles);
@@ -928,16 +1041,30 @@ pool_svc_step_up_cb(struct ds_rsvc *rsvc)
 	d_rank_list_t		       *replicas = NULL;
 	struct pool_map		       *map = NULL;
 	uint32_t			map_version;
+	uint32_t			cont_svc_nr = 1;
 	struct ds_pool_create_arg	arg;
+	daos_iov_t			value;
 	d_rank_t			rank;
 	int				rc;
 
-	/* Read the pool map into map and map_version. */
+	/*
+	 * Read the pool map into map and map_version, and the number of
+	 * container services into cont_svc_nr.
+	 */
 	rc = rdb_tx_begin(rsvc->s_db, rsvc->s_term, &tx);
 	if (rc != 0)
 		goto out;
 	ABT_rwlock_rdlock(svc->ps_lock);
 	rc = read_map(&tx, &svc->ps_root, &map);
+	if (rc == 0) {
+		daos_iov_set(&value, &cont_svc_nr, sizeof(cont_svc_nr));
+		rc = rdb_tx_lookup(&tx, &svc->ps_root,
+				   &ds_pool_prop_cont_svc_nr, &value);
+		if (rc == -DER_NONEXIST) {
+			cont_svc_nr = 1;
+			rc = 0;
+		}
+	}
 	if (rc == 0)
 		rc = rdb_get_ranks(rsvc->s_db, &replicas);
 	ABT_rwlock_unlock(svc->ps_lock);
@@ -995,6 +1122,7 @@ pool_svc_step_up_cb(struct ds_rsvc *rsvc)
 	} else {
 		map = NULL; /* taken over by pool */
 	}
+	pool->sp_cont_svc_nr = cont_svc_nr;
 	ABT_rwlock_unlock(pool->sp_lock);
 
 	ds_cont_svc_step_up(svc->ps_cont_svc);
@@ -1030,6 +1158,8 @@ pool_svc_step_down_cb(struct ds_rsvc *rsvc)
 	D_ASSERT(svc->ps_pool != NULL);
 	ds_pool_put(svc->ps_pool);
 	svc->ps_pool = NULL;
+	pool_svc_delta_reset(svc);
+	svc->ps_map_pushed = 0;
 
 	rc = crt_group_rank(NULL, &rank);
 	D_ASSERTF(rc == 0, "%d\n", rc);
@@ -1186,6 +1316,90 @@ ds_pool_svc_stop(uuid_t uuid, bool destroy)
 	return rc;
 }
 
+/*
+ * Start container service \a id (> 0) of pool \a pool_uuid. If create is false,
+ * db_uuid, size, and replicas are ignored.
+ */
+int
+ds_pool_cont_svc_start(const uuid_t pool_uuid, uint64_t id, bool create,
+		       uuid_t db_uuid, size_t size, d_rank_list_t *replicas)
+{
+	uuid_t	db_uuid_buf;
+	int	rc;
+
+	if (!create) {
+		rc = cont_svc_rdb_uuid_load(pool_uuid, id, db_uuid_buf);
+		if (rc != 0) {
+			D_ERROR(DF_UUID": failed to load container service "
+				DF_U64" DB UUID: %d\n", DP_UUID(pool_uuid), id,
+				rc);
+			return rc;
+		}
+		db_uuid = db_uuid_buf;
+	}
+
+	rc = ds_cont_svc_start(pool_uuid, id, db_uuid, create, size, replicas);
+	if (rc != 0 && rc != -DER_ALREADY && !(create && rc == -DER_EXIST)) {
+		D_ERROR(DF_UUID": failed to start container service "DF_U64
+			": %d\n", DP_UUID(pool_uuid), id, rc);
+		return rc;
+	}
+
+	if (create) {
+		rc = cont_svc_rdb_uuid_store(pool_uuid, id, db_uuid);
+		if (rc != 0) {
+			ds_cont_svc_stop(pool_uuid, id, create /* destroy */);
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Stop all container services (other than the one combined with the pool
+ * service) of pool \a pool_uuid that have replicas here, i.e., whose DB UUID
+ * files exist. They are numbered from 1 without holes.
+ */
+int
+ds_pool_cont_svc_stop_all(const uuid_t pool_uuid, bool destroy)
+{
+	uint64_t	id;
+	char	       *path;
+	struct stat	st;
+	int		rc = 0;
+
+	for (id = 1; ; id++) {
+		path = cont_svc_rdb_uuid_path(pool_uuid, id);
+		if (path == NULL)
+			return -DER_NOMEM;
+		if (stat(path, &st) != 0) {
+			D_FREE(path);
+			break;
+		}
+
+		rc = ds_cont_svc_stop(pool_uuid, id, destroy);
+		if (rc != 0 && rc != -DER_ALREADY) {
+			D_ERROR(DF_UUID": failed to stop container service "
+				DF_U64": %d\n", DP_UUID(pool_uuid), id, rc);
+			D_FREE(path);
+			break;
+		}
+		rc = 0;
+
+		if (destroy && remove(path) != 0) {
+			D_ERROR(DF_UUID": failed to remove %s: %d\n",
+				DP_UUID(pool_uuid), path, errno);
+			rc = daos_errno2der(errno);
+			D_FREE(path);
+			break;
+		}
+		D_FREE(path);
+	}
+
+	return rc;
+}
+
 /*
  * Try to start a pool's pool service if its RDB exists. Continue the iteration
  * upon errors as other pools may still be able to work.
@@ -1195,6 +1409,7 @@ start_one(uuid_t uuid, void *arg)
 {
 	char	       *path;
 	struct stat	st;
+	uint64_t	id;
 	int		rc;
 
 	/*
@@ -1224,6 +1439,23 @@ start_one(uuid_t uuid, void *arg)
 	}
 
 	D_DEBUG(DB_MD, "started pool service "DF_UUID"\n", DP_UUID(uuid));
+
+	/* Start the container services that have replicas here, if any. */
+	for (id = 1; ; id++) {
+		path = ds_pool_cont_svc_rdb_path(uuid, id);
+		if (path == NULL)
+			break;
+		rc = stat(path, &st);
+		D_FREE(path);
+		if (rc != 0)
+			break;
+		rc = ds_pool_cont_svc_start(uuid, id, false /* create */,
+					    NULL /* db_uuid */, 0 /* size */,
+					    NULL /* replicas */);
+		if (rc != 0)
+			D_ERROR("failed to start container service "DF_U64
+				" of "DF_UUID": %d\n", id, DP_UUID(uuid), rc);
+	}
 	return 0;
 }
 
@@ -1264,6 +1496,11 @@ ds_pool_svc_start_all(void)
 int
 ds_pool_svc_stop_all(void)
 {
+	int rc;
+
+	rc = ds_rsvc_stop_all(DS_RSVC_CLASS_CONT);
+	if (rc != 0)
+		return rc;
 	return ds_rsvc_stop_all(DS_RSVC_CLASS_POOL);
 }
 
@@ -1491,6 +1728,14 @@ ds_pool_create_handler(crt_rpc_t *rpc)
 	rc = ds_cont_init_metadata(&tx, &svc->ps_root, in->pri_op.pi_uuid);
 	if (rc != 0)
 		D_GOTO(out_tx, rc);
+	if (in->pri_cont_svc_nr > 1) {
+		daos_iov_set(&value, &in->pri_cont_svc_nr,
+			     sizeof(in->pri_cont_svc_nr));
+		rc = rdb_tx_update(&tx, &svc->ps_root,
+				   &ds_pool_prop_cont_svc_nr, &value);
+		if (rc != 0)
+			D_GOTO(out_tx, rc);
+	}
 
 	rc = rdb_tx_commit(&tx);
 	if (rc != 0)
@@ -1560,6 +1805,10 @@ permitted(const struct pool_prop_ugm *ugm, uint32_t uid, uint32_t gid,
 	return (capas & capas_permitted) == capas;
 }
 
+static int pool_map_update(crt_context_t ctx, struct pool_svc *svc,
+			   uint32_t map_version, struct pool_buf *buf,
+			   uint32_t delta_base, unsigned int sync_mode);
+
 static int
 pool_connect_bcast(crt_context_t ctx, struct pool_svc *svc,
 		   const uuid_t pool_hdl, uint64_t capas,
@@ -1591,6 +1840,7 @@ pool_connect_bcast(crt_context_t ctx, struct pool_svc *svc,
 	in->tci_iv_ctxt.iov_buf_len = global_ns->iov_buf_len;
 	in->tci_iv_ctxt.iov_len = global_ns->iov_len;
 	in->tci_master_rank = rank;
+	in->tci_cont_svc_nr = svc->ps_pool->sp_cont_svc_nr;
 
 	rc = dss_rpc_send(rpc);
 	if (rc != 0)
@@ -1631,7 +1881,8 @@ bulk_cb(const struct crt_bulk_cb_info *cb_info)
  */
 static int
 transfer_map_buf(struct rdb_tx *tx, struct pool_svc *svc, crt_rpc_t *rpc,
-		 crt_bulk_t remote_bulk, uint32_t *required_buf_size)
+		 crt_bulk_t remote_bulk, uint32_t cli_version,
+		 uint32_t *delta_base, uint32_t *required_buf_size)
 {
 	struct pool_buf	       *map_buf;
 	size_t			map_buf_size;
@@ -1662,6 +1913,20 @@ transfer_map_buf(struct rdb_tx *tx, struct pool_svc *svc, crt_rpc_t *rpc,
 		D_GOTO(out, rc = -DER_IO);
 	}
 
+	/*
+	 * Send the delta instead if the client map is not older than its
+	 * base. The caller holds ps_lock, so ps_delta can't change under us.
+	 */
+	*delta_base = 0;
+	if (svc->ps_delta != NULL && svc->ps_delta_ver == map_version &&
+	    cli_version >= svc->ps_delta_base && cli_version <= map_version) {
+		D_DEBUG(DF_DSMS, DF_UUID": send map delta %u->%u to %u\n",
+			DP_UUID(svc->ps_uuid), svc->ps_delta_base, map_version,
+			cli_version);
+		map_buf = svc->ps_delta;
+		*delta_base = svc->ps_delta_base;
+	}
+
 	map_buf_size = pool_buf_size(map_buf->pb_nr);
 
 	/* Check if the client bulk buffer is large enough. */
@@ -1732,6 +1997,7 @@ ds_pool_connect_handler(crt_rpc_t *rpc)
 	daos_iov_t			iv_iov;
 	unsigned int			iv_ns_id;
 	uint32_t			nhandles;
+	uint32_t			delta_base;
 	int				skip_update = 0;
 	int				rc;
 
@@ -1814,6 +2080,7 @@ ds_pool_connect_handler(crt_rpc_t *rpc)
 	 * its pool_buf away.
 	 */
 	rc = transfer_map_buf(&tx, svc, rpc, in->pci_map_bulk,
+			      0 /* cli_version */, &delta_base,
 			      &out->pco_map_buf_size);
 	if (rc != 0)
 		D_GOTO(out_map_version, rc);
@@ -1856,6 +2123,32 @@ ds_pool_connect_handler(crt_rpc_t *rpc)
 		D_GOTO(out_map_version, rc);
 	}
 
+	/*
+	 * The leaders of the other container services need the full pool map
+	 * to create the pool group for their broadcasts. Push it to all
+	 * targets before the client can reach them, once per map version in
+	 * this term; later deltas keep the target maps up to date.
+	 */
+	if (svc->ps_pool->sp_cont_svc_nr > 1 &&
+	    svc->ps_map_pushed != pool_map_get_version(svc->ps_pool->sp_map)) {
+		struct pool_buf *map_buf;
+
+		rc = pool_buf_extract(svc->ps_pool->sp_map, &map_buf);
+		if (rc != 0)
+			D_GOTO(out_map_version, rc);
+		rc = pool_map_update(rpc->cr_ctx, svc,
+				     pool_map_get_version(svc->ps_pool->sp_map),
+				     map_buf, 0 /* delta_base */,
+				     CRT_IV_SYNC_EAGER);
+		pool_buf_free(map_buf);
+		if (rc != 0) {
+			D_ERROR(DF_UUID": failed to distribute pool map: %d\n",
+				DP_UUID(in->pci_op.pi_uuid), rc);
+			D_GOTO(out_map_version, rc);
+		}
+		svc->ps_map_pushed = pool_map_get_version(svc->ps_pool->sp_map);
+	}
+
 	hdl.ph_capas = in->pci_capas;
 	nhandles++;
 
@@ -1873,6 +2166,7 @@ ds_pool_connect_handler(crt_rpc_t *rpc)
 	rc = rdb_tx_commit(&tx);
 out_map_version:
 	out->pco_op.po_map_version = pool_map_get_version(svc->ps_pool->sp_map);
+	out->pco_cont_svc_nr = svc->ps_pool->sp_cont_svc_nr;
 out_lock:
 	ABT_rwlock_unlock(svc->ps_lock);
 	rdb_tx_end(&tx);
@@ -2135,6 +2429,7 @@ ds_pool_query_handler(crt_rpc_t *rpc)
 	out->pqo_prop = prop;
 
 	rc = transfer_map_buf(&tx, svc, rpc, in->pqi_map_bulk,
+			      in->pqi_map_version, &out->pqo_map_delta_base,
 			      &out->pqo_map_buf_size);
 	if (rc != 0)
 		D_GOTO(out_map_version, rc);
@@ -2159,9 +2454,46 @@ out:
 	daos_prop_free(prop);
 }
 
+/* Number of versions a pool map delta can span before sending a full map */
+#define POOL_MAP_DELTA_SPAN	64
+
+/*
+ * Called with ps_lock held for writing after pool map \a prev is replaced by
+ * \a map, to maintain the cumulative delta from version ps_delta_base to
+ * \a map. If the delta can't be extracted, is too large, or spans too many
+ * versions, it is rebased on \a map, i.e. the full map of this version is
+ * sent; targets and clients missing that map will fetch it in full later.
+ */
+static void
+pool_svc_delta_update(struct pool_svc *svc, struct pool_map *prev,
+		      struct pool_map *map)
+{
+	struct pool_buf	*delta = NULL;
+	uint32_t	 version = pool_map_get_version(map);
+	int		 rc = -DER_MISMATCH;
+
+	if (svc->ps_delta_base != 0 && prev != NULL &&
+	    pool_map_get_version(prev) == svc->ps_delta_ver &&
+	    version - svc->ps_delta_base <= POOL_MAP_DELTA_SPAN)
+		rc = pool_map_delta_extract(prev, map, svc->ps_delta, &delta);
+
+	if (rc != 0) {
+		D_DEBUG(DF_DSMS, DF_UUID": rebase map delta on %u: %d\n",
+			DP_UUID(svc->ps_uuid), version, rc);
+		pool_svc_delta_reset(svc);
+		svc->ps_delta_base = version;
+	} else {
+		if (svc->ps_delta != NULL)
+			pool_buf_free(svc->ps_delta);
+		svc->ps_delta = delta;
+	}
+	svc->ps_delta_ver = version;
+}
+
 static int
 pool_map_update(crt_context_t ctx, struct pool_svc *svc,
-		uint32_t map_version, struct pool_buf *buf)
+		uint32_t map_version, struct pool_buf *buf,
+		uint32_t delta_base, unsigned int sync_mode)
 {
 	struct pool_iv_entry	*iv_entry;
 	uint32_t		size;
@@ -2186,9 +2518,10 @@ pool_map_update(crt_context_t ctx, struct pool_svc *svc,
 	crt_group_rank(svc->ps_pool->sp_group, &iv_entry->piv_master_rank);
 	uuid_copy(iv_entry->piv_pool_uuid, svc->ps_uuid);
 	iv_entry->piv_pool_map_ver = map_version;
+	iv_entry->piv_delta_base = delta_base;
 	memcpy(&iv_entry->piv_pool_buf, buf, pool_buf_size(buf->pb_nr));
 	rc = pool_iv_update(svc->ps_pool->sp_iv_ns, iv_entry,
-			    CRT_IV_SHORTCUT_NONE, CRT_IV_SYNC_LAZY);
+			    CRT_IV_SHORTCUT_NONE, sync_mode);
 
 	/* Some nodes ivns does not exist, might because of the disconnection,
 	 * let's ignore it
@@ -2214,6 +2547,8 @@ ds_pool_update_internal(uuid_t pool_uuid, struct pool_target_id_list *tgts,
 	uint32_t		map_version_before;
 	uint32_t		map_version = 0;
 	struct pool_buf	       *map_buf = NULL;
+	struct pool_buf	       *delta_buf = NULL;
+	uint32_t		delta_base = 0;
 	struct pool_map	       *map_tmp;
 	bool			updated = false;
 	struct dss_module_info *info = dss_get_module_info();
@@ -2283,6 +2618,14 @@ ds_pool_update_internal(uuid_t pool_uuid, struct pool_target_id_list *tgts,
 	svc->ps_pool->sp_map_version = map_version;
 	ABT_rwlock_unlock(svc->ps_pool->sp_lock);
 
+	/* Distribute the delta rather than the full map if possible. */
+	pool_svc_delta_update(svc, map, svc->ps_pool->sp_map);
+	if (svc->ps_delta != NULL) {
+		delta_buf = pool_buf_dup(svc->ps_delta);
+		if (delta_buf != NULL)
+			delta_base = svc->ps_delta_base;
+	}
+
 out_map:
 	pool_map_decref(map);
 out_replicas:
@@ -2303,8 +2646,12 @@ out_map_version:
 	 * dissemination.
 	 */
 	if (updated)
-		pool_map_update(info->dmi_ctx, svc, map_version, map_buf);
+		pool_map_update(info->dmi_ctx, svc, map_version,
+				delta_buf != NULL ? delta_buf : map_buf,
+				delta_base, CRT_IV_SYNC_LAZY);
 
+	if (delta_buf != NULL)
+		pool_buf_free(delta_buf);
 	if (map_buf != NULL)
 		pool_buf_free(map_buf);
 out_svc:
@@ -2403,6 +2750,13 @@ ds_pool_tgt_exclude(uuid_t pool_uuid, struct pool_target_id_list *list)
 				       NULL, NULL, NULL);
 }
 
+int
+ds_pool_tgt_add_in(uuid_t pool_uuid, struct pool_target_id_list *list)
+{
+	return ds_pool_update_internal(pool_uuid, list, POOL_ADD_IN,
+				       NULL, NULL, NULL);
+}
+
 void
 ds_pool_update_handler(crt_rpc_t *rpc)
 {
@@ -2447,7 +2801,8 @@ out:
 	rc = crt_reply_send(rpc);
 
 	if (out->pto_op.po_rc == 0 && updated &&
-	    opc_get(rpc->cr_opc) == POOL_EXCLUDE) {
+	    (opc_get(rpc->cr_opc) == POOL_EXCLUDE ||
+	     opc_get(rpc->cr_opc) == POOL_ADD)) {
 		char	*env;
 		int	 ret;
 
@@ -2459,7 +2814,9 @@ out:
 			D_ASSERT(replicas != NULL);
 			ret = ds_rebuild_schedule(in->pti_op.pi_uuid,
 				out->pto_op.po_map_version,
-				&target_list, replicas);
+				&target_list, replicas,
+				opc_get(rpc->cr_opc) == POOL_ADD ?
+				RB_OP_REINT : RB_OP_FAIL);
 			if (ret != 0) {
 				D_ERROR("rebuild fails rc %d\n", ret);
 				if (rc == 0)
@@ -3163,8 +3520,8 @@ ds_pool_replicas_update_handler(crt_rpc_t *rpc)
 
 	switch (opc) {
 	case POOL_REPLICAS_ADD:
-		rc = ds_pool_rdb_dist_start(dbid, psid, in->pmi_targets,
-					    true /* create */,
+		rc = ds_pool_rdb_dist_start(dbid, psid, 0 /* cont_svc */,
+					    in->pmi_targets, true /* create */,
 					    false /* bootstrap */,
 					    get_md_cap());
 		if (rc != 0)
@@ -56,6 +56,8 @@ bcast_create(crt_opcode_t opc, crt_group_t *group, crt_rpc_t **rpc);
  *
  * \param[in]	dbid		database UUID
  * \param[in]	pool_uuid	pool UUID (for ds_mgmt_tgt_file())
+ * \param[in]	cont_svc	container service ID, or 0 for the pool
+ *				service
  * \param[in]	ranks		list of replica ranks
  * \param[in]	create		create replicas first
  * \param[in]	bootstrap	start with an initial list of replicas
@@ -63,8 +65,8 @@ bcast_create(crt_opcode_t opc, crt_group_t *group, crt_rpc_t **rpc);
  */
 int
 ds_pool_rdb_dist_start(const uuid_t dbid, const uuid_t pool_uuid,
-		       const d_rank_list_t *ranks, bool create, bool bootstrap,
-		       size_t size)
+		       uint32_t cont_svc, const d_rank_list_t *ranks,
+		       bool create, bool bootstrap, size_t size)
 {
 	crt_rpc_t			*rpc;
 	struct pool_rdb_start_in	*in;
@@ -85,6 +87,7 @@ ds_pool_rdb_dist_start(const uuid_t dbid, const uuid_t pool_uuid,
 	in = crt_req_get(rpc);
 	uuid_copy(in->dai_dbid, dbid);
 	uuid_copy(in->dai_pool, pool_uuid);
+	in->dai_cont_svc = cont_svc;
 	if (create)
 		in->dai_flags |= RDB_AF_CREATE;
 	if (bootstrap)
@@ -133,12 +136,20 @@ ds_pool_rdb_start_handler(crt_rpc_t *rpc)
 			D_GOTO(out, rc = 0);
 	}
 
-	rc = ds_pool_svc_start(in->dai_pool, create, in->dai_dbid, in->dai_size,
-			       (in->dai_flags & RDB_AF_BOOTSTRAP) ?
-			       in->dai_ranks : NULL);
+	if (in->dai_cont_svc != 0)
+		rc = ds_pool_cont_svc_start(in->dai_pool, in->dai_cont_svc,
+					    create, in->dai_dbid, in->dai_size,
+					    (in->dai_flags & RDB_AF_BOOTSTRAP) ?
+					    in->dai_ranks : NULL);
+	else
+		rc = ds_pool_svc_start(in->dai_pool, create, in->dai_dbid,
+				       in->dai_size,
+				       (in->dai_flags & RDB_AF_BOOTSTRAP) ?
+				       in->dai_ranks : NULL);
 	if (rc != 0)
-		D_ERROR(DF_UUID": failed to start pool service: %d\n",
-			DP_UUID(in->dai_dbid), rc);
+		D_ERROR(DF_UUID": failed to start %s service: %d\n",
+			DP_UUID(in->dai_dbid),
+			in->dai_cont_svc != 0 ? "container" : "pool", rc);
 
 out:
 	out->dao_rc = (rc == 0 ? 0 : 1);
@@ -224,6 +235,14 @@ ds_pool_rdb_stop_handler(crt_rpc_t *rpc)
 			D_GOTO(out, rc = 0);
 	}
 
+	rc = ds_pool_cont_svc_stop_all(in->doi_pool,
+				       in->doi_flags & RDB_OF_DESTROY);
+	if (rc != 0) {
+		D_ERROR(DF_UUID": failed to stop container services: %d\n",
+			DP_UUID(in->doi_pool), rc);
+		D_GOTO(out, rc);
+	}
+
 	rc = ds_pool_svc_stop(in->doi_pool, in->doi_flags & RDB_OF_DESTROY);
 	if (rc != 0)
 		D_ERROR(DF_UUID": failed to stop pool service: %d\n",
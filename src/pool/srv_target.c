@@ -387,6 +387,45 @@ ds_pool_put(struct ds_pool *pool)
 	ABT_mutex_unlock(pool_cache_lock);
 }
 
+/**
+ * Make sure \a pool has its group, which is created from the cached pool map
+ * if it does not exist on this node yet. Used by container service leaders
+ * that are not colocated with the pool service leader.
+ */
+int
+ds_pool_group_init(struct ds_pool *pool)
+{
+	char		id[DAOS_UUID_STR_SIZE];
+	crt_group_t    *group;
+	int		rc;
+
+	if (pool->sp_group != NULL)
+		return 0;
+
+	uuid_unparse_lower(pool->sp_uuid, id);
+	group = crt_group_lookup(id);
+	if (group == NULL) {
+		ABT_rwlock_rdlock(pool->sp_lock);
+		if (pool->sp_map == NULL)
+			rc = -DER_NONEXIST;
+		else
+			rc = ds_pool_group_create(pool->sp_uuid, pool->sp_map,
+						  &group);
+		ABT_rwlock_unlock(pool->sp_lock);
+		if (rc != 0) {
+			D_ERROR(DF_UUID": failed to create pool group: %d\n",
+				DP_UUID(pool->sp_uuid), rc);
+			return rc;
+		}
+	}
+
+	ABT_rwlock_wrlock(pool->sp_lock);
+	if (pool->sp_group == NULL)
+		pool->sp_group = group;
+	ABT_rwlock_unlock(pool->sp_lock);
+	return 0;
+}
+
 /* ds_pool_hdl ****************************************************************/
 
 static struct d_hash_table *pool_hdl_hash;
@@ -684,6 +723,7 @@ ds_pool_tgt_connect_handler(crt_rpc_t *rpc)
 	uuid_copy(hdl->sph_uuid, in->tci_hdl);
 	hdl->sph_capas = in->tci_capas;
 	hdl->sph_pool = pool;
+	pool->sp_cont_svc_nr = in->tci_cont_svc_nr;
 
 	rc = pool_hdl_add(hdl);
 	if (rc != 0) {
@@ -796,21 +836,15 @@ update_child_map(void *data)
 	return 0;
 }
 
-int
-ds_pool_tgt_map_update(struct ds_pool *pool, struct pool_buf *buf,
-		       unsigned int map_version)
+/*
+ * Install \a map, which can be NULL, as the cached pool map of \a map_version.
+ * The reference of \a map is consumed.
+ */
+static int
+pool_tgt_map_install(struct ds_pool *pool, struct pool_map *map,
+		     unsigned int map_version)
 {
-	struct pool_map *map = NULL;
-	int		rc = 0;
-
-	if (buf != NULL) {
-		rc = pool_map_create(buf, map_version, &map);
-		if (rc != 0) {
-			D_ERROR(DF_UUID" failed to create pool map: %d\n",
-				DP_UUID(pool->sp_uuid), rc);
-			D_GOTO(out, rc);
-		}
-	}
+	int rc = 0;
 
 	ABT_rwlock_wrlock(pool->sp_lock);
 	if (pool->sp_map_version < map_version ||
@@ -848,7 +882,89 @@ ds_pool_tgt_map_update(struct ds_pool *pool, struct pool_buf *buf,
 	if (map)
 		pool_map_decref(map);
 
-out:
+	return rc;
+}
+
+int
+ds_pool_tgt_map_update(struct ds_pool *pool, struct pool_buf *buf,
+		       unsigned int map_version)
+{
+	struct pool_map *map = NULL;
+	int		rc;
+
+	if (buf != NULL) {
+		rc = pool_map_create(buf, map_version, &map);
+		if (rc != 0) {
+			D_ERROR(DF_UUID" failed to create pool map: %d\n",
+				DP_UUID(pool->sp_uuid), rc);
+			return rc;
+		}
+	}
+
+	return pool_tgt_map_install(pool, map, map_version);
+}
+
+static void
+pool_tgt_map_fetch_ult(void *arg)
+{
+	struct ds_pool	*pool = arg;
+	int		 rc;
+
+	rc = pool_iv_map_fetch(pool);
+	if (rc != 0)
+		D_ERROR(DF_UUID": failed to fetch pool map: %d\n",
+			DP_UUID(pool->sp_uuid), rc);
+	ds_pool_put(pool);
+}
+
+/**
+ * Update the cached pool map with the delta \a buf since pool map version
+ * \a base, see pool_map_delta_extract(). If the cached map is older than
+ * \a base, the delta can't be applied: the map version is updated, and the
+ * full map is fetched from the IV root in the background.
+ */
+int
+ds_pool_tgt_map_update_delta(struct ds_pool *pool, struct pool_buf *buf,
+			     unsigned int base, unsigned int map_version)
+{
+	struct pool_map *map = NULL;
+	struct ds_pool	*ref;
+	bool		 stale = false;
+	int		 rc = 0;
+
+	ABT_rwlock_rdlock(pool->sp_lock);
+	if (pool->sp_map == NULL || pool_map_get_version(pool->sp_map) < base)
+		stale = true;
+	else if (pool_map_get_version(pool->sp_map) < map_version)
+		rc = pool_map_delta_apply(pool->sp_map, map_version, buf, &map);
+	ABT_rwlock_unlock(pool->sp_lock);
+
+	if (rc != 0) {
+		D_ERROR(DF_UUID": failed to apply pool map delta %u->%u: %d\n",
+			DP_UUID(pool->sp_uuid), base, map_version, rc);
+		return rc;
+	}
+
+	if (map != NULL)
+		return pool_tgt_map_install(pool, map, map_version);
+
+	D_DEBUG(DF_DSMS, DF_UUID": skip pool map delta %u->%u\n",
+		DP_UUID(pool->sp_uuid), base, map_version);
+	rc = ds_pool_tgt_map_update(pool, NULL, map_version);
+	if (rc != 0 || !stale)
+		return rc;
+
+	/* Can't fetch from the IV callback, which holds the IV entry. */
+	ref = ds_pool_lookup(pool->sp_uuid);
+	if (ref == NULL)
+		return 0;
+	rc = dss_ult_create(pool_tgt_map_fetch_ult, ref, DSS_ULT_SELF, 0, 0,
+			    NULL);
+	if (rc != 0) {
+		D_ERROR(DF_UUID": failed to create map fetch ULT: %d\n",
+			DP_UUID(pool->sp_uuid), rc);
+		ds_pool_put(ref);
+	}
 	return rc;
 }
 
@@ -943,10 +1059,8 @@ ds_pool_tgt_query_aggregator(crt_rpc_t *source, crt_rpc_t *result, void *priv)
 	return 0;
 }
 
-typedef int (*pool_iter_cb_t)(daos_handle_t ph, uuid_t co_uuid, void *arg);
-
 /* iterate all of the container of the pool. */
-static int
+int
 ds_pool_cont_iter(daos_handle_t ph, pool_iter_cb_t callback, void *arg)
 {
 	vos_iter_param_t param;
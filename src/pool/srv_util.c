@@ -327,6 +327,26 @@ ds_pool_map_tgts_update(struct pool_map *map, struct pool_target_id_list *tgts,
 			nchanges++;
 			dom->do_comp.co_status = PO_COMP_ST_UP;
 			dom->do_comp.co_ver = version;
+		} else if (opc == POOL_ADD_IN && pool_target_reint(target)) {
+			D_DEBUG(DF_DSMS, "change target %u/%u to UPIN %p\n",
+				target->ta_comp.co_rank,
+				target->ta_comp.co_index, map);
+			/* co_ver is the version the target joined the layout,
+			 * it has been stamped by POOL_ADD and must be kept:
+			 * ring placement groups targets by co_ver, and a map
+			 * merge takes a domain with co_ver == version as new,
+			 * so bumping it here would move the shards that have
+			 * just been resynchronized. Like the other
+			 * transitions, the rank follows its targets.
+			 */
+			target->ta_comp.co_status = PO_COMP_ST_UPIN;
+			nchanges++;
+			if (pool_map_node_status_match(dom,
+						       PO_COMP_ST_UPIN)) {
+				D_DEBUG(DF_DSMS, "change rank %u to UPIN\n",
+					dom->do_comp.co_rank);
+				dom->do_comp.co_status = PO_COMP_ST_UPIN;
+			}
 		} else if (opc == POOL_EXCLUDE_OUT &&
 			 target->ta_comp.co_status == PO_COMP_ST_DOWN) {
 			D_DEBUG(DF_DSMS, "change target %u/%u to DOWNOUT %p\n",
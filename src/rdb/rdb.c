@@ -448,6 +448,20 @@ rdb_resign(struct rdb *db, uint64_t term)
 	rdb_raft_resign(db, term);
 }
 
+/**
+ * Set whether this replica is preferred to be the leader. Replicated services
+ * may use this to spread the leaders of their DBs over different replicas.
+ * Only a hint to elections; no leadership transfer is triggered.
+ *
+ * \param[in]	db	database
+ * \param[in]	prefer	whether this replica is preferred
+ */
+void
+rdb_prefer_leader(struct rdb *db, bool prefer)
+{
+	rdb_raft_prefer_leader(db, prefer);
+}
+
 /**
  * Is this replica in the leader state? True does not guarantee a _current_
  * leadership.
@@ -32,6 +32,7 @@
 #include <gurt/hash.h>
 #include <daos/lru.h>
 #include <daos/rpc.h>
+#include <daos_srv/daos_server.h>
 #include "rdb_layout.h"
 
 /* rdb_raft.c (parts required by struct rdb) **********************************/
@@ -70,7 +71,11 @@ struct rdb {
 	d_rank_list_t	       *d_replicas;
 	uint64_t		d_applied;	/* last applied index */
 	uint64_t		d_debut;	/* first entry in a term */
-	ABT_cond		d_applied_cv;	/* for d_applied updates */
+	double			d_contact;	/* last message from leader */
+	ABT_cond		d_applied_cv;	/* for d_applied, d_commits */
+	d_list_t		d_commits;	/* rdb_raft_commit queue */
+	bool			d_committing;	/* d_commits being appended */
+	bool			d_ae_defer;	/* hold AEs until flushed */
 	struct d_hash_table	d_results;	/* rdb_raft_result hash */
 	d_list_t		d_requests;	/* RPCs waiting for replies */
 	d_list_t		d_replies;	/* RPCs received replies */
@@ -79,8 +84,11 @@ struct rdb {
 	int			d_nevents;	/* d_events queue len from 0 */
 	ABT_cond		d_events_cv;	/* for d_events enqueues */
 	uint64_t		d_compact_thres;/* of compactable entries */
+	uint64_t		d_compact_lag;	/* log kept for followers */
+	int			d_election_timeout; /* base, in ms */
 	ABT_cond		d_compact_cv;	/* for base updates */
 	bool			d_stop;		/* for rdb_stop() */
+	struct dss_sleep_ult	d_timer_sleep;	/* for waking up d_timerd */
 	ABT_thread		d_timerd;
 	ABT_thread		d_callbackd;
 	ABT_thread		d_recvd;
@@ -118,12 +126,15 @@ struct rdb *rdb_lookup(const uuid_t uuid);
  * Per-raft_node_t INSTALLSNAPSHOT state
  *
  * dis_seq and dis_anchor track the last chunk successfully received by the
- * follower.
+ * follower. At most one chunk is in flight; dis_sent records when it was sent,
+ * so that a lost chunk is resent after the request timeout.
  */
 struct rdb_raft_is {
 	uint64_t		dis_index;	/* snapshot index */
 	uint64_t		dis_seq;	/* last sequence number */
 	struct rdb_anchor	dis_anchor;	/* last anchor */
+	bool			dis_inflight;	/* chunk awaiting reply */
+	double			dis_sent;	/* of the in-flight chunk */
 };
 
 /* Per-raft_node_t data */
@@ -133,20 +144,53 @@ struct rdb_raft_node {
 	/* Leader fields */
 	uint64_t		dn_term;	/* of leader */
 	struct rdb_raft_is	dn_is;
+	double			dn_lease_ack;	/* send time of last AE acked */
+	bool			dn_ae_deferred;	/* AE held back by d_ae_defer */
 };
 
+/* Maximum rate of clock drift between replicas */
+#define RDB_RAFT_LEASE_DRIFT	0.1
+
+/*
+ * Is a lease acknowledged by a majority since start (0 if none) still valid at
+ * now? The followers may time out as early as election_timeout (in ms) minus
+ * the drift margin.
+ */
+static inline bool
+rdb_raft_lease_unexpired(double start, double now, int election_timeout)
+{
+	double timeout = election_timeout / 1000.0 * (1 - RDB_RAFT_LEASE_DRIFT);
+
+	return start != 0 && now < start + timeout;
+}
+
+/*
+ * Shall a replica refuse to vote at now? True if it's the leader, or it has
+ * heard from a leader, or started, within election_timeout (in ms) before.
+ * A replica restarted with d_contact set to its start time therefore can't
+ * help elect a new leader while an old one may still hold its lease.
+ */
+static inline bool
+rdb_raft_vote_refused(bool leader, double contact, double now,
+		      int election_timeout)
+{
+	return leader || now - contact < election_timeout / 1000.0;
+}
+
 int rdb_raft_init(daos_handle_t pool, daos_handle_t mc,
 		  const d_rank_list_t *replicas);
 int rdb_raft_start(struct rdb *db);
 void rdb_raft_stop(struct rdb *db);
 void rdb_raft_resign(struct rdb *db, uint64_t term);
+void rdb_raft_prefer_leader(struct rdb *db, bool prefer);
 int rdb_raft_verify_leadership(struct rdb *db);
 int rdb_raft_append_apply(struct rdb *db, msg_entry_t *mentry, void *result);
 int rdb_raft_wait_applied(struct rdb *db, uint64_t index, uint64_t term);
 void rdb_requestvote_handler(crt_rpc_t *rpc);
 void rdb_appendentries_handler(crt_rpc_t *rpc);
 void rdb_installsnapshot_handler(crt_rpc_t *rpc);
-void rdb_raft_process_reply(struct rdb *db, raft_node_t *node, crt_rpc_t *rpc);
+void rdb_raft_process_reply(struct rdb *db, raft_node_t *node, crt_rpc_t *rpc,
+			    double sent);
 void rdb_raft_free_request(struct rdb *db, crt_rpc_t *rpc);
 
 /* rdb_rpc.c ******************************************************************/
@@ -25,7 +25,7 @@
  *
  * Each replica employs four daemon ULTs:
  *
- *   ~ rdb_timerd(): Call raft_periodic() periodically.
+ *   ~ rdb_timerd(): Call raft_periodic() at least twice per request timeout.
  *   ~ rdb_recvd(): Process RPC replies received.
  *   ~ rdb_callbackd(): Invoke user dc_step_{up,down} callbacks.
  *   ~ rdb_compactd(): Compact polled entries by calling rdb_lc_aggregate().
@@ -36,6 +36,12 @@
  * rdb's raft callbacks may return rdb errors (e.g., -DER_IO, -DER_NOSPACE,
  * etc.), rdb's and raft's error domains are disjoint (see the compile-time
  * assertion in rdb_raft_rc()).
+ *
+ * A leader holds a lease while a majority of replicas have acknowledged
+ * APPENDENTRIES sent within the last election timeout (minus a clock drift
+ * margin). Replicas that have heard from a leader within the election timeout
+ * do not vote for other candidates, so no other leader can be elected during
+ * the lease, and queries on the leader are served without a log round.
  */
 
 #define D_LOGFAC	DD_FAC(rdb)
@@ -180,6 +186,12 @@ rdb_raft_cb_send_appendentries(raft_server_t *raft, void *arg,
 	if (DAOS_FAIL_CHECK(DAOS_RDB_SKIP_APPENDENTRIES_FAIL))
 		D_GOTO(err, rc = 0);
 
+	/* Send one AE for the whole commit group in rdb_raft_flush_ae(). */
+	if (db->d_ae_defer) {
+		rdb_node->dn_ae_deferred = true;
+		return 0;
+	}
+
 	rc = rdb_create_raft_rpc(RDB_APPENDENTRIES, node, &rpc);
 	if (rc != 0) {
 		D_ERROR(DF_DB": failed to create AE RPC to node %d: %d\n",
@@ -441,6 +453,28 @@ rdb_raft_cb_send_installsnapshot(raft_server_t *raft, void *arg,
 	struct dss_module_info	       *info = dss_get_module_info();
 	int				rc;
 
+	/*
+	 * If the INSTALLSNAPSHOT state tracks a different term or snapshot,
+	 * reinitialize it for the current term and snapshot.
+	 */
+	if (rdb_node->dn_term != raft_get_current_term(raft) ||
+	    is->dis_index != msg->last_idx) {
+		rdb_node->dn_term = raft_get_current_term(raft);
+		is->dis_index = msg->last_idx;
+		is->dis_seq = 0;
+		rdb_anchor_set_zero(&is->dis_anchor);
+		is->dis_inflight = false;
+	}
+
+	/*
+	 * Do not pack and send the same chunk again on every heartbeat while
+	 * it is in flight. rdb_raft_process_reply() sends the next chunk as
+	 * soon as this one is acknowledged.
+	 */
+	if (is->dis_inflight && ABT_get_wtime() - is->dis_sent <
+	    raft_get_request_timeout(raft) / 1000.0)
+		return 0;
+
 	rc = rdb_create_raft_rpc(RDB_INSTALLSNAPSHOT, node, &rpc);
 	if (rc != 0) {
 		D_ERROR(DF_DB": failed to create IS RPC to rank %u: %d\n",
@@ -468,18 +502,6 @@ rdb_raft_cb_send_installsnapshot(raft_server_t *raft, void *arg,
 	if (data.iov_buf == NULL)
 		goto err_kds;
 
-	/*
-	 * If the INSTALLSNAPSHOT state tracks a different term or snapshot,
-	 * reinitialize it for the current term and snapshot.
-	 */
-	if (rdb_node->dn_term != raft_get_current_term(raft) ||
-	    is->dis_index != msg->last_idx) {
-		rdb_node->dn_term = raft_get_current_term(raft);
-		is->dis_index = msg->last_idx;
-		is->dis_seq = 0;
-		rdb_anchor_set_zero(&is->dis_anchor);
-	}
-
 	/* Pack the chunk's data, anchor, and seq. */
 	rc = rdb_raft_pack_chunk(db->d_lc, is, &kds, &data, &in->isi_anchor);
 	if (rc != 0)
@@ -519,6 +541,8 @@ rdb_raft_cb_send_installsnapshot(raft_server_t *raft, void *arg,
 			DP_DB(db), rdb_node->dn_rank, rc);
 		goto err_data_bulk;
 	}
+	is->dis_inflight = true;
+	is->dis_sent = ABT_get_wtime();
 
 	D_DEBUG(DB_TRACE, DF_DB": sent is to node %u rank %u: term=%d "
 		"last_idx=%d seq="DF_U64" kds.len="DF_U64" data.len="DF_U64"\n",
@@ -1187,17 +1211,11 @@ rdb_raft_log_offer_single(raft_server_t *raft, void *arg,
 		entry->data.buf = NULL;
 	}
 
-	/* Update the log tail. See the log tail assertion above. */
+	/*
+	 * Update the log tail in memory. See the log tail assertion above.
+	 * rdb_raft_cb_log_offer() persists it once for the whole batch.
+	 */
 	db->d_lc_record.dlr_tail++;
-	daos_iov_set(&values[0], &db->d_lc_record, sizeof(db->d_lc_record));
-	rc = rdb_mc_update(db->d_mc, RDB_MC_ATTRS, 1 /* n */, &rdb_mc_lc,
-			   &values[0]);
-	if (rc != 0) {
-		D_ERROR(DF_DB": failed to update log tail "DF_U64": %d\n",
-			DP_DB(db), db->d_lc_record.dlr_tail, rc);
-		db->d_lc_record.dlr_tail--;
-		goto err_discard;
-	}
 
 	D_DEBUG(DB_TRACE, DF_DB": appended entry "DF_U64": term=%d type=%d "
 		"buf=%p len=%u\n", DP_DB(db), index, entry->term, entry->type,
@@ -1216,8 +1234,12 @@ static int
 rdb_raft_cb_log_offer(raft_server_t *raft, void *arg, raft_entry_t *entries,
 		      int index, int *n_entries)
 {
-	int i;
-	int rc = 0;
+	struct rdb     *db = arg;
+	uint64_t	tail = db->d_lc_record.dlr_tail;
+	daos_iov_t	value;
+	int		i;
+	int		rc = 0;
+	int		rc_tmp;
 
 	for (i = 0; i < *n_entries; ++i) {
 		rc = rdb_raft_log_offer_single(raft, arg, &entries[i],
@@ -1225,6 +1247,31 @@ rdb_raft_cb_log_offer(raft_server_t *raft, void *arg, raft_entry_t *entries,
 		if (rc != 0)
 			break;
 	}
+	if (i == 0)
+		goto out;
+
+	/*
+	 * Persist the log tail once for all the entries appended above. If we
+	 * crash before this update, the entries remain beyond the persistent
+	 * log tail, and rdb_raft_start() will discard them.
+	 */
+	daos_iov_set(&value, &db->d_lc_record, sizeof(db->d_lc_record));
+	rc_tmp = rdb_mc_update(db->d_mc, RDB_MC_ATTRS, 1 /* n */, &rdb_mc_lc,
+			       &value);
+	if (rc_tmp != 0) {
+		D_ERROR(DF_DB": failed to update log tail "DF_U64": %d\n",
+			DP_DB(db), db->d_lc_record.dlr_tail, rc_tmp);
+		db->d_lc_record.dlr_tail = tail;
+		rdb_kvs_cache_evict(db->d_kvss);
+		rc = rdb_lc_discard(db->d_lc, tail, RDB_LC_INDEX_MAX);
+		if (rc != 0)
+			D_ERROR(DF_DB": failed to discard entries "DF_U64
+				": %d\n", DP_DB(db), tail, rc);
+		rc = rc_tmp;
+		i = 0;
+	}
+
+out:
 	*n_entries = i;
 	return rc;
 }
@@ -1345,6 +1392,37 @@ static raft_cbs_t rdb_raft_cbs = {
 	.log				= rdb_raft_cb_debug
 };
 
+/*
+ * If this is the leader, keep the log entries that followers lagging by at
+ * most db->d_compact_lag entries still need, so that they catch up from the
+ * log instead of requiring a snapshot. Return the index to compact to.
+ */
+static uint64_t
+rdb_raft_compact_limit(struct rdb *db, uint64_t index)
+{
+	d_rank_t	self;
+	int		i;
+
+	if (db->d_compact_lag == 0 || !raft_is_leader(db->d_raft))
+		return index;
+
+	self = raft_get_nodeid(db->d_raft);
+	for (i = 0; i < db->d_replicas->rl_nr; i++) {
+		raft_node_t    *node;
+		uint64_t	match;
+
+		if (db->d_replicas->rl_ranks[i] == self)
+			continue;
+		node = raft_get_node(db->d_raft, db->d_replicas->rl_ranks[i]);
+		if (node == NULL)
+			continue;
+		match = raft_node_get_match_idx(node);
+		if (match < index && db->d_applied - match <= db->d_compact_lag)
+			index = match;
+	}
+	return index;
+}
+
 /*
  * Check if the log should be compacted. If so, trigger the compaction by
  * taking a snapshot (i.e., simply increasing the log base index in our
@@ -1379,6 +1457,9 @@ rdb_raft_trigger_compaction(struct rdb *db)
 			index = base + 1;
 		else
 			index = base + n / 2;
+		index = rdb_raft_compact_limit(db, index);
+		if (index <= base)
+			return 0;
 		D_DEBUG(DB_TRACE, DF_DB": snapping "DF_U64"\n", DP_DB(db),
 			index);
 		rc = raft_begin_snapshot(db->d_raft, index);
@@ -1618,6 +1699,102 @@ rdb_callbackd(void *arg)
 	D_DEBUG(DB_MD, DF_DB": callbackd stopping\n", DP_DB(db));
 }
 
+/* Forget the acknowledgements of the previous terms. */
+static void
+rdb_raft_lease_reset(struct rdb *db)
+{
+	int	i;
+
+	for (i = 0; i < db->d_replicas->rl_nr; i++) {
+		raft_node_t	       *node;
+		struct rdb_raft_node   *rdb_node;
+
+		node = raft_get_node(db->d_raft, db->d_replicas->rl_ranks[i]);
+		if (node == NULL)
+			continue;
+		rdb_node = raft_node_get_udata(node);
+		rdb_node->dn_lease_ack = 0;
+	}
+}
+
+/*
+ * Return the time from which a majority of replicas, including this leader,
+ * have acknowledged the leadership, or 0 if there is no such majority.
+ */
+static double
+rdb_raft_lease_start(struct rdb *db)
+{
+	d_rank_t	self = raft_get_nodeid(db->d_raft);
+	int		n = db->d_replicas->rl_nr;
+	int		nacks = n / 2;	/* besides this leader */
+	double		start = 0;
+	int		i;
+	int		j;
+
+	if (nacks == 0)
+		return ABT_get_wtime();
+
+	/* Find the largest ack time that nacks replicas are at or after. */
+	for (i = 0; i < n; i++) {
+		struct rdb_raft_node   *ni;
+		raft_node_t	       *node;
+		int			cnt = 0;
+
+		if (db->d_replicas->rl_ranks[i] == self)
+			continue;
+		node = raft_get_node(db->d_raft, db->d_replicas->rl_ranks[i]);
+		if (node == NULL)
+			continue;
+		ni = raft_node_get_udata(node);
+		if (ni->dn_lease_ack <= start)
+			continue;
+
+		for (j = 0; j < n; j++) {
+			struct rdb_raft_node *nj;
+
+			if (db->d_replicas->rl_ranks[j] == self)
+				continue;
+			node = raft_get_node(db->d_raft,
+					     db->d_replicas->rl_ranks[j]);
+			if (node == NULL)
+				continue;
+			nj = raft_node_get_udata(node);
+			if (nj->dn_lease_ack >= ni->dn_lease_ack)
+				cnt++;
+		}
+		if (cnt >= nacks)
+			start = ni->dn_lease_ack;
+	}
+	return start;
+}
+
+/* Is this replica a leader holding a valid lease? */
+static bool
+rdb_raft_lease_valid(struct rdb *db)
+{
+	if (!raft_is_leader(db->d_raft))
+		return false;
+
+	/* See rdb_raft_prefer_leader for the followers' election timeouts. */
+	return rdb_raft_lease_unexpired(rdb_raft_lease_start(db),
+					ABT_get_wtime(),
+					db->d_election_timeout);
+}
+
+/*
+ * Shall this replica refuse to vote? True if it's the leader, or it has heard
+ * from a leader within the election timeout, which may still be relying on
+ * the acknowledgement of this replica for its lease. Whether this replica
+ * still knows that leader doesn't matter: it may have restarted, or timed out
+ * itself, while the lease was valid.
+ */
+static bool
+rdb_raft_lease_sticky(struct rdb *db)
+{
+	return rdb_raft_vote_refused(raft_is_leader(db->d_raft), db->d_contact,
+				     ABT_get_wtime(), db->d_election_timeout);
+}
+
 static int
 rdb_raft_step_up(struct rdb *db, uint64_t term)
 {
@@ -1640,6 +1817,7 @@ rdb_raft_step_up(struct rdb *db, uint64_t term)
 		return rdb_raft_rc(rc);
 	}
 	db->d_debut = mresponse.idx;
+	rdb_raft_lease_reset(db);
 	rdb_raft_queue_event(db, RDB_RAFT_STEP_UP, term);
 	return 0;
 }
@@ -1818,44 +1996,167 @@ rdb_raft_unregister_result(struct rdb *db, uint64_t index)
 }
 
 /* Append and wait for \a entry to be applied. */
-int
-rdb_raft_append_apply(struct rdb *db, msg_entry_t *mentry, void *result)
+/* rdb_raft_append_apply() call queued in rdb::d_commits */
+struct rdb_raft_commit {
+	d_list_t	drc_entry;	/* in rdb::d_commits */
+	msg_entry_t    *drc_mentry;
+	void	       *drc_result;
+	uint64_t	drc_index;
+	uint64_t	drc_term;
+	int		drc_rc;
+	bool		drc_done;	/* appended or failed */
+};
+
+/* Append the entry of commit to the log. Must not yield. */
+static void
+rdb_raft_append_one(struct rdb *db, struct rdb_raft_commit *commit)
 {
 	msg_entry_response_t	mresponse;
 	struct rdb_raft_state	state;
 	uint64_t		index;
 	int			rc;
 
-	/*
-	 * Do not yield before calling rdb_recv_entry(), so that the index
-	 * assertion below will hold.
-	 */
 	index = raft_get_current_idx(db->d_raft) + 1;
-	if (result != NULL) {
-		rc = rdb_raft_register_result(db, index, result);
+	if (commit->drc_result != NULL) {
+		rc = rdb_raft_register_result(db, index, commit->drc_result);
 		if (rc != 0)
 			goto out;
 	}
 
 	rdb_raft_save_state(db, &state);
-	rc = raft_recv_entry(db->d_raft, mentry, &mresponse);
+	rc = raft_recv_entry(db->d_raft, commit->drc_mentry, &mresponse);
 	rc = rdb_raft_check_state(db, &state, rc);
 	if (rc != 0) {
 		if (rc != -DER_NOTLEADER)
 			D_ERROR(DF_DB": failed to append entry: %d\n",
 				DP_DB(db), rc);
-		goto out_result;
+		if (commit->drc_result != NULL)
+			rdb_raft_unregister_result(db, index);
+		goto out;
 	}
 
 	/* The actual index must match the expected index. */
 	D_ASSERTF(mresponse.idx == index, "%d == "DF_U64"\n", mresponse.idx,
 		  index);
+	commit->drc_index = mresponse.idx;
+	commit->drc_term = mresponse.term;
+out:
+	commit->drc_rc = rc;
+}
+
+/* Send the AEs held back while appending a commit group. */
+static void
+rdb_raft_flush_ae(struct rdb *db)
+{
+	int i;
+	int rc;
+
+	for (i = 0; i < db->d_replicas->rl_nr; i++) {
+		struct rdb_raft_node   *rdb_node;
+		raft_node_t	       *node;
+
+		node = raft_get_node(db->d_raft, db->d_replicas->rl_ranks[i]);
+		if (node == NULL)
+			continue;
+		rdb_node = raft_node_get_udata(node);
+		if (rdb_node == NULL || !rdb_node->dn_ae_deferred)
+			continue;
+		rdb_node->dn_ae_deferred = false;
+		if (!raft_is_leader(db->d_raft))
+			continue;
+		rc = raft_send_appendentries(db->d_raft, node);
+		if (rc != 0)
+			D_ERROR(DF_DB": failed to send AE to rank %u: %d\n",
+				DP_DB(db), rdb_node->dn_rank, rdb_raft_rc(rc));
+	}
+}
+
+/*
+ * Append all queued commits back to back, so that raft replicates them in as
+ * few AE rounds as possible, and then wake up their TXs. The AEs raft would
+ * send for each entry are held back and sent once the group is appended, so
+ * that an up-to-date follower gets the whole group right away instead of one
+ * entry now and the rest on the reply.
+ *
+ * Unlike a follower, which persists the log tail once per AE batch, the leader
+ * still pays one rdb_lc_update() and one tail rdb_mc_update() per entry here:
+ * raft_recv_entry() takes one entry at a time, and each entry is an LC update
+ * at its own index anyway. Deferring the tail update to the end of the group
+ * isn't safe, since raft already holds the entries in memory by then, and
+ * can't drop them if that update fails.
+ */
+static void
+rdb_raft_append_group(struct rdb *db)
+{
+	struct rdb_raft_commit *commit;
+	struct rdb_raft_commit *tmp;
+	d_list_t		group;
+	int			n;
+
+	D_INIT_LIST_HEAD(&group);
+	ABT_mutex_lock(db->d_mutex);
+	while (!d_list_empty(&db->d_commits)) {
+		d_list_splice_init(&db->d_commits, &group);
+		ABT_mutex_unlock(db->d_mutex);
+
+		n = 0;
+		db->d_ae_defer = true;
+		d_list_for_each_entry(commit, &group, drc_entry) {
+			rdb_raft_append_one(db, commit);
+			n++;
+		}
+		db->d_ae_defer = false;
+		rdb_raft_flush_ae(db);
+		D_DEBUG(DB_TRACE, DF_DB": appended a group of %d entries\n",
+			DP_DB(db), n);
+
+		ABT_mutex_lock(db->d_mutex);
+		d_list_for_each_entry_safe(commit, tmp, &group, drc_entry) {
+			d_list_del_init(&commit->drc_entry);
+			commit->drc_done = true;
+		}
+		ABT_cond_broadcast(db->d_applied_cv);
+	}
+	db->d_committing = false;
+	ABT_mutex_unlock(db->d_mutex);
+}
 
-	rc = rdb_raft_wait_applied(db, mresponse.idx, mresponse.term);
+/*
+ * Append mentry to the log and wait for it to be applied. Concurrent callers
+ * are committed as a group: the first one yields once to let the others queue
+ * their entries, and then appends all of them on their behalf. Each caller
+ * still waits for its own entry, and gets its own result.
+ */
+int
+rdb_raft_append_apply(struct rdb *db, msg_entry_t *mentry, void *result)
+{
+	struct rdb_raft_commit	commit = {
+		.drc_mentry	= mentry,
+		.drc_result	= result
+	};
+	int			rc;
+
+	ABT_mutex_lock(db->d_mutex);
+	d_list_add_tail(&commit.drc_entry, &db->d_commits);
+	if (db->d_committing) {
+		while (!commit.drc_done)
+			ABT_cond_wait(db->d_applied_cv, db->d_mutex);
+		ABT_mutex_unlock(db->d_mutex);
+	} else {
+		db->d_committing = true;
+		ABT_mutex_unlock(db->d_mutex);
+		ABT_thread_yield();
+		rdb_raft_append_group(db);
+	}
+
+	rc = commit.drc_rc;
+	if (rc != 0)
+		goto out;
+
+	rc = rdb_raft_wait_applied(db, commit.drc_index, commit.drc_term);
 
-out_result:
 	if (result != NULL)
-		rdb_raft_unregister_result(db, mresponse.idx);
+		rdb_raft_unregister_result(db, commit.drc_index);
 out:
 	return rc;
 }
@@ -1866,6 +2167,10 @@ rdb_raft_verify_leadership(struct rdb *db)
 {
 	msg_entry_t		entry = {};
 
+	/* No other leader can be elected while we hold the lease. */
+	if (rdb_raft_lease_valid(db))
+		return 0;
+
 	entry.type = RAFT_LOGTYPE_NORMAL;
 	entry.data.buf = NULL;
 	entry.data.len = 0;
@@ -1883,19 +2188,41 @@ rdb_raft_rand(void)
 	return (double)rand() / RAND_MAX;
 }
 
+/*
+ * Sleep in the scheduler until wtime deadline or rdb_stop(). rdb_raft_stop()
+ * sets d_stop and wakes us up without yielding in between, and so do we when
+ * checking d_stop and going to sleep, as all rdb ULTs run on the same xstream.
+ */
+static void
+rdb_timerd_sleep(struct rdb *db, double deadline)
+{
+	if (!db->d_stop)
+		dss_ult_sleep(&db->d_timer_sleep, deadline);
+}
+
 /* Daemon ULT for raft_periodic() */
 static void
 rdb_timerd(void *arg)
 {
 	struct rdb     *db = arg;
-	const double	d_min = 0.5;	/* min duration between beats (s) */
-	const double	d_max = 1;	/* max duration between beats (s) */
+	double		d_min;		/* min duration between beats (s) */
+	double		d_max;		/* max duration between beats (s) */
 	double		d = 0;		/* duration till next beat (s) */
 	double		t;		/* timestamp of beat (s) */
 	double		t_prev;		/* timestamp of previous beat (s) */
 	int		rc;
 
-	D_DEBUG(DB_MD, DF_DB": timerd starting\n", DP_DB(db));
+	/*
+	 * Beat at least twice per request timeout, so that heartbeats are not
+	 * delayed by more than half of it, and at least once per second.
+	 */
+	d_max = raft_get_request_timeout(db->d_raft) / 1000.0 / 2;
+	if (d_max > 1)
+		d_max = 1;
+	d_min = d_max / 2;
+
+	D_DEBUG(DB_MD, DF_DB": timerd starting: beat=[%f, %f]s\n", DP_DB(db),
+		d_min, d_max);
 	t = ABT_get_wtime();
 	t_prev = t;
 	do {
@@ -1914,10 +2241,10 @@ rdb_timerd(void *arg)
 				DP_DB(db), rc);
 
 		t_prev = t;
-		/* Wait for d in [d_min, d_max] before the next beat. */
+		/* Sleep for d in [d_min, d_max] before the next beat. */
 		d = d_min + (d_max - d_min) * rdb_raft_rand();
-		while ((t = ABT_get_wtime()) < t_prev + d && !db->d_stop)
-			ABT_thread_yield();
+		rdb_timerd_sleep(db, t_prev + d);
+		t = ABT_get_wtime();
 	} while (!db->d_stop);
 	D_DEBUG(DB_MD, DF_DB": timerd stopping\n", DP_DB(db));
 }
@@ -2236,6 +2563,15 @@ rdb_raft_get_compact_thres(void)
 	return i == 0 ? UINT64_MAX : i;
 }
 
+static uint64_t
+rdb_raft_get_compact_lag(void)
+{
+	unsigned int i = 0;
+
+	d_getenv_int("RDB_COMPACT_LAG", &i);
+	return i;
+}
+
 int
 rdb_raft_start(struct rdb *db)
 {
@@ -2248,7 +2584,12 @@ rdb_raft_start(struct rdb *db)
 
 	D_INIT_LIST_HEAD(&db->d_requests);
 	D_INIT_LIST_HEAD(&db->d_replies);
+	D_INIT_LIST_HEAD(&db->d_commits);
+	db->d_committing = false;
+	/* we may have acknowledged a leader's lease right before a restart */
+	db->d_contact = ABT_get_wtime();
 	db->d_compact_thres = rdb_raft_get_compact_thres();
+	db->d_compact_lag = rdb_raft_get_compact_lag();
 
 	rc = d_hash_table_create_inplace(D_HASH_FT_NOLOCK, 4 /* bits */,
 					 NULL /* priv */,
@@ -2289,6 +2630,8 @@ rdb_raft_start(struct rdb *db)
 		goto err_replies_cv;
 	}
 
+	dss_sleep_ult_init(&db->d_timer_sleep);
+
 	db->d_raft = raft_new();
 	if (db->d_raft == NULL) {
 		D_ERROR(DF_DB": failed to create raft object\n", DP_DB(db));
@@ -2325,6 +2668,13 @@ rdb_raft_start(struct rdb *db)
 
 	election_timeout = rdb_raft_get_election_timeout();
 	request_timeout = rdb_raft_get_request_timeout();
+	if (request_timeout >= election_timeout) {
+		D_WARN(DF_DB": request timeout %dms not below election timeout "
+		       "%dms, using %dms\n", DP_DB(db), request_timeout,
+		       election_timeout, election_timeout / 2);
+		request_timeout = election_timeout / 2;
+	}
+	db->d_election_timeout = election_timeout;
 	raft_set_election_timeout(db->d_raft, election_timeout);
 	raft_set_request_timeout(db->d_raft, request_timeout);
 
@@ -2344,8 +2694,9 @@ rdb_raft_start(struct rdb *db)
 		goto err_callbackd;
 
 	D_DEBUG(DB_MD, DF_DB": raft started: election_timeout=%dms "
-		"request_timeout=%dms compact_thres="DF_U64"\n", DP_DB(db),
-		election_timeout, request_timeout, db->d_compact_thres);
+		"request_timeout=%dms compact_thres="DF_U64" compact_lag="DF_U64
+		"\n", DP_DB(db), election_timeout, request_timeout,
+		db->d_compact_thres, db->d_compact_lag);
 	return 0;
 
 err_callbackd:
@@ -2355,6 +2706,7 @@ err_callbackd:
 	ABT_thread_free(&db->d_callbackd);
 err_timerd:
 	db->d_stop = true;
+	dss_ult_wakeup(&db->d_timer_sleep);
 	rc = ABT_thread_join(db->d_timerd);
 	D_ASSERTF(rc == 0, "%d\n", rc);
 	ABT_thread_free(&db->d_timerd);
@@ -2397,6 +2749,7 @@ rdb_raft_stop(struct rdb *db)
 	ABT_cond_broadcast(db->d_events_cv);
 	ABT_cond_broadcast(db->d_replies_cv);
 	ABT_cond_broadcast(db->d_compact_cv);
+	dss_ult_wakeup(&db->d_timer_sleep);
 
 	/* Abort all in-flight RPCs. */
 	rdb_abort_raft_rpcs(db);
@@ -2455,6 +2808,23 @@ rdb_raft_resign(struct rdb *db, uint64_t term)
 	D_ASSERTF(rc == 0, "%d\n", rc);
 }
 
+/*
+ * Make this replica more or less likely to win elections. A replica not
+ * preferred waits twice the base election timeout before campaigning, so that
+ * a preferred one, if alive, normally campaigns first. The leases are always
+ * based on the base election timeout, the shortest among the replicas.
+ */
+void
+rdb_raft_prefer_leader(struct rdb *db, bool prefer)
+{
+	int timeout = db->d_election_timeout;
+
+	if (!prefer)
+		timeout *= 2;
+	D_DEBUG(DB_MD, DF_DB": election timeout %dms\n", DP_DB(db), timeout);
+	raft_set_election_timeout(db->d_raft, timeout);
+}
+
 /* Wait for index to be applied in term. For leaders only. */
 int
 rdb_raft_wait_applied(struct rdb *db, uint64_t index, uint64_t term)
@@ -2499,6 +2869,13 @@ rdb_requestvote_handler(crt_rpc_t *rpc)
 
 	D_DEBUG(DB_TRACE, DF_DB": handling raft rv from rank %u\n", DP_DB(db),
 		rpc->cr_ep.ep_rank);
+	if (rdb_raft_lease_sticky(db)) {
+		D_DEBUG(DB_MD, DF_DB": refuse to vote for rank %u in term %d\n",
+			DP_DB(db), rpc->cr_ep.ep_rank, in->rvi_msg.term);
+		out->rvo_msg.term = raft_get_current_term(db->d_raft);
+		out->rvo_msg.vote_granted = 0;
+		D_GOTO(out_db, rc = 0);
+	}
 	rdb_raft_save_state(db, &state);
 	rc = raft_recv_requestvote(db->d_raft,
 				   raft_get_node(db->d_raft,
@@ -2545,6 +2922,9 @@ rdb_appendentries_handler(crt_rpc_t *rpc)
 				     raft_get_node(db->d_raft,
 						   rpc->cr_ep.ep_rank),
 				     &in->aei_msg, &out->aeo_msg);
+	/* the sender is the leader of our term */
+	if (in->aei_msg.term == raft_get_current_term(db->d_raft))
+		db->d_contact = ABT_get_wtime();
 	rc = rdb_raft_check_state(db, &state, rc);
 	if (rc != 0) {
 		D_ERROR(DF_DB": failed to process APPENDENTRIES from rank %u: "
@@ -2601,6 +2981,8 @@ rdb_installsnapshot_handler(crt_rpc_t *rpc)
 				       raft_get_node(db->d_raft,
 						     rpc->cr_ep.ep_rank),
 				       &in->isi_msg, &out->iso_msg);
+	if (in->isi_msg.term == raft_get_current_term(db->d_raft))
+		db->d_contact = ABT_get_wtime();
 	rc = rdb_raft_check_state(db, &state, rc);
 	if (rc != 0) {
 		D_ERROR(DF_DB": failed to process INSTALLSNAPSHOT from rank "
@@ -2625,14 +3007,17 @@ out:
 }
 
 void
-rdb_raft_process_reply(struct rdb *db, raft_node_t *node, crt_rpc_t *rpc)
+rdb_raft_process_reply(struct rdb *db, raft_node_t *node, crt_rpc_t *rpc,
+		       double sent)
 {
+	struct rdb_raft_node	       *rdb_node = raft_node_get_udata(node);
 	struct rdb_raft_state		state;
 	crt_opcode_t			opc = opc_get(rpc->cr_opc);
 	void			       *out = crt_reply_get(rpc);
 	struct rdb_requestvote_out     *out_rv;
 	struct rdb_appendentries_out   *out_ae;
-	struct rdb_installsnapshot_out *out_is;
+	struct rdb_installsnapshot_in  *in_is;
+	struct rdb_installsnapshot_out *out_is = NULL;
 	int				rc;
 
 	rc = ((struct rdb_op_out *)out)->ro_rc;
@@ -2651,11 +3036,22 @@ rdb_raft_process_reply(struct rdb *db, raft_node_t *node, crt_rpc_t *rpc)
 		break;
 	case RDB_APPENDENTRIES:
 		out_ae = out;
+		/* the node recognized our leadership when it replied */
+		if (state.drs_leader &&
+		    out_ae->aeo_msg.term == state.drs_term &&
+		    sent > rdb_node->dn_lease_ack)
+			rdb_node->dn_lease_ack = sent;
 		rc = raft_recv_appendentries_response(db->d_raft, node,
 						      &out_ae->aeo_msg);
 		break;
 	case RDB_INSTALLSNAPSHOT:
 		out_is = out;
+		in_is = crt_req_get(rpc);
+		/* a stale reply must not clear a newer chunk in flight */
+		if (in_is->isi_msg.term == rdb_node->dn_term &&
+		    in_is->isi_msg.last_idx == rdb_node->dn_is.dis_index &&
+		    in_is->isi_seq == rdb_node->dn_is.dis_seq + 1)
+			rdb_node->dn_is.dis_inflight = false;
 		rc = raft_recv_installsnapshot_response(db->d_raft, node,
 							&out_is->iso_msg);
 		break;
@@ -2663,9 +3059,25 @@ rdb_raft_process_reply(struct rdb *db, raft_node_t *node, crt_rpc_t *rpc)
 		D_ASSERTF(0, DF_DB": unexpected opc: %u\n", DP_DB(db), opc);
 	}
 	rc = rdb_raft_check_state(db, &state, rc);
-	if (rc != 0 && rc != -DER_NOTLEADER)
+	if (rc != 0 && rc != -DER_NOTLEADER) {
 		D_ERROR(DF_DB": failed to process opc %u response: %d\n",
 			DP_DB(db), opc, rc);
+		return;
+	}
+
+	/*
+	 * Stream the snapshot: send the next chunk right away instead of on
+	 * the next heartbeat.
+	 */
+	if (opc == RDB_INSTALLSNAPSHOT && out_is->iso_success &&
+	    raft_is_leader(db->d_raft) &&
+	    !rdb_anchor_is_eof(&rdb_node->dn_is.dis_anchor)) {
+		rc = raft_send_appendentries(db->d_raft, node);
+		if (rc != 0)
+			D_ERROR(DF_DB": failed to send next IS chunk to rank "
+				"%u: %d\n", DP_DB(db), rdb_node->dn_rank,
+				rdb_raft_rc(rc));
+	}
 }
 
 /* The buffer belonging to bulk must a single daos_iov_t. */
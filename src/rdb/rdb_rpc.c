@@ -397,7 +397,7 @@ rdb_recvd(void *arg)
 		 */
 		if (!stop)
 			rdb_raft_process_reply(db, rrpc->drc_node,
-					       rrpc->drc_rpc);
+					       rrpc->drc_rpc, rrpc->drc_sent);
 		rdb_raft_free_request(db, rrpc->drc_rpc);
 		rdb_free_raft_rpc(rrpc);
 		ABT_thread_yield();
@@ -0,0 +1,118 @@
+/*
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. 8F-30005.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+
+/*
+ * Unit tests for the rdb lease and vote logic
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "../rdb_internal.h"
+
+/* Election timeout in ms */
+#define ET	1000
+
+static void
+test_lease_without_majority(void **state)
+{
+	assert_false(rdb_raft_lease_unexpired(0, 0.5, ET));
+	assert_false(rdb_raft_lease_unexpired(0, 100.0, ET));
+}
+
+static void
+test_lease_within_timeout(void **state)
+{
+	assert_true(rdb_raft_lease_unexpired(100.0, 100.0, ET));
+	assert_true(rdb_raft_lease_unexpired(100.0, 100.5, ET));
+}
+
+static void
+test_lease_expires_before_followers_time_out(void **state)
+{
+	double margin = ET / 1000.0 * RDB_RAFT_LEASE_DRIFT;
+
+	/* followers may vote again at start + ET; the lease ends earlier */
+	assert_true(rdb_raft_lease_unexpired(100.0, 101.0 - margin - 0.01,
+					     ET));
+	assert_false(rdb_raft_lease_unexpired(100.0, 101.0 - margin, ET));
+	assert_false(rdb_raft_lease_unexpired(100.0, 101.0, ET));
+}
+
+static void
+test_vote_refused_by_leader(void **state)
+{
+	assert_true(rdb_raft_vote_refused(true, 0, 100.0, ET));
+}
+
+static void
+test_vote_refused_after_contact(void **state)
+{
+	assert_true(rdb_raft_vote_refused(false, 100.0, 100.0, ET));
+	assert_true(rdb_raft_vote_refused(false, 100.0, 100.99, ET));
+}
+
+static void
+test_vote_granted_after_timeout(void **state)
+{
+	assert_false(rdb_raft_vote_refused(false, 100.0, 101.0, ET));
+	assert_false(rdb_raft_vote_refused(false, 100.0, 200.0, ET));
+}
+
+static void
+test_lease_and_vote_disjoint(void **state)
+{
+	double	start = 100.0;
+	double	now;
+
+	/*
+	 * Whenever the leader still considers its lease valid, a follower
+	 * that acknowledged it at start, or restarted after that, must still
+	 * refuse to vote, even with its clock running faster by the drift.
+	 */
+	for (now = start; now < start + 2.0; now += 0.01) {
+		double	fast = start + (now - start) *
+			       (1 + RDB_RAFT_LEASE_DRIFT / 2);
+
+		if (!rdb_raft_lease_unexpired(start, now, ET))
+			continue;
+		assert_true(rdb_raft_vote_refused(false, start, fast, ET));
+	}
+}
+
+int
+main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_lease_without_majority),
+		cmocka_unit_test(test_lease_within_timeout),
+		cmocka_unit_test(test_lease_expires_before_followers_time_out),
+		cmocka_unit_test(test_vote_refused_by_leader),
+		cmocka_unit_test(test_vote_refused_after_contact),
+		cmocka_unit_test(test_vote_granted_after_timeout),
+		cmocka_unit_test(test_lease_and_vote_disjoint)
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -37,6 +37,7 @@
 #include <daos/pool.h>
 #include <daos_srv/container.h>
 #include <daos_srv/daos_server.h>
+#include <daos_srv/rebuild.h>
 #include <daos_srv/vos.h>
 #include <daos_srv/dtx_srv.h>
 #include "rpc.h"
@@ -65,6 +66,8 @@ struct rebuild_iter_obj_arg {
 	daos_handle_t	cont_hdl;
 	daos_unit_oid_t oid;
 	daos_epoch_t	epoch;
+	/* reintegration only resyncs the changes after this epoch */
+	daos_epoch_t	base_epoch;
 	unsigned int	shard;
 	unsigned int	tgt_idx;
 	struct rebuild_tgt_pool_tracker *rpt;
@@ -353,6 +356,8 @@ rebuild_dkey(struct rebuild_tgt_pool_tracker *rpt,
 	}
 
 	tls->rebuild_pool_rec_count += rdone->ro_rec_num;
+	if (rc == 0 && data_size != (daos_size_t)(-1))
+		tls->rebuild_pool_size += data_size;
 cont_put:
 	ds_cont_put(rebuild_cont);
 obj_close:
@@ -393,10 +398,213 @@ rebuild_one_destroy(struct rebuild_one *rdone)
 	D_FREE(rdone);
 }
 
+/* Argument of the ULT pulling one dkey */
+struct rebuild_dkey_arg {
+	struct rebuild_tgt_pool_tracker	*rpt;
+	struct rebuild_puller		*puller;
+	struct rebuild_one		*rdone;
+};
+
+/* Interval (in seconds) of adjusting the pull depth */
+#define REBUILD_DEPTH_CHECK_INTERVAL	0.01
+/* Bandwidth limiter can burst up to this many ms of tokens */
+#define REBUILD_BURST_MS		100
+
+/**
+ * Adjust the pull depth by the foreground I/O delay of the current xstream,
+ * it backs off multiplicatively and recovers additively.
+ */
+static void
+rebuild_puller_depth_adjust(struct rebuild_puller *puller, double now)
+{
+	unsigned int	max_depth = dss_rebuild_pull_depth;
+
+	if (puller->rp_depth > max_depth)
+		puller->rp_depth = max_depth;
+
+	if (now - puller->rp_check_ts < REBUILD_DEPTH_CHECK_INTERVAL)
+		return;
+
+	puller->rp_check_ts = now;
+	if (dss_rebuild_lat_target != 0 &&
+	    dss_xstream_io_delay() > dss_rebuild_lat_target) {
+		if (puller->rp_depth > 1) {
+			puller->rp_depth /= 2;
+			D_DEBUG(DB_REBUILD, "puller %p backs off to depth %u\n",
+				puller, puller->rp_depth);
+		}
+	} else if (puller->rp_depth < max_depth) {
+		puller->rp_depth++;
+	}
+}
+
+/**
+ * Take \a size bytes of tokens from the bandwidth limiter. The bucket is
+ * refilled at dss_rebuild_bandwidth scaled by the current pull depth, so the
+ * bandwidth backs off together with the depth. A dkey can be pulled as long
+ * as the bucket is not in debt, so dkeys larger than the bucket still move.
+ *
+ * \return	true if the dkey can be pulled now.
+ */
+static bool
+rebuild_puller_tokens_get(struct rebuild_puller *puller, daos_size_t size,
+			  double now)
+{
+	uint64_t	rate;
+	int64_t		burst;
+
+	if (dss_rebuild_bandwidth == 0)
+		return true;
+
+	rate = ((uint64_t)dss_rebuild_bandwidth << 20) * puller->rp_depth /
+	       max(dss_rebuild_pull_depth, 1U);
+	burst = rate * REBUILD_BURST_MS / 1000;
+
+	puller->rp_tokens += (now - puller->rp_refill_ts) * rate;
+	puller->rp_refill_ts = now;
+	if (puller->rp_tokens > burst)
+		puller->rp_tokens = burst;
+
+	if (puller->rp_tokens < 0)
+		return false;
+
+	puller->rp_tokens -= size;
+	return true;
+}
+
+/* Wait until the dkey can be pulled by the depth and bandwidth limits */
+static void
+rebuild_puller_throttle(struct rebuild_tgt_pool_tracker *rpt,
+			struct rebuild_puller *puller,
+			struct rebuild_one *rdone)
+{
+	daos_size_t	size;
+	double		now;
+
+	size = daos_iods_len(rdone->ro_iods, rdone->ro_iod_num);
+	if (size == (daos_size_t)(-1))
+		size = MAX_BUF_SIZE;
+
+	while (!rpt->rt_abort) {
+		now = ABT_get_wtime();
+		rebuild_puller_depth_adjust(puller, now);
+		if (puller->rp_running < puller->rp_depth &&
+		    rebuild_puller_tokens_get(puller, size, now))
+			break;
+
+		ABT_thread_yield();
+	}
+}
+
+static void
+rebuild_one_pull(struct rebuild_tgt_pool_tracker *rpt,
+		 struct rebuild_puller *puller, struct rebuild_one *rdone)
+{
+	struct rebuild_pool_tls	*tls;
+	int			 rc = 0;
+
+	tls = rebuild_pool_tls_lookup(rpt->rt_pool_uuid,
+				      rpt->rt_rebuild_ver);
+	D_ASSERT(tls != NULL);
+
+	if (!rpt->rt_abort) {
+		rc = rebuild_dkey(rpt, rdone);
+		D_DEBUG(DB_REBUILD, DF_UOID" rebuild dkey %d %s rc %d tag %d"
+			" rpt %p\n", DP_UOID(rdone->ro_oid),
+			(int)rdone->ro_dkey.iov_len,
+			(char *)rdone->ro_dkey.iov_buf, rc,
+			dss_get_module_info()->dmi_tgt_id, rpt);
+	}
+
+	ABT_mutex_lock(puller->rp_lock);
+	D_ASSERT(puller->rp_inflight > 0);
+	puller->rp_inflight--;
+	ABT_mutex_unlock(puller->rp_lock);
+
+	if (rc == -DER_NOSPACE) {
+		/* If there are no space on current VOS, let's hang the
+		 * rebuild ULT on the current xstream, and waitting for the
+		 * space is reclaimed or the drive is replaced.
+		 *
+		 * If the space is reclaimed, then it will resume the rebuild
+		 * ULT.
+		 * If the drive is replaced, then it will abort the current
+		 * rebuild by other process.
+		 */
+		rebuild_hang();
+		ABT_thread_yield();
+		D_DEBUG(DB_REBUILD, "%p rebuild got back.\n", rpt);
+		/* Added it back to rdone */
+		ABT_mutex_lock(puller->rp_lock);
+		d_list_add_tail(&rdone->ro_list, &puller->rp_one_list);
+		ABT_mutex_unlock(puller->rp_lock);
+		return;
+	}
+
+	/* Ignore nonexistent error because puller could race
+	 * with user's container destroy:
+	 * - puller got the container+oid from a remote scanner
+	 * - user destroyed the container
+	 * - puller try to open container or pulling data
+	 *   (nonexistent)
+	 * This is just a workaround...
+	 */
+	if (tls->rebuild_pool_status == 0 && rc != 0 && rc != -DER_NONEXIST) {
+		tls->rebuild_pool_status = rc;
+		rpt->rt_abort = 1;
+	}
+	/* XXX If rebuild fails, Should we add this back to dkey list */
+	rebuild_one_destroy(rdone);
+}
+
+static void
+rebuild_dkey_ult(void *data)
+{
+	struct rebuild_dkey_arg	*arg = data;
+
+	rebuild_one_pull(arg->rpt, arg->puller, arg->rdone);
+
+	D_ASSERT(arg->puller->rp_running > 0);
+	arg->puller->rp_running--;
+	rpt_put(arg->rpt);
+	D_FREE(arg);
+}
+
+/**
+ * Pull a dkey in its own ULT on the current xstream, so the fetch RPC of
+ * one dkey overlaps with the local VOS update of the others.
+ */
+static int
+rebuild_dkey_ult_create(struct rebuild_tgt_pool_tracker *rpt,
+			struct rebuild_puller *puller,
+			struct rebuild_one *rdone)
+{
+	struct rebuild_dkey_arg	*arg;
+	int			 rc;
+
+	D_ALLOC_PTR(arg);
+	if (arg == NULL)
+		return -DER_NOMEM;
+
+	arg->rpt = rpt;
+	arg->puller = puller;
+	arg->rdone = rdone;
+
+	rpt_get(rpt);
+	puller->rp_running++;
+	rc = dss_rebuild_ult_create(rebuild_dkey_ult, arg, DSS_ULT_SELF, 0,
+				    PULLER_STACK_SIZE, NULL);
+	if (rc) {
+		puller->rp_running--;
+		rpt_put(rpt);
+		D_FREE(arg);
+	}
+	return rc;
+}
+
 static void
 rebuild_one_ult(void *arg)
 {
-	struct rebuild_pool_tls		*tls;
 	struct rebuild_tgt_pool_tracker *rpt = arg;
 	struct rebuild_puller		*puller;
 	unsigned int			idx;
@@ -404,18 +612,17 @@ rebuild_one_ult(void *arg)
 	while (daos_fail_check(DAOS_REBUILD_TGT_REBUILD_HANG))
 		ABT_thread_yield();
 
-	tls = rebuild_pool_tls_lookup(rpt->rt_pool_uuid,
-				      rpt->rt_rebuild_ver);
-	D_ASSERT(tls != NULL);
 	D_ASSERT(rpt->rt_pullers != NULL);
 	idx = dss_get_module_info()->dmi_tgt_id;
 	puller = &rpt->rt_pullers[idx];
 	puller->rp_ult_running = 1;
+	puller->rp_depth = dss_rebuild_pull_depth;
+	puller->rp_refill_ts = puller->rp_check_ts = ABT_get_wtime();
 	while (1) {
 		struct rebuild_one	*rdone;
 		struct rebuild_one	*tmp;
 		d_list_t		rebuild_list;
-		int			rc = 0;
+		int			rc;
 
 		D_INIT_LIST_HEAD(&rebuild_list);
 		ABT_mutex_lock(puller->rp_lock);
@@ -428,65 +635,26 @@ rebuild_one_ult(void *arg)
 
 		d_list_for_each_entry_safe(rdone, tmp, &rebuild_list, ro_list) {
 			d_list_del_init(&rdone->ro_list);
-			if (!rpt->rt_abort) {
-				rc = rebuild_dkey(rpt, rdone);
-				D_DEBUG(DB_REBUILD, DF_UOID" rebuild dkey %d %s"
-					" rc %d tag %d rpt %p\n",
-					DP_UOID(rdone->ro_oid),
-					(int)rdone->ro_dkey.iov_len,
-					(char *)rdone->ro_dkey.iov_buf, rc,
-					idx, rpt);
-			}
-
-			D_ASSERT(puller->rp_inflight > 0);
-			puller->rp_inflight--;
-
-			if (rc == -DER_NOSPACE) {
-				/* If there are no space on current VOS, let's
-				 * hang the rebuild ULT on the current xstream,
-				 * and waitting for the space is reclaimed or
-				 * the drive is replaced.
-				 *
-				 * If the space is reclaimed, then it will
-				 * resume the rebuild ULT.
-				 * If the drive is replaced, then it will
-				 * abort the current rebuild by other process.
-				 */
-				rebuild_hang();
-				ABT_thread_yield();
-				D_DEBUG(DB_REBUILD, "%p rebuild got back.\n",
-					rpt);
-				rc = 0;
-				/* Added it back to rdone */
-				ABT_mutex_lock(puller->rp_lock);
-				d_list_add_tail(&rdone->ro_list,
-						&puller->rp_one_list);
-				ABT_mutex_unlock(puller->rp_lock);
+			rebuild_puller_throttle(rpt, puller, rdone);
+			if (rpt->rt_abort) {
+				rebuild_one_pull(rpt, puller, rdone);
 				continue;
 			}
 
-			/* Ignore nonexistent error because puller could race
-			 * with user's container destroy:
-			 * - puller got the container+oid from a remote scanner
-			 * - user destroyed the container
-			 * - puller try to open container or pulling data
-			 *   (nonexistent)
-			 * This is just a workaround...
-			 */
-			if (tls->rebuild_pool_status == 0 && rc != 0 &&
-			    rc != -DER_NONEXIST) {
-				tls->rebuild_pool_status = rc;
-				rpt->rt_abort = 1;
+			rc = rebuild_dkey_ult_create(rpt, puller, rdone);
+			if (rc) {
+				D_DEBUG(DB_REBUILD, "pull dkey inline: %d\n",
+					rc);
+				rebuild_one_pull(rpt, puller, rdone);
 			}
-			/* XXX If rebuild fails, Should we add this back to
-			 * dkey list
-			 */
-			rebuild_one_destroy(rdone);
 		}
 
-		/* check if it should exist */
+		/* check if it should exist, pulling ULTs may add the dkey
+		 * back to the list on -DER_NOSPACE.
+		 */
 		ABT_mutex_lock(puller->rp_lock);
-		if (d_list_empty(&puller->rp_one_list) && rpt->rt_finishing) {
+		if (d_list_empty(&puller->rp_one_list) &&
+		    puller->rp_running == 0 && rpt->rt_finishing) {
 			ABT_mutex_unlock(puller->rp_lock);
 			break;
 		}
@@ -577,6 +745,42 @@ punch_iod_pack(struct rebuild_one *rdone, daos_iod_t *iod)
 	return 0;
 }
 
+/*
+ * Drop the records and the akey punch which are not newer than @base, they
+ * are already on the reintegrated target. The source only enumerates the
+ * changes after @base (see rebuild_obj_ult()), so this is mostly about the
+ * key punch epochs, which are reported for the keys it still returns. Return
+ * true if any record is dropped.
+ */
+static bool
+rebuild_iod_filter(daos_iod_t *iod, daos_epoch_t *akey_eph, daos_epoch_t base)
+{
+	bool	dropped = false;
+	int	nr = 0;
+	int	i;
+
+	if (*akey_eph <= base)
+		*akey_eph = DAOS_EPOCH_MAX;
+
+	for (i = 0; i < iod->iod_nr; i++) {
+		if (iod->iod_eprs[i].epr_lo <= base) {
+			dropped = true;
+			continue;
+		}
+
+		if (nr != i) {
+			if (iod->iod_recxs != NULL)
+				iod->iod_recxs[nr] = iod->iod_recxs[i];
+			if (iod->iod_csums != NULL)
+				iod->iod_csums[nr] = iod->iod_csums[i];
+			iod->iod_eprs[nr] = iod->iod_eprs[i];
+		}
+		nr++;
+	}
+	iod->iod_nr = nr;
+	return dropped;
+}
+
 /*
  * Queue dkey to the rebuild dkey list on each xstream. Note that this function
  * steals the memory of the recx, csum, and epr arrays from iods.
@@ -606,6 +810,31 @@ rebuild_one_queue(struct rebuild_iter_obj_arg *iter_arg, daos_unit_oid_t *oid,
 		return 0;
 	}
 
+	if (iter_arg->base_epoch != 0) {
+		bool	changed = dkey_eph > iter_arg->base_epoch &&
+				  dkey_eph != DAOS_EPOCH_MAX;
+
+		if (!changed)
+			dkey_eph = DAOS_EPOCH_MAX;
+
+		for (i = 0; i < iod_eph_total; i++) {
+			/* inline data does not match the filtered recxs */
+			if (rebuild_iod_filter(&iods[i], &akey_ephs[i],
+					       iter_arg->base_epoch))
+				inline_copy = false;
+			if (iods[i].iod_nr > 0 ||
+			    akey_ephs[i] != DAOS_EPOCH_MAX)
+				changed = true;
+		}
+
+		if (!changed) {
+			D_DEBUG(DB_REBUILD, "dkey %d %s not changed after "
+				DF_U64"\n", (int)dkey->iov_len,
+				(char *)dkey->iov_buf, iter_arg->base_epoch);
+			return 0;
+		}
+	}
+
 	D_ALLOC_PTR(rdone);
 	if (rdone == NULL)
 		return -DER_NOMEM;
@@ -622,7 +851,7 @@ rebuild_one_queue(struct rebuild_iter_obj_arg *iter_arg, daos_unit_oid_t *oid,
 
 	rdone->ro_iod_alloc_num = iod_eph_total;
 	/* only do the copy below when each with inline recx data */
-	for (i = 0; i < iod_eph_total; i++) {
+	for (i = 0; inline_copy && i < iod_eph_total; i++) {
 		int j;
 
 		if (sgls[i].sg_nr == 0 || sgls[i].sg_iovs == NULL) {
@@ -736,6 +965,11 @@ rebuild_obj_punch_one(void *data)
 
 	rc = vos_obj_punch(cont->sc_hdl, arg->oid, arg->epoch,
 			   arg->rpt->rt_rebuild_ver, 0, NULL, 0, NULL);
+	if (rc == 0)
+		ds_rebuild_obj_index_punch(arg->rpt->rt_pool_uuid,
+					   cont->sc_hdl, arg->oid,
+					   arg->rpt->rt_rebuild_ver,
+					   arg->epoch);
 	ds_cont_put(cont);
 	if (rc)
 		D_ERROR(DF_UOID" rebuild punch failed rc %d\n",
@@ -750,6 +984,40 @@ rebuild_obj_punch(struct rebuild_iter_obj_arg *arg)
 	return dss_task_collective(rebuild_obj_punch_one, arg, 0);
 }
 
+/*
+ * Prepare the rebuilt shard on the target xstream it is written to: index it
+ * and, for reintegration, find the epoch the local replica is complete up to.
+ * All data up to the aggregated epoch of the container has been persisted
+ * before the target went away, so only the later changes are resynced.
+ */
+static int
+rebuild_obj_prep_one(void *data)
+{
+	struct rebuild_iter_obj_arg	*arg = data;
+	struct ds_cont			*cont;
+	vos_cont_info_t			 info;
+	int				 rc;
+
+	rc = ds_cont_lookup(arg->rpt->rt_pool_uuid, arg->cont_uuid, &cont);
+	if (rc)
+		return rc;
+
+	if (arg->rpt->rt_rebuild_op == RB_OP_REINT) {
+		rc = vos_cont_query(cont->sc_hdl, &info);
+		if (rc)
+			D_GOTO(out, rc);
+		arg->base_epoch = info.ci_hae;
+	}
+
+	if (arg->epoch == DAOS_EPOCH_MAX)
+		ds_rebuild_obj_index_insert(arg->rpt->rt_pool_uuid,
+					    cont->sc_hdl, arg->oid,
+					    arg->rpt->rt_rebuild_ver);
+out:
+	ds_cont_put(cont);
+	return rc;
+}
+
 #define KDS_NUM		16
 #define ITER_BUF_SIZE   2048
 
@@ -770,6 +1038,7 @@ rebuild_obj_ult(void *data)
 	char				 stack_buf[ITER_BUF_SIZE];
 	char				*buf = NULL;
 	daos_size_t			 buf_len;
+	daos_epoch_t			 epoch_lo;
 	struct dss_enum_arg		 enum_arg;
 	int				 rc;
 
@@ -777,7 +1046,16 @@ rebuild_obj_ult(void *data)
 				      arg->rpt->rt_rebuild_ver);
 	D_ASSERT(tls != NULL);
 
-	if (arg->epoch != DAOS_EPOCH_MAX) {
+	rc = dss_ult_create_execute(rebuild_obj_prep_one, arg, NULL, NULL,
+				    DSS_ULT_REBUILD, arg->tgt_idx, 0);
+	if (rc) {
+		D_ERROR(DF_UOID" rebuild prepare failed: %d\n",
+			DP_UOID(arg->oid), rc);
+		D_GOTO(free, rc);
+	}
+
+	/* the object punch is already on the reintegrated target */
+	if (arg->epoch != DAOS_EPOCH_MAX && arg->epoch > arg->base_epoch) {
 		rc = rebuild_obj_punch(arg);
 		if (rc)
 			D_GOTO(free, rc);
@@ -799,6 +1077,8 @@ rebuild_obj_ult(void *data)
 	enum_arg.oid = arg->oid;
 	enum_arg.chk_key2big = true;
 
+	/* the source only enumerates the changes after the resync base */
+	epoch_lo = arg->base_epoch == 0 ? 0 : arg->base_epoch + 1;
 	buf = stack_buf;
 	buf_len = ITER_BUF_SIZE;
 	while (1) {
@@ -816,8 +1096,8 @@ rebuild_obj_ult(void *data)
 		sgl.sg_nr_out = 1;
 		sgl.sg_iovs = &iov;
 
-		rc = ds_obj_list_obj(oh, arg->epoch, NULL, NULL, &size,
-				     &num, kds, eprs, &sgl, &anchor,
+		rc = ds_obj_list_obj(oh, arg->epoch, epoch_lo, NULL, NULL,
+				     &size, &num, kds, eprs, &sgl, &anchor,
 				     &dkey_anchor, &akey_anchor);
 
 		if (rc == -DER_KEY2BIG) {
@@ -926,7 +1206,7 @@ puller_obj_iter_cb(daos_handle_t ih, daos_iov_t *key_iov,
 	daos_unit_oid_t			oid = key->oid;
 	daos_epoch_t			epoch = key->eph;
 	unsigned int			tgt_idx = key->tgt_idx;
-	unsigned int			*shard = val_iov->iov_buf;
+	struct rebuild_obj_val		*val = val_iov->iov_buf;
 	bool				scheduled = false;
 	int				rc;
 
@@ -938,7 +1218,7 @@ puller_obj_iter_cb(daos_handle_t ih, daos_iov_t *key_iov,
 	/* NB: if rebuild for this obj fail, let's continue rebuilding
 	 * other objs, and rebuild this obj again later.
 	 */
-	rc = arg->obj_cb(oid, epoch, *shard, tgt_idx, arg);
+	rc = arg->obj_cb(oid, epoch, val->shard, tgt_idx, arg);
 	if (rc == 0) {
 		scheduled = true;
 		--arg->yield_freq;
@@ -1187,8 +1467,9 @@ struct rebuilt_oid {
 static int
 rebuild_scheduled_obj_insert_cb(struct rebuild_root *cont_root, uuid_t co_uuid,
 				daos_unit_oid_t oid, daos_epoch_t eph,
-				unsigned int shard, unsigned int tgt_idx,
-				unsigned int *cnt, int ref)
+				unsigned int shard, daos_size_t size,
+				unsigned int tgt_idx, unsigned int *cnt,
+				int ref)
 {
 	struct rebuilt_oid	*roid;
 	struct rebuilt_oid	roid_tmp;
@@ -1300,6 +1581,8 @@ rebuild_obj_handler(crt_rpc_t *rpc)
 	unsigned int			co_count;
 	uint32_t			*shards;
 	unsigned int			shards_count;
+	uint64_t			*sizes;
+	unsigned int			sizes_count;
 	daos_handle_t			btr_hdl;
 	daos_handle_t			rebuilt_btr_hdl;
 	unsigned int			i;
@@ -1314,12 +1597,16 @@ rebuild_obj_handler(crt_rpc_t *rpc)
 	co_count = rebuild_in->roi_uuids.ca_count;
 	shards = rebuild_in->roi_shards.ca_arrays;
 	shards_count = rebuild_in->roi_shards.ca_count;
+	sizes = rebuild_in->roi_sizes.ca_arrays;
+	sizes_count = rebuild_in->roi_sizes.ca_count;
 
 	if (co_count == 0 || oids_count == 0 || shards_count == 0 ||
 	    ephs_count == 0 || oids_count != co_count ||
-	    oids_count != shards_count || oids_count != ephs_count) {
-		D_ERROR("oids %u cont %u shards %u ephs %d\n",
-			oids_count, co_count, shards_count, ephs_count);
+	    oids_count != shards_count || oids_count != ephs_count ||
+	    oids_count != sizes_count) {
+		D_ERROR("oids %u cont %u shards %u ephs %d sizes %u\n",
+			oids_count, co_count, shards_count, ephs_count,
+			sizes_count);
 		D_GOTO(out, rc = -DER_INVAL);
 	}
 
@@ -1351,7 +1638,7 @@ rebuild_obj_handler(crt_rpc_t *rpc)
 		/* firstly insert/check rebuilt tree */
 		rc = rebuild_cont_obj_insert(rebuilt_btr_hdl, co_uuids[i],
 					     oids[i], ephs[i], shards[i],
-					     rebuild_in->roi_tgt_idx,
+					     sizes[i], rebuild_in->roi_tgt_idx,
 					     &rpt->rt_rebuilt_obj_cnt, 1,
 					     rebuild_scheduled_obj_insert_cb);
 		if (rc == 0) {
@@ -1371,13 +1658,14 @@ rebuild_obj_handler(crt_rpc_t *rpc)
 		/* for un-rebuilt objs insert to to-be-rebuilt tree */
 		rc = rebuild_cont_obj_insert(btr_hdl, co_uuids[i],
 					     oids[i], ephs[i], shards[i],
-					     rebuild_in->roi_tgt_idx,
+					     sizes[i], rebuild_in->roi_tgt_idx,
 					     NULL, 0, rebuild_obj_insert_cb);
 		if (rc == 1) {
 			D_DEBUG(DB_REBUILD, "insert local "DF_UOID"/"DF_U64" "
 				DF_UUID" %u hdl %"PRIx64"\n", DP_UOID(oids[i]),
 				ephs[i], DP_UUID(co_uuids[i]), shards[i],
 				btr_hdl.cookie);
+			rpt->rt_toberb_size += sizes[i];
 			rc = 0;
 		} else if (rc == 0) {
 			D_DEBUG(DB_REBUILD, DF_UOID"/"DF_U64" "DF_UUID
@@ -1388,7 +1676,7 @@ rebuild_obj_handler(crt_rpc_t *rpc)
 			/* rollback the ref in rebuilt tree taken above */
 			rebuild_cont_obj_insert(rebuilt_btr_hdl, co_uuids[i],
 					oids[i], ephs[i], shards[i],
-					rebuild_in->roi_tgt_idx,
+					sizes[i], rebuild_in->roi_tgt_idx,
 					&rpt->rt_rebuilt_obj_cnt, -1,
 					rebuild_scheduled_obj_insert_cb);
 			break;
@@ -0,0 +1,505 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * rebuild: replica index
+ *
+ * Every target keeps, per container, an index from the targets holding the
+ * other replicas of its object shards to the object IDs. The index is stored
+ * in a reserved VOS object of the container: the dkey is the ID of the peer
+ * target, the akeys are the local object shards, and the single value is the
+ * shard index on the peer target and the epoch the shard was punched at. The
+ * scanner then only needs to enumerate the dkeys of the failed targets instead
+ * of all objects of the pool.
+ *
+ * The index is updated when an object shard is created on the target, i.e.
+ * when the first update finds the object without any key, and when it is
+ * punched. The peers are taken from the layout of the pool map version the
+ * client used. The entry is written before the data of the update is
+ * committed, so a crash can only leave an entry for an empty object, which is
+ * harmless. Entries left behind by remapped shards are harmless too, since
+ * the scanner recomputes the layout of each object it finds.
+ *
+ * Entries are written at the reserved epoch REBUILD_OBJ_INDEX_EPOCH instead
+ * of the epoch of the update, and overwritten in place: discarding that epoch
+ * must not drop the entry of an object which still has data in later epochs,
+ * and aggregation has nothing to merge. A discard only clears the punch
+ * epochs it covers, see ds_rebuild_obj_index_discard().
+ *
+ * Containers created before the index existed do not have the marker, and a
+ * failed index update clears it, the scanner falls back to iterating all of
+ * their objects.
+ */
+#define D_LOGFAC	DD_FAC(rebuild)
+
+#include <daos/placement.h>
+#include <daos/pool_map.h>
+#include <daos_srv/container.h>
+#include <daos_srv/pool.h>
+#include <daos_srv/rebuild.h>
+#include <daos_srv/vos.h>
+#include "rebuild_internal.h"
+
+/* dkey of the index metadata, never a valid target ID */
+#define REBUILD_OBJ_INDEX_META	((uint32_t)-1)
+/* version of the index layout */
+#define REBUILD_OBJ_INDEX_VER	3
+/* epoch of the index, clients never update at it */
+#define REBUILD_OBJ_INDEX_EPOCH	0
+
+/* value of an index entry */
+struct rebuild_obj_index_val {
+	uint32_t	riv_shard;	/* shard index on the peer target */
+	uint32_t	riv_padding;
+	daos_epoch_t	riv_punched;	/* punch epoch, 0 if not punched */
+};
+
+static char rebuild_obj_index_valid_akey[] = "valid";
+
+/* oid of the index, clients always generate oids with a non-zero version */
+static const daos_unit_oid_t rebuild_obj_index_oid = {
+	.id_pub		= { .lo = 0x7265627569646978ULL, .hi = 0 },
+};
+
+bool
+rebuild_obj_is_index(daos_unit_oid_t oid)
+{
+	return daos_unit_obj_id_equal(oid, rebuild_obj_index_oid);
+}
+
+static int
+rebuild_obj_index_rw(daos_handle_t coh, uint32_t dkey_val, daos_iov_t *akey,
+		     void *val, size_t size, bool update)
+{
+	daos_key_t	dkey;
+	daos_iod_t	iod;
+	daos_sg_list_t	sgl;
+	daos_iov_t	iov;
+	int		rc;
+
+	daos_iov_set(&dkey, &dkey_val, sizeof(dkey_val));
+	memset(&iod, 0, sizeof(iod));
+	iod.iod_name = *akey;
+	iod.iod_type = DAOS_IOD_SINGLE;
+	iod.iod_size = size;
+	iod.iod_nr = 1;
+
+	daos_iov_set(&iov, val, size);
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &iov;
+
+	if (update)
+		return vos_obj_update(coh, rebuild_obj_index_oid,
+				      REBUILD_OBJ_INDEX_EPOCH, 0, &dkey, 1,
+				      &iod, &sgl);
+
+	rc = vos_obj_fetch(coh, rebuild_obj_index_oid, DAOS_EPOCH_MAX, &dkey,
+			   1, &iod, &sgl);
+	/* zero size means the value does not exist */
+	if (rc == 0 && iod.iod_size != size)
+		rc = iod.iod_size == 0 ? -DER_NONEXIST : -DER_IO;
+	return rc;
+}
+
+static int
+rebuild_obj_index_marker_set(daos_handle_t coh, uint32_t ver)
+{
+	daos_iov_t	akey;
+
+	daos_iov_set(&akey, rebuild_obj_index_valid_akey,
+		     strlen(rebuild_obj_index_valid_akey));
+	return rebuild_obj_index_rw(coh, REBUILD_OBJ_INDEX_META, &akey, &ver,
+				    sizeof(ver), true);
+}
+
+/**
+ * Mark the index of a container as complete, it should be called when the
+ * container is created on the target, i.e. before any object is written.
+ */
+int
+ds_rebuild_obj_index_init(daos_handle_t coh)
+{
+	return rebuild_obj_index_marker_set(coh, REBUILD_OBJ_INDEX_VER);
+}
+
+/**
+ * Mark the index of a container as incomplete after an object shard failed
+ * to be indexed, the scanner will iterate all of its objects.
+ */
+static void
+rebuild_obj_index_invalidate(daos_handle_t coh)
+{
+	int	rc;
+
+	rc = rebuild_obj_index_marker_set(coh, 0);
+	if (rc)
+		D_ERROR("failed to invalidate rebuild index: %d\n", rc);
+}
+
+/** Check if the index covers all objects of the container */
+bool
+rebuild_obj_index_valid(daos_handle_t coh)
+{
+	daos_iov_t	akey;
+	uint32_t	ver;
+	int		rc;
+
+	/* to compare the index with the full scan */
+	if (DAOS_FAIL_CHECK(DAOS_REBUILD_NO_INDEX))
+		return false;
+
+	daos_iov_set(&akey, rebuild_obj_index_valid_akey,
+		     strlen(rebuild_obj_index_valid_akey));
+	rc = rebuild_obj_index_rw(coh, REBUILD_OBJ_INDEX_META, &akey, &ver,
+				  sizeof(ver), false);
+	if (rc != 0) {
+		if (rc != -DER_NONEXIST)
+			D_ERROR("failed to check rebuild index: %d\n", rc);
+		return false;
+	}
+	return ver == REBUILD_OBJ_INDEX_VER;
+}
+
+/**
+ * Add the object shard @oid with a replica on target @tgt_id to the index,
+ * @punched is the epoch the shard was punched at or 0. The whole index is
+ * invalidated if the entry cannot be written.
+ */
+void
+rebuild_obj_index_add(daos_handle_t coh, daos_unit_oid_t oid, uint32_t tgt_id,
+		      uint32_t shard, daos_epoch_t punched)
+{
+	struct rebuild_obj_index_val	val = { 0 };
+	daos_iov_t			akey;
+	int				rc;
+
+	val.riv_shard = shard;
+	val.riv_punched = punched;
+	daos_iov_set(&akey, &oid, sizeof(oid));
+	rc = rebuild_obj_index_rw(coh, tgt_id, &akey, &val, sizeof(val), true);
+	if (rc) {
+		D_ERROR("failed to index "DF_UOID" for target %u: %d\n",
+			DP_UOID(oid), tgt_id, rc);
+		rebuild_obj_index_invalidate(coh);
+	}
+}
+
+/**
+ * Return the placement map of the pool, it is created or refreshed from the
+ * pool map if it is missing or stale.
+ */
+static struct pl_map *
+rebuild_obj_index_plmap(uuid_t pool_uuid, daos_obj_id_t oid)
+{
+	struct ds_pool	*pool;
+	struct pl_map	*map;
+	uint32_t	 ver;
+	int		 rc;
+
+	pool = ds_pool_lookup(pool_uuid);
+	if (pool == NULL)
+		return NULL;
+
+	map = pl_map_find(pool_uuid, oid);
+	ABT_rwlock_rdlock(pool->sp_lock);
+	if (pool->sp_map == NULL) {
+		ABT_rwlock_unlock(pool->sp_lock);
+		goto out;
+	}
+
+	ver = pool_map_get_version(pool->sp_map);
+	if (map != NULL && pl_map_version(map) >= ver) {
+		ABT_rwlock_unlock(pool->sp_lock);
+		goto out;
+	}
+
+	rc = pl_map_update(pool_uuid, pool->sp_map, map == NULL);
+	ABT_rwlock_unlock(pool->sp_lock);
+	if (rc != 0) {
+		D_ERROR(DF_UUID" failed to update placement map: %d\n",
+			DP_UUID(pool_uuid), rc);
+		goto out;
+	}
+
+	if (map != NULL)
+		pl_map_decref(map);
+	map = pl_map_find(pool_uuid, oid);
+out:
+	ds_pool_put(pool);
+	return map;
+}
+
+/**
+ * Index the object shard @oid by the targets of the other shards of its
+ * redundancy group in the layout of pool map version @map_ver.
+ */
+static int
+rebuild_obj_index_set(uuid_t pool_uuid, daos_handle_t coh,
+		      daos_unit_oid_t oid, uint32_t map_ver,
+		      daos_epoch_t punched)
+{
+	struct daos_oclass_attr	*oc_attr;
+	struct pl_obj_layout	*layout;
+	struct pl_map		*map;
+	struct daos_obj_md	 md;
+	unsigned int		 grp_size;
+	unsigned int		 start;
+	unsigned int		 i;
+	int			 rc;
+
+	oc_attr = daos_oclass_attr_find(oid.id_pub);
+	if (oc_attr == NULL)
+		return 0;
+
+	/* no replica to rebuild from */
+	grp_size = daos_oclass_grp_size(oc_attr);
+	if (grp_size <= 1)
+		return 0;
+
+	map = rebuild_obj_index_plmap(pool_uuid, oid.id_pub);
+	if (map == NULL) {
+		D_ERROR(DF_UOID" cannot find placement map of "DF_UUID"\n",
+			DP_UOID(oid), DP_UUID(pool_uuid));
+		return -DER_NONEXIST;
+	}
+
+	/* the layout of a newer map than ours is unknown */
+	if (pl_map_version(map) < map_ver) {
+		D_DEBUG(DB_REBUILD, DF_UOID" placement map %u < %u\n",
+			DP_UOID(oid), pl_map_version(map), map_ver);
+		D_GOTO(out, rc = -DER_STALE);
+	}
+
+	dc_obj_fetch_md(oid.id_pub, &md);
+	md.omd_ver = map_ver;
+	rc = pl_obj_layout_get(map, &md, &layout);
+	if (rc)
+		D_GOTO(out, rc);
+
+	start = (oid.id_shard / grp_size) * grp_size;
+	for (i = start; i < start + grp_size && i < layout->ol_nr; i++) {
+		struct pl_obj_shard *shard = &layout->ol_shards[i];
+
+		if (i == oid.id_shard || shard->po_shard == -1 ||
+		    shard->po_target == -1)
+			continue;
+
+		rebuild_obj_index_add(coh, oid, shard->po_target, i, punched);
+	}
+	pl_obj_layout_put(layout);
+out:
+	pl_map_decref(map);
+	return rc;
+}
+
+/**
+ * Index the object shard @oid created by a client using pool map version
+ * @map_ver. A failure is not returned to the update, the index of the
+ * container is invalidated instead.
+ */
+void
+ds_rebuild_obj_index_insert(uuid_t pool_uuid, daos_handle_t coh,
+			    daos_unit_oid_t oid, uint32_t map_ver)
+{
+	int	rc;
+
+	rc = rebuild_obj_index_set(pool_uuid, coh, oid, map_ver, 0);
+	if (rc) {
+		D_ERROR(DF_UOID" failed to update rebuild index: %d\n",
+			DP_UOID(oid), rc);
+		rebuild_obj_index_invalidate(coh);
+	}
+}
+
+/**
+ * Record that the object shard @oid was punched at @epoch, so that the
+ * rebuild replays the punch instead of creating an empty shard.
+ */
+void
+ds_rebuild_obj_index_punch(uuid_t pool_uuid, daos_handle_t coh,
+			   daos_unit_oid_t oid, uint32_t map_ver,
+			   daos_epoch_t epoch)
+{
+	int	rc;
+
+	rc = rebuild_obj_index_set(pool_uuid, coh, oid, map_ver, epoch);
+	if (rc) {
+		D_ERROR(DF_UOID" failed to update rebuild index: %d\n",
+			DP_UOID(oid), rc);
+		rebuild_obj_index_invalidate(coh);
+	}
+}
+
+/**
+ * Clear the punch epochs of the index entries which are in the discarded
+ * range @epr, the object shards are then rebuilt as they are at the latest
+ * epoch. The index is invalidated if it cannot be walked.
+ */
+void
+ds_rebuild_obj_index_discard(daos_handle_t coh, daos_epoch_range_t *epr)
+{
+	vos_iter_param_t		param = { 0 };
+	vos_iter_entry_t		ent;
+	struct rebuild_obj_index_val	val;
+	daos_handle_t			dih;
+	daos_handle_t			aih;
+	uint32_t			tgt_id;
+	int				rc;
+
+	param.ip_hdl = coh;
+	param.ip_oid = rebuild_obj_index_oid;
+	param.ip_epr.epr_lo = 0;
+	param.ip_epr.epr_hi = DAOS_EPOCH_MAX;
+
+	rc = vos_iter_prepare(VOS_ITER_DKEY, &param, &dih);
+	if (rc != 0) {
+		if (rc != -DER_NONEXIST)
+			rebuild_obj_index_invalidate(coh);
+		return;
+	}
+
+	rc = vos_iter_probe(dih, NULL);
+	while (rc == 0) {
+		rc = vos_iter_fetch(dih, &ent, NULL);
+		if (rc != 0)
+			break;
+
+		if (ent.ie_key.iov_len != sizeof(tgt_id))
+			D_GOTO(out, rc = -DER_IO);
+
+		memcpy(&tgt_id, ent.ie_key.iov_buf, sizeof(tgt_id));
+		if (tgt_id == REBUILD_OBJ_INDEX_META)
+			goto next;
+
+		param.ip_dkey = ent.ie_key;
+		rc = vos_iter_prepare(VOS_ITER_AKEY, &param, &aih);
+		if (rc != 0)
+			D_GOTO(out, rc);
+
+		rc = vos_iter_probe(aih, NULL);
+		while (rc == 0) {
+			rc = vos_iter_fetch(aih, &ent, NULL);
+			if (rc != 0)
+				break;
+
+			rc = rebuild_obj_index_rw(coh, tgt_id, &ent.ie_key,
+						  &val, sizeof(val), false);
+			if (rc != 0)
+				break;
+
+			if (val.riv_punched != 0 &&
+			    val.riv_punched >= epr->epr_lo &&
+			    val.riv_punched <= epr->epr_hi) {
+				val.riv_punched = 0;
+				rc = rebuild_obj_index_rw(coh, tgt_id,
+							  &ent.ie_key, &val,
+							  sizeof(val), true);
+				if (rc != 0)
+					break;
+			}
+			rc = vos_iter_next(aih);
+		}
+		vos_iter_finish(aih);
+		if (rc != -DER_NONEXIST)
+			D_GOTO(out, rc);
+next:
+		rc = vos_iter_next(dih);
+	}
+
+	if (rc == -DER_NONEXIST)
+		rc = 0;
+out:
+	vos_iter_finish(dih);
+	if (rc) {
+		D_ERROR("failed to discard rebuild index: %d\n", rc);
+		rebuild_obj_index_invalidate(coh);
+	}
+}
+
+/**
+ * Iterate the object shards of container @co_uuid which have a replica on
+ * target @tgt_id.
+ */
+int
+rebuild_obj_index_iterate(daos_handle_t coh, uuid_t co_uuid, uint32_t tgt_id,
+			  cont_iter_cb_t callback, void *arg)
+{
+	vos_iter_param_t		param = { 0 };
+	vos_iter_entry_t		ent;
+	struct rebuild_obj_index_val	val;
+	daos_handle_t			ih;
+	daos_unit_oid_t			oid;
+	int				rc;
+
+	param.ip_hdl = coh;
+	param.ip_oid = rebuild_obj_index_oid;
+	daos_iov_set(&param.ip_dkey, &tgt_id, sizeof(tgt_id));
+	param.ip_epr.epr_lo = 0;
+	param.ip_epr.epr_hi = DAOS_EPOCH_MAX;
+
+	rc = vos_iter_prepare(VOS_ITER_AKEY, &param, &ih);
+	if (rc != 0)
+		return rc == -DER_NONEXIST ? 0 : rc;
+
+	rc = vos_iter_probe(ih, NULL);
+	while (rc == 0) {
+		rc = vos_iter_fetch(ih, &ent, NULL);
+		if (rc != 0)
+			break;
+
+		if (ent.ie_key.iov_len != sizeof(oid)) {
+			D_ERROR("invalid rebuild index key size "DF_U64"\n",
+				ent.ie_key.iov_len);
+			D_GOTO(out, rc = -DER_IO);
+		}
+
+		memcpy(&oid, ent.ie_key.iov_buf, sizeof(oid));
+		rc = rebuild_obj_index_rw(coh, tgt_id, &ent.ie_key, &val,
+					  sizeof(val), false);
+		if (rc != 0) {
+			D_ERROR("failed to fetch rebuild index of "DF_UOID
+				": %d\n", DP_UOID(oid), rc);
+			D_GOTO(out, rc);
+		}
+		D_DEBUG(DB_REBUILD, "index "DF_UOID"/"DF_UUID" on tgt %u "
+			"punched "DF_U64"\n", DP_UOID(oid), DP_UUID(co_uuid),
+			tgt_id, val.riv_punched);
+
+		/* same as the object iterator, see oi_iter_fetch() */
+		rc = callback(co_uuid, oid, val.riv_punched != 0 ?
+			      val.riv_punched : DAOS_EPOCH_MAX, arg);
+		if (rc) {
+			if (rc > 0)
+				rc = 0;
+			D_GOTO(out, rc);
+		}
+
+		rc = vos_iter_next(ih);
+	}
+
+	if (rc == -DER_NONEXIST)
+		rc = 0;
+out:
+	vos_iter_finish(ih);
+	return rc;
+}
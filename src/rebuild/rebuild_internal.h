@@ -32,6 +32,8 @@
 #include <uuid/uuid.h>
 #include <daos/rpc.h>
 #include <daos/btree.h>
+#include <daos_srv/container.h>
+#include <daos_srv/rebuild.h>
 
 struct rebuild_one {
 	daos_key_t	ro_dkey;
@@ -55,6 +57,20 @@ struct rebuild_one {
 
 struct rebuild_puller {
 	unsigned int	rp_inflight;
+	/** # ULTs pulling dkeys of this puller */
+	unsigned int	rp_running;
+	/**
+	 * Current pull depth, it is halved while the foreground I/O delay
+	 * exceeds dss_rebuild_lat_target, and grows back to
+	 * dss_rebuild_pull_depth by one per check otherwise.
+	 */
+	unsigned int	rp_depth;
+	/** token bucket of the bandwidth limiter in bytes, can go negative */
+	int64_t		rp_tokens;
+	/** last time the bucket was refilled */
+	double		rp_refill_ts;
+	/** last time the pull depth was adjusted */
+	double		rp_check_ts;
 	ABT_thread	rp_ult;
 	ABT_mutex	rp_lock;
 	/** serialize initialization of ULTs */
@@ -69,6 +85,14 @@ struct rebuild_obj_key {
 	uint32_t	tgt_idx;
 };
 
+/* value of the object records in the rebuild object trees */
+struct rebuild_obj_val {
+	uint32_t	shard;
+	uint32_t	padding;
+	/* estimated bytes to rebuild, see rebuild_obj_size_estimate() */
+	uint64_t	size;
+};
+
 /* Track the pool rebuild status on each target, which exists on
  * all server targets. Then each target will report its rebuild
  * status to the global pool tracker(see below) on the master node,
@@ -84,6 +108,8 @@ struct rebuild_tgt_pool_tracker {
 
 	/** the current version being rebuilt, only used by leader */
 	uint32_t		rt_rebuild_ver;
+	/** daos_rebuild_opc_t */
+	uint32_t		rt_rebuild_op;
 
 	/** rebuild pool/container hdl uuid */
 	uuid_t			rt_poh_uuid;
@@ -113,6 +139,11 @@ struct rebuild_tgt_pool_tracker {
 	/* reported # rebuilt objs */
 	uint64_t		rt_reported_obj_cnt;
 	uint64_t		rt_reported_rec_cnt;
+	/* # estimated to-be-rebuilt bytes */
+	uint64_t		rt_toberb_size;
+	uint64_t		rt_reported_toberb_size;
+	/* reported # rebuilt bytes */
+	uint64_t		rt_reported_size;
 
 	unsigned int		rt_lead_puller_running:1,
 				rt_abort:1,
@@ -156,6 +187,9 @@ struct rebuild_global_pool_tracker {
 	/* The term of the current rebuild leader */
 	uint64_t	rgt_leader_term;
 
+	/* start time of the rebuild, to estimate the rate and ETA */
+	double		rgt_start_time;
+
 	unsigned int	rgt_scan_done:1,
 			rgt_done:1,
 			rgt_abort:1;
@@ -218,6 +252,7 @@ struct rebuild_task {
 	struct pool_target_id_list	dst_tgts;
 	d_rank_list_t	*dst_svc_list;
 	uint32_t	dst_map_ver;
+	daos_rebuild_opc_t dst_rebuild_op;
 };
 
 /* Per pool structure in TLS to check pool rebuild status
@@ -231,6 +266,8 @@ struct rebuild_pool_tls {
 	d_list_t	rebuild_pool_list;
 	uint64_t	rebuild_pool_obj_count;
 	uint64_t	rebuild_pool_rec_count;
+	/* # bytes pulled */
+	uint64_t	rebuild_pool_size;
 	unsigned int	rebuild_pool_ver;
 	int		rebuild_pool_status;
 	unsigned int	rebuild_pool_scanning:1;
@@ -253,6 +290,7 @@ struct rebuild_tgt_query_info {
 	int status;
 	uint64_t rec_count;
 	uint64_t obj_count;
+	uint64_t size;
 	bool rebuilding;
 	ABT_mutex lock;
 };
@@ -262,6 +300,8 @@ struct rebuild_iv {
 	uint64_t	riv_toberb_obj_count;
 	uint64_t	riv_obj_count;
 	uint64_t	riv_rec_count;
+	uint64_t	riv_toberb_size;
+	uint64_t	riv_size;
 	uint64_t	riv_leader_term;
 	unsigned int	riv_rank;
 	unsigned int	riv_master_rank;
@@ -318,17 +358,19 @@ is_current_tgt_up(struct rebuild_tgt_pool_tracker *rpt);
 typedef int (*rebuild_obj_insert_cb_t)(struct rebuild_root *cont_root,
 				       uuid_t co_uuid, daos_unit_oid_t oid,
 				       daos_epoch_t epoch, unsigned int shard,
-				       unsigned int tgt_idx, unsigned int *cnt,
-				       int ref);
+				       daos_size_t size, unsigned int tgt_idx,
+				       unsigned int *cnt, int ref);
 int
 rebuild_obj_insert_cb(struct rebuild_root *cont_root, uuid_t co_uuid,
 		      daos_unit_oid_t oid, daos_epoch_t eph, unsigned int shard,
-		      unsigned int tgt_idx, unsigned int *cnt, int ref);
+		      daos_size_t size, unsigned int tgt_idx, unsigned int *cnt,
+		      int ref);
 
 int
 rebuild_cont_obj_insert(daos_handle_t toh, uuid_t co_uuid, daos_unit_oid_t oid,
 			daos_epoch_t epoch, unsigned int shard,
-			unsigned int tgt_idx, unsigned int *cnt, int ref,
+			daos_size_t size, unsigned int tgt_idx,
+			unsigned int *cnt, int ref,
 			rebuild_obj_insert_cb_t obj_cb);
 int
 rebuilt_btr_destroy(daos_handle_t btr_hdl);
@@ -349,4 +391,16 @@ void
 rebuild_one_destroy(struct rebuild_one *rdone);
 void
 rebuild_hang(void);
+
+/* obj_index.c */
+bool
+rebuild_obj_is_index(daos_unit_oid_t oid);
+bool
+rebuild_obj_index_valid(daos_handle_t coh);
+void
+rebuild_obj_index_add(daos_handle_t coh, daos_unit_oid_t oid, uint32_t tgt_id,
+		      uint32_t shard, daos_epoch_t punched);
+int
+rebuild_obj_index_iterate(daos_handle_t coh, uuid_t co_uuid, uint32_t tgt_id,
+			  cont_iter_cb_t callback, void *arg);
 #endif /* __REBUILD_INTERNAL_H_ */
@@ -138,6 +138,9 @@ rebuild_iv_ent_update(struct ds_iv_entry *entry, d_sg_list_t *dst,
 				src_iv->riv_toberb_obj_count;
 			rgt->rgt_status.rs_obj_nr += src_iv->riv_obj_count;
 			rgt->rgt_status.rs_rec_nr += src_iv->riv_rec_count;
+			rgt->rgt_status.rs_toberb_size +=
+				src_iv->riv_toberb_size;
+			rgt->rgt_status.rs_size += src_iv->riv_size;
 		}
 
 		rebuild_global_status_update(rgt, src_iv);
@@ -200,7 +203,7 @@ rebuild_iv_ent_refresh(d_sg_list_t *dst, d_sg_list_t *src, int ref_rc,
 		rc = crt_group_rank(NULL, &rank);
 		if (dst_iv->riv_global_done && rc == 0 &&
 		    d_rank_in_rank_list(rpt->rt_svc_list, rank)) {
-			struct daos_rebuild_status rs;
+			struct daos_rebuild_status rs = { 0 };
 
 			rs.rs_version	= src_iv->riv_ver;
 			rs.rs_errno	= src_iv->riv_status;
@@ -209,6 +212,8 @@ rebuild_iv_ent_refresh(d_sg_list_t *dst, d_sg_list_t *src, int ref_rc,
 			rs.rs_rec_nr	= src_iv->riv_rec_count;
 			rs.rs_toberb_obj_nr	=
 				src_iv->riv_toberb_obj_count;
+			rs.rs_toberb_size	= src_iv->riv_toberb_size;
+			rs.rs_size		= src_iv->riv_size;
 
 			rc = rebuild_status_completed_update(
 					src_iv->riv_pool_uuid, &rs);
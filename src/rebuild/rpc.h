@@ -75,7 +75,7 @@ extern struct crt_proto_format rebuild_proto_fmt;
 	((uint32_t)		(rsi_pool_map_ver)	CRT_VAR) \
 	((uint32_t)		(rsi_rebuild_ver)	CRT_VAR) \
 	((uint32_t)		(rsi_master_rank)	CRT_VAR) \
-	((uint32_t)		(rsi_padding)		CRT_VAR)
+	((uint32_t)		(rsi_rebuild_op)	CRT_VAR)
 
 #define DAOS_OSEQ_REBUILD_SCAN	/* output fields */		 \
 	((d_rank_list_t)	(rso_ranks_list)	CRT_PTR) \
@@ -90,7 +90,8 @@ CRT_RPC_DECLARE(rebuild_scan, DAOS_ISEQ_REBUILD_SCAN, DAOS_OSEQ_REBUILD_SCAN)
 	((daos_unit_oid_t)	(roi_oids)		CRT_ARRAY) \
 	((uint64_t)		(roi_ephs)		CRT_ARRAY) \
 	((uuid_t)		(roi_uuids)		CRT_ARRAY) \
-	((uint32_t)		(roi_shards)		CRT_ARRAY)
+	((uint32_t)		(roi_shards)		CRT_ARRAY) \
+	((uint64_t)		(roi_sizes)		CRT_ARRAY)
 
 #define DAOS_OSEQ_REBUILD	/* output fields */		 \
 	((int32_t)		(roo_status)		CRT_VAR)
@@ -51,6 +51,7 @@ struct rebuild_send_arg {
 	daos_epoch_t	    *ephs;
 	uuid_t		    *uuids;
 	unsigned int	    *shards;
+	uint64_t	    *sizes;
 	uuid_t		    current_uuid;
 	int		    count;
 };
@@ -60,6 +61,15 @@ struct rebuild_scan_arg {
 	struct rebuild_tgt_pool_tracker *rpt;
 	ABT_mutex		scan_lock;
 	int			rebuild_tgt_nr;
+	/* targets to rebuild, to look up the replica index */
+	struct pool_target	*rb_tgts;
+	unsigned int		rb_tgt_nr;
+};
+
+/* Per container argument of the scanner */
+struct rebuild_cont_scan_arg {
+	struct rebuild_scan_arg	*scan_arg;
+	daos_handle_t		 coh;
 };
 
 static int
@@ -71,6 +81,7 @@ rebuild_obj_fill_buf(daos_handle_t ih, daos_iov_t *key_iov,
 	daos_unit_oid_t		*oids = arg->oids;
 	daos_epoch_t		*ephs = arg->ephs;
 	struct rebuild_obj_key	*key = key_iov->iov_buf;
+	struct rebuild_obj_val	*val = val_iov->iov_buf;
 	uuid_t			*uuids = arg->uuids;
 	unsigned int		*shards = arg->shards;
 	int			count = arg->count;
@@ -79,7 +90,8 @@ rebuild_obj_fill_buf(daos_handle_t ih, daos_iov_t *key_iov,
 	D_ASSERT(count < REBUILD_SEND_LIMIT);
 	oids[count] = key->oid;
 	ephs[count] = key->eph;
-	shards[count] = *((unsigned int *)val_iov->iov_buf);
+	shards[count] = val->shard;
+	arg->sizes[count] = val->size;
 	uuid_copy(uuids[count], arg->current_uuid);
 	arg->count++;
 
@@ -155,6 +167,7 @@ rebuild_objects_send(struct rebuild_root *root, unsigned int tgt_id,
 	daos_epoch_t		*ephs = NULL;
 	uuid_t			*uuids = NULL;
 	unsigned int		*shards = NULL;
+	uint64_t		*sizes = NULL;
 	crt_rpc_t		*rpc = NULL;
 	crt_endpoint_t		tgt_ep = {0};
 	int			rc = 0;
@@ -179,12 +192,17 @@ rebuild_objects_send(struct rebuild_root *root, unsigned int tgt_id,
 	if (ephs == NULL)
 		D_GOTO(out, rc = -DER_NOMEM);
 
+	D_ALLOC_ARRAY(sizes, REBUILD_SEND_LIMIT);
+	if (sizes == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
 	arg->tgt_root = root;
 	arg->count = 0;
 	arg->oids = oids;
 	arg->uuids = uuids;
 	arg->shards = shards;
 	arg->ephs = ephs;
+	arg->sizes = sizes;
 
 	while (!dbtree_is_empty(root->root_hdl)) {
 		rc = dbtree_iterate(root->root_hdl, DAOS_INTENT_REBUILD, false,
@@ -234,6 +252,8 @@ rebuild_objects_send(struct rebuild_root *root, unsigned int tgt_id,
 		rebuild_in->roi_uuids.ca_arrays = uuids;
 		rebuild_in->roi_shards.ca_count = arg->count;
 		rebuild_in->roi_shards.ca_arrays = shards;
+		rebuild_in->roi_sizes.ca_count = arg->count;
+		rebuild_in->roi_sizes.ca_arrays = sizes;
 		uuid_copy(rebuild_in->roi_pool_uuid, rpt->rt_pool_uuid);
 		rebuild_in->roi_tgt_idx = target->ta_comp.co_index;
 
@@ -298,6 +318,8 @@ out:
 		D_FREE(shards);
 	if (ephs != NULL)
 		D_FREE(ephs);
+	if (sizes != NULL)
+		D_FREE(sizes);
 	if (arg != NULL)
 		D_FREE(arg);
 
@@ -418,9 +440,11 @@ rebuild_obj_tree_create(daos_handle_t toh, uuid_t uuid,
 int
 rebuild_obj_insert_cb(struct rebuild_root *cont_root, uuid_t co_uuid,
 		      daos_unit_oid_t oid, daos_epoch_t eph, unsigned int shard,
-		      unsigned int tgt_idx, unsigned int *cnt, int ref)
+		      daos_size_t size, unsigned int tgt_idx, unsigned int *cnt,
+		      int ref)
 {
 	struct rebuild_obj_key	key;
+	struct rebuild_obj_val	val = { 0 };
 	daos_iov_t		key_iov;
 	daos_iov_t		val_iov;
 	int			rc;
@@ -429,10 +453,12 @@ rebuild_obj_insert_cb(struct rebuild_root *cont_root, uuid_t co_uuid,
 	key.oid = oid;
 	key.eph = eph;
 	key.tgt_idx = tgt_idx;
+	val.shard = shard;
+	val.size = size;
 
 	/* look up the object under the container tree */
 	daos_iov_set(&key_iov, &key, sizeof(key));
-	daos_iov_set(&val_iov, &shard, sizeof(shard));
+	daos_iov_set(&val_iov, &val, sizeof(val));
 	rc = dbtree_lookup(cont_root->root_hdl, &key_iov, &val_iov);
 	D_DEBUG(DB_REBUILD, "lookup "DF_UOID" in cont "DF_UUID" eph "
 		DF_U64" rc %d\n", DP_UOID(oid), DP_UUID(co_uuid), eph, rc);
@@ -457,7 +483,8 @@ out:
 int
 rebuild_cont_obj_insert(daos_handle_t toh, uuid_t co_uuid, daos_unit_oid_t oid,
 			daos_epoch_t epoch, unsigned int shard,
-			unsigned int tgt_idx, unsigned int *cnt, int ref,
+			daos_size_t size, unsigned int tgt_idx,
+			unsigned int *cnt, int ref,
 			rebuild_obj_insert_cb_t obj_cb)
 {
 	struct rebuild_root	*cont_root;
@@ -485,7 +512,8 @@ rebuild_cont_obj_insert(daos_handle_t toh, uuid_t co_uuid, daos_unit_oid_t oid,
 		cont_root = val_iov.iov_buf;
 	}
 
-	rc = obj_cb(cont_root, co_uuid, oid, epoch, shard, tgt_idx, cnt, ref);
+	rc = obj_cb(cont_root, co_uuid, oid, epoch, shard, size, tgt_idx, cnt,
+		    ref);
 out:
 	return rc;
 }
@@ -497,7 +525,7 @@ out:
 static int
 rebuild_object_insert(struct rebuild_scan_arg *arg, unsigned int tgt_id,
 		      unsigned int shard, uuid_t pool_uuid, uuid_t co_uuid,
-		      daos_unit_oid_t oid, daos_epoch_t epoch)
+		      daos_unit_oid_t oid, daos_epoch_t epoch, daos_size_t size)
 {
 	daos_iov_t		key_iov;
 	daos_iov_t		val_iov;
@@ -522,7 +550,7 @@ rebuild_object_insert(struct rebuild_scan_arg *arg, unsigned int tgt_id,
 	}
 
 	rc = rebuild_cont_obj_insert(tgt_root->root_hdl, co_uuid, oid, epoch,
-				     shard, tgt_id, NULL, 0,
+				     shard, size, tgt_id, NULL, 0,
 				     rebuild_obj_insert_cb);
 	if (rc <= 0) {
 		ABT_mutex_unlock(arg->scan_lock);
@@ -546,12 +574,106 @@ out:
 	return rc;
 }
 
+/** max number of values visited to estimate the size of an object shard */
+#define REBUILD_SIZE_EST_VALS	256
+
+struct obj_size_est {
+	/* bytes of the values visited */
+	daos_size_t	ose_size;
+	/* bytes of the values of the dkeys before the current one */
+	daos_size_t	ose_dkey_size;
+	/* number of values visited */
+	unsigned int	ose_nr;
+	/* number of dkeys visited, including the current one */
+	unsigned int	ose_dkey_nr;
+};
+
+static int
+obj_size_iter_cb(daos_handle_t ih, vos_iter_entry_t *entry,
+		 vos_iter_type_t type, vos_iter_param_t *param, void *cb_arg,
+		 unsigned int *acts)
+{
+	struct obj_size_est	*est = cb_arg;
+
+	if (type == VOS_ITER_DKEY) {
+		est->ose_dkey_size = est->ose_size;
+		est->ose_dkey_nr++;
+		return 0;
+	} else if (type == VOS_ITER_SINGLE) {
+		est->ose_size += entry->ie_rsize;
+	} else if (type == VOS_ITER_RECX) {
+		est->ose_size += entry->ie_rsize * entry->ie_recx.rx_nr;
+	} else {
+		return 0;
+	}
+
+	/* stop the walk, the rest is extrapolated from the sample */
+	return ++est->ose_nr >= REBUILD_SIZE_EST_VALS ? 1 : 0;
+}
+
+static int
+obj_dkey_count_cb(daos_handle_t ih, vos_iter_entry_t *entry,
+		  vos_iter_type_t type, vos_iter_param_t *param, void *cb_arg,
+		  unsigned int *acts)
+{
+	(*(uint64_t *)cb_arg)++;
+	return 0;
+}
+
+/**
+ * Estimate the bytes to move for rebuilding a shard of the object, by
+ * summing up the values of the local shard. Overwritten extents are counted
+ * as well. Only the first REBUILD_SIZE_EST_VALS values are visited so the
+ * walk stays cheap for large objects: if the walk stops early, the average
+ * size of the dkeys fully visited is extrapolated to all the dkeys, which
+ * are only counted.
+ */
+static int
+rebuild_obj_size_estimate(daos_handle_t coh, daos_unit_oid_t oid,
+			  daos_size_t *size)
+{
+	struct vos_iter_anchors	 anchors = { 0 };
+	vos_iter_param_t	 param = { 0 };
+	struct obj_size_est	 est = { 0 };
+	uint64_t		 dkey_nr = 0;
+	daos_size_t		 extrap;
+	int			 rc;
+
+	*size = 0;
+	param.ip_hdl = coh;
+	param.ip_oid = oid;
+	param.ip_epr.epr_lo = 0;
+	param.ip_epr.epr_hi = DAOS_EPOCH_MAX;
+	param.ip_flags = VOS_IT_FOR_REBUILD;
+	rc = vos_iterate(&param, VOS_ITER_DKEY, true, &anchors,
+			 obj_size_iter_cb, &est);
+	if (rc < 0)
+		return rc;
+
+	*size = est.ose_size;
+	/* the whole shard was visited, or nothing to extrapolate from */
+	if (rc == 0 || est.ose_dkey_nr < 2)
+		return 0;
+
+	memset(&anchors, 0, sizeof(anchors));
+	rc = vos_iterate(&param, VOS_ITER_DKEY, false, &anchors,
+			 obj_dkey_count_cb, &dkey_nr);
+	if (rc < 0)
+		return rc;
+
+	extrap = est.ose_dkey_size / (est.ose_dkey_nr - 1) * dkey_nr;
+	if (extrap > *size)
+		*size = extrap;
+	return 0;
+}
+
 #define LOCAL_ARRAY_SIZE	128
 static int
 placement_check(uuid_t co_uuid, daos_unit_oid_t oid,
 		daos_epoch_t epoch, void *data)
 {
-	struct rebuild_scan_arg	*arg = data;
+	struct rebuild_cont_scan_arg *cont_arg = data;
+	struct rebuild_scan_arg	*arg = cont_arg->scan_arg;
 	struct rebuild_tgt_pool_tracker *rpt = arg->rpt;
 	struct pl_obj_layout	*layout = NULL;
 	struct pl_map		*map = NULL;
@@ -560,6 +682,7 @@ placement_check(uuid_t co_uuid, daos_unit_oid_t oid,
 	unsigned int		shard_array[LOCAL_ARRAY_SIZE];
 	unsigned int		*tgts = NULL;
 	unsigned int		*shards = NULL;
+	daos_size_t		size = 0;
 	int			rebuild_nr;
 	d_rank_t		myrank;
 	int			i;
@@ -568,6 +691,9 @@ placement_check(uuid_t co_uuid, daos_unit_oid_t oid,
 	if (rpt->rt_abort)
 		return 1;
 
+	if (rebuild_obj_is_index(oid))
+		return 0;
+
 	map = pl_map_find(rpt->rt_pool_uuid, oid.id_pub);
 	if (map == NULL) {
 		D_ERROR(DF_UOID"Cannot find valid placement map"
@@ -589,12 +715,28 @@ placement_check(uuid_t co_uuid, daos_unit_oid_t oid,
 		shards = shard_array;
 	}
 
-	rebuild_nr = pl_obj_find_rebuild(map, &md, NULL, rpt->rt_rebuild_ver,
-					 tgts, shards, arg->rebuild_tgt_nr);
+	if (rpt->rt_rebuild_op == RB_OP_REINT)
+		rebuild_nr = pl_obj_find_reint(map, &md, NULL,
+					       rpt->rt_rebuild_ver, tgts,
+					       shards, arg->rebuild_tgt_nr);
+	else
+		rebuild_nr = pl_obj_find_rebuild(map, &md, NULL,
+						 rpt->rt_rebuild_ver, tgts,
+						 shards, arg->rebuild_tgt_nr);
 	if (rebuild_nr <= 0) /* No need rebuild */
 		D_GOTO(out, rc = rebuild_nr);
 
 	D_ASSERT(rebuild_nr <= arg->rebuild_tgt_nr);
+	if (epoch == DAOS_EPOCH_MAX) {
+		/* the size is only for progress report, don't fail on it */
+		rc = rebuild_obj_size_estimate(cont_arg->coh, oid, &size);
+		if (rc) {
+			D_WARN(DF_UOID" size estimation failed: %d\n",
+			       DP_UOID(oid), rc);
+			rc = 0;
+		}
+	}
+
 	for (i = 0; i < rebuild_nr; i++) {
 		D_DEBUG(DB_REBUILD, "rebuild obj "DF_UOID"/"DF_UUID"/"DF_UUID
 			" on %d for shard %d\n", DP_UOID(oid), DP_UUID(co_uuid),
@@ -610,9 +752,17 @@ placement_check(uuid_t co_uuid, daos_unit_oid_t oid,
 		if (myrank != tgts[i]) {
 			rc = rebuild_object_insert(arg, tgts[i], shards[i],
 						   rpt->rt_pool_uuid, co_uuid,
-						   oid, epoch);
+						   oid, epoch, size);
 			if (rc)
 				D_GOTO(out, rc);
+
+			/* the spare holds a replica of the local shard now */
+			if (rpt->rt_rebuild_op == RB_OP_FAIL &&
+			    !daos_handle_is_inval(cont_arg->coh))
+				rebuild_obj_index_add(cont_arg->coh, oid,
+						      tgts[i], shards[i],
+						      epoch == DAOS_EPOCH_MAX ?
+						      0 : epoch);
 		} else {
 			D_DEBUG(DB_REBUILD, "skip "DF_UOID".\n", DP_UOID(oid));
 			rc = 0;
@@ -634,17 +784,55 @@ out:
 	return rc;
 }
 
-struct rebuild_iter_arg {
-	cont_iter_cb_t	callback;
-	void		*arg;
-};
+static int
+rebuild_cont_scan_cb(daos_handle_t ph, uuid_t co_uuid, void *data)
+{
+	struct rebuild_scan_arg		*scan_arg = data;
+	struct rebuild_cont_scan_arg	 arg;
+	unsigned int			 i;
+	int				 rc;
+
+	arg.scan_arg = scan_arg;
+	rc = vos_cont_open(ph, co_uuid, &arg.coh);
+	if (rc) {
+		D_ERROR("Open container "DF_UUID" failed: rc %d\n",
+			DP_UUID(co_uuid), rc);
+		return rc;
+	}
+
+	/* only the objects with a replica on the rebuilding targets are
+	 * looked up in the index, containers without a complete index are
+	 * fully scanned. Reintegration always scans all objects, because the
+	 * objects created while the targets were down are indexed under the
+	 * spare targets instead.
+	 */
+	if (scan_arg->rpt->rt_rebuild_op == RB_OP_REINT ||
+	    !rebuild_obj_index_valid(arg.coh)) {
+		D_DEBUG(DB_REBUILD, "scan all objects of "DF_UUID"\n",
+			DP_UUID(co_uuid));
+		rc = ds_cont_obj_iter(ph, co_uuid, placement_check, &arg);
+		goto out;
+	}
+
+	for (i = 0; i < scan_arg->rb_tgt_nr; i++) {
+		rc = rebuild_obj_index_iterate(arg.coh, co_uuid,
+					scan_arg->rb_tgts[i].ta_comp.co_id,
+					placement_check, &arg);
+		if (rc)
+			break;
+	}
+out:
+	vos_cont_close(arg.coh);
+	return rc;
+}
 
 int
 rebuild_scanner(void *data)
 {
-	struct rebuild_iter_arg *arg = data;
-	struct rebuild_scan_arg	*scan_arg = arg->arg;
+	struct rebuild_scan_arg		*scan_arg = data;
 	struct rebuild_tgt_pool_tracker *rpt = scan_arg->rpt;
+	struct ds_pool_child		*child;
+	int				 rc;
 
 	if (!is_current_tgt_up(rpt))
 		return 0;
@@ -652,8 +840,13 @@ rebuild_scanner(void *data)
 	while (daos_fail_check(DAOS_REBUILD_TGT_SCAN_HANG))
 		ABT_thread_yield();
 
-	return ds_pool_obj_iter(rpt->rt_pool_uuid, arg->callback,
-				arg->arg);
+	child = ds_pool_child_lookup(rpt->rt_pool_uuid);
+	if (child == NULL)
+		return -DER_NONEXIST;
+
+	rc = ds_pool_cont_iter(child->spc_hdl, rebuild_cont_scan_cb, scan_arg);
+	ds_pool_child_put(child);
+	return rc;
 }
 
 static int
@@ -670,6 +863,20 @@ rebuild_scan_done(void *data)
 	return 0;
 }
 
+/**
+ * Find the targets being rebuilt, i.e. the DOWN targets for failures. The
+ * reintegration scans all objects, so it doesn't need them.
+ */
+static int
+rebuild_scan_tgts_get(struct rebuild_tgt_pool_tracker *rpt,
+		      struct pool_map *map, struct rebuild_scan_arg *arg)
+{
+	if (rpt->rt_rebuild_op == RB_OP_REINT)
+		return 0;
+
+	return pool_map_find_down_tgts(map, &arg->rb_tgts, &arg->rb_tgt_nr);
+}
+
 /**
  * Wait for pool map and setup global status, then spawn scanners for all
  * service xsteams
@@ -681,7 +888,6 @@ rebuild_scan_leader(void *data)
 	struct pool_map		  *map;
 	struct rebuild_tgt_pool_tracker *rpt;
 	struct rebuild_pool_tls	  *tls;
-	struct rebuild_iter_arg    iter_arg;
 	int			   rc;
 
 	D_ASSERT(arg != NULL);
@@ -699,10 +905,11 @@ rebuild_scan_leader(void *data)
 	}
 	ABT_mutex_unlock(rpt->rt_lock);
 
-	iter_arg.arg = arg;
-	iter_arg.callback = placement_check;
+	rc = rebuild_scan_tgts_get(rpt, map, arg);
+	if (rc)
+		D_GOTO(put_plmap, rc);
 
-	rc = dss_thread_collective(rebuild_scanner, &iter_arg, 0);
+	rc = dss_thread_collective(rebuild_scanner, arg, 0);
 	if (rc)
 		D_GOTO(put_plmap, rc);
 
@@ -744,6 +951,8 @@ out_map:
 	D_DEBUG(DB_REBUILD, DF_UUID"scan leader done %d\n",
 		DP_UUID(rpt->rt_pool_uuid), rc);
 	ABT_mutex_free(&arg->scan_lock);
+	if (arg->rb_tgts != NULL)
+		D_FREE(arg->rb_tgts);
 	D_FREE(arg);
 	rpt_put(rpt);
 }
@@ -103,6 +103,7 @@ rebuild_pool_tls_create(uuid_t pool_uuid, uuid_t poh_uuid, uuid_t coh_uuid,
 	rebuild_pool_tls->rebuild_pool_scanning = 1;
 	rebuild_pool_tls->rebuild_pool_rec_count = 0;
 	rebuild_pool_tls->rebuild_pool_obj_count = 0;
+	rebuild_pool_tls->rebuild_pool_size = 0;
 
 	/* Only 1 thread will access the list, no need lock */
 	d_list_add(&rebuild_pool_tls->rebuild_pool_list,
@@ -398,7 +399,8 @@ is_current_tgt_up(struct rebuild_tgt_pool_tracker *rpt)
 	rc = pool_map_find_target_by_rank_idx(rpt->rt_pool->sp_map, rank,
 					      idx, &tgt);
 	D_ASSERT(rc == 1);
-	if (tgt->ta_comp.co_status != PO_COMP_ST_UP) {
+	/* a reintegrating target is not a source of the rebuild */
+	if (pool_target_unavail(tgt) || pool_target_reint(tgt)) {
 		D_DEBUG(DB_REBUILD, "%d/%d target status %d\n",
 			rank, idx, tgt->ta_comp.co_status);
 		return false;
@@ -439,6 +441,7 @@ dss_rebuild_check_one(void *data)
 
 	status->rec_count += pool_tls->rebuild_pool_rec_count;
 	status->obj_count += pool_tls->rebuild_pool_obj_count;
+	status->size += pool_tls->rebuild_pool_size;
 
 	ABT_mutex_unlock(status->lock);
 
@@ -499,6 +502,33 @@ out:
 	return rc;
 }
 
+/**
+ * Estimate the rebuild rate and the remaining time by the bytes rebuilt
+ * since the rebuild started.
+ */
+static void
+rebuild_status_eta_update(struct rebuild_global_pool_tracker *rgt)
+{
+	struct daos_rebuild_status	*rs = &rgt->rgt_status;
+	double				 elapsed;
+
+	rs->rs_rate = 0;
+	rs->rs_eta = 0;
+	elapsed = ABT_get_wtime() - rgt->rgt_start_time;
+	if (elapsed <= 0)
+		return;
+
+	rs->rs_rate = (uint64_t)(rs->rs_size / elapsed);
+	if (rs->rs_done || rs->rs_rate == 0)
+		return;
+
+	if (rs->rs_toberb_size > rs->rs_size)
+		rs->rs_eta = (rs->rs_toberb_size - rs->rs_size) / rs->rs_rate;
+	/* the estimate can fall short, don't report a running rebuild done */
+	if (rs->rs_eta == 0)
+		rs->rs_eta = 1;
+}
+
 int
 ds_rebuild_query(uuid_t pool_uuid, struct daos_rebuild_status *status)
 {
@@ -520,6 +550,7 @@ ds_rebuild_query(uuid_t pool_uuid, struct daos_rebuild_status *status)
 			D_GOTO(out, rc = 0);
 		}
 	} else {
+		rebuild_status_eta_update(rgt);
 		memcpy(status, &rgt->rgt_status, sizeof(*status));
 		status->rs_version = rgt->rgt_rebuild_ver;
 	}
@@ -644,6 +675,7 @@ rebuild_leader_status_check(struct ds_pool *pool, uint32_t map_ver,
 		/* query the current rebuild status */
 		if (rgt->rgt_done)
 			rs->rs_done = 1;
+		rebuild_status_eta_update(rgt);
 
 		if (rs->rs_done)
 			str = rs->rs_errno ? "failed" : "completed";
@@ -656,11 +688,14 @@ rebuild_leader_status_check(struct ds_pool *pool, uint32_t map_ver,
 
 		snprintf(sbuf, RBLD_SBUF_LEN,
 			"Rebuild [%s] (pool "DF_UUID" ver=%u, toberb_obj="
-			DF_U64", rb_obj="DF_U64", rec= "DF_U64", done %d "
-			"status %d duration=%d secs)\n",
+			DF_U64", rb_obj="DF_U64", rec= "DF_U64", toberb_size="
+			DF_U64", rb_size="DF_U64", rate="DF_U64" B/s, eta="
+			DF_U64" secs, done %d status %d duration=%d secs)\n",
 			str, DP_UUID(pool->sp_uuid), map_ver,
 			rs->rs_toberb_obj_nr, rs->rs_obj_nr, rs->rs_rec_nr,
-			rs->rs_done, rs->rs_errno, (int)(now - begin));
+			rs->rs_toberb_size, rs->rs_size, rs->rs_rate,
+			rs->rs_eta, rs->rs_done, rs->rs_errno,
+			(int)(now - begin));
 
 		D_DEBUG(DB_REBUILD, "%s", sbuf);
 		if (rs->rs_done || rebuild_gst.rg_abort || rgt->rgt_abort) {
@@ -704,6 +739,7 @@ rebuild_global_pool_tracker_create(struct ds_pool *pool, uint32_t ver,
 	if (rgt == NULL)
 		return -DER_NOMEM;
 	D_INIT_LIST_HEAD(&rgt->rgt_list);
+	rgt->rgt_start_time = ABT_get_wtime();
 
 	node_nr = pool_map_node_nr(pool->sp_map);
 	array_size = roundup(node_nr, DAOS_BITS_SIZE) / DAOS_BITS_SIZE;
@@ -787,6 +823,7 @@ static int
 rebuild_prepare(struct ds_pool *pool, uint32_t rebuild_ver,
 		uint64_t leader_term,
 		struct pool_target_id_list *exclude_tgts,
+		daos_rebuild_opc_t op,
 		struct rebuild_global_pool_tracker **rgt)
 {
 	unsigned int	master_rank;
@@ -829,6 +866,13 @@ rebuild_prepare(struct ds_pool *pool, uint32_t rebuild_ver,
 			if (ret <= 0)
 				continue;
 
+			/* The reintegrated targets pull the data themselves */
+			if (op == RB_OP_REINT) {
+				if (pool_target_reint(target))
+					excluded = true;
+				continue;
+			}
+
 			if (target &&
 			    target->ta_comp.co_status == PO_COMP_ST_DOWN)
 				excluded = true;
@@ -868,7 +912,7 @@ rebuild_scan_broadcast(struct ds_pool *pool,
 		       struct rebuild_global_pool_tracker *rgt,
 		       struct pool_target_id_list *tgts_failed,
 		       d_rank_list_t *svc_list, uint32_t map_ver,
-		       daos_iov_t *map_buf)
+		       daos_iov_t *map_buf, daos_rebuild_opc_t op)
 {
 	struct rebuild_scan_in	*rsi;
 	struct rebuild_scan_out	*rso;
@@ -912,6 +956,7 @@ retry:
 	rsi->rsi_leader_term = rgt->rgt_leader_term;
 	rsi->rsi_rebuild_ver = rgt->rgt_rebuild_ver;
 	rsi->rsi_tgts_num = tgts_failed->pti_number;
+	rsi->rsi_rebuild_op = op;
 	rsi->rsi_svc_list = svc_list;
 	crt_group_rank(pool->sp_group,  &rsi->rsi_master_rank);
 	rc = dss_rpc_send(rpc);
@@ -967,7 +1012,7 @@ retry:
 
 			rc = ds_rebuild_schedule(pool->sp_uuid,
 					pool_map_get_version(pool->sp_map),
-					&list, svc_list);
+					&list, svc_list, RB_OP_FAIL);
 			if (rc != 0) {
 				D_ERROR("rebuild fails rc %d\n", rc);
 				break;
@@ -1077,7 +1122,7 @@ rebuild_task_destroy(struct rebuild_task *task)
 static int
 rebuild_leader_start(struct ds_pool *pool, uint32_t rebuild_ver,
 		     struct pool_target_id_list *tgts_failed,
-		     d_rank_list_t *svc_list,
+		     d_rank_list_t *svc_list, daos_rebuild_opc_t op,
 		     struct rebuild_global_pool_tracker **p_rgt)
 {
 	uint32_t	map_ver;
@@ -1094,7 +1139,7 @@ rebuild_leader_start(struct ds_pool *pool, uint32_t rebuild_ver,
 		D_GOTO(out, rc);
 	}
 
-	rc = rebuild_prepare(pool, rebuild_ver, leader_term, tgts_failed,
+	rc = rebuild_prepare(pool, rebuild_ver, leader_term, tgts_failed, op,
 			     p_rgt);
 	if (rc) {
 		D_ERROR("rebuild prepare failed: rc %d\n", rc);
@@ -1109,7 +1154,7 @@ rebuild_leader_start(struct ds_pool *pool, uint32_t rebuild_ver,
 
 	/* broadcast scan RPC to all targets */
 	rc = rebuild_scan_broadcast(pool, *p_rgt, tgts_failed, svc_list,
-				    map_ver, &map_buf_iov);
+				    map_ver, &map_buf_iov, op);
 	if (rc) {
 		D_ERROR("object scan failed: rc %d\n", rc);
 		D_GOTO(out, rc);
@@ -1141,7 +1186,8 @@ rebuild_task_ult(void *arg)
 		 DP_UUID(task->dst_pool_uuid), task->dst_map_ver);
 
 	rc = rebuild_leader_start(pool, task->dst_map_ver, &task->dst_tgts,
-				  task->dst_svc_list, &rgt);
+				  task->dst_svc_list, task->dst_rebuild_op,
+				  &rgt);
 	if (rc != 0) {
 		if (rc == -DER_CANCELED) {
 			D_DEBUG(DB_REBUILD, "pool "DF_UUID" ver %u rebuild is"
@@ -1173,10 +1219,17 @@ rebuild_task_ult(void *arg)
 		D_GOTO(out, rc);
 	}
 
-	rc = ds_pool_tgt_exclude_out(pool->sp_uuid, &task->dst_tgts);
-	D_DEBUG(DB_REBUILD, "mark failed target %d of "DF_UUID
-		" as DOWNOUT: %d\n", task->dst_tgts.pti_ids[0].pti_id,
-		DP_UUID(task->dst_pool_uuid), rc);
+	if (task->dst_rebuild_op == RB_OP_REINT) {
+		rc = ds_pool_tgt_add_in(pool->sp_uuid, &task->dst_tgts);
+		D_DEBUG(DB_REBUILD, "mark reintegrated target %d of "DF_UUID
+			" as UPIN: %d\n", task->dst_tgts.pti_ids[0].pti_id,
+			DP_UUID(task->dst_pool_uuid), rc);
+	} else {
+		rc = ds_pool_tgt_exclude_out(pool->sp_uuid, &task->dst_tgts);
+		D_DEBUG(DB_REBUILD, "mark failed target %d of "DF_UUID
+			" as DOWNOUT: %d\n", task->dst_tgts.pti_ids[0].pti_id,
+			DP_UUID(task->dst_pool_uuid), rc);
+	}
 
 	memset(&iv, 0, sizeof(iv));
 	uuid_copy(iv.riv_pool_uuid, task->dst_pool_uuid);
@@ -1188,6 +1241,8 @@ rebuild_task_ult(void *arg)
 	iv.riv_toberb_obj_count	= rgt->rgt_status.rs_toberb_obj_nr;
 	iv.riv_obj_count	= rgt->rgt_status.rs_obj_nr;
 	iv.riv_rec_count	= rgt->rgt_status.rs_rec_nr;
+	iv.riv_toberb_size	= rgt->rgt_status.rs_toberb_size;
+	iv.riv_size		= rgt->rgt_status.rs_size;
 
 	rc = rebuild_iv_update(pool->sp_iv_ns,
 			       &iv, CRT_IV_SHORTCUT_NONE,
@@ -1196,6 +1251,7 @@ out:
 	ds_pool_put(pool);
 	if (rgt) {
 		rgt->rgt_status.rs_version = rgt->rgt_rebuild_ver;
+		rebuild_status_eta_update(rgt);
 		rc = rebuild_status_completed_update(task->dst_pool_uuid,
 						     &rgt->rgt_status);
 		if (rc != 0) {
@@ -1351,7 +1407,7 @@ ds_rebuild_leader_stop_all()
 int
 ds_rebuild_schedule(const uuid_t uuid, uint32_t map_ver,
 		    struct pool_target_id_list *tgts_failed,
-		    d_rank_list_t *svc_list)
+		    d_rank_list_t *svc_list, daos_rebuild_opc_t op)
 {
 	struct rebuild_task	*task;
 	struct rebuild_task	*found = NULL;
@@ -1360,7 +1416,8 @@ ds_rebuild_schedule(const uuid_t uuid, uint32_t map_ver,
 	/* Check if the pool already in the queue list */
 	d_list_for_each_entry(task, &rebuild_gst.rg_queue_list,
 			      dst_list) {
-		if (uuid_compare(task->dst_pool_uuid, uuid) == 0) {
+		if (uuid_compare(task->dst_pool_uuid, uuid) == 0 &&
+		    task->dst_rebuild_op == op) {
 			found = task;
 			break;
 		}
@@ -1386,6 +1443,7 @@ ds_rebuild_schedule(const uuid_t uuid, uint32_t map_ver,
 		return -DER_NOMEM;
 
 	task->dst_map_ver = map_ver;
+	task->dst_rebuild_op = op;
 	uuid_copy(task->dst_pool_uuid, uuid);
 	D_INIT_LIST_HEAD(&task->dst_list);
 
@@ -1421,47 +1479,77 @@ free:
 	return rc;
 }
 
+static int
+rebuild_tgts_regenerate(struct ds_pool *pool, struct pool_target *tgts,
+			unsigned int tgts_cnt, d_rank_list_t *svc_list,
+			daos_rebuild_opc_t op)
+{
+	unsigned int	i;
+	int		rc = 0;
+
+	for (i = 0; i < tgts_cnt; i++) {
+		struct pool_target		*tgt = &tgts[i];
+		struct pool_target_id		tgt_id;
+		struct pool_target_id_list	id_list;
+		uint32_t			ver;
+
+		if (op == RB_OP_REINT && !pool_target_reint(tgt))
+			continue;
+
+		/* reintegration is scheduled by the version of POOL_ADD */
+		ver = op == RB_OP_REINT ? tgt->ta_comp.co_ver :
+					  tgt->ta_comp.co_fseq;
+		tgt_id.pti_id = tgt->ta_comp.co_id;
+		id_list.pti_ids = &tgt_id;
+		id_list.pti_number = 1;
+
+		rc = ds_rebuild_schedule(pool->sp_uuid, ver, &id_list,
+					 svc_list, op);
+		if (rc) {
+			D_ERROR(DF_UUID" schedule ver %d failed: rc %d\n",
+				DP_UUID(pool->sp_uuid), ver, rc);
+			break;
+		}
+	}
+
+	return rc;
+}
+
 /* Regenerate the rebuild tasks when changing the leader. */
 int
 ds_rebuild_regenerate_task(struct ds_pool *pool, d_rank_list_t *svc_list)
 {
-	struct pool_target *down_tgts;
-	unsigned int	down_tgts_cnt;
-	unsigned int	i;
+	struct pool_target *tgts;
+	unsigned int	tgts_cnt;
 	int		rc;
 
 	rebuild_gst.rg_abort = 0;
 
 	/* get all down targets */
-	rc = pool_map_find_down_tgts(pool->sp_map, &down_tgts,
-				     &down_tgts_cnt);
+	rc = pool_map_find_down_tgts(pool->sp_map, &tgts, &tgts_cnt);
 	if (rc != 0) {
 		D_ERROR("failed to create failed tgt list rc %d\n", rc);
 		return rc;
 	}
 
-	if (down_tgts_cnt == 0)
-		return 0;
-
-	for (i = 0; i < down_tgts_cnt; i++) {
-		struct pool_target		*tgt = &down_tgts[i];
-		struct pool_target_id		tgt_id;
-		struct pool_target_id_list	id_list;
-
-		tgt_id.pti_id = tgt->ta_comp.co_id;
-		id_list.pti_ids = &tgt_id;
-		id_list.pti_number = 1;
+	rc = rebuild_tgts_regenerate(pool, tgts, tgts_cnt, svc_list,
+				     RB_OP_FAIL);
+	if (tgts != NULL)
+		D_FREE(tgts);
+	if (rc)
+		return rc;
 
-		rc = ds_rebuild_schedule(pool->sp_uuid, tgt->ta_comp.co_fseq,
-					 &id_list, svc_list);
-		if (rc) {
-			D_ERROR(DF_UUID" schedule ver %d failed: rc %d\n",
-				DP_UUID(pool->sp_uuid), tgt->ta_comp.co_fseq,
-				rc);
-			break;
-		}
+	/* then the targets being reintegrated */
+	rc = pool_map_find_up_tgts(pool->sp_map, &tgts, &tgts_cnt);
+	if (rc != 0) {
+		D_ERROR("failed to create up tgt list rc %d\n", rc);
+		return rc;
 	}
 
+	rc = rebuild_tgts_regenerate(pool, tgts, tgts_cnt, svc_list,
+				     RB_OP_REINT);
+	if (tgts != NULL)
+		D_FREE(tgts);
 	return rc;
 }
 
@@ -1622,10 +1710,14 @@ rebuild_tgt_status_check(void *arg)
 		D_ASSERT(status.obj_count >= rpt->rt_reported_obj_cnt);
 		D_ASSERT(status.rec_count >= rpt->rt_reported_rec_cnt);
 		D_ASSERT(rpt->rt_toberb_objs >= rpt->rt_reported_toberb_objs);
+		D_ASSERT(status.size >= rpt->rt_reported_size);
+		D_ASSERT(rpt->rt_toberb_size >= rpt->rt_reported_toberb_size);
 		if (rpt->rt_re_report) {
 			iv.riv_toberb_obj_count = rpt->rt_toberb_objs;
 			iv.riv_obj_count = status.obj_count;
 			iv.riv_rec_count = status.rec_count;
+			iv.riv_toberb_size = rpt->rt_toberb_size;
+			iv.riv_size = status.size;
 		} else {
 			iv.riv_toberb_obj_count = rpt->rt_toberb_objs -
 						  rpt->rt_reported_toberb_objs;
@@ -1633,6 +1725,9 @@ rebuild_tgt_status_check(void *arg)
 					   rpt->rt_reported_obj_cnt;
 			iv.riv_rec_count = status.rec_count -
 					   rpt->rt_reported_rec_cnt;
+			iv.riv_toberb_size = rpt->rt_toberb_size -
+					     rpt->rt_reported_toberb_size;
+			iv.riv_size = status.size - rpt->rt_reported_size;
 		}
 		iv.riv_status = status.status;
 		if (status.scanning == 0 || rpt->rt_abort) {
@@ -1669,13 +1764,18 @@ rebuild_tgt_status_check(void *arg)
 				if (rpt->rt_re_report) {
 					rpt->rt_reported_toberb_objs =
 						iv.riv_toberb_obj_count;
+					rpt->rt_reported_toberb_size =
+						iv.riv_toberb_size;
 					rpt->rt_re_report = 0;
 				} else {
 					rpt->rt_reported_toberb_objs +=
 						iv.riv_toberb_obj_count;
+					rpt->rt_reported_toberb_size +=
+						iv.riv_toberb_size;
 				}
 				rpt->rt_reported_obj_cnt = status.obj_count;
 				rpt->rt_reported_rec_cnt = status.rec_count;
+				rpt->rt_reported_size = status.size;
 			} else {
 				D_WARN("rebuild tgt iv update failed: %d\n",
 					rc);
@@ -1779,6 +1879,9 @@ rpt_create(struct ds_pool *pool, d_rank_list_t *svc_list, uint32_t pm_ver,
 	rpt->rt_reported_toberb_objs = 0;
 	rpt->rt_reported_obj_cnt = 0;
 	rpt->rt_reported_rec_cnt = 0;
+	rpt->rt_toberb_size = 0;
+	rpt->rt_reported_toberb_size = 0;
+	rpt->rt_reported_size = 0;
 	rpt->rt_rebuild_ver = pm_ver;
 	rpt->rt_leader_term = leader_term;
 	crt_group_rank(pool->sp_group, &rank);
@@ -1883,6 +1986,7 @@ rebuild_tgt_prepare(crt_rpc_t *rpc, struct rebuild_tgt_pool_tracker **p_rpt)
 
 	uuid_copy(rpt->rt_poh_uuid, rsi->rsi_pool_hdl_uuid);
 	uuid_copy(rpt->rt_coh_uuid, rsi->rsi_cont_hdl_uuid);
+	rpt->rt_rebuild_op = rsi->rsi_rebuild_op;
 
 	D_DEBUG(DB_REBUILD, "rebuild coh/poh "DF_UUID"/"DF_UUID"\n",
 		DP_UUID(rpt->rt_coh_uuid), DP_UUID(rpt->rt_poh_uuid));
@@ -306,6 +306,39 @@ ds_rsvc_set_hint(struct ds_rsvc *svc, struct rsvc_hint *hint)
 	hint->sh_flags |= RSVC_HINT_VALID;
 }
 
+/**
+ * Prefer the replica that is the \a idx-th, modulo the number of replicas, in
+ * the rank order to be the leader of \a svc. Services sharing the same set of
+ * replicas may pass different \a idx values to spread their leaders. Must be
+ * called on all replicas. See rdb_prefer_leader.
+ *
+ * \param[in]	svc	replicated service
+ * \param[in]	idx	index of the preferred replica
+ */
+int
+ds_rsvc_prefer_leader(struct ds_rsvc *svc, unsigned int idx)
+{
+	d_rank_list_t  *ranks;
+	d_rank_t	self;
+	int		rc;
+
+	rc = rdb_get_ranks(svc->s_db, &ranks);
+	if (rc != 0)
+		return rc;
+	if (ranks->rl_nr == 0) {
+		daos_rank_list_free(ranks);
+		return 0;
+	}
+	daos_rank_list_sort(ranks);
+
+	rc = crt_group_rank(NULL /* grp */, &self);
+	D_ASSERTF(rc == 0, "%d\n", rc);
+	rdb_prefer_leader(svc->s_db,
+			  ranks->rl_ranks[idx % ranks->rl_nr] == self);
+	daos_rank_list_free(ranks);
+	return 0;
+}
+
 static void
 get_leader(struct ds_rsvc *svc)
 {
@@ -267,6 +267,74 @@ co_properties(void **state)
 	test_teardown((void **)&arg);
 }
 
+#define CO_SVC_NR	3
+#define CO_SVC_CONTS	8
+
+/** open, allocate OIDs and close containers spread over several services */
+static void
+co_multi_svc(void **state)
+{
+	test_arg_t	*arg = *state;
+	test_arg_t	*svc_arg = NULL;
+	uuid_t		 uuids[CO_SVC_CONTS];
+	daos_handle_t	 coh;
+	uint64_t	 oid;
+	unsigned int	 svc_nr = svc_nreplicas;
+	int		 i;
+	int		 rc;
+
+	if (!test_runable(arg, CO_SVC_NR))
+		return;
+
+	/* new pool with CO_SVC_NR replicas and container services */
+	if (arg->myrank == 0)
+		daos_mgmt_set_params(arg->group, -1, DSS_KEY_FAIL_LOC,
+				     DAOS_POOL_CONT_SVC_NR | DAOS_FAIL_ALWAYS,
+				     CO_SVC_NR, NULL);
+	MPI_Barrier(MPI_COMM_WORLD);
+	svc_nreplicas = CO_SVC_NR;
+	rc = test_setup((void **)&svc_arg, SETUP_POOL_CONNECT, arg->multi_rank,
+			DEFAULT_POOL_SIZE, NULL);
+	svc_nreplicas = svc_nr;
+	if (arg->myrank == 0)
+		daos_mgmt_set_params(arg->group, -1, DSS_KEY_FAIL_LOC, 0, 0,
+				     NULL);
+	MPI_Barrier(MPI_COMM_WORLD);
+	assert_int_equal(rc, 0);
+
+	if (arg->myrank != 0)
+		goto out;
+
+	/* containers map to services by UUID, so most services get some */
+	for (i = 0; i < CO_SVC_CONTS; i++) {
+		uuid_generate(uuids[i]);
+		print_message("creating container %d\n", i);
+		rc = daos_cont_create(svc_arg->pool.poh, uuids[i], NULL, NULL);
+		assert_int_equal(rc, 0);
+
+		rc = daos_cont_open(svc_arg->pool.poh, uuids[i], DAOS_COO_RW,
+				    &coh, NULL, NULL);
+		assert_int_equal(rc, 0);
+
+		rc = daos_cont_alloc_oids(coh, 16, &oid, NULL);
+		assert_int_equal(rc, 0);
+		print_message("container %d: OID range "DF_U64" - "DF_U64"\n",
+			      i, oid, oid + 15);
+
+		rc = daos_cont_close(coh, NULL);
+		assert_int_equal(rc, 0);
+	}
+
+	for (i = 0; i < CO_SVC_CONTS; i++) {
+		rc = daos_cont_destroy(svc_arg->pool.poh, uuids[i],
+				       1 /* force */, NULL);
+		assert_int_equal(rc, 0);
+	}
+out:
+	MPI_Barrier(MPI_COMM_WORLD);
+	test_teardown((void **)&svc_arg);
+}
+
 static int
 co_setup_sync(void **state)
 {
@@ -303,6 +371,8 @@ static const struct CMUnitTest co_tests[] = {
 	  co_attribute, co_setup_async, test_case_teardown},
 	{ "CONT6: create container with properties and query",
 	  co_properties, NULL, test_case_teardown},
+	{ "CONT7: container operations over multiple container services",
+	  co_multi_svc, NULL, test_case_teardown},
 };
 
 int
@@ -1377,6 +1377,180 @@ enumerate_simple(void **state)
 	ioreq_fini(&req);
 }
 
+#define ENUM_GRP_KEY_NR		200 /* dkeys of the multi-group test */
+#define ENUM_GRP_LARGE_NR	4 /* number of large dkeys among them */
+
+/**
+ * Enumerate dkeys of an object striped over several redundancy groups, which
+ * are prefetched in parallel by the client. Large dkeys spread over the groups
+ * must be reported by -DER_KEY2BIG rather than dropped.
+ */
+static void
+enumerate_multi_grp(void **state)
+{
+	test_arg_t	*arg = *state;
+	char		*small_buf;
+	char		*large_key;
+	char		*large_buf;
+	char		*buf;
+	daos_size_t	 buf_len;
+	char		 key[ENUM_KEY_BUF];
+	daos_key_desc_t  kds[ENUM_DESC_NR];
+	daos_anchor_t	 anchor;
+	daos_obj_id_t	 oid;
+	struct ioreq	 req;
+	uint32_t	 number;
+	int		 large_nr = 0;
+	int		 key_nr = 0;
+	int		 i;
+	int		 rc;
+
+	oid = dts_oid_gen(DAOS_OC_SMALL_RW, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_ARRAY, arg);
+
+	D_ALLOC(small_buf, ENUM_DESC_BUF);
+	assert_non_null(small_buf);
+	D_ALLOC(large_key, ENUM_LARGE_KEY_BUF);
+	assert_non_null(large_key);
+	D_ALLOC(large_buf, ENUM_LARGE_KEY_BUF * 2);
+	assert_non_null(large_buf);
+
+	print_message("Insert %d dkeys, %d of them large (obj:"DF_OID")\n",
+		      ENUM_GRP_KEY_NR, ENUM_GRP_LARGE_NR, DP_OID(oid));
+	for (i = 0; i < ENUM_GRP_KEY_NR; i++) {
+		if (i % (ENUM_GRP_KEY_NR / ENUM_GRP_LARGE_NR) == 0) {
+			/* distinct large keys, so they hash to any group */
+			memset(large_key, 'A' + i % 26, ENUM_LARGE_KEY_BUF);
+			sprintf(large_key, "%d", i);
+			large_key[strlen(large_key)] = 'L';
+			large_key[ENUM_LARGE_KEY_BUF - 1] = '\0';
+			insert_single(large_key, "a_key", 0, "data",
+				      strlen("data") + 1, DAOS_TX_NONE, &req);
+		} else {
+			sprintf(key, "%d", i);
+			insert_single(key, "a_key", 0, "data",
+				      strlen("data") + 1, DAOS_TX_NONE, &req);
+		}
+	}
+
+	print_message("Enumerate dkeys\n");
+	memset(&anchor, 0, sizeof(anchor));
+	while (!daos_anchor_is_eof(&anchor)) {
+		number = ENUM_DESC_NR;
+		buf = small_buf;
+		buf_len = ENUM_DESC_BUF;
+		rc = enumerate_dkey(DAOS_TX_NONE, &number, kds, &anchor, buf,
+				    buf_len, &req);
+		if (rc == -DER_KEY2BIG) {
+			print_message("Ret:-DER_KEY2BIG, len:"DF_U64"\n",
+				      kds[0].kd_key_len);
+			assert_int_equal((int)kds[0].kd_key_len,
+					 ENUM_LARGE_KEY_BUF - 1);
+			number = ENUM_DESC_NR;
+			buf = large_buf;
+			buf_len = ENUM_LARGE_KEY_BUF * 2;
+			rc = enumerate_dkey(DAOS_TX_NONE, &number, kds,
+					    &anchor, buf, buf_len, &req);
+		}
+		assert_int_equal(rc, 0);
+
+		for (i = 0; i < number; i++) {
+			if (kds[i].kd_key_len > ENUM_KEY_BUF)
+				large_nr++;
+		}
+		key_nr += number;
+	}
+
+	print_message("Enumerated %d dkeys, %d large\n", key_nr, large_nr);
+	assert_int_equal(key_nr, ENUM_GRP_KEY_NR);
+	assert_int_equal(large_nr, ENUM_GRP_LARGE_NR);
+
+	D_FREE(small_buf);
+	D_FREE(large_buf);
+	D_FREE(large_key);
+	ioreq_fini(&req);
+}
+
+#define ENUM_GRP_BATCH_NR	10 /* dkeys per call of the resume test */
+
+/**
+ * Resume a dkey enumeration of a multi-group object after its prefetch
+ * context is gone, either recycled by other enumerations or dropped by
+ * closing the object. Every dkey must be returned exactly once.
+ */
+static void
+enumerate_multi_grp_resume(void **state)
+{
+	test_arg_t	*arg = *state;
+	char		 buf[ENUM_DESC_BUF];
+	char		 key[ENUM_KEY_BUF];
+	daos_key_desc_t  kds[ENUM_GRP_BATCH_NR];
+	bool		 seen[ENUM_GRP_KEY_NR] = { 0 };
+	daos_anchor_t	 anchor;
+	daos_anchor_t	 other;
+	daos_obj_id_t	 oid;
+	struct ioreq	 req;
+	uint32_t	 number;
+	char		*ptr;
+	int		 key_nr = 0;
+	int		 round = 0;
+	int		 i;
+	int		 j;
+	int		 rc;
+
+	oid = dts_oid_gen(DAOS_OC_SMALL_RW, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_ARRAY, arg);
+
+	print_message("Insert %d dkeys (obj:"DF_OID")\n", ENUM_GRP_KEY_NR,
+		      DP_OID(oid));
+	for (i = 0; i < ENUM_GRP_KEY_NR; i++) {
+		sprintf(key, "%d", i);
+		insert_single(key, "a_key", 0, "data", strlen("data") + 1,
+			      DAOS_TX_NONE, &req);
+	}
+
+	memset(&anchor, 0, sizeof(anchor));
+	while (!daos_anchor_is_eof(&anchor)) {
+		number = ENUM_GRP_BATCH_NR;
+		rc = enumerate_dkey(DAOS_TX_NONE, &number, kds, &anchor, buf,
+				    sizeof(buf), &req);
+		assert_int_equal(rc, 0);
+
+		for (i = 0, ptr = buf; i < number; i++) {
+			memset(key, 0, sizeof(key));
+			memcpy(key, ptr, kds[i].kd_key_len);
+			ptr += kds[i].kd_key_len;
+			j = atoi(key);
+			assert_true(j >= 0 && j < ENUM_GRP_KEY_NR);
+			assert_false(seen[j]);
+			seen[j] = true;
+		}
+		key_nr += number;
+
+		if (round++ % 2 == 0) {
+			/* recycle the context by enumerations started after
+			 * it and abandoned.
+			 */
+			for (i = 0; i < 16; i++) {
+				memset(&other, 0, sizeof(other));
+				number = 1;
+				rc = enumerate_dkey(DAOS_TX_NONE, &number,
+						    kds, &other, buf,
+						    sizeof(buf), &req);
+				assert_int_equal(rc, 0);
+			}
+		} else {
+			/* drop the context with the object handle */
+			ioreq_fini(&req);
+			ioreq_init(&req, arg->coh, oid, DAOS_IOD_ARRAY, arg);
+		}
+	}
+
+	print_message("Enumerated %d dkeys in %d calls\n", key_nr, round);
+	assert_int_equal(key_nr, ENUM_GRP_KEY_NR);
+	ioreq_fini(&req);
+}
+
 #define PUNCH_NUM_KEYS 5
 #define PUNCH_IOD_SIZE 1024
 #define PUNCH_SCM_NUM_EXTS 2 /* SCM 2k record */
@@ -3353,6 +3527,10 @@ static const struct CMUnitTest io_tests[] = {
 	  punch_then_lookup, async_disable, test_case_teardown},
 	{ "IO35: split update fetch",
 	  split_sgl_update_fetch, async_disable, test_case_teardown},
+	{ "IO36: enumerate dkeys of a multi-group object",
+	  enumerate_multi_grp, async_disable, test_case_teardown},
+	{ "IO37: resume dkey enumeration without its context",
+	  enumerate_multi_grp_resume, async_disable, test_case_teardown},
 };
 
 int
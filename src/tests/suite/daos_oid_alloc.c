@@ -276,6 +276,52 @@ check:
 	assert_int_equal(rc, 0);
 }
 
+#define NUM_PREFETCH_OIDS 2000
+
+static void
+prefetch_oid_allocator(void **state)
+{
+	test_arg_t		*arg = *state;
+	struct daos_oid_alloc	*alloc;
+	uint64_t		*oids;
+	int			*num_oids;
+	int			i;
+	int			rc, rc_reduce;
+
+	D_ALLOC_ARRAY(oids, NUM_PREFETCH_OIDS);
+	assert_non_null(oids);
+	D_ALLOC_ARRAY(num_oids, NUM_PREFETCH_OIDS);
+	assert_non_null(num_oids);
+
+	rc = daos_cont_oid_alloc_init(arg->coh, &alloc);
+	assert_int_equal(rc, 0);
+
+	for (i = 0; i < NUM_PREFETCH_OIDS; i++) {
+		num_oids[i] = 1;
+		rc = daos_cont_oid_alloc(alloc, &oids[i]);
+		if (rc) {
+			fprintf(stderr, "%d: oid alloc failed (%d)\n", i, rc);
+			break;
+		}
+	}
+
+	rc_reduce = daos_cont_oid_alloc_fini(alloc);
+	if (rc == 0)
+		rc = rc_reduce;
+	if (arg->rank_size > 1) {
+		MPI_Allreduce(&rc, &rc_reduce, 1, MPI_INT, MPI_MIN,
+			      MPI_COMM_WORLD);
+		rc = rc_reduce;
+	}
+	assert_int_equal(rc, 0);
+
+	rc = check_ranges(num_oids, oids, NUM_PREFETCH_OIDS, arg);
+	assert_int_equal(rc, 0);
+
+	D_FREE(num_oids);
+	D_FREE(oids);
+}
+
 static const struct CMUnitTest oid_alloc_tests[] = {
 	{"OID_ALLOC1: Simple OID ALLOCATION (blocking)",
 	 simple_oid_allocator, async_disable, NULL},
@@ -283,6 +329,8 @@ static const struct CMUnitTest oid_alloc_tests[] = {
 	 multi_cont_oid_allocator, async_disable, NULL},
 	{"OID_ALLOC3: OID Allocator check (blocking)",
 	 oid_allocator_checker, async_disable, NULL},
+	{"OID_ALLOC4: Prefetching OID allocator check",
+	 prefetch_oid_allocator, async_disable, NULL},
 };
 
 int
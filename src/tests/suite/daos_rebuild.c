@@ -525,6 +525,225 @@ rebuild_objects(void **state)
 	rebuild_io_validate(arg, oids, OBJ_NR, false);
 }
 
+static void
+rebuild_objects_full_scan(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	oids[OBJ_NR];
+	int		i;
+
+	if (!test_runable(arg, 6))
+		return;
+
+	for (i = 0; i < OBJ_NR; i++) {
+		oids[i] = dts_oid_gen(DAOS_OC_R3S_SPEC_RANK, 0, arg->myrank);
+		oids[i] = dts_oid_set_rank(oids[i], ranks_to_kill[0]);
+		oids[i] = dts_oid_set_tgt(oids[i], DEFAULT_FAIL_TGT);
+	}
+
+	rebuild_io(arg, oids, OBJ_NR);
+
+	/* same as REBUILD6, but ignore the replica index on all servers */
+	if (arg->myrank == 0)
+		daos_mgmt_set_params(arg->group, -1, DSS_KEY_FAIL_LOC,
+				     DAOS_REBUILD_NO_INDEX | DAOS_FAIL_ALWAYS,
+				     0, NULL);
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	rebuild_single_pool_target(arg, ranks_to_kill[0], DEFAULT_FAIL_TGT);
+
+	if (arg->myrank == 0)
+		daos_mgmt_set_params(arg->group, -1, DSS_KEY_FAIL_LOC, 0, 0,
+				     NULL);
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	rebuild_io_validate(arg, oids, OBJ_NR, false);
+}
+
+static void
+rebuild_punched_object(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	oid;
+	struct ioreq	req;
+	char		buf[16];
+	int		i;
+
+	if (!test_runable(arg, 6))
+		return;
+
+	oid = dts_oid_gen(DAOS_OC_R3S_SPEC_RANK, 0, arg->myrank);
+	oid = dts_oid_set_rank(oid, ranks_to_kill[0]);
+	oid = dts_oid_set_tgt(oid, DEFAULT_FAIL_TGT);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_ARRAY, arg);
+	insert_single("dkey", "akey", 0, "data", strlen("data") + 1,
+		      DAOS_TX_NONE, &req);
+	punch_obj(DAOS_TX_NONE, &req);
+	ioreq_fini(&req);
+
+	/* the object is found through the replica index */
+	rebuild_single_pool_target(arg, ranks_to_kill[0], DEFAULT_FAIL_TGT);
+
+	/* every replica, including the rebuilt one, is punched */
+	arg->fail_loc = DAOS_OBJ_SPECIAL_SHARD;
+	for (i = 0; i < OBJ_REPLICAS; i++) {
+		arg->fail_value = i;
+		ioreq_init(&req, arg->coh, oid, DAOS_IOD_ARRAY, arg);
+		memset(buf, 0, sizeof(buf));
+		lookup_empty_single("dkey", "akey", 0, buf, sizeof(buf),
+				    DAOS_TX_NONE, &req);
+		assert_int_equal(req.iod[0].iod_size, 0);
+		ioreq_fini(&req);
+	}
+	arg->fail_loc = 0;
+	arg->fail_value = 0;
+}
+
+#define EST_VAL_SIZE	1024
+static void
+rebuild_size_estimate(void **state)
+{
+	test_arg_t		*arg = *state;
+	daos_pool_info_t	 pinfo = { 0 };
+	daos_obj_id_t		 oid;
+	struct ioreq		 req;
+	char			 data[EST_VAL_SIZE];
+	int			 i;
+	int			 rc;
+
+	if (!test_runable(arg, 6))
+		return;
+
+	oid = dts_oid_gen(DAOS_OC_R3S_SPEC_RANK, 0, arg->myrank);
+	oid = dts_oid_set_rank(oid, ranks_to_kill[0]);
+	oid = dts_oid_set_tgt(oid, DEFAULT_FAIL_TGT);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_ARRAY, arg);
+
+	/* far more values than sampled by the size estimate of the scanner */
+	print_message("Insert %d %d bytes records in object "DF_OID"\n",
+		      KEY_NR, EST_VAL_SIZE, DP_OID(oid));
+	memset(data, 'e', sizeof(data));
+	for (i = 0; i < KEY_NR; i++) {
+		char	key[16];
+
+		sprintf(key, "%d", i);
+		insert_single(key, "a_key", 0, data, sizeof(data),
+			      DAOS_TX_NONE, &req);
+	}
+	ioreq_fini(&req);
+
+	rebuild_single_pool_target(arg, ranks_to_kill[0], DEFAULT_FAIL_TGT);
+
+	rc = test_pool_get_info(arg, &pinfo);
+	assert_int_equal(rc, 0);
+	print_message("rebuilt "DF_U64" bytes, estimated "DF_U64"\n",
+		      pinfo.pi_rebuild_st.rs_size,
+		      pinfo.pi_rebuild_st.rs_toberb_size);
+	assert_int_equal(pinfo.pi_rebuild_st.rs_done, 1);
+	assert_int_equal(pinfo.pi_rebuild_st.rs_eta, 0);
+	/* the estimate of the shard is extrapolated to all of its dkeys */
+	assert_true(pinfo.pi_rebuild_st.rs_toberb_size >=
+		    (uint64_t)KEY_NR * EST_VAL_SIZE / 2);
+}
+
+static void
+rebuild_discarded_epoch(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	oid;
+	struct ioreq	req;
+	daos_handle_t	th[2];
+	char		buf[16];
+	int		i;
+	int		rc;
+
+	if (!test_runable(arg, 6))
+		return;
+
+	oid = dts_oid_gen(DAOS_OC_R3S_SPEC_RANK, 0, arg->myrank);
+	oid = dts_oid_set_rank(oid, ranks_to_kill[0]);
+	oid = dts_oid_set_tgt(oid, DEFAULT_FAIL_TGT);
+	/* tx discard only supports DAOS_IOD_SINGLE */
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_SINGLE, arg);
+
+	/* the object is created, and indexed, in the first transaction */
+	for (i = 0; i < 2; i++) {
+		rc = daos_tx_open(arg->coh, &th[i], NULL);
+		assert_int_equal(rc, 0);
+	}
+	insert_single("dkey0", "akey", 0, "data0", strlen("data0") + 1,
+		      th[0], &req);
+	insert_single("dkey1", "akey", 0, "data1", strlen("data1") + 1,
+		      th[1], &req);
+	rc = daos_tx_commit(th[1], NULL);
+	assert_int_equal(rc, 0);
+
+	print_message("Discarding the first transaction\n");
+	rc = daos_tx_abort(th[0], NULL);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < 2; i++) {
+		rc = daos_tx_close(th[i], NULL);
+		assert_int_equal(rc, 0);
+	}
+	ioreq_fini(&req);
+
+	/* the object must still be found through the replica index */
+	rebuild_single_pool_target(arg, ranks_to_kill[0], DEFAULT_FAIL_TGT);
+
+	/* every replica, including the rebuilt one, has the second update */
+	arg->fail_loc = DAOS_OBJ_SPECIAL_SHARD;
+	for (i = 0; i < OBJ_REPLICAS; i++) {
+		arg->fail_value = i;
+		ioreq_init(&req, arg->coh, oid, DAOS_IOD_SINGLE, arg);
+		memset(buf, 0, sizeof(buf));
+		lookup_single("dkey1", "akey", 0, buf, sizeof(buf),
+			      DAOS_TX_NONE, &req);
+		assert_int_equal(req.iod[0].iod_size, strlen("data1") + 1);
+		assert_string_equal(buf, "data1");
+		ioreq_fini(&req);
+	}
+	arg->fail_loc = 0;
+	arg->fail_value = 0;
+}
+
+static void
+rebuild_reint_objects(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	oids[OBJ_NR];
+	int		i;
+
+	if (!test_runable(arg, 6))
+		return;
+
+	for (i = 0; i < OBJ_NR; i++) {
+		oids[i] = dts_oid_gen(DAOS_OC_R3S_SPEC_RANK, 0, arg->myrank);
+		oids[i] = dts_oid_set_rank(oids[i], ranks_to_kill[0]);
+		oids[i] = dts_oid_set_tgt(oids[i], DEFAULT_FAIL_TGT);
+	}
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	if (arg->myrank == 0) {
+		rebuild_exclude_tgt(&arg, 1, ranks_to_kill[0],
+				    DEFAULT_FAIL_TGT, false);
+		test_rebuild_wait(&arg, 1);
+	}
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	/* the objects are created while their target is down */
+	rebuild_io(arg, oids, OBJ_NR);
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	if (arg->myrank == 0) {
+		rebuild_add_tgt(&arg, 1, ranks_to_kill[0], DEFAULT_FAIL_TGT);
+		test_rebuild_wait(&arg, 1);
+	}
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	/* including the shards on the reintegrated target */
+	rebuild_io_validate(arg, oids, OBJ_NR, false);
+}
+
 static void
 rebuild_drop_scan(void **state)
 {
@@ -1794,6 +2013,16 @@ static const struct CMUnitTest rebuild_tests[] = {
 	 rebuild_fail_all_replicas, NULL, test_case_teardown},
 	{"REBUILD33: multi-pools rebuild concurrently",
 	 multi_pools_rebuild_concurrently, NULL, test_case_teardown},
+	{"REBUILD34: reintegrate objects created while target down",
+	 rebuild_reint_objects, NULL, test_case_teardown},
+	{"REBUILD35: rebuild multiple objects with full scan",
+	 rebuild_objects_full_scan, NULL, test_case_teardown},
+	{"REBUILD36: rebuild punched object",
+	 rebuild_punched_object, NULL, test_case_teardown},
+	{"REBUILD37: estimate the size of a large object",
+	 rebuild_size_estimate, NULL, test_case_teardown},
+	{"REBUILD38: rebuild object after discarding its first epoch",
+	 rebuild_discarded_epoch, NULL, test_case_teardown},
 };
 
 int
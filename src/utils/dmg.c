@@ -458,6 +458,14 @@ pool_op_hdlr(int argc, char *argv[])
 
 			D_PRINT("Rebuild %s, "DF_U64" objs, "DF_U64" recs\n",
 				sstr, rstat->rs_obj_nr, rstat->rs_rec_nr);
+			if (rstat->rs_version != 0 && !rstat->rs_done)
+				D_PRINT("Rebuild progress "DF_U64"/"DF_U64
+					" objs, "DF_U64"/"DF_U64" bytes, rate "
+					DF_U64" bytes/s, ETA "DF_U64" secs\n",
+					rstat->rs_obj_nr,
+					rstat->rs_toberb_obj_nr,
+					rstat->rs_size, rstat->rs_toberb_size,
+					rstat->rs_rate, rstat->rs_eta);
 		} else {
 			D_PRINT("Rebuild failed, rc=%d, status=%d\n",
 				rc, rstat->rs_errno);
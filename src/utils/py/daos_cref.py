@@ -64,7 +64,11 @@ class RebuildStatus(ctypes.Structure):
                 ("rs_done", ctypes.c_uint32),
                 ("rs_toberb_obj_nr", ctypes.c_uint64),
                 ("rs_obj_nr", ctypes.c_uint64),
-                ("rs_rec_nr", ctypes.c_uint64)]
+                ("rs_rec_nr", ctypes.c_uint64),
+                ("rs_toberb_size", ctypes.c_uint64),
+                ("rs_size", ctypes.c_uint64),
+                ("rs_rate", ctypes.c_uint64),
+                ("rs_eta", ctypes.c_uint64)]
 
 class Daos_handle_t(ctypes.Structure):
     """ Structure to represent rebuild status info """
@@ -59,7 +59,8 @@ struct vos_io_context {
 	d_list_t		 ic_blk_exts;
 	/** flags */
 	unsigned int		 ic_update:1,
-				 ic_size_fetch:1;
+				 ic_size_fetch:1,
+				 ic_new_obj:1;
 };
 
 static struct vos_io_context *
@@ -177,6 +178,10 @@ vos_ioc_create(daos_handle_t coh, daos_unit_oid_t oid, bool read_only,
 	if (rc != 0)
 		goto error;
 
+	/* the object has no key yet, it is created by this update */
+	if (!read_only)
+		ioc->ic_new_obj = (ioc->ic_obj->obj_df->vo_tree.tr_depth == 0);
+
 	rc = vos_ioc_reserve_init(ioc);
 	if (rc != 0)
 		goto error;
@@ -1270,6 +1275,15 @@ error:
 	return rc;
 }
 
+bool
+vos_update_obj_new(daos_handle_t ioh)
+{
+	struct vos_io_context *ioc = vos_ioh2ioc(ioh);
+
+	D_ASSERT(ioc->ic_update);
+	return ioc->ic_new_obj;
+}
+
 struct bio_desc *
 vos_ioh2desc(daos_handle_t ioh)
 {